@@ -39,16 +39,20 @@ namespace benchmarks {
  */
 class BigtableImpl final : public btproto::Bigtable::Service {
  public:
-  BigtableImpl()
-      : mutate_row_count_(0), mutate_rows_count_(0), read_rows_count_(0) {
+  explicit BigtableImpl(RowShape shape)
+      : shape_(shape),
+        mutate_row_count_(0),
+        mutate_rows_count_(0),
+        read_rows_count_(0) {
     // Prepare a list of random values to use at run-time.  This is because we
     // want the overhead of this implementation to be as small as possible.
     // Using a single value is an option, but compresses too well and makes the
     // tests a bit unrealistic.
     auto generator = google::cloud::internal::MakeDefaultPRNG();
     values_.resize(1000);
-    std::generate(values_.begin(), values_.end(),
-                  [&generator]() { return MakeRandomValue(generator); });
+    std::generate(values_.begin(), values_.end(), [&generator, this]() {
+      return MakeRandomValue(generator, shape_.value_size);
+    });
   }
 
   grpc::Status MutateRow(grpc::ServerContext*, btproto::MutateRowRequest const*,
@@ -83,26 +87,25 @@ class BigtableImpl final : public btproto::Bigtable::Service {
     btproto::ReadRowsResponse msg;
     for (std::int64_t i = 0; i != rows_limit; ++i) {
       std::size_t idx = 0;
-      char const* cf = kColumnFamily;
       std::ostringstream os;
       os << "user" << std::setw(12) << std::setfill('0') << i;
-      std::string row_key = os.str();
-      for (int j = 0; j != kNumFields; ++j) {
+      for (int j = 0; j != shape_.cells_per_row; ++j) {
         auto& chunk = *msg.add_chunks();
         // This is neither the real format of the keys, nor the keys requested,
-        // but it is good enough for a simulation.
-        chunk.set_row_key(row_key);
+        // but it is good enough for a simulation. Like the service, only the
+        // first cell in the row includes the row key and column family. Each
+        // chunk contains a complete cell, so `value_size` is not set.
+        if (j == 0) {
+          chunk.set_row_key(os.str());
+          chunk.mutable_family_name()->set_value(kColumnFamily);
+        }
         chunk.set_timestamp_micros(0);
-        chunk.mutable_family_name()->set_value(cf);
         chunk.mutable_qualifier()->set_value("field" + std::to_string(j));
         chunk.set_value(values_[idx]);
-        chunk.set_value_size(static_cast<std::int32_t>(values_[idx].size()));
         if (++idx >= values_.size()) {
           idx = 0;
         }
-        cf = "";
-        if (j == kNumFields - 1) {
-          chunk.set_value_size(0);
+        if (j == shape_.cells_per_row - 1) {
           chunk.set_commit_row(true);
         }
       }
@@ -120,6 +123,7 @@ class BigtableImpl final : public btproto::Bigtable::Service {
   int read_rows_count() const { return read_rows_count_.load(); }
 
  private:
+  RowShape shape_;
   std::vector<std::string> values_;
   std::atomic<int> mutate_row_count_;
   std::atomic<int> mutate_rows_count_;
@@ -160,7 +164,7 @@ class TableAdminImpl final : public btadmin::BigtableTableAdmin::Service {
 /// The implementation of EmbeddedServer.
 class DefaultEmbeddedServer : public EmbeddedServer {
  public:
-  explicit DefaultEmbeddedServer() {
+  explicit DefaultEmbeddedServer(RowShape shape) : bigtable_service_(shape) {
     int port;
     std::string server_address("[::]:0");
     builder_.AddListeningPort(server_address, grpc::InsecureServerCredentials(),
@@ -200,7 +204,11 @@ class DefaultEmbeddedServer : public EmbeddedServer {
 };
 
 std::unique_ptr<EmbeddedServer> CreateEmbeddedServer() {
-  return std::unique_ptr<EmbeddedServer>(new DefaultEmbeddedServer);
+  return CreateEmbeddedServer(RowShape{});
+}
+
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(RowShape shape) {
+  return std::unique_ptr<EmbeddedServer>(new DefaultEmbeddedServer(shape));
 }
 
 }  // namespace benchmarks
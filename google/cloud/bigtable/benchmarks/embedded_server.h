@@ -15,6 +15,8 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_EMBEDDED_SERVER_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_EMBEDDED_SERVER_H
 
+#include "google/cloud/bigtable/benchmarks/constants.h"
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -22,6 +24,14 @@ namespace google {
 namespace cloud {
 namespace bigtable {
 namespace benchmarks {
+/// The shape of the rows returned by the embedded server `ReadRows()` RPC.
+struct RowShape {
+  /// The number of cells in each row, each in a different column.
+  int cells_per_row = kNumFields;
+  /// The size of each cell value.
+  std::size_t value_size = kFieldSize;
+};
+
 /**
  * An abstract class to run and stop the embedded Bigtable server.
  *
@@ -49,6 +59,9 @@ class EmbeddedServer {
 /// Create an embedded server.
 std::unique_ptr<EmbeddedServer> CreateEmbeddedServer();
 
+/// Create an embedded server returning rows with the given @p shape.
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(RowShape shape);
+
 }  // namespace benchmarks
 }  // namespace bigtable
 }  // namespace cloud
@@ -172,6 +172,38 @@ TEST(EmbeddedServer, ReadRows100) {
   wait_thread.join();
 }
 
+TEST(EmbeddedServer, ReadRowsShape) {
+  RowShape shape;
+  shape.cells_per_row = 3;
+  shape.value_size = 7;
+  auto server = CreateEmbeddedServer(shape);
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  auto options =
+      Options{}
+          .set<GrpcCredentialOption>(grpc::InsecureChannelCredentials())
+          .set<EndpointOption>(server->address());
+
+  Table table(MakeDataConnection(
+                  {InstanceResource(Project("fake-project"), "fake-instance")},
+                  std::move(options)),
+              TableResource("fake-project", "fake-instance", "fake-table"));
+
+  auto reader = table.ReadRows(RowSet(RowRange::StartingAt("foo")), 2,
+                               Filter::PassAllFilter());
+  int count = 0;
+  for (auto& row : reader) {
+    ASSERT_STATUS_OK(row);
+    ASSERT_EQ(3, row->cells().size());
+    for (auto const& cell : row->cells()) EXPECT_EQ(7, cell.value().size());
+    ++count;
+  }
+  EXPECT_EQ(2, count);
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
 }  // namespace
 }  // namespace benchmarks
 }  // namespace bigtable
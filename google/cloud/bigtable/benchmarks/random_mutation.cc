@@ -27,9 +27,15 @@ bigtable::Mutation MakeRandomMutation(google::cloud::internal::DefaultPRNG& gen,
 }
 
 std::string MakeRandomValue(google::cloud::internal::DefaultPRNG& generator) {
+  return MakeRandomValue(generator, kFieldSize);
+}
+
+std::string MakeRandomValue(google::cloud::internal::DefaultPRNG& generator,
+                            std::size_t size) {
   static auto const* const kLetters = new std::string(
       "ABCDEFGHIJLKMNOPQRSTUVWXYZabcdefghijlkmnopqrstuvwxyz0123456789-/_");
-  return google::cloud::internal::Sample(generator, kFieldSize, *kLetters);
+  return google::cloud::internal::Sample(generator, static_cast<int>(size),
+                                         *kLetters);
 }
 }  // namespace benchmarks
 }  // namespace bigtable
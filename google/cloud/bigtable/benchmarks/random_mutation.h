@@ -17,6 +17,7 @@
 
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/internal/random.h"
+#include <cstddef>
 #include <string>
 
 namespace google {
@@ -31,6 +32,10 @@ bigtable::Mutation MakeRandomMutation(google::cloud::internal::DefaultPRNG& gen,
 /// Create a random value to store in a field.
 std::string MakeRandomValue(google::cloud::internal::DefaultPRNG& gen);
 
+/// Create a random value of @p size bytes.
+std::string MakeRandomValue(google::cloud::internal::DefaultPRNG& gen,
+                            std::size_t size);
+
 }  // namespace benchmarks
 }  // namespace bigtable
 }  // namespace cloud
@@ -0,0 +1,292 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/constants.h"
+#include "google/cloud/bigtable/benchmarks/embedded_server.h"
+#include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/mutation_batcher.h"
+#include "google/cloud/bigtable/resource_names.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/testing_util/allocation_counter.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ *
+ * CPU and allocation microbenchmarks for the `ReadRows()` and `MutateRows()`
+ * data paths.
+ *
+ * Unlike the other benchmarks in this directory these do not need a Cloud
+ * Bigtable instance or emulator. `ReadRowsParser` is fed pre-built chunks, and
+ * the other benchmarks use the embedded server, configured to return rows of
+ * each shape. Besides the usual timings, each benchmark reports:
+ *
+ * - `allocs_per_row`: heap allocations per row, made by the benchmark thread.
+ *   This excludes the allocations of the embedded server.
+ * - `cpu_per_cell`: CPU time per cell.
+ */
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+namespace {
+
+using ::google::cloud::testing_util::AllocationCounter;
+
+// Each iteration reads or writes about this much data.
+auto constexpr kBytesPerIteration = 1024 * 1024;
+auto constexpr kMaxRowsPerIteration = 64;
+
+// The benchmark arguments are the number of cells per row and the size of
+// each value.
+void RowShapes(::benchmark::internal::Benchmark* b) {
+  b->ArgNames({"cells", "value_size"});
+  b->Args({kNumFields, kFieldSize});  // The shape used by other benchmarks.
+  b->Args({1000, 100});               // Wide rows.
+  b->Args({256, 1});                  // Many small cells.
+  b->Args({4, 256 * 1024});           // Large values.
+}
+
+RowShape MakeRowShape(::benchmark::State const& state) {
+  RowShape shape;
+  shape.cells_per_row = static_cast<int>(state.range(0));
+  shape.value_size = static_cast<std::size_t>(state.range(1));
+  return shape;
+}
+
+std::int64_t RowsPerIteration(RowShape const& shape) {
+  auto const row_size =
+      static_cast<std::int64_t>(shape.cells_per_row * shape.value_size);
+  return (std::max<std::int64_t>)(
+      1, (std::min<std::int64_t>)(kMaxRowsPerIteration,
+                                  kBytesPerIteration / row_size));
+}
+
+std::string MakeRowKey(std::int64_t i) {
+  std::ostringstream os;
+  os << "user" << std::setw(12) << std::setfill('0') << i;
+  return os.str();
+}
+
+void ReportCounters(::benchmark::State& state, RowShape const& shape,
+                    std::int64_t rows, std::int64_t allocations) {
+  auto const cells = rows * shape.cells_per_row;
+  state.SetItemsProcessed(rows);
+  state.SetBytesProcessed(cells * static_cast<std::int64_t>(shape.value_size));
+  state.counters["allocs_per_row"] =
+      rows == 0 ? 0 : static_cast<double>(allocations) / rows;
+  state.counters["cpu_per_cell"] = ::benchmark::Counter(
+      static_cast<double>(cells),
+      ::benchmark::Counter::kIsRate | ::benchmark::Counter::kInvert);
+}
+
+/// Runs an embedded server and a `Table` connected to it.
+class EmbeddedTable {
+ public:
+  explicit EmbeddedTable(RowShape shape)
+      : server_(CreateEmbeddedServer(shape)),
+        server_thread_([this] { server_->Wait(); }),
+        table_(MakeDataConnection(
+                   {InstanceResource(Project("fake-project"), "fake-instance")},
+                   Options{}
+                       .set<GrpcCredentialOption>(
+                           grpc::InsecureChannelCredentials())
+                       .set<EndpointOption>(server_->address())),
+               TableResource("fake-project", "fake-instance", "fake-table")) {}
+
+  ~EmbeddedTable() {
+    server_->Shutdown();
+    server_thread_.join();
+  }
+
+  Table& table() { return table_; }
+
+ private:
+  std::unique_ptr<EmbeddedServer> server_;
+  std::thread server_thread_;
+  Table table_;
+};
+
+std::vector<SingleRowMutation> MakeMutations(RowShape const& shape,
+                                             std::int64_t rows) {
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  auto const value = MakeRandomValue(generator, shape.value_size);
+  std::vector<SingleRowMutation> mutations;
+  for (std::int64_t i = 0; i != rows; ++i) {
+    SingleRowMutation m(MakeRowKey(i));
+    for (int j = 0; j != shape.cells_per_row; ++j) {
+      m.emplace_back(SetCell(kColumnFamily, "field" + std::to_string(j),
+                             std::chrono::milliseconds(0), value));
+    }
+    mutations.push_back(std::move(m));
+  }
+  return mutations;
+}
+
+// Parse a stream of chunks with `ReadRowsParser`.
+void BM_ReadRowsParser(::benchmark::State& state) {
+  auto const shape = MakeRowShape(state);
+  auto const rows = RowsPerIteration(shape);
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  auto const value = MakeRandomValue(generator, shape.value_size);
+  std::vector<google::bigtable::v2::ReadRowsResponse::CellChunk> chunks;
+  for (std::int64_t i = 0; i != rows; ++i) {
+    for (int j = 0; j != shape.cells_per_row; ++j) {
+      google::bigtable::v2::ReadRowsResponse::CellChunk chunk;
+      if (j == 0) {
+        chunk.set_row_key(MakeRowKey(i));
+        chunk.mutable_family_name()->set_value(kColumnFamily);
+      }
+      chunk.mutable_qualifier()->set_value("field" + std::to_string(j));
+      chunk.set_value(value);
+      chunk.set_commit_row(j == shape.cells_per_row - 1);
+      chunks.push_back(std::move(chunk));
+    }
+  }
+
+  std::int64_t total_rows = 0;
+  std::int64_t allocations = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto input = chunks;
+    state.ResumeTiming();
+    auto const counter = AllocationCounter::PerThread();
+    bigtable::internal::ReadRowsParser parser(/*reverse=*/false);
+    grpc::Status status;
+    for (auto& chunk : input) {
+      parser.HandleChunk(std::move(chunk), status);
+      while (parser.HasNext()) {
+        auto row = parser.Next(status);
+        ::benchmark::DoNotOptimize(row);
+        ++total_rows;
+      }
+    }
+    parser.HandleEndOfStream(status);
+    allocations += counter.Sample();
+    if (!status.ok()) state.SkipWithError(status.error_message().c_str());
+  }
+  ReportCounters(state, shape, total_rows, allocations);
+}
+BENCHMARK(BM_ReadRowsParser)->Apply(RowShapes);
+
+// Read rows from the embedded server, using `Table::ReadRows()` and thus the
+// `DefaultRowReader`.
+void BM_DefaultRowReader(::benchmark::State& state) {
+  auto const shape = MakeRowShape(state);
+  auto const rows = RowsPerIteration(shape);
+  EmbeddedTable embedded(shape);
+
+  std::int64_t total_rows = 0;
+  std::int64_t allocations = 0;
+  for (auto _ : state) {
+    auto const counter = AllocationCounter::PerThread();
+    auto reader = embedded.table().ReadRows(RowSet(RowRange::InfiniteRange()),
+                                            rows, Filter::PassAllFilter());
+    for (auto& row : reader) {
+      if (!row) {
+        state.SkipWithError(row.status().message().c_str());
+        break;
+      }
+      ::benchmark::DoNotOptimize(*row);
+      ++total_rows;
+    }
+    allocations += counter.Sample();
+  }
+  ReportCounters(state, shape, total_rows, allocations);
+}
+BENCHMARK(BM_DefaultRowReader)->Apply(RowShapes);
+
+// Write rows to the embedded server, using `Table::BulkApply()` and thus the
+// `BulkMutator`.
+void BM_BulkMutator(::benchmark::State& state) {
+  auto const shape = MakeRowShape(state);
+  auto const rows = RowsPerIteration(shape);
+  EmbeddedTable embedded(shape);
+  auto const mutations = MakeMutations(shape, rows);
+
+  std::int64_t total_rows = 0;
+  std::int64_t allocations = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    BulkMutation bulk(mutations.begin(), mutations.end());
+    state.ResumeTiming();
+    auto const counter = AllocationCounter::PerThread();
+    auto failures = embedded.table().BulkApply(std::move(bulk));
+    allocations += counter.Sample();
+    if (!failures.empty()) {
+      state.SkipWithError(failures.front().status().message().c_str());
+      break;
+    }
+    total_rows += rows;
+  }
+  ReportCounters(state, shape, total_rows, allocations);
+}
+BENCHMARK(BM_BulkMutator)->Apply(RowShapes);
+
+// Write rows to the embedded server using a `MutationBatcher`. The batcher
+// completes the operations in the completion queue threads, only the
+// allocations to admit the mutations are counted.
+void BM_MutationBatcher(::benchmark::State& state) {
+  auto const shape = MakeRowShape(state);
+  auto const rows = RowsPerIteration(shape);
+  EmbeddedTable embedded(shape);
+  auto const mutations = MakeMutations(shape, rows);
+  CompletionQueue cq;
+  std::thread cq_thread([&cq] { cq.Run(); });
+  MutationBatcher batcher(embedded.table());
+
+  std::int64_t total_rows = 0;
+  std::int64_t allocations = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto input = mutations;
+    state.ResumeTiming();
+    auto const counter = AllocationCounter::PerThread();
+    std::vector<future<Status>> completions;
+    completions.reserve(input.size());
+    for (auto& m : input) {
+      auto admission_completion = batcher.AsyncApply(cq, std::move(m));
+      admission_completion.first.get();
+      completions.push_back(std::move(admission_completion.second));
+    }
+    allocations += counter.Sample();
+    for (auto& c : completions) {
+      auto status = c.get();
+      if (!status.ok()) state.SkipWithError(status.message().c_str());
+    }
+    total_rows += rows;
+  }
+  ReportCounters(state, shape, total_rows, allocations);
+
+  cq.Shutdown();
+  cq_thread.join();
+}
+BENCHMARK(BM_MutationBatcher)->Apply(RowShapes);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
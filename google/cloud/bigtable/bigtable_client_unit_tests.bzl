@@ -23,8 +23,10 @@ bigtable_client_unit_tests = [
     "bound_query_test.cc",
     "bytes_test.cc",
     "cell_test.cc",
+    "change_stream_reader_test.cc",
     "client_test.cc",
     "cluster_config_test.cc",
+    "column_batch_test.cc",
     "column_family_test.cc",
     "data_connection_test.cc",
     "expr_test.cc",
@@ -47,6 +49,7 @@ bigtable_client_unit_tests = [
     "internal/bulk_mutator_test.cc",
     "internal/channel_usage_test.cc",
     "internal/client_schema_metrics_test.cc",
+    "internal/column_batch_builder_test.cc",
     "internal/connection_refresh_state_test.cc",
     "internal/convert_policies_test.cc",
     "internal/crc32c_test.cc",
@@ -64,8 +67,10 @@ bigtable_client_unit_tests = [
     "internal/partial_result_set_resume_test.cc",
     "internal/partial_result_set_source_test.cc",
     "internal/prefix_range_end_test.cc",
+    "internal/query_plan_cache_test.cc",
     "internal/query_plan_test.cc",
     "internal/rate_limiter_test.cc",
+    "internal/read_modify_write_coalescer_test.cc",
     "internal/retry_traits_test.cc",
     "internal/stub_manager_test.cc",
     "internal/table_schema_metrics_test.cc",
@@ -78,6 +83,7 @@ bigtable_client_unit_tests = [
     "polling_policy_test.cc",
     "prepared_query_test.cc",
     "query_row_test.cc",
+    "read_modify_write_batcher_test.cc",
     "read_modify_write_rule_test.cc",
     "row_range_test.cc",
     "row_reader_test.cc",
@@ -0,0 +1,375 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/change_stream_reader.h"
+#include "google/cloud/bigtable/options.h"
+#include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/idempotency.h"
+#include "google/cloud/internal/retry_loop_helpers.h"
+#include "google/cloud/internal/time_utils.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace v2 = ::google::bigtable::v2;
+
+auto constexpr kDefaultHeartbeatDuration = std::chrono::seconds(1);
+auto constexpr kDefaultMaxBatchSize = 1000;
+
+/// Reassembles `DataChange` messages into `ChangeStreamMutation` values.
+class DataChangeDecoder {
+ public:
+  /// Returns the decoded change once its last message is received.
+  std::optional<ChangeStreamMutation> Add(
+      v2::ReadChangeStreamResponse::DataChange data_change) {
+    if (!current_) {
+      current_.emplace();
+      current_->type =
+          data_change.type() ==
+                  v2::ReadChangeStreamResponse::DataChange::GARBAGE_COLLECTION
+              ? ChangeStreamMutation::Type::kGarbageCollection
+              : ChangeStreamMutation::Type::kUser;
+      current_->row_key = std::move(*data_change.mutable_row_key());
+      current_->source_cluster_id =
+          std::move(*data_change.mutable_source_cluster_id());
+      current_->commit_timestamp = google::cloud::internal::ToChronoTimePoint(
+          data_change.commit_timestamp());
+      current_->tiebreaker = data_change.tiebreaker();
+    }
+    for (auto& chunk : *data_change.mutable_chunks()) {
+      if (!chunk.has_chunk_info()) {
+        current_->mutations.push_back(std::move(*chunk.mutable_mutation()));
+        continue;
+      }
+      auto const& info = chunk.chunk_info();
+      if (info.chunked_value_offset() == 0) {
+        partial_ = std::move(*chunk.mutable_mutation());
+        partial_.mutable_set_cell()->mutable_value()->reserve(
+            info.chunked_value_size());
+      } else {
+        partial_.mutable_set_cell()->mutable_value()->append(
+            chunk.mutation().set_cell().value());
+      }
+      if (info.last_chunk()) {
+        current_->mutations.push_back(std::move(partial_));
+        partial_.Clear();
+      }
+    }
+    if (!data_change.done()) return std::nullopt;
+    current_->token = std::move(*data_change.mutable_token());
+    current_->estimated_low_watermark =
+        google::cloud::internal::ToChronoTimePoint(
+            data_change.estimated_low_watermark());
+    auto result = std::move(current_);
+    current_.reset();
+    return result;
+  }
+
+  /// Discard any partially received change, e.g., after a stream fails.
+  void Reset() {
+    current_.reset();
+    partial_.Clear();
+  }
+
+ private:
+  std::optional<ChangeStreamMutation> current_;
+  v2::Mutation partial_;
+};
+
+// Partitions returned by the service use `[start_key_closed, end_key_open)`
+// ranges, where an empty end key denotes the end of the table.
+bool SameRange(v2::StreamPartition const& a, v2::StreamPartition const& b) {
+  return a.row_range().start_key_closed() == b.row_range().start_key_closed() &&
+         a.row_range().end_key_open() == b.row_range().end_key_open();
+}
+
+/// Returns true if the ranges of @p tokens cover all of @p partition.
+bool Covers(v2::StreamPartition const& partition,
+            std::vector<v2::StreamContinuationToken> tokens) {
+  std::sort(tokens.begin(), tokens.end(), [](auto const& a, auto const& b) {
+    return a.partition().row_range().start_key_closed() <
+           b.partition().row_range().start_key_closed();
+  });
+  auto const& end = partition.row_range().end_key_open();
+  std::string covered = partition.row_range().start_key_closed();
+  for (auto const& t : tokens) {
+    auto const& range = t.partition().row_range();
+    if (range.start_key_closed() > covered) return false;
+    if (range.end_key_open().empty()) return true;
+    covered = (std::max)(covered, range.end_key_open());
+  }
+  return !end.empty() && covered >= end;
+}
+
+struct PartitionWork {
+  v2::StreamPartition partition;
+  // If empty, the partition starts at the configured start time.
+  std::vector<v2::StreamContinuationToken> tokens;
+};
+
+/// Schedules partitions and collects the result of a `Read()` call.
+class ReadState {
+ public:
+  explicit ReadState(std::vector<v2::StreamPartition> partitions) {
+    for (auto& p : partitions) ready_.push_back({std::move(p), {}});
+  }
+
+  /// Blocks until there is a partition to start or resume, or returns
+  /// `std::nullopt` when there is no more work.
+  std::optional<PartitionWork> Next() {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk,
+             [this] { return stopped_ || !ready_.empty() || active_ == 0; });
+    if (stopped_ || ready_.empty()) return std::nullopt;
+    auto work = std::move(ready_.front());
+    ready_.pop_front();
+    ++active_;
+    return work;
+  }
+
+  /// Record the continuation token for a new partition, starting it once the
+  /// tokens cover its full range.
+  void AddToken(v2::StreamPartition partition,
+                v2::StreamContinuationToken token) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto i = std::find_if(pending_.begin(), pending_.end(), [&](auto const& p) {
+      return SameRange(p.partition, partition);
+    });
+    if (i == pending_.end()) {
+      i = pending_.insert(pending_.end(),
+                          PartitionWork{std::move(partition), {}});
+    }
+    i->tokens.push_back(std::move(token));
+    if (!Covers(i->partition, i->tokens)) return;
+    ready_.push_back(std::move(*i));
+    pending_.erase(i);
+    cv_.notify_one();
+  }
+
+  /// Whether any partition is waiting for a thread.
+  bool HasWaiting() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return !ready_.empty();
+  }
+
+  /// Requeue a partition that an active thread stops reading, to resume it
+  /// from @p work's tokens.
+  void Yield(PartitionWork work) {
+    std::lock_guard<std::mutex> lk(mu_);
+    --active_;
+    ready_.push_back(std::move(work));
+    cv_.notify_all();
+  }
+
+  void Done(Status status) {
+    std::lock_guard<std::mutex> lk(mu_);
+    --active_;
+    if (!status.ok() && status_.ok()) {
+      status_ = std::move(status);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  void Stop() {
+    std::lock_guard<std::mutex> lk(mu_);
+    stopped_ = true;
+    cv_.notify_all();
+  }
+
+  bool stopped() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return stopped_;
+  }
+
+  Status status() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return status_;
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<PartitionWork> ready_;
+  std::vector<PartitionWork> pending_;
+  int active_ = 0;
+  bool stopped_ = false;
+  Status status_;
+};
+
+}  // namespace
+
+ChangeStreamReader::Options::Options()
+    : heartbeat_duration(kDefaultHeartbeatDuration),
+      max_batch_size(kDefaultMaxBatchSize),
+      max_threads((std::max)(1U, std::thread::hardware_concurrency())) {}
+
+ChangeStreamReader::Options& ChangeStreamReader::Options::SetMaxBatchSize(
+    std::size_t max_batch_size_arg) {
+  max_batch_size = (std::max<std::size_t>)(1, max_batch_size_arg);
+  return *this;
+}
+
+ChangeStreamReader::Options& ChangeStreamReader::Options::SetMaxThreads(
+    std::size_t max_threads_arg) {
+  max_threads = (std::max<std::size_t>)(1, max_threads_arg);
+  return *this;
+}
+
+ChangeStreamReader::ChangeStreamReader(Table table, Options options)
+    : table_(std::move(table)), options_(std::move(options)) {}
+
+Status ChangeStreamReader::Read(BatchCallback callback) {
+  google::cloud::internal::OptionsSpan span(table_.options_);
+  auto partitions =
+      table_.connection_->GenerateInitialChangeStreamPartitions(
+          table_.table_name());
+  if (!partitions) return std::move(partitions).status();
+
+  ReadState state(*std::move(partitions));
+  auto read_partition = [&](PartitionWork work) {
+    google::cloud::internal::OptionsSpan span(table_.options_);
+    auto const& current = google::cloud::internal::CurrentOptions();
+    v2::ReadChangeStreamRequest request;
+    request.set_table_name(table_.table_name());
+    *request.mutable_partition() = work.partition;
+    if (options_.end_time) {
+      *request.mutable_end_time() =
+          google::cloud::internal::ToProtoTimestamp(*options_.end_time);
+    }
+    *request.mutable_heartbeat_duration() =
+        google::cloud::internal::ToDurationProto(options_.heartbeat_duration);
+
+    std::vector<ChangeStreamMutation> batch;
+    auto flush = [&] {
+      if (batch.empty()) return;
+      if (!callback(std::move(batch))) state.Stop();
+      batch.clear();
+    };
+
+    DataChangeDecoder decoder;
+    auto tokens = std::move(work.tokens);
+    // Give the thread to a waiting partition. Only called between changes,
+    // so the partition resumes from `tokens` without losing data.
+    auto yield = [&] {
+      if (tokens.empty() || !state.HasWaiting()) return false;
+      state.Yield(PartitionWork{work.partition, std::move(tokens)});
+      return true;
+    };
+    // The policies are only allocated after a failure, and are reset once
+    // the stream makes progress.
+    std::unique_ptr<DataRetryPolicy> retry;
+    std::unique_ptr<BackoffPolicy> backoff;
+    while (true) {
+      if (!tokens.empty()) {
+        auto& t = *request.mutable_continuation_tokens();
+        t.clear_tokens();
+        for (auto const& token : tokens) *t.add_tokens() = token;
+      } else if (options_.start_time) {
+        *request.mutable_start_time() =
+            google::cloud::internal::ToProtoTimestamp(*options_.start_time);
+      }
+      Status status;
+      std::optional<v2::ReadChangeStreamResponse::CloseStream> close;
+      for (auto& r : table_.connection_->ReadChangeStream(request)) {
+        if (!r) {
+          status = std::move(r).status();
+          break;
+        }
+        if (state.stopped()) return state.Done({});
+        retry.reset();
+        backoff.reset();
+        switch (r->stream_record_case()) {
+          case v2::ReadChangeStreamResponse::kDataChange: {
+            auto m = decoder.Add(std::move(*r->mutable_data_change()));
+            if (!m) break;
+            v2::StreamContinuationToken token;
+            *token.mutable_partition() = work.partition;
+            token.set_token(m->token);
+            tokens.assign(1, std::move(token));
+            batch.push_back(*std::move(m));
+            if (batch.size() < options_.max_batch_size) break;
+            flush();
+            if (yield()) return;
+            break;
+          }
+          case v2::ReadChangeStreamResponse::kHeartbeat:
+            tokens.assign(
+                1, std::move(*r->mutable_heartbeat()
+                                  ->mutable_continuation_token()));
+            flush();
+            if (yield()) return;
+            break;
+          case v2::ReadChangeStreamResponse::kCloseStream:
+            close = std::move(*r->mutable_close_stream());
+            break;
+          default:
+            break;
+        }
+        if (close) break;
+      }
+      if (close && close->continuation_tokens_size() != 0) {
+        flush();
+        for (int i = 0; i != close->continuation_tokens_size(); ++i) {
+          auto& token = *close->mutable_continuation_tokens(i);
+          auto partition = i < close->new_partitions_size()
+                               ? close->new_partitions(i)
+                               : token.partition();
+          state.AddToken(std::move(partition), std::move(token));
+        }
+        return state.Done({});
+      }
+      if (close) status = MakeStatusFromRpcError(close->status());
+      if (status.ok()) {
+        flush();
+        return state.Done({});
+      }
+      if (state.stopped()) return state.Done({});
+      // The last token precedes any partially received change.
+      decoder.Reset();
+      if (!retry) retry = current.get<DataRetryPolicyOption>()->clone();
+      if (!backoff) backoff = current.get<DataBackoffPolicyOption>()->clone();
+      auto delay = google::cloud::internal::Backoff(
+          status, "ReadChangeStream", *retry, *backoff,
+          Idempotency::kIdempotent, /*enable_server_retries=*/true);
+      if (!delay) {
+        flush();
+        return state.Done(std::move(delay).status());
+      }
+      std::this_thread::sleep_for(*delay);
+    }
+  };
+
+  auto worker = [&] {
+    while (auto work = state.Next()) read_partition(*std::move(work));
+  };
+  std::vector<std::thread> threads(options_.max_threads - 1);
+  for (auto& t : threads) t = std::thread(worker);
+  worker();
+  for (auto& t : threads) t.join();
+  return state.status();
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
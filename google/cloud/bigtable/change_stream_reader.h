@@ -0,0 +1,170 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CHANGE_STREAM_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CHANGE_STREAM_READER_H
+
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status.h"
+#include "google/bigtable/v2/bigtable.pb.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * A committed change to a single row, decoded from a table's change stream.
+ *
+ * Values split across several `ReadChangeStreamResponse` messages are
+ * reassembled, so each element of `mutations` is a complete mutation.
+ */
+struct ChangeStreamMutation {
+  /// Whether the change was made by an application or by garbage collection.
+  enum class Type { kUser, kGarbageCollection };
+
+  Type type = Type::kUser;
+  std::string row_key;
+  /// The cluster where the change was applied. Empty for garbage collection.
+  std::string source_cluster_id;
+  std::chrono::system_clock::time_point commit_timestamp;
+  /// Orders changes to the same row with the same `commit_timestamp`.
+  std::int32_t tiebreaker = 0;
+  std::vector<google::bigtable::v2::Mutation> mutations;
+  /// Resume the partition from this token to skip this and earlier changes.
+  std::string token;
+  std::chrono::system_clock::time_point estimated_low_watermark;
+};
+
+/**
+ * Reads the change stream of a table.
+ *
+ * The reader discovers the table's change stream partitions and reads them
+ * with a pool of at most `max_threads` threads. When there are more
+ * partitions than threads, a thread yields its partition at the next
+ * heartbeat or full batch, and the partition is later resumed from its
+ * continuation token, so all the partitions make progress. When the service
+ * splits or merges partitions the reader starts the new partitions from the
+ * continuation tokens returned by the service. A merged partition starts
+ * only after all the partitions that it replaces have been closed.
+ *
+ * Decoded changes are delivered to the application in batches. A partition's
+ * batch is delivered when it holds `max_batch_size` changes, when the service
+ * sends a heartbeat, or when the partition's stream is closed. Transient
+ * errors are retried using the `DataRetryPolicyOption` and
+ * `DataBackoffPolicyOption` of the `Table`, resuming from the last
+ * continuation token received for the partition.
+ *
+ * @par Thread-safety
+ * The callback passed to `Read()` is invoked concurrently from the threads
+ * reading the partitions. Within a partition batches are delivered in commit
+ * order.
+ *
+ * @code
+ * bigtable::ChangeStreamReader reader(
+ *     table, bigtable::ChangeStreamReader::Options().SetStartTime(start));
+ * auto status = reader.Read(
+ *     [](std::vector<bigtable::ChangeStreamMutation> batch) {
+ *       for (auto const& m : batch) Process(m);
+ *       return true;
+ *     });
+ * @endcode
+ */
+class ChangeStreamReader {
+ public:
+  /// Configuration for `ChangeStreamReader`.
+  struct Options {
+    Options();
+
+    /**
+     * Start reading at this time. If unset, start at the current time.
+     *
+     * The value is ignored for partitions started from continuation tokens.
+     */
+    Options& SetStartTime(std::chrono::system_clock::time_point start) {
+      start_time = start;
+      return *this;
+    }
+
+    /// Stop reading at this time. If unset, read until `Read()` is stopped.
+    Options& SetEndTime(std::chrono::system_clock::time_point end) {
+      end_time = end;
+      return *this;
+    }
+
+    /**
+     * How often the service sends a heartbeat on idle partitions.
+     *
+     * Heartbeats flush partially filled batches and bound how long it takes
+     * to stop the reader.
+     */
+    Options& SetHeartbeatDuration(std::chrono::milliseconds heartbeat) {
+      heartbeat_duration = heartbeat;
+      return *this;
+    }
+
+    /// Deliver a partition's changes once this many are buffered.
+    Options& SetMaxBatchSize(std::size_t max_batch_size_arg);
+
+    /**
+     * Read at most this many partitions at the same time.
+     *
+     * The default is the number of hardware threads.
+     */
+    Options& SetMaxThreads(std::size_t max_threads_arg);
+
+    std::optional<std::chrono::system_clock::time_point> start_time;
+    std::optional<std::chrono::system_clock::time_point> end_time;
+    std::chrono::milliseconds heartbeat_duration;
+    std::size_t max_batch_size;
+    std::size_t max_threads;
+  };
+
+  /**
+   * Receives a batch of changes from a single partition.
+   *
+   * Return `false` to stop reading all the partitions.
+   */
+  using BatchCallback =
+      std::function<bool(std::vector<ChangeStreamMutation> batch)>;
+
+  explicit ChangeStreamReader(Table table, Options options = Options());
+
+  /**
+   * Read the change stream, invoking @p callback with each batch of changes.
+   *
+   * Blocks until the end time is reached, @p callback returns `false`, or
+   * a partition fails with a non-retryable error. In the last case the
+   * remaining partitions are stopped and the error is returned.
+   */
+  Status Read(BatchCallback callback);
+
+ private:
+  Table table_;
+  Options options_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CHANGE_STREAM_READER_H
@@ -0,0 +1,333 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/change_stream_reader.h"
+#include "google/cloud/bigtable/mocks/mock_data_connection.h"
+#include "google/cloud/bigtable/options.h"
+#include "google/cloud/mocks/mock_stream_range.h"
+#include "google/cloud/internal/backoff_policy.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace v2 = ::google::bigtable::v2;
+using ::google::cloud::bigtable_mocks::MockDataConnection;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::Return;
+using ::testing::UnorderedElementsAre;
+using ms = std::chrono::milliseconds;
+
+auto const* const kTableName =
+    "projects/test-project/instances/test-instance/tables/test-table";
+
+v2::StreamPartition MakePartition(std::string start, std::string end) {
+  v2::StreamPartition p;
+  p.mutable_row_range()->set_start_key_closed(std::move(start));
+  p.mutable_row_range()->set_end_key_open(std::move(end));
+  return p;
+}
+
+v2::ReadChangeStreamResponse MakeDataChange(std::string row_key,
+                                            std::string value,
+                                            std::string token) {
+  v2::ReadChangeStreamResponse r;
+  auto& dc = *r.mutable_data_change();
+  dc.set_type(v2::ReadChangeStreamResponse::DataChange::USER);
+  dc.set_row_key(std::move(row_key));
+  dc.set_source_cluster_id("test-cluster");
+  auto& cell = *dc.add_chunks()->mutable_mutation()->mutable_set_cell();
+  cell.set_family_name("fam");
+  cell.set_column_qualifier("col");
+  cell.set_value(std::move(value));
+  dc.set_done(true);
+  dc.set_token(std::move(token));
+  return r;
+}
+
+v2::ReadChangeStreamResponse MakeHeartbeat(v2::StreamPartition partition,
+                                           std::string token) {
+  v2::ReadChangeStreamResponse r;
+  auto& t = *r.mutable_heartbeat()->mutable_continuation_token();
+  *t.mutable_partition() = std::move(partition);
+  t.set_token(std::move(token));
+  return r;
+}
+
+std::shared_ptr<MockDataConnection> MakeMock() {
+  auto mock = std::make_shared<MockDataConnection>();
+  EXPECT_CALL(*mock, options).WillRepeatedly([] {
+    return Options{}
+        .set<DataRetryPolicyOption>(
+            DataLimitedErrorCountRetryPolicy(3).clone())
+        .set<DataBackoffPolicyOption>(
+            google::cloud::internal::ExponentialBackoffPolicy(ms(0), ms(0),
+                                                              2.0)
+                .clone());
+  });
+  return mock;
+}
+
+Table MakeTable(std::shared_ptr<DataConnection> conn) {
+  return Table(std::move(conn),
+               TableResource("test-project", "test-instance", "test-table"));
+}
+
+TEST(ChangeStreamReaderOptions, Defaults) {
+  ChangeStreamReader::Options options;
+  EXPECT_FALSE(options.start_time.has_value());
+  EXPECT_FALSE(options.end_time.has_value());
+  EXPECT_LT(ms(0), options.heartbeat_duration);
+  EXPECT_LT(0, options.max_batch_size);
+  EXPECT_LT(0, options.max_threads);
+
+  options.SetMaxBatchSize(0);
+  EXPECT_EQ(1, options.max_batch_size);
+  options.SetMaxThreads(0);
+  EXPECT_EQ(1, options.max_threads);
+}
+
+TEST(ChangeStreamReader, PartitionsError) {
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, GenerateInitialChangeStreamPartitions)
+      .WillOnce(Return(Status(StatusCode::kPermissionDenied, "fail")));
+  EXPECT_CALL(*mock, ReadChangeStream).Times(0);
+
+  ChangeStreamReader reader(MakeTable(mock));
+  auto status = reader.Read([](auto) { return true; });
+  EXPECT_THAT(status, StatusIs(StatusCode::kPermissionDenied));
+}
+
+TEST(ChangeStreamReader, DecodesChunkedValuesInBatches) {
+  auto const partition = MakePartition("", "");
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, GenerateInitialChangeStreamPartitions(kTableName))
+      .WillOnce(Return(std::vector<v2::StreamPartition>{partition}));
+  EXPECT_CALL(*mock, ReadChangeStream)
+      .WillOnce([&](v2::ReadChangeStreamRequest const& request) {
+        EXPECT_EQ(kTableName, request.table_name());
+        EXPECT_TRUE(request.has_start_time());
+        EXPECT_TRUE(request.has_heartbeat_duration());
+
+        // A single change split across two messages, with a chunked value.
+        v2::ReadChangeStreamResponse r1;
+        auto& dc1 = *r1.mutable_data_change();
+        dc1.set_row_key("r1");
+        auto& c1 = *dc1.add_chunks();
+        c1.mutable_chunk_info()->set_chunked_value_size(6);
+        c1.mutable_mutation()->mutable_set_cell()->set_value("abc");
+        v2::ReadChangeStreamResponse r2;
+        auto& dc2 = *r2.mutable_data_change();
+        auto& c2 = *dc2.add_chunks();
+        c2.mutable_chunk_info()->set_chunked_value_size(6);
+        c2.mutable_chunk_info()->set_chunked_value_offset(3);
+        c2.mutable_chunk_info()->set_last_chunk(true);
+        c2.mutable_mutation()->mutable_set_cell()->set_value("def");
+        dc2.set_done(true);
+        dc2.set_token("t1");
+
+        return mocks::MakeStreamRange<v2::ReadChangeStreamResponse>(
+            {r1, r2, MakeDataChange("r2", "v2", "t2"),
+             MakeDataChange("r3", "v3", "t3"), MakeHeartbeat(partition, "t4")});
+      });
+
+  std::vector<std::vector<std::string>> batches;
+  ChangeStreamReader reader(
+      MakeTable(mock), ChangeStreamReader::Options()
+                           .SetStartTime(std::chrono::system_clock::now())
+                           .SetMaxBatchSize(2));
+  auto status = reader.Read([&](std::vector<ChangeStreamMutation> batch) {
+    std::vector<std::string> values;
+    for (auto const& m : batch) {
+      EXPECT_EQ(1, m.mutations.size());
+      values.push_back(m.row_key + "=" + m.mutations[0].set_cell().value());
+    }
+    batches.push_back(std::move(values));
+    return true;
+  });
+  ASSERT_STATUS_OK(status);
+  EXPECT_THAT(batches, ElementsAre(ElementsAre("r1=abcdef", "r2=v2"),
+                                   ElementsAre("r3=v3")));
+}
+
+TEST(ChangeStreamReader, ResumesFromLastToken) {
+  auto const partition = MakePartition("", "");
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, GenerateInitialChangeStreamPartitions)
+      .WillOnce(Return(std::vector<v2::StreamPartition>{partition}));
+  EXPECT_CALL(*mock, ReadChangeStream)
+      .WillOnce([&](v2::ReadChangeStreamRequest const& request) {
+        EXPECT_FALSE(request.has_continuation_tokens());
+        return mocks::MakeStreamRange<v2::ReadChangeStreamResponse>(
+            {MakeDataChange("r1", "v1", "t1")},
+            Status(StatusCode::kUnavailable, "try again"));
+      })
+      .WillOnce([&](v2::ReadChangeStreamRequest const& request) {
+        EXPECT_FALSE(request.has_start_time());
+        EXPECT_EQ(1, request.continuation_tokens().tokens_size());
+        EXPECT_EQ("t1", request.continuation_tokens().tokens(0).token());
+        return mocks::MakeStreamRange<v2::ReadChangeStreamResponse>(
+            {MakeDataChange("r2", "v2", "t2")});
+      });
+
+  std::vector<std::string> rows;
+  ChangeStreamReader reader(MakeTable(mock));
+  auto status = reader.Read([&](std::vector<ChangeStreamMutation> batch) {
+    for (auto const& m : batch) rows.push_back(m.row_key);
+    return true;
+  });
+  ASSERT_STATUS_OK(status);
+  EXPECT_THAT(rows, ElementsAre("r1", "r2"));
+}
+
+TEST(ChangeStreamReader, PermanentErrorStopsReader) {
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, GenerateInitialChangeStreamPartitions)
+      .WillOnce(Return(
+          std::vector<v2::StreamPartition>{MakePartition("", "")}));
+  EXPECT_CALL(*mock, ReadChangeStream).WillOnce([](auto) {
+    return mocks::MakeStreamRange<v2::ReadChangeStreamResponse>(
+        {}, Status(StatusCode::kPermissionDenied, "fail"));
+  });
+
+  ChangeStreamReader reader(MakeTable(mock));
+  auto status = reader.Read([](auto) { return true; });
+  EXPECT_THAT(status, StatusIs(StatusCode::kPermissionDenied));
+}
+
+TEST(ChangeStreamReader, CallbackStopsReader) {
+  auto const partition = MakePartition("", "");
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, GenerateInitialChangeStreamPartitions)
+      .WillOnce(Return(std::vector<v2::StreamPartition>{partition}));
+  EXPECT_CALL(*mock, ReadChangeStream).WillOnce([&](auto) {
+    return mocks::MakeStreamRange<v2::ReadChangeStreamResponse>(
+        {MakeHeartbeat(partition, "t0"), MakeDataChange("r1", "v1", "t1"),
+         MakeHeartbeat(partition, "t2"), MakeDataChange("r2", "v2", "t3"),
+         MakeHeartbeat(partition, "t4")});
+  });
+
+  int calls = 0;
+  ChangeStreamReader reader(MakeTable(mock));
+  auto status = reader.Read([&](auto) {
+    ++calls;
+    return false;
+  });
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(1, calls);
+}
+
+TEST(ChangeStreamReader, MergeWaitsForAllParents) {
+  auto const left = MakePartition("a", "m");
+  auto const right = MakePartition("m", "z");
+  auto const merged = MakePartition("a", "z");
+  auto close = [&merged](v2::StreamPartition const& parent, std::string token) {
+    v2::ReadChangeStreamResponse r;
+    auto& cs = *r.mutable_close_stream();
+    cs.mutable_status()->set_code(
+        static_cast<std::int32_t>(StatusCode::kOutOfRange));
+    auto& t = *cs.add_continuation_tokens();
+    *t.mutable_partition() = parent;
+    t.set_token(std::move(token));
+    *cs.add_new_partitions() = merged;
+    return r;
+  };
+
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, GenerateInitialChangeStreamPartitions)
+      .WillOnce(Return(std::vector<v2::StreamPartition>{left, right}));
+  std::mutex mu;
+  std::vector<std::string> merged_tokens;
+  EXPECT_CALL(*mock, ReadChangeStream)
+      .Times(3)
+      .WillRepeatedly([&](v2::ReadChangeStreamRequest const& request) {
+        auto const& key = request.partition().row_range().start_key_closed();
+        auto const& end = request.partition().row_range().end_key_open();
+        if (key == "a" && end == "m") {
+          return mocks::MakeStreamRange<v2::ReadChangeStreamResponse>(
+              {MakeDataChange("b", "v", "tl"), close(left, "left-end")});
+        }
+        if (key == "m") {
+          return mocks::MakeStreamRange<v2::ReadChangeStreamResponse>(
+              {close(right, "right-end")});
+        }
+        std::lock_guard<std::mutex> lk(mu);
+        for (auto const& t : request.continuation_tokens().tokens()) {
+          merged_tokens.push_back(t.token());
+        }
+        return mocks::MakeStreamRange<v2::ReadChangeStreamResponse>(
+            {MakeDataChange("n", "v", "tm")});
+      });
+
+  std::vector<std::string> rows;
+  ChangeStreamReader reader(MakeTable(mock));
+  auto status = reader.Read([&](std::vector<ChangeStreamMutation> batch) {
+    std::lock_guard<std::mutex> lk(mu);
+    for (auto const& m : batch) rows.push_back(m.row_key);
+    return true;
+  });
+  ASSERT_STATUS_OK(status);
+  EXPECT_THAT(merged_tokens, UnorderedElementsAre("left-end", "right-end"));
+  EXPECT_THAT(rows, UnorderedElementsAre("b", "n"));
+}
+
+TEST(ChangeStreamReader, MorePartitionsThanThreads) {
+  auto const left = MakePartition("a", "m");
+  auto const right = MakePartition("m", "z");
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, GenerateInitialChangeStreamPartitions)
+      .WillOnce(Return(std::vector<v2::StreamPartition>{left, right}));
+  // With a single thread, each partition gives up the thread at its first
+  // heartbeat, and resumes from that heartbeat's token.
+  std::vector<std::string> calls;
+  EXPECT_CALL(*mock, ReadChangeStream)
+      .Times(4)
+      .WillRepeatedly([&](v2::ReadChangeStreamRequest const& request) {
+        auto const& key = request.partition().row_range().start_key_closed();
+        auto const& tokens = request.continuation_tokens().tokens();
+        calls.push_back(key + ":" +
+                        (tokens.empty() ? "start" : tokens[0].token()));
+        if (!tokens.empty()) {
+          return mocks::MakeStreamRange<v2::ReadChangeStreamResponse>(
+              {MakeDataChange(key + "2", "v", key + "-t2")});
+        }
+        return mocks::MakeStreamRange<v2::ReadChangeStreamResponse>(
+            {MakeDataChange(key + "1", "v", key + "-t1"),
+             MakeHeartbeat(request.partition(), key + "-hb"),
+             MakeDataChange(key + "-unread", "v", key + "-t3")});
+      });
+
+  std::vector<std::string> rows;
+  ChangeStreamReader reader(
+      MakeTable(mock), ChangeStreamReader::Options().SetMaxThreads(1));
+  auto status = reader.Read([&](std::vector<ChangeStreamMutation> batch) {
+    for (auto const& m : batch) rows.push_back(m.row_key);
+    return true;
+  });
+  ASSERT_STATUS_OK(status);
+  EXPECT_THAT(calls, ElementsAre("a:start", "m:start", "a:a-hb", "m:m-hb"));
+  EXPECT_THAT(rows, ElementsAre("a1", "m1", "a2", "m2"));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
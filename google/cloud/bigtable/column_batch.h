@@ -0,0 +1,141 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COLUMN_BATCH_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COLUMN_BATCH_H
+
+#include "google/cloud/bigtable/value.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/bigtable/v2/data.pb.h"
+#include "google/bigtable/v2/types.pb.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+class ColumnBatchBuilder;
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+
+namespace bigtable {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * The values of a single result column, stored in typed contiguous buffers.
+ *
+ * Scalar columns are decoded directly from the wire format, without creating
+ * a `Value` per cell:
+ *
+ * - `INT64` columns are stored in `int64_values()`.
+ * - `FLOAT32` and `FLOAT64` columns are stored in `float64_values()`.
+ * - `BOOL` columns are stored in `bool_values()`, one byte per row.
+ * - `STRING` and `BYTES` columns are stored in `data()`. The value of row `i`
+ *   is `data()[offsets()[i], offsets()[i + 1])`.
+ *
+ * Columns of any other type (e.g. `TIMESTAMP`, `DATE`, `ARRAY`, `MAP`, or
+ * `STRUCT`) are stored as `Value` objects in `values()`.
+ *
+ * Null values have their bit set in `null_bitmap()`, and hold a zero (or
+ * empty) placeholder in the typed buffer, so row `i` is always at index `i`.
+ */
+class ColumnBuffer {
+ public:
+  /// The buffer used to store the column values.
+  enum class Kind { kInt64, kFloat64, kBool, kString, kBytes, kValue };
+
+  ColumnBuffer() = default;
+
+  std::string const& name() const { return name_; }
+  google::bigtable::v2::Type const& type() const { return type_; }
+  Kind kind() const { return kind_; }
+
+  /// The number of rows in the column.
+  std::size_t size() const { return size_; }
+
+  /// Returns true if the value in row @p row is null.
+  bool IsNull(std::size_t row) const {
+    return (null_bitmap_[row / 8] >> (row % 8)) & 1;
+  }
+
+  /// Bit `i % 8` of byte `i / 8` is set if the value in row `i` is null.
+  std::vector<std::uint8_t> const& null_bitmap() const { return null_bitmap_; }
+
+  std::vector<std::int64_t> const& int64_values() const {
+    return int64_values_;
+  }
+  std::vector<double> const& float64_values() const { return float64_values_; }
+  std::vector<std::uint8_t> const& bool_values() const { return bool_values_; }
+
+  /// Offsets into `data()`, with `size() + 1` elements.
+  std::vector<std::size_t> const& offsets() const { return offsets_; }
+  std::string const& data() const { return data_; }
+
+  /// Returns the value of row @p row in a `STRING` or `BYTES` column.
+  std::string_view string_value(std::size_t row) const {
+    return std::string_view(data_).substr(offsets_[row],
+                                          offsets_[row + 1] - offsets_[row]);
+  }
+
+  std::vector<Value> const& values() const { return values_; }
+
+ private:
+  friend class bigtable_internal::ColumnBatchBuilder;
+
+  std::string name_;
+  google::bigtable::v2::Type type_;
+  Kind kind_ = Kind::kValue;
+  std::size_t size_ = 0;
+  std::vector<std::uint8_t> null_bitmap_;
+  std::vector<std::int64_t> int64_values_;
+  std::vector<double> float64_values_;
+  std::vector<std::uint8_t> bool_values_;
+  std::vector<std::size_t> offsets_;
+  std::string data_;
+  std::vector<Value> values_;
+};
+
+/**
+ * A batch of rows returned by `RowStream::NextBatch()`, stored by column.
+ *
+ * The batch has one `ColumnBuffer` per column in the result set metadata, in
+ * the same order. All the columns have `num_rows()` rows.
+ */
+class ColumnBatch {
+ public:
+  ColumnBatch() = default;
+
+  std::size_t num_rows() const { return num_rows_; }
+  std::vector<ColumnBuffer> const& columns() const { return columns_; }
+  ColumnBuffer const& column(std::size_t index) const {
+    return columns_[index];
+  }
+
+ private:
+  friend class bigtable_internal::ColumnBatchBuilder;
+
+  std::size_t num_rows_ = 0;
+  std::vector<ColumnBuffer> columns_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COLUMN_BATCH_H
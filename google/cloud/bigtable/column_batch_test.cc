@@ -0,0 +1,93 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/column_batch.h"
+#include "google/cloud/bigtable/mocks/mock_query_row.h"
+#include "google/cloud/bigtable/result_source_interface.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <google/protobuf/text_format.h>
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::google::protobuf::TextFormat;
+using ::testing::ElementsAre;
+using ::testing::Return;
+
+google::bigtable::v2::ResultSetMetadata MakeMetadata() {
+  auto constexpr kResultMetadataText = R"pb(
+    proto_schema {
+      columns {
+        name: "flag"
+        type { bool_type {} }
+      }
+      columns {
+        name: "blob"
+        type { bytes_type {} }
+      }
+      columns {
+        name: "list"
+        type { array_type { element_type { int64_type {} } } }
+      }
+    }
+  )pb";
+  google::bigtable::v2::ResultSetMetadata metadata;
+  EXPECT_TRUE(TextFormat::ParseFromString(kResultMetadataText, &metadata));
+  return metadata;
+}
+
+class FakeResultSource : public ResultSourceInterface {
+ public:
+  MOCK_METHOD(StatusOr<QueryRow>, NextRow, (), (override));
+  MOCK_METHOD(std::optional<google::bigtable::v2::ResultSetMetadata>, Metadata,
+              (), (override));
+};
+
+TEST(ResultSourceInterfaceTest, DefaultNextBatch) {
+  FakeResultSource source;
+  EXPECT_CALL(source, Metadata).WillRepeatedly(Return(MakeMetadata()));
+  auto row = [](bool flag, std::string blob) {
+    return bigtable_mocks::MakeQueryRow(
+        {{"flag", Value(flag)},
+         {"blob", Value(Bytes(std::move(blob)))},
+         {"list", Value(std::vector<std::int64_t>{})}});
+  };
+  EXPECT_CALL(source, NextRow)
+      .WillOnce(Return(row(true, "a")))
+      .WillOnce(Return(row(false, "bc")))
+      .WillOnce(Return(QueryRow()))
+      .WillOnce(Return(Status(StatusCode::kUnavailable, "try-again")));
+
+  auto batch = source.NextBatch(4);
+  ASSERT_STATUS_OK(batch);
+  ASSERT_EQ(2, batch->num_rows());
+  EXPECT_THAT(batch->column(0).bool_values(), ElementsAre(1, 0));
+  EXPECT_EQ("abc", batch->column(1).data());
+
+  EXPECT_THAT(source.NextBatch(4), StatusIs(StatusCode::kUnavailable));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
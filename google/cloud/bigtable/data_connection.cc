@@ -181,6 +181,20 @@ bigtable::RowStream DataConnection::ExecuteQuery(bigtable::ExecuteQueryParams) {
           Status(StatusCode::kUnimplemented, "not implemented")));
 }
 
+StatusOr<std::vector<google::bigtable::v2::StreamPartition>>
+DataConnection::GenerateInitialChangeStreamPartitions(std::string const&) {
+  return Status(StatusCode::kUnimplemented, "not implemented");
+}
+
+StreamRange<google::bigtable::v2::ReadChangeStreamResponse>
+DataConnection::ReadChangeStream(
+    // NOLINTNEXTLINE(performance-unnecessary-value-param)
+    google::bigtable::v2::ReadChangeStreamRequest) {
+  return google::cloud::internal::MakeStreamRange<
+      google::bigtable::v2::ReadChangeStreamResponse>(
+      [] { return Status(StatusCode::kUnimplemented, "not implemented"); });
+}
+
 std::shared_ptr<DataConnection> MakeDataConnection(
     std::vector<InstanceResource> instances, Options options) {
   options.set<bigtable_internal::InstanceChannelAffinityOption>(
@@ -164,6 +164,25 @@ class DataConnection {
   virtual future<StatusOr<bigtable::PreparedQuery>> AsyncPrepareQuery(
       bigtable::PrepareQueryParams const& p);
   virtual bigtable::RowStream ExecuteQuery(bigtable::ExecuteQueryParams p);
+
+  /**
+   * Returns the partitions used to start reading a table's change stream.
+   *
+   * Transient failures are retried using the connection's retry and backoff
+   * policies.
+   */
+  virtual StatusOr<std::vector<google::bigtable::v2::StreamPartition>>
+  GenerateInitialChangeStreamPartitions(std::string const& table_name);
+
+  /**
+   * Reads the change stream for a single partition.
+   *
+   * This performs a single streaming RPC and does not retry. The caller is
+   * expected to resume from the last continuation token it received, see
+   * `ChangeStreamReader`.
+   */
+  virtual StreamRange<google::bigtable::v2::ReadChangeStreamResponse>
+  ReadChangeStream(google::bigtable::v2::ReadChangeStreamRequest request);
 };
 
 /**
@@ -49,9 +49,11 @@ google_cloud_cpp_bigtable_hdrs = [
     "bound_query.h",
     "bytes.h",
     "cell.h",
+    "change_stream_reader.h",
     "client.h",
     "cluster_config.h",
     "cluster_list_responses.h",
+    "column_batch.h",
     "column_family.h",
     "completion_queue.h",
     "data_connection.h",
@@ -83,6 +85,7 @@ google_cloud_cpp_bigtable_hdrs = [
     "internal/channel_usage.h",
     "internal/client_options_defaults.h",
     "internal/client_schema_metrics.h",
+    "internal/column_batch_builder.h",
     "internal/common_client.h",
     "internal/connection_refresh_state.h",
     "internal/const_buffer.h",
@@ -106,7 +109,9 @@ google_cloud_cpp_bigtable_hdrs = [
     "internal/partial_result_set_source.h",
     "internal/prefix_range_end.h",
     "internal/query_plan.h",
+    "internal/query_plan_cache.h",
     "internal/rate_limiter.h",
+    "internal/read_modify_write_coalescer.h",
     "internal/readrowsparser.h",
     "internal/retry_traits.h",
     "internal/row_reader_impl.h",
@@ -124,6 +129,7 @@ google_cloud_cpp_bigtable_hdrs = [
     "polling_policy.h",
     "prepared_query.h",
     "query_row.h",
+    "read_modify_write_batcher.h",
     "read_modify_write_rule.h",
     "resource_names.h",
     "result_source_interface.h",
@@ -176,6 +182,7 @@ google_cloud_cpp_bigtable_srcs = [
     "app_profile_config.cc",
     "bound_query.cc",
     "bytes.cc",
+    "change_stream_reader.cc",
     "client.cc",
     "cluster_config.cc",
     "data_connection.cc",
@@ -201,6 +208,7 @@ google_cloud_cpp_bigtable_srcs = [
     "internal/bigtable_tracing_stub.cc",
     "internal/bulk_mutator.cc",
     "internal/client_schema_metrics.cc",
+    "internal/column_batch_builder.cc",
     "internal/connection_refresh_state.cc",
     "internal/const_buffer.cc",
     "internal/convert_policies.cc",
@@ -220,7 +228,9 @@ google_cloud_cpp_bigtable_srcs = [
     "internal/partial_result_set_source.cc",
     "internal/prefix_range_end.cc",
     "internal/query_plan.cc",
+    "internal/query_plan_cache.cc",
     "internal/rate_limiter.cc",
+    "internal/read_modify_write_coalescer.cc",
     "internal/readrowsparser.cc",
     "internal/retry_traits.cc",
     "internal/stub_manager.cc",
@@ -232,7 +242,9 @@ google_cloud_cpp_bigtable_srcs = [
     "polling_policy.cc",
     "prepared_query.cc",
     "query_row.cc",
+    "read_modify_write_batcher.cc",
     "resource_names.cc",
+    "result_source_interface.cc",
     "row_range.cc",
     "row_reader.cc",
     "row_set.cc",
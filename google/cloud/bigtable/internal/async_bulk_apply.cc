@@ -31,7 +31,8 @@ future<std::vector<bigtable::FailedMutation>> AsyncBulkApplier::Create(
     bigtable::IdempotentMutationPolicy& idempotent_policy,
     std::string const& app_profile_id, std::string const& table_name,
     bigtable::BulkMutation mut,
-    std::shared_ptr<OperationContext> operation_context) {
+    std::shared_ptr<OperationContext> operation_context,
+    bool merge_row_mutations) {
   if (mut.empty()) {
     return make_ready_future(std::vector<bigtable::FailedMutation>{});
   }
@@ -40,7 +41,7 @@ future<std::vector<bigtable::FailedMutation>> AsyncBulkApplier::Create(
       std::move(cq), std::move(stub), std::move(limiter),
       std::move(retry_policy), std::move(backoff_policy), enable_server_retries,
       idempotent_policy, app_profile_id, table_name, std::move(mut),
-      std::move(operation_context)));
+      std::move(operation_context), merge_row_mutations));
   bulk_apply->StartIteration();
   return bulk_apply->promise_.get_future();
 }
@@ -53,14 +54,16 @@ AsyncBulkApplier::AsyncBulkApplier(
     bigtable::IdempotentMutationPolicy& idempotent_policy,
     std::string const& app_profile_id, std::string const& table_name,
     bigtable::BulkMutation mut,
-    std::shared_ptr<OperationContext> operation_context)
+    std::shared_ptr<OperationContext> operation_context,
+    bool merge_row_mutations)
     : cq_(std::move(cq)),
       stub_(std::move(stub)),
       limiter_(std::move(limiter)),
       retry_policy_(std::move(retry_policy)),
       backoff_policy_(std::move(backoff_policy)),
       enable_server_retries_(enable_server_retries),
-      state_(app_profile_id, table_name, idempotent_policy, std::move(mut)),
+      state_(app_profile_id, table_name, idempotent_policy, std::move(mut),
+             merge_row_mutations),
       promise_([this] { keep_reading_ = false; }),
       options_(internal::SaveCurrentOptions()),
       call_context_(options_),
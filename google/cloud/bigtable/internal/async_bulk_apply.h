@@ -49,7 +49,8 @@ class AsyncBulkApplier : public std::enable_shared_from_this<AsyncBulkApplier> {
       bigtable::IdempotentMutationPolicy& idempotent_policy,
       std::string const& app_profile_id, std::string const& table_name,
       bigtable::BulkMutation mut,
-      std::shared_ptr<OperationContext> operation_context);
+      std::shared_ptr<OperationContext> operation_context,
+      bool merge_row_mutations = false);
 
  private:
   AsyncBulkApplier(CompletionQueue cq, std::shared_ptr<BigtableStub> stub,
@@ -60,7 +61,8 @@ class AsyncBulkApplier : public std::enable_shared_from_this<AsyncBulkApplier> {
                    bigtable::IdempotentMutationPolicy& idempotent_policy,
                    std::string const& app_profile_id,
                    std::string const& table_name, bigtable::BulkMutation mut,
-                   std::shared_ptr<OperationContext> operation_context);
+                   std::shared_ptr<OperationContext> operation_context,
+                   bool merge_row_mutations);
 
   void StartIteration();
   void MakeRequest();
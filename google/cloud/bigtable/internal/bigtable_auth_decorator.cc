@@ -121,6 +121,37 @@ BigtableAuth::ReadModifyWriteRow(
                                     operation_context);
 }
 
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>
+BigtableAuth::GenerateInitialChangeStreamPartitions(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsRequest const&
+        request,
+    std::shared_ptr<google::cloud::bigtable_internal::OperationContext>
+        operation_context) {
+  using ErrorStream = ::google::cloud::internal::StreamingReadRpcError<
+      google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>;
+  auto status = auth_->ConfigureContext(*context);
+  if (!status.ok()) return std::make_unique<ErrorStream>(std::move(status));
+  return child_->GenerateInitialChangeStreamPartitions(
+      std::move(context), options, request, std::move(operation_context));
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::ReadChangeStreamResponse>>
+BigtableAuth::ReadChangeStream(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::bigtable::v2::ReadChangeStreamRequest const& request,
+    std::shared_ptr<google::cloud::bigtable_internal::OperationContext>
+        operation_context) {
+  using ErrorStream = ::google::cloud::internal::StreamingReadRpcError<
+      google::bigtable::v2::ReadChangeStreamResponse>;
+  auto status = auth_->ConfigureContext(*context);
+  if (!status.ok()) return std::make_unique<ErrorStream>(std::move(status));
+  return child_->ReadChangeStream(std::move(context), options, request,
+                                  std::move(operation_context));
+}
+
 StatusOr<google::bigtable::v2::PrepareQueryResponse> BigtableAuth::PrepareQuery(
     grpc::ClientContext& context, Options const& options,
     google::bigtable::v2::PrepareQueryRequest const& request,
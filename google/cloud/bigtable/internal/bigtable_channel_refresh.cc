@@ -84,6 +84,28 @@ BigtableChannelRefresh::ReadModifyWriteRow(
                                     operation_context);
 }
 
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>
+BigtableChannelRefresh::GenerateInitialChangeStreamPartitions(
+    std::shared_ptr<grpc::ClientContext> client_context, Options const& options,
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsRequest const&
+        request,
+    std::shared_ptr<OperationContext> operation_context) {
+  return child_->GenerateInitialChangeStreamPartitions(
+      std::move(client_context), options, request,
+      std::move(operation_context));
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::ReadChangeStreamResponse>>
+BigtableChannelRefresh::ReadChangeStream(
+    std::shared_ptr<grpc::ClientContext> client_context, Options const& options,
+    google::bigtable::v2::ReadChangeStreamRequest const& request,
+    std::shared_ptr<OperationContext> operation_context) {
+  return child_->ReadChangeStream(std::move(client_context), options, request,
+                                  std::move(operation_context));
+}
+
 StatusOr<google::bigtable::v2::PrepareQueryResponse>
 BigtableChannelRefresh::PrepareQuery(
     grpc::ClientContext& client_context, Options const& options,
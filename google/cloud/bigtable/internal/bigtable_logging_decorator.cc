@@ -182,6 +182,66 @@ BigtableLogging::ReadModifyWriteRow(
       context, options, request, __func__, tracing_options_);
 }
 
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>
+BigtableLogging::GenerateInitialChangeStreamPartitions(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsRequest const&
+        request,
+    std::shared_ptr<google::cloud::bigtable_internal::OperationContext>
+        operation_context) {
+  return google::cloud::internal::LogWrapper(
+      [this, operation_context = std::move(operation_context)](
+          std::shared_ptr<grpc::ClientContext> context, Options const& options,
+          google::bigtable::v2::
+              GenerateInitialChangeStreamPartitionsRequest const& request)
+          -> std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+              google::bigtable::v2::
+                  GenerateInitialChangeStreamPartitionsResponse>> {
+        auto stream = child_->GenerateInitialChangeStreamPartitions(
+            std::move(context), options, request,
+            std::move(operation_context));
+        if (stream_logging_) {
+          stream =
+              std::make_unique<google::cloud::internal::StreamingReadRpcLogging<
+                  google::bigtable::v2::
+                      GenerateInitialChangeStreamPartitionsResponse>>(
+                  std::move(stream), tracing_options_,
+                  google::cloud::internal::RequestIdForLogging());
+        }
+        return stream;
+      },
+      std::move(context), options, request, __func__, tracing_options_);
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::ReadChangeStreamResponse>>
+BigtableLogging::ReadChangeStream(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::bigtable::v2::ReadChangeStreamRequest const& request,
+    std::shared_ptr<google::cloud::bigtable_internal::OperationContext>
+        operation_context) {
+  return google::cloud::internal::LogWrapper(
+      [this, operation_context = std::move(operation_context)](
+          std::shared_ptr<grpc::ClientContext> context, Options const& options,
+          google::bigtable::v2::ReadChangeStreamRequest const& request)
+          -> std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+              google::bigtable::v2::ReadChangeStreamResponse>> {
+        auto stream =
+            child_->ReadChangeStream(std::move(context), options, request,
+                                     std::move(operation_context));
+        if (stream_logging_) {
+          stream =
+              std::make_unique<google::cloud::internal::StreamingReadRpcLogging<
+                  google::bigtable::v2::ReadChangeStreamResponse>>(
+                  std::move(stream), tracing_options_,
+                  google::cloud::internal::RequestIdForLogging());
+        }
+        return stream;
+      },
+      std::move(context), options, request, __func__, tracing_options_);
+}
+
 StatusOr<google::bigtable::v2::PrepareQueryResponse>
 BigtableLogging::PrepareQuery(
     grpc::ClientContext& context, Options const& options,
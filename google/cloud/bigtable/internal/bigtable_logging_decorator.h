@@ -88,6 +88,23 @@ class BigtableLogging : public BigtableStub {
       google::cloud::bigtable_internal::OperationContext& operation_context)
       override;
 
+  std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+      google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>
+  GenerateInitialChangeStreamPartitions(
+      std::shared_ptr<grpc::ClientContext> context, Options const& options,
+      google::bigtable::v2::GenerateInitialChangeStreamPartitionsRequest const&
+          request,
+      std::shared_ptr<google::cloud::bigtable_internal::OperationContext>
+          operation_context) override;
+
+  std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+      google::bigtable::v2::ReadChangeStreamResponse>>
+  ReadChangeStream(
+      std::shared_ptr<grpc::ClientContext> context, Options const& options,
+      google::bigtable::v2::ReadChangeStreamRequest const& request,
+      std::shared_ptr<google::cloud::bigtable_internal::OperationContext>
+          operation_context) override;
+
   StatusOr<google::bigtable::v2::PrepareQueryResponse> PrepareQuery(
       grpc::ClientContext& context, Options const& options,
       google::bigtable::v2::PrepareQueryRequest const& request,
@@ -363,6 +363,35 @@ BigtableMetadata::ReadModifyWriteRow(
                                     operation_context);
 }
 
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>
+BigtableMetadata::GenerateInitialChangeStreamPartitions(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsRequest const&
+        request,
+    std::shared_ptr<google::cloud::bigtable_internal::OperationContext>
+        operation_context) {
+  SetMetadata(*context, options,
+              absl::StrCat("table_name=",
+                           internal::UrlEncode(request.table_name())));
+  return child_->GenerateInitialChangeStreamPartitions(
+      std::move(context), options, request, std::move(operation_context));
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::ReadChangeStreamResponse>>
+BigtableMetadata::ReadChangeStream(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::bigtable::v2::ReadChangeStreamRequest const& request,
+    std::shared_ptr<google::cloud::bigtable_internal::OperationContext>
+        operation_context) {
+  SetMetadata(*context, options,
+              absl::StrCat("table_name=",
+                           internal::UrlEncode(request.table_name())));
+  return child_->ReadChangeStream(std::move(context), options, request,
+                                  std::move(operation_context));
+}
+
 StatusOr<google::bigtable::v2::PrepareQueryResponse>
 BigtableMetadata::PrepareQuery(
     grpc::ClientContext& context, Options const& options,
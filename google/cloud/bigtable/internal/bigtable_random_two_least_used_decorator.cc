@@ -16,6 +16,8 @@
 #include "google/cloud/async_streaming_read_write_rpc.h"
 #include "google/cloud/internal/async_streaming_read_rpc.h"
 #include "google/cloud/internal/streaming_read_rpc.h"
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -27,18 +29,51 @@ namespace bigtable_internal {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
 
+std::chrono::microseconds ElapsedSince(
+    std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+
+// Reports the latency of a streaming RPC to its channel. The latency is
+// measured until the first response, or until the stream ends if there are no
+// responses. Only the first call to `Record()` has an effect.
+class LatencyRecorder {
+ public:
+  explicit LatencyRecorder(std::weak_ptr<ChannelUsage<BigtableStub>> channel)
+      : channel_(std::move(channel)),
+        start_(std::chrono::steady_clock::now()) {}
+
+  void Record(bool success) {
+    if (recorded_.exchange(true)) return;
+    if (auto channel = channel_.lock()) {
+      channel->RecordRpcResult(ElapsedSince(start_), success);
+    }
+  }
+
+ private:
+  std::weak_ptr<ChannelUsage<BigtableStub>> channel_;
+  std::chrono::steady_clock::time_point start_;
+  std::atomic<bool> recorded_{false};
+};
+
 template <typename T>
 class StreamingReadRpcTracking : public internal::StreamingReadRpc<T> {
  public:
   StreamingReadRpcTracking(std::unique_ptr<internal::StreamingReadRpc<T>> child,
-                           std::function<void()> on_destruction)
-      : child_(std::move(child)), on_destruction_(std::move(on_destruction)) {}
+                           std::function<void()> on_destruction,
+                           std::shared_ptr<LatencyRecorder> recorder)
+      : child_(std::move(child)),
+        on_destruction_(std::move(on_destruction)),
+        recorder_(std::move(recorder)) {}
 
   ~StreamingReadRpcTracking() override { on_destruction_(); }
 
   void Cancel() override { child_->Cancel(); }
   std::optional<Status> Read(T* response) override {
-    return child_->Read(response);
+    auto status = child_->Read(response);
+    recorder_->Record(!status.has_value() || status->ok());
+    return status;
   }
   RpcMetadata GetRequestMetadata() const override {
     return child_->GetRequestMetadata();
@@ -47,6 +82,7 @@ class StreamingReadRpcTracking : public internal::StreamingReadRpc<T> {
  private:
   std::unique_ptr<internal::StreamingReadRpc<T>> child_;
   std::function<void()> on_destruction_;
+  std::shared_ptr<LatencyRecorder> recorder_;
 };
 
 template <typename T>
@@ -55,15 +91,31 @@ class AsyncStreamingReadRpcTracking
  public:
   AsyncStreamingReadRpcTracking(
       std::unique_ptr<internal::AsyncStreamingReadRpc<T>> child,
-      std::function<void()> on_destruction)
-      : child_(std::move(child)), on_destruction_(std::move(on_destruction)) {}
+      std::function<void()> on_destruction,
+      std::shared_ptr<LatencyRecorder> recorder)
+      : child_(std::move(child)),
+        on_destruction_(std::move(on_destruction)),
+        recorder_(std::move(recorder)) {}
 
   ~AsyncStreamingReadRpcTracking() override { on_destruction_(); }
 
   void Cancel() override { child_->Cancel(); }
   future<bool> Start() override { return child_->Start(); }
-  future<std::optional<T>> Read() override { return child_->Read(); }
-  future<Status> Finish() override { return child_->Finish(); }
+  future<std::optional<T>> Read() override {
+    return child_->Read().then([recorder = recorder_](auto f) {
+      auto response = f.get();
+      // A stream without responses is recorded when it finishes.
+      if (response.has_value()) recorder->Record(true);
+      return response;
+    });
+  }
+  future<Status> Finish() override {
+    return child_->Finish().then([recorder = recorder_](auto f) {
+      auto status = f.get();
+      recorder->Record(status.ok());
+      return status;
+    });
+  }
   RpcMetadata GetRequestMetadata() const override {
     return child_->GetRequestMetadata();
   }
@@ -71,6 +123,7 @@ class AsyncStreamingReadRpcTracking
  private:
   std::unique_ptr<internal::AsyncStreamingReadRpc<T>> child_;
   std::function<void()> on_destruction_;
+  std::shared_ptr<LatencyRecorder> recorder_;
 };
 
 template <typename Request, typename Response>
@@ -111,7 +164,9 @@ Response UnaryHelper(std::shared_ptr<DynamicChannelPool<BigtableStub>>& pool,
       selection.outstanding_rpcs, ChannelPoolLbPolicy::kRandomTwoLeastUsed,
       pool->transport_type(), RpcType::kUnary});
   std::shared_ptr<BigtableStub> stub = selection.channel->AcquireStub();
+  auto const start = std::chrono::steady_clock::now();
   Response result = fn(*stub);
+  selection.channel->RecordRpcResult(ElapsedSince(start), result.ok());
   selection.channel->ReleaseStub();
   return result;
 }
@@ -128,9 +183,16 @@ Response AsyncHelper(std::shared_ptr<DynamicChannelPool<BigtableStub>>& pool,
         pool->transport_type(), RpcType::kUnary});
   }
   std::shared_ptr<BigtableStub> stub = selection.channel->AcquireStub();
+  auto const start = std::chrono::steady_clock::now();
   Response result = fn(*stub);
   selection.channel->ReleaseStub();
-  return result;
+  return result.then([weak = selection.channel->MakeWeak(), start](auto f) {
+    auto r = f.get();
+    if (auto channel = weak.lock()) {
+      channel->RecordRpcResult(ElapsedSince(start), r.ok());
+    }
+    return r;
+  });
 }
 
 template <typename Response>
@@ -147,13 +209,15 @@ std::unique_ptr<internal::StreamingReadRpc<Response>> StreamingHelper(
         pool->transport_type(), RpcType::kStreaming});
   }
   std::shared_ptr<BigtableStub> stub = selection.channel->AcquireStub();
+  auto recorder =
+      std::make_shared<LatencyRecorder>(selection.channel->MakeWeak());
   std::unique_ptr<internal::StreamingReadRpc<Response>> result = fn(*stub);
   auto release_fn = [weak = selection.channel->MakeWeak()] {
     std::shared_ptr<ChannelUsage<BigtableStub>> child = weak.lock();
     if (child) child->ReleaseStub();
   };
   return std::make_unique<StreamingReadRpcTracking<Response>>(
-      std::move(result), std::move(release_fn));
+      std::move(result), std::move(release_fn), std::move(recorder));
 }
 
 template <typename Response>
@@ -170,13 +234,15 @@ std::unique_ptr<internal::AsyncStreamingReadRpc<Response>> AsyncStreamingHelper(
         pool->transport_type(), RpcType::kStreaming});
   }
   std::shared_ptr<BigtableStub> stub = selection.channel->AcquireStub();
+  auto recorder =
+      std::make_shared<LatencyRecorder>(selection.channel->MakeWeak());
   std::unique_ptr<internal::AsyncStreamingReadRpc<Response>> result = fn(*stub);
   auto release_fn = [weak = selection.channel->MakeWeak()] {
     std::shared_ptr<ChannelUsage<BigtableStub>> child = weak.lock();
     if (child) child->ReleaseStub();
   };
   return std::make_unique<AsyncStreamingReadRpcTracking<Response>>(
-      std::move(result), std::move(release_fn));
+      std::move(result), std::move(release_fn), std::move(recorder));
 }
 
 template <typename Request, typename Response>
@@ -298,6 +364,39 @@ BigtableRandomTwoLeastUsed::ReadModifyWriteRow(
       });
 }
 
+std::unique_ptr<internal::StreamingReadRpc<
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>
+BigtableRandomTwoLeastUsed::GenerateInitialChangeStreamPartitions(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsRequest const&
+        request,
+    std::shared_ptr<OperationContext> operation_context) {
+  return StreamingHelper<
+      google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>(
+      pool_, operation_context,
+      [&, context = std::move(context),
+       operation_context](BigtableStub& stub) mutable {
+        return stub.GenerateInitialChangeStreamPartitions(
+            std::move(context), options, request,
+            std::move(operation_context));
+      });
+}
+
+std::unique_ptr<
+    internal::StreamingReadRpc<google::bigtable::v2::ReadChangeStreamResponse>>
+BigtableRandomTwoLeastUsed::ReadChangeStream(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::bigtable::v2::ReadChangeStreamRequest const& request,
+    std::shared_ptr<OperationContext> operation_context) {
+  return StreamingHelper<google::bigtable::v2::ReadChangeStreamResponse>(
+      pool_, operation_context,
+      [&, context = std::move(context),
+       operation_context](BigtableStub& stub) mutable {
+        return stub.ReadChangeStream(std::move(context), options, request,
+                                     std::move(operation_context));
+      });
+}
+
 StatusOr<google::bigtable::v2::PrepareQueryResponse>
 BigtableRandomTwoLeastUsed::PrepareQuery(
     grpc::ClientContext& context, Options const& options,
@@ -79,6 +79,21 @@ class BigtableRandomTwoLeastUsed : public BigtableStub {
       google::bigtable::v2::ReadModifyWriteRowRequest const& request,
       OperationContext& operation_context) override;
 
+  std::unique_ptr<internal::StreamingReadRpc<
+      google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>
+  GenerateInitialChangeStreamPartitions(
+      std::shared_ptr<grpc::ClientContext> context, Options const& options,
+      google::bigtable::v2::GenerateInitialChangeStreamPartitionsRequest const&
+          request,
+      std::shared_ptr<OperationContext> operation_context) override;
+
+  std::unique_ptr<internal::StreamingReadRpc<
+      google::bigtable::v2::ReadChangeStreamResponse>>
+  ReadChangeStream(
+      std::shared_ptr<grpc::ClientContext> context, Options const& options,
+      google::bigtable::v2::ReadChangeStreamRequest const& request,
+      std::shared_ptr<OperationContext> operation_context) override;
+
   StatusOr<google::bigtable::v2::PrepareQueryResponse> PrepareQuery(
       grpc::ClientContext& context, Options const& options,
       google::bigtable::v2::PrepareQueryRequest const& request,
@@ -99,6 +99,29 @@ BigtableRoundRobin::ReadModifyWriteRow(
                                      operation_context);
 }
 
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>
+BigtableRoundRobin::GenerateInitialChangeStreamPartitions(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsRequest const&
+        request,
+    std::shared_ptr<google::cloud::bigtable_internal::OperationContext>
+        operation_context) {
+  return Child()->GenerateInitialChangeStreamPartitions(
+      std::move(context), options, request, std::move(operation_context));
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::ReadChangeStreamResponse>>
+BigtableRoundRobin::ReadChangeStream(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::bigtable::v2::ReadChangeStreamRequest const& request,
+    std::shared_ptr<google::cloud::bigtable_internal::OperationContext>
+        operation_context) {
+  return Child()->ReadChangeStream(std::move(context), options, request,
+                                   std::move(operation_context));
+}
+
 StatusOr<google::bigtable::v2::PrepareQueryResponse>
 BigtableRoundRobin::PrepareQuery(
     grpc::ClientContext& context, Options const& options,
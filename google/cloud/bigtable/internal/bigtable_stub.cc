@@ -123,6 +123,32 @@ DefaultBigtableStub::ReadModifyWriteRow(
   return response;
 }
 
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>
+DefaultBigtableStub::GenerateInitialChangeStreamPartitions(
+    std::shared_ptr<grpc::ClientContext> context, Options const&,
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsRequest const&
+        request,
+    std::shared_ptr<google::cloud::bigtable_internal::OperationContext>) {
+  auto stream =
+      grpc_stub_->GenerateInitialChangeStreamPartitions(context.get(), request);
+  return std::make_unique<google::cloud::internal::StreamingReadRpcImpl<
+      google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>(
+      std::move(context), std::move(stream));
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::ReadChangeStreamResponse>>
+DefaultBigtableStub::ReadChangeStream(
+    std::shared_ptr<grpc::ClientContext> context, Options const&,
+    google::bigtable::v2::ReadChangeStreamRequest const& request,
+    std::shared_ptr<google::cloud::bigtable_internal::OperationContext>) {
+  auto stream = grpc_stub_->ReadChangeStream(context.get(), request);
+  return std::make_unique<google::cloud::internal::StreamingReadRpcImpl<
+      google::bigtable::v2::ReadChangeStreamResponse>>(std::move(context),
+                                                       std::move(stream));
+}
+
 StatusOr<google::bigtable::v2::PrepareQueryResponse>
 DefaultBigtableStub::PrepareQuery(
     grpc::ClientContext& context, Options const&,
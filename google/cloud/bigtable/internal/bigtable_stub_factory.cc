@@ -34,6 +34,7 @@
 #include "google/cloud/log.h"
 #include "google/bigtable/v2/feature_flags.pb.h"
 #include <grpcpp/grpcpp.h>
+#include <optional>
 
 namespace google {
 namespace cloud {
@@ -172,6 +173,13 @@ std::shared_ptr<BigtableStub> CreateBigtableStubRandomTwoLeastUsed(
     }
   }
 
+  std::optional<bigtable::experimental::LatencyAwareChannelSelectionPolicy>
+      selection_policy;
+  if (options.has<
+          bigtable::experimental::LatencyAwareChannelSelectionOption>()) {
+    selection_policy = options.get<
+        bigtable::experimental::LatencyAwareChannelSelectionOption>();
+  }
   return std::make_shared<BigtableRandomTwoLeastUsed>(
       DynamicChannelPool<BigtableStub>::Create(
           std::string{instance_name}, CompletionQueue(std::move(cq_impl)),
@@ -181,7 +189,8 @@ std::shared_ptr<BigtableStub> CreateBigtableStubRandomTwoLeastUsed(
               bigtable::experimental::DynamicChannelPoolSizingPolicyOption>(),
           bigtable::internal::IsDirectPath(options)
               ? TransportType::kDirectPath
-              : TransportType::kCloudPath));
+              : TransportType::kCloudPath,
+          std::move(selection_policy)));
 }
 
 std::shared_ptr<BigtableStub> CreateDecoratedStubs(
@@ -144,6 +144,43 @@ BigtableTracingStub::ReadModifyWriteRow(
       child_->ReadModifyWriteRow(context, options, request, operation_context));
 }
 
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>
+BigtableTracingStub::GenerateInitialChangeStreamPartitions(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::bigtable::v2::GenerateInitialChangeStreamPartitionsRequest const&
+        request,
+    std::shared_ptr<google::cloud::bigtable_internal::OperationContext>
+        operation_context) {
+  auto span = internal::MakeSpanGrpc("google.bigtable.v2.Bigtable",
+                                     "GenerateInitialChangeStreamPartitions");
+  auto scope = opentelemetry::trace::Scope(span);
+  internal::InjectTraceContext(*context, *propagator_);
+  auto stream = child_->GenerateInitialChangeStreamPartitions(
+      context, options, request, std::move(operation_context));
+  return std::make_unique<internal::StreamingReadRpcTracing<
+      google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>(
+      std::move(context), std::move(stream), std::move(span));
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::ReadChangeStreamResponse>>
+BigtableTracingStub::ReadChangeStream(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::bigtable::v2::ReadChangeStreamRequest const& request,
+    std::shared_ptr<google::cloud::bigtable_internal::OperationContext>
+        operation_context) {
+  auto span = internal::MakeSpanGrpc("google.bigtable.v2.Bigtable",
+                                     "ReadChangeStream");
+  auto scope = opentelemetry::trace::Scope(span);
+  internal::InjectTraceContext(*context, *propagator_);
+  auto stream = child_->ReadChangeStream(context, options, request,
+                                         std::move(operation_context));
+  return std::make_unique<internal::StreamingReadRpcTracing<
+      google::bigtable::v2::ReadChangeStreamResponse>>(
+      std::move(context), std::move(stream), std::move(span));
+}
+
 StatusOr<google::bigtable::v2::PrepareQueryResponse>
 BigtableTracingStub::PrepareQuery(
     grpc::ClientContext& context, Options const& options,
@@ -18,7 +18,14 @@
 #include "google/cloud/grpc_options.h"
 #include "google/cloud/internal/make_status.h"
 #include "google/cloud/log.h"
+#include <algorithm>
+#include <cstdint>
 #include <numeric>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -27,10 +34,110 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 
 namespace btproto = ::google::bigtable::v2;
 
+namespace {
+
+// The service rejects entries with more mutations than this.
+auto constexpr kMaxMutationsPerEntry = 100000;
+
+bool Covers(btproto::TimestampRange const& range, std::int64_t timestamp) {
+  auto const start = range.start_timestamp_micros();
+  auto const end = range.end_timestamp_micros();
+  // A timestamp of -1 is replaced by the server time, only an unbounded range
+  // is known to include it.
+  if (timestamp < 0) return start == 0 && end == 0;
+  return timestamp >= start && (end == 0 || timestamp < end);
+}
+
+bool Supersedes(btproto::Mutation::DeleteFromColumn const& d,
+                btproto::Mutation::SetCell const& c) {
+  return d.family_name() == c.family_name() &&
+         d.column_qualifier() == c.column_qualifier() &&
+         (!d.has_time_range() || Covers(d.time_range(), c.timestamp_micros()));
+}
+
+void DropSupersededMutations(btproto::MutateRowsRequest::Entry& entry) {
+  auto& mutations = *entry.mutable_mutations();
+  // Walk the mutations backwards, recording the deletes applied after each
+  // mutation.
+  bool row_deleted = false;
+  std::unordered_set<std::string> deleted_families;
+  std::vector<btproto::Mutation::DeleteFromColumn const*> deleted_columns;
+  std::vector<bool> keep(mutations.size(), true);
+  for (int i = mutations.size() - 1; i >= 0; --i) {
+    auto const& m = mutations[i];
+    if (row_deleted) {
+      keep[i] = false;
+      continue;
+    }
+    switch (m.mutation_case()) {
+      case btproto::Mutation::kDeleteFromRow:
+        row_deleted = true;
+        break;
+      case btproto::Mutation::kDeleteFromFamily:
+        deleted_families.insert(m.delete_from_family().family_name());
+        break;
+      case btproto::Mutation::kDeleteFromColumn:
+        deleted_columns.push_back(&m.delete_from_column());
+        break;
+      case btproto::Mutation::kSetCell:
+        keep[i] =
+            deleted_families.count(m.set_cell().family_name()) == 0 &&
+            std::none_of(deleted_columns.begin(), deleted_columns.end(),
+                         [&m](auto const* d) {
+                           return Supersedes(*d, m.set_cell());
+                         });
+        break;
+      default:
+        break;
+    }
+  }
+  if (std::all_of(keep.begin(), keep.end(), [](bool k) { return k; })) return;
+
+  google::protobuf::RepeatedPtrField<btproto::Mutation> kept;
+  for (int i = 0; i != mutations.size(); ++i) {
+    if (keep[i]) kept.Add()->Swap(&mutations[i]);
+  }
+  mutations.Swap(&kept);
+}
+
+}  // namespace
+
+std::vector<std::vector<int>> MergeRowMutations(
+    btproto::MutateRowsRequest& request) {
+  auto& entries = *request.mutable_entries();
+  std::vector<std::vector<int>> indices;
+  indices.reserve(entries.size());
+  google::protobuf::RepeatedPtrField<btproto::MutateRowsRequest::Entry> merged;
+  // Maps each row key to its entry in `merged`.
+  std::unordered_map<std::string, int> rows;
+  for (int i = 0; i != entries.size(); ++i) {
+    auto& e = entries[i];
+    auto key = std::string(e.row_key());
+    auto r = rows.find(key);
+    if (r != rows.end()) {
+      auto& target = merged[r->second];
+      if (target.mutations_size() + e.mutations_size() <=
+          kMaxMutationsPerEntry) {
+        for (auto& m : *e.mutable_mutations()) {
+          target.add_mutations()->Swap(&m);
+        }
+        indices[r->second].push_back(i);
+        continue;
+      }
+    }
+    rows[std::move(key)] = merged.size();
+    merged.Add()->Swap(&e);
+    indices.push_back({i});
+  }
+  entries.Swap(&merged);
+  for (auto& e : entries) DropSupersededMutations(e);
+  return indices;
+}
+
 BulkMutatorState::BulkMutatorState(
     std::string const& app_profile_id, std::string const& table_name,
     bigtable::IdempotentMutationPolicy& idempotent_policy,
-    bigtable::BulkMutation mut) {
+    bigtable::BulkMutation mut, bool merge_row_mutations) {
   // Every time the client library calls MakeOneRequest(), the data in the
   // "pending_*" variables initializes the next request.  So in the constructor
   // we start by putting the data on the "pending_*" variables.
@@ -40,6 +147,11 @@ BulkMutatorState::BulkMutatorState(
   pending_mutations_.set_app_profile_id(app_profile_id);
   pending_mutations_.set_table_name(table_name);
 
+  // Merging happens before computing the idempotency, dropping a superseded
+  // `SetCell` with a server-assigned timestamp may make the row idempotent.
+  std::vector<std::vector<int>> merged;
+  if (merge_row_mutations) merged = MergeRowMutations(pending_mutations_);
+
   // As we receive successful responses, we shrink the size of the request (only
   // those pending are present).  But if any fails we want to report their index
   // in the original sequence provided by the user. This vector maps from the
@@ -59,9 +171,27 @@ BulkMutatorState::BulkMutatorState(
                     });
     auto idempotency =
         is_idempotent ? Idempotency::kIdempotent : Idempotency::kNonIdempotent;
+    if (merged.empty()) {
+      // NOLINTNEXTLINE(modernize-use-emplace) - brace initializer
+      pending_annotations_.push_back(
+          Annotations{index++, {}, idempotency, false, Status()});
+      continue;
+    }
+    auto& m = merged[index++];
+    auto const original_index = m.front();
+    m.erase(m.begin());
     // NOLINTNEXTLINE(modernize-use-emplace) - brace initializer
-    pending_annotations_.push_back(
-        Annotations{index++, idempotency, false, Status()});
+    pending_annotations_.push_back(Annotations{original_index, std::move(m),
+                                               idempotency, false, Status()});
+  }
+}
+
+void BulkMutatorState::AddFailures(
+    std::vector<bigtable::FailedMutation>& failures, Status const& status,
+    Annotations const& annotation) {
+  failures.emplace_back(status, annotation.original_index);
+  for (auto index : annotation.merged_indices) {
+    failures.emplace_back(status, index);
   }
 }
 
@@ -115,13 +245,15 @@ void BulkMutatorState::OnRead(
       // vector and other miscellanea.
       pending_mutations_.add_entries()->Swap(&original);
       pending_annotations_.push_back(
-          Annotations{annotation.original_index, annotation.idempotency,
-                      annotation.has_mutation_result, std::move(status)});
+          Annotations{annotation.original_index,
+                      std::move(annotation.merged_indices),
+                      annotation.idempotency, annotation.has_mutation_result,
+                      std::move(status)});
     } else {
       // Failures are saved for reporting, notice that we avoid copying, and
       // we use the original index in the first request, not the one where it
       // failed.
-      failures_.emplace_back(std::move(status), annotation.original_index);
+      AddFailures(failures_, status, annotation);
     }
   }
 }
@@ -154,9 +286,9 @@ void BulkMutatorState::OnFinish(Status finish_status,
             "report it at "
             "https://github.com/googleapis/google-cloud-cpp/issues/new",
             GCP_ERROR_INFO());
-        failures_.emplace_back(std::move(status), annotation.original_index);
+        AddFailures(failures_, status, annotation);
       } else {
-        failures_.emplace_back(last_status_, annotation.original_index);
+        AddFailures(failures_, last_status_, annotation);
       }
     }
     ++index;
@@ -170,10 +302,9 @@ std::vector<bigtable::FailedMutation> BulkMutatorState::OnRetryDone() && {
   for (int idx = 0; idx != size; idx++) {
     auto& annotation = pending_annotations_[idx];
     if (annotation.has_mutation_result) {
-      result.emplace_back(std::move(annotation.status),
-                          annotation.original_index);
+      AddFailures(result, annotation.status, annotation);
     } else if (!last_status_.ok()) {
-      result.emplace_back(last_status_, annotation.original_index);
+      AddFailures(result, last_status_, annotation);
     } else {
       auto status = internal::InternalError(
           "The server never sent a confirmation for this mutation but the "
@@ -181,7 +312,7 @@ std::vector<bigtable::FailedMutation> BulkMutatorState::OnRetryDone() && {
           "report it at "
           "https://github.com/googleapis/google-cloud-cpp/issues/new",
           GCP_ERROR_INFO());
-      result.emplace_back(std::move(status), annotation.original_index);
+      AddFailures(result, status, annotation);
     }
   }
 
@@ -192,8 +323,10 @@ BulkMutator::BulkMutator(std::string const& app_profile_id,
                          std::string const& table_name,
                          bigtable::IdempotentMutationPolicy& idempotent_policy,
                          bigtable::BulkMutation mut,
-                         std::shared_ptr<OperationContext> operation_context)
-    : state_(app_profile_id, table_name, idempotent_policy, std::move(mut)),
+                         std::shared_ptr<OperationContext> operation_context,
+                         bool merge_row_mutations)
+    : state_(app_profile_id, table_name, idempotent_policy, std::move(mut),
+             merge_row_mutations),
       operation_context_(std::move(operation_context)) {}
 
 Status BulkMutator::MakeOneRequest(BigtableStub& stub,
@@ -32,12 +32,28 @@ namespace cloud {
 namespace bigtable_internal {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 
+/**
+ * Merge the entries for the same row in @p request.
+ *
+ * The mutations for each row are concatenated, in their original order, into
+ * the first entry for that row. The server may apply the entries of a
+ * `MutateRows()` request in any order, even for the same row, so this preserves
+ * the semantics of the request. `SetCell` mutations superseded by a later
+ * `DeleteFromColumn`, `DeleteFromFamily`, or `DeleteFromRow` mutation in the
+ * same entry are dropped, as are all the mutations before a `DeleteFromRow`.
+ *
+ * @return the indices of the original entries merged into each entry.
+ */
+std::vector<std::vector<int>> MergeRowMutations(
+    google::bigtable::v2::MutateRowsRequest& request);
+
 class BulkMutatorState {
  public:
   BulkMutatorState(std::string const& app_profile_id,
                    std::string const& table_name,
                    bigtable::IdempotentMutationPolicy& idempotent_policy,
-                   bigtable::BulkMutation mut);
+                   bigtable::BulkMutation mut,
+                   bool merge_row_mutations = false);
 
   bool HasPendingMutations() const {
     return pending_mutations_.entries_size() != 0;
@@ -89,6 +105,8 @@ class BulkMutatorState {
      * request provided by the application.
      */
     int original_index;
+    /// The indices of any other original mutations merged into this one.
+    std::vector<int> merged_indices;
     google::cloud::Idempotency idempotency;
     /// Set to `false` if the result is unknown.
     bool has_mutation_result;
@@ -102,6 +120,11 @@ class BulkMutatorState {
     Status status;
   };
 
+  /// Add a failure for each of the original mutations in @p annotation.
+  static void AddFailures(std::vector<bigtable::FailedMutation>& failures,
+                          Status const& status,
+                          Annotations const& annotation);
+
   /// The annotations about the current bulk request.
   std::vector<Annotations> annotations_;
 
@@ -118,7 +141,8 @@ class BulkMutator {
   BulkMutator(std::string const& app_profile_id, std::string const& table_name,
               bigtable::IdempotentMutationPolicy& idempotent_policy,
               bigtable::BulkMutation mut,
-              std::shared_ptr<OperationContext> operation_context);
+              std::shared_ptr<OperationContext> operation_context,
+              bool merge_row_mutations = false);
 
   /// Return true if there are pending mutations in the mutator
   bool HasPendingMutations() const { return state_.HasPendingMutations(); }
@@ -850,6 +850,109 @@ TEST_F(BulkMutatorTest, BigtableCookies) {
   status = mutator.MakeOneRequest(*mock, limiter, Options{});
   EXPECT_THAT(status, StatusIs(StatusCode::kPermissionDenied));
 }
+
+TEST(MergeRowMutationsTest, MergesRows) {
+  BulkMutation mut(
+      SingleRowMutation("r0", {SetCell("fam", "c0", 0_ms, "v0")}),
+      SingleRowMutation("r1", {SetCell("fam", "c0", 0_ms, "v1")}),
+      SingleRowMutation("r0", {SetCell("fam", "c1", 0_ms, "v2")}),
+      SingleRowMutation("r0", {SetCell("fam", "c2", 0_ms, "v3")}));
+  v2::MutateRowsRequest request;
+  mut.MoveTo(&request);
+
+  auto indices = bigtable_internal::MergeRowMutations(request);
+  EXPECT_THAT(indices, ElementsAre(ElementsAre(0, 2, 3), ElementsAre(1)));
+  ASSERT_EQ(2, request.entries_size());
+  EXPECT_EQ("r0", request.entries(0).row_key());
+  std::vector<std::string> values;
+  for (auto const& m : request.entries(0).mutations()) {
+    values.emplace_back(m.set_cell().value());
+  }
+  EXPECT_THAT(values, ElementsAre("v0", "v2", "v3"));
+  EXPECT_EQ("r1", request.entries(1).row_key());
+  EXPECT_EQ(1, request.entries(1).mutations_size());
+}
+
+TEST(MergeRowMutationsTest, DropsSupersededCells) {
+  BulkMutation mut(
+      SingleRowMutation("r0", {SetCell("fam", "c0", 0_ms, "deleted"),
+                               SetCell("fam", "c1", 0_ms, "kept"),
+                               SetCell("fam", "c2", 20_ms, "deleted"),
+                               SetCell("fam", "c2", 5_ms, "kept"),
+                               SetCell("fam", "c3", "kept")}),
+      SingleRowMutation(
+          "r0", {DeleteFromColumn("fam", "c0"),
+                 DeleteFromColumnStartingFrom("fam", "c2", 10_ms),
+                 DeleteFromColumnStartingFrom("fam", "c3", 10_ms)}),
+      SingleRowMutation("r1", {SetCell("fam", "c0", 0_ms, "deleted"),
+                               SetCell("other", "c0", 0_ms, "kept"),
+                               DeleteFromFamily("fam")}),
+      SingleRowMutation("r2", {SetCell("fam", "c0", 0_ms, "deleted"),
+                               DeleteFromFamily("other")}),
+      SingleRowMutation("r2",
+                        {DeleteFromRow(), SetCell("fam", "c0", 0_ms, "kept")}));
+  v2::MutateRowsRequest request;
+  mut.MoveTo(&request);
+
+  auto indices = bigtable_internal::MergeRowMutations(request);
+  EXPECT_THAT(indices, ElementsAre(ElementsAre(0, 1), ElementsAre(2),
+                                   ElementsAre(3, 4)));
+  auto summary = [](v2::MutateRowsRequest::Entry const& e) {
+    std::vector<std::string> result;
+    for (auto const& m : e.mutations()) {
+      result.push_back(m.has_set_cell() ? std::string(m.set_cell().value())
+                                        : "delete");
+    }
+    return result;
+  };
+  ASSERT_EQ(3, request.entries_size());
+  EXPECT_THAT(summary(request.entries(0)),
+              ElementsAre("kept", "kept", "kept", "delete", "delete",
+                          "delete"));
+  EXPECT_THAT(summary(request.entries(1)), ElementsAre("kept", "delete"));
+  EXPECT_THAT(summary(request.entries(2)), ElementsAre("delete", "kept"));
+}
+
+TEST_F(BulkMutatorTest, MergedRowFailureReportsAllIndices) {
+  BulkMutation mut(IdempotentMutation("r0"), NonIdempotentMutation("r1"),
+                   IdempotentMutation("r0"));
+
+  auto mock = std::make_shared<MockBigtableStub>();
+  EXPECT_CALL(*mock, MutateRows)
+      .WillOnce([](auto, auto const&,
+                   google::bigtable::v2::MutateRowsRequest const& request,
+                   auto const&) {
+        EXPECT_EQ(2, request.entries_size());
+        auto stream = std::make_unique<MockMutateRowsStream>();
+        EXPECT_CALL(*stream, Read)
+            .WillOnce([](google::bigtable::v2::MutateRowsResponse* r) {
+              *r = MakeResponse({{0, grpc::StatusCode::PERMISSION_DENIED},
+                                 {1, grpc::StatusCode::OK}});
+              return std::nullopt;
+            })
+            .WillOnce(Return(Status()));
+        return stream;
+      });
+
+  auto policy = DefaultIdempotentMutationPolicy();
+  bigtable_internal::BulkMutator mutator(
+      kAppProfile, kTableName, *policy, std::move(mut),
+      std::make_shared<bigtable_internal::OperationContext>(),
+      /*merge_row_mutations=*/true);
+
+  bigtable_internal::NoopMutateRowsLimiter limiter;
+  auto status = mutator.MakeOneRequest(*mock, limiter, Options{});
+  EXPECT_STATUS_OK(status);
+  EXPECT_FALSE(mutator.HasPendingMutations());
+  auto failures = std::move(mutator).OnRetryDone();
+  std::vector<int> indices;
+  for (auto const& f : failures) {
+    EXPECT_THAT(f.status(), StatusIs(StatusCode::kPermissionDenied));
+    indices.push_back(f.original_index());
+  }
+  EXPECT_THAT(indices, ElementsAre(0, 2));
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace bigtable
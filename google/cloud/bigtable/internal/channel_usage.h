@@ -18,6 +18,8 @@
 #include "google/cloud/internal/clock.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -27,9 +29,20 @@ namespace cloud {
 namespace bigtable_internal {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 
+// A snapshot of the load and latency statistics of a channel.
+struct ChannelStats {
+  int outstanding_rpcs;
+  // Exponentially weighted moving averages of the RPC latency, in
+  // microseconds, and of the fraction of RPCs that failed.
+  double latency_us;
+  double error_rate;
+  std::int64_t samples;
+};
+
 // This class wraps a `T`, typically a BigtableStub, and tracks the number of
 // outstanding RPCs by taking measurements when the wrapped stub is acquired
-// and released.
+// and released. It also tracks the latency and error rate of the RPCs
+// reported via `RecordRpcResult()`.
 template <typename T>
 class ChannelUsage : public std::enable_shared_from_this<ChannelUsage<T>> {
  public:
@@ -84,6 +97,23 @@ class ChannelUsage : public std::enable_shared_from_this<ChannelUsage<T>> {
     --outstanding_rpcs_;
   }
 
+  StatusOr<ChannelStats> instant_stats() {
+    std::scoped_lock lk(mu_);
+    if (!IsRefreshSuccessful(lk)) return last_refresh_status_;
+    return ChannelStats{outstanding_rpcs_, latency_us_, error_rate_, samples_};
+  }
+
+  // Updates the moving averages with the result of an RPC. The first sample
+  // initializes the averages.
+  void RecordRpcResult(std::chrono::microseconds latency, bool success) {
+    auto constexpr kWeight = 0.2;
+    std::scoped_lock lk(mu_);
+    auto const w = samples_ == 0 ? 1.0 : kWeight;
+    latency_us_ += w * (static_cast<double>(latency.count()) - latency_us_);
+    error_rate_ += w * ((success ? 0.0 : 1.0) - error_rate_);
+    ++samples_;
+  }
+
  private:
   bool IsRefreshSuccessful(std::scoped_lock<std::mutex> const&) const {
     return IsSuccessfulRefreshStatus(last_refresh_status_);
@@ -93,6 +123,9 @@ class ChannelUsage : public std::enable_shared_from_this<ChannelUsage<T>> {
   std::shared_ptr<T> stub_;
   int outstanding_rpcs_ = 0;
   Status last_refresh_status_;
+  double latency_us_ = 0;
+  double error_rate_ = 0;
+  std::int64_t samples_ = 0;
 };
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
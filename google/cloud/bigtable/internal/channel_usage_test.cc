@@ -77,6 +77,35 @@ TEST(ChannelUsageTest, SetLastRefreshStatus) {
               StatusIs(error_status.code()));
 }
 
+TEST(ChannelUsageTest, RecordRpcResult) {
+  auto channel = std::make_shared<ChannelUsage<BigtableStub>>(
+      std::make_shared<MockBigtableStub>());
+  auto stats = channel->instant_stats();
+  ASSERT_STATUS_OK(stats);
+  EXPECT_EQ(0, stats->samples);
+
+  // The first sample initializes the averages.
+  channel->RecordRpcResult(std::chrono::microseconds(1000), true);
+  stats = channel->instant_stats();
+  ASSERT_STATUS_OK(stats);
+  EXPECT_EQ(1, stats->samples);
+  EXPECT_DOUBLE_EQ(stats->latency_us, 1000.0);
+  EXPECT_DOUBLE_EQ(stats->error_rate, 0.0);
+
+  // Later samples move the averages towards the new values.
+  channel->RecordRpcResult(std::chrono::microseconds(2000), false);
+  stats = channel->instant_stats();
+  ASSERT_STATUS_OK(stats);
+  EXPECT_EQ(2, stats->samples);
+  EXPECT_GT(stats->latency_us, 1000.0);
+  EXPECT_LT(stats->latency_us, 2000.0);
+  EXPECT_GT(stats->error_rate, 0.0);
+  EXPECT_LT(stats->error_rate, 1.0);
+
+  channel->set_last_refresh_status(internal::InternalError("uh oh"));
+  EXPECT_THAT(channel->instant_stats(), StatusIs(StatusCode::kInternal));
+}
+
 TEST(ChannelUsageTest, MakeWeak) {
   auto channel = std::make_shared<ChannelUsage<BigtableStub>>();
   auto weak = channel->MakeWeak();
@@ -0,0 +1,140 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/column_batch_builder.h"
+#include "absl/strings/cord.h"
+#include <type_traits>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using Kind = bigtable::ColumnBuffer::Kind;
+
+// Some Bigtable proto fields use Cord internally and string externally.
+template <typename T, typename std::enable_if<
+                          std::is_same<T, std::string>::value>::type* = nullptr>
+void AppendTo(std::string& dst, T const& s) {
+  dst.append(s);
+}
+
+template <typename T, typename std::enable_if<
+                          std::is_same<T, absl::Cord>::value>::type* = nullptr>
+void AppendTo(std::string& dst, T const& s) {
+  absl::AppendCordToString(s, &dst);
+}
+
+Kind KindOf(google::bigtable::v2::Type const& type) {
+  switch (type.kind_case()) {
+    case google::bigtable::v2::Type::kInt64Type:
+      return Kind::kInt64;
+    case google::bigtable::v2::Type::kFloat32Type:
+    case google::bigtable::v2::Type::kFloat64Type:
+      return Kind::kFloat64;
+    case google::bigtable::v2::Type::kBoolType:
+      return Kind::kBool;
+    case google::bigtable::v2::Type::kStringType:
+      return Kind::kString;
+    case google::bigtable::v2::Type::kBytesType:
+      return Kind::kBytes;
+    default:
+      return Kind::kValue;
+  }
+}
+
+}  // namespace
+
+ColumnBatchBuilder::ColumnBatchBuilder(
+    google::bigtable::v2::ResultSetMetadata const& metadata) {
+  auto const& columns = metadata.proto_schema().columns();
+  batch_.columns_.resize(columns.size());
+  for (int i = 0; i != columns.size(); ++i) {
+    auto& c = batch_.columns_[i];
+    c.name_ = columns[i].name();
+    c.type_ = columns[i].type();
+    c.kind_ = KindOf(c.type_);
+    if (c.kind_ == Kind::kString || c.kind_ == Kind::kBytes) {
+      c.offsets_.push_back(0);
+    }
+  }
+}
+
+void ColumnBatchBuilder::Reserve(std::size_t rows) {
+  for (auto& c : batch_.columns_) {
+    c.null_bitmap_.reserve((c.size_ + rows + 7) / 8);
+    switch (c.kind_) {
+      case Kind::kInt64:
+        c.int64_values_.reserve(c.size_ + rows);
+        break;
+      case Kind::kFloat64:
+        c.float64_values_.reserve(c.size_ + rows);
+        break;
+      case Kind::kBool:
+        c.bool_values_.reserve(c.size_ + rows);
+        break;
+      case Kind::kString:
+      case Kind::kBytes:
+        c.offsets_.reserve(c.size_ + rows + 1);
+        break;
+      case Kind::kValue:
+        c.values_.reserve(c.size_ + rows);
+        break;
+    }
+  }
+}
+
+void ColumnBatchBuilder::Append(std::size_t index,
+                                google::bigtable::v2::Value value) {
+  auto& c = batch_.columns_[index];
+  auto const row = c.size_++;
+  if (row % 8 == 0) c.null_bitmap_.push_back(0);
+  auto const is_null = bigtable::Value::IsNullValue(value);
+  if (is_null) {
+    c.null_bitmap_.back() |= static_cast<std::uint8_t>(1U << (row % 8));
+  }
+  switch (c.kind_) {
+    case Kind::kInt64:
+      c.int64_values_.push_back(is_null ? 0 : value.int_value());
+      break;
+    case Kind::kFloat64:
+      c.float64_values_.push_back(is_null ? 0 : value.float_value());
+      break;
+    case Kind::kBool:
+      c.bool_values_.push_back(!is_null && value.bool_value() ? 1 : 0);
+      break;
+    case Kind::kString:
+      if (!is_null) AppendTo(c.data_, value.string_value());
+      c.offsets_.push_back(c.data_.size());
+      break;
+    case Kind::kBytes:
+      if (!is_null) AppendTo(c.data_, value.bytes_value());
+      c.offsets_.push_back(c.data_.size());
+      break;
+    case Kind::kValue:
+      c.values_.push_back(FromProto(c.type_, std::move(value)));
+      break;
+  }
+}
+
+void ColumnBatchBuilder::Append(std::size_t index, bigtable::Value value) {
+  Append(index, ToProto(std::move(value)).second);
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+}  // namespace cloud
+}  // namespace google
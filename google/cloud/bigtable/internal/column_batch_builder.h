@@ -0,0 +1,62 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_COLUMN_BATCH_BUILDER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_COLUMN_BATCH_BUILDER_H
+
+#include "google/cloud/bigtable/column_batch.h"
+#include "google/cloud/bigtable/value.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/bigtable/v2/data.pb.h"
+#include <cstddef>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/// Decodes protobuf values, one row at a time, into a `ColumnBatch`.
+class ColumnBatchBuilder {
+ public:
+  explicit ColumnBatchBuilder(
+      google::bigtable::v2::ResultSetMetadata const& metadata);
+
+  /// Reserve space for @p rows rows in the fixed-width buffers.
+  void Reserve(std::size_t rows);
+
+  /// Append the value of column @p index for the row being built.
+  void Append(std::size_t index, google::bigtable::v2::Value value);
+
+  /// Append @p value, which must match the type of column @p index.
+  void Append(std::size_t index, bigtable::Value value);
+
+  /// Complete the current row. Every column must have a value for it.
+  void FinishRow() { ++batch_.num_rows_; }
+
+  std::size_t num_rows() const { return batch_.num_rows_; }
+  std::size_t num_columns() const { return batch_.columns_.size(); }
+
+  bigtable::ColumnBatch Build() && { return std::move(batch_); }
+
+ private:
+  bigtable::ColumnBatch batch_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_COLUMN_BATCH_BUILDER_H
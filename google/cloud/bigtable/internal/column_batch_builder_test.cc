@@ -0,0 +1,132 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/column_batch_builder.h"
+#include "google/cloud/bigtable/value.h"
+#include <google/protobuf/text_format.h>
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::bigtable::Bytes;
+using ::google::cloud::bigtable::ColumnBuffer;
+using ::google::cloud::bigtable::MakeNullValue;
+using ::google::cloud::bigtable::Value;
+using ::google::protobuf::TextFormat;
+using ::testing::ElementsAre;
+
+google::bigtable::v2::ResultSetMetadata MakeMetadata() {
+  auto constexpr kResultMetadataText = R"pb(
+    proto_schema {
+      columns {
+        name: "flag"
+        type { bool_type {} }
+      }
+      columns {
+        name: "blob"
+        type { bytes_type {} }
+      }
+      columns {
+        name: "list"
+        type { array_type { element_type { int64_type {} } } }
+      }
+    }
+  )pb";
+  google::bigtable::v2::ResultSetMetadata metadata;
+  EXPECT_TRUE(TextFormat::ParseFromString(kResultMetadataText, &metadata));
+  return metadata;
+}
+
+TEST(ColumnBatchBuilderTest, Empty) {
+  ColumnBatchBuilder builder(MakeMetadata());
+  auto batch = std::move(builder).Build();
+  EXPECT_EQ(0, batch.num_rows());
+  ASSERT_EQ(3, batch.columns().size());
+  EXPECT_EQ("flag", batch.column(0).name());
+  EXPECT_EQ(ColumnBuffer::Kind::kBool, batch.column(0).kind());
+  EXPECT_EQ("blob", batch.column(1).name());
+  EXPECT_EQ(ColumnBuffer::Kind::kBytes, batch.column(1).kind());
+  EXPECT_THAT(batch.column(1).offsets(), ElementsAre(0));
+  EXPECT_EQ("list", batch.column(2).name());
+  EXPECT_EQ(ColumnBuffer::Kind::kValue, batch.column(2).kind());
+}
+
+TEST(ColumnBatchBuilderTest, DecodesColumns) {
+  ColumnBatchBuilder builder(MakeMetadata());
+  builder.Reserve(2);
+  builder.Append(0, Value(true));
+  builder.Append(1, Value(Bytes("abc")));
+  builder.Append(2, Value(std::vector<std::int64_t>{1, 2}));
+  builder.FinishRow();
+  builder.Append(0, MakeNullValue<bool>());
+  builder.Append(1, MakeNullValue<Bytes>());
+  builder.Append(2, MakeNullValue<std::vector<std::int64_t>>());
+  builder.FinishRow();
+  auto batch = std::move(builder).Build();
+
+  ASSERT_EQ(2, batch.num_rows());
+  auto const& flag = batch.column(0);
+  EXPECT_EQ(2, flag.size());
+  EXPECT_THAT(flag.bool_values(), ElementsAre(1, 0));
+  EXPECT_FALSE(flag.IsNull(0));
+  EXPECT_TRUE(flag.IsNull(1));
+
+  auto const& blob = batch.column(1);
+  EXPECT_THAT(blob.offsets(), ElementsAre(0, 3, 3));
+  EXPECT_EQ("abc", blob.data());
+  EXPECT_EQ("abc", blob.string_value(0));
+  EXPECT_EQ("", blob.string_value(1));
+  EXPECT_TRUE(blob.IsNull(1));
+
+  auto const& list = batch.column(2);
+  ASSERT_EQ(2, list.values().size());
+  EXPECT_EQ(Value(std::vector<std::int64_t>{1, 2}), list.values()[0]);
+  EXPECT_TRUE(list.values()[1].is_null());
+}
+
+TEST(ColumnBatchBuilderTest, NullBitmap) {
+  auto constexpr kResultMetadataText = R"pb(
+    proto_schema {
+      columns {
+        name: "n"
+        type { int64_type {} }
+      }
+    }
+  )pb";
+  google::bigtable::v2::ResultSetMetadata metadata;
+  ASSERT_TRUE(TextFormat::ParseFromString(kResultMetadataText, &metadata));
+  ColumnBatchBuilder builder(metadata);
+  for (std::int64_t i = 0; i != 10; ++i) {
+    builder.Append(0, i % 3 == 0 ? MakeNullValue<std::int64_t>() : Value(i));
+    builder.FinishRow();
+  }
+  auto batch = std::move(builder).Build();
+  auto const& n = batch.column(0);
+  EXPECT_THAT(n.int64_values(), ElementsAre(0, 1, 2, 0, 4, 5, 0, 7, 8, 0));
+  // Rows 0, 3, 6 and 9 are null.
+  EXPECT_THAT(n.null_bitmap(), ElementsAre(0x49, 0x02));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+}  // namespace cloud
+}  // namespace google
@@ -25,6 +25,7 @@
 #include "google/cloud/bigtable/internal/partial_result_set_resume.h"
 #include "google/cloud/bigtable/internal/partial_result_set_source.h"
 #include "google/cloud/bigtable/internal/query_plan.h"
+#include "google/cloud/bigtable/internal/query_plan_cache.h"
 #include "google/cloud/bigtable/internal/retry_traits.h"
 #include "google/cloud/bigtable/internal/rpc_policy_parameters.h"
 #include "google/cloud/bigtable/options.h"
@@ -44,6 +45,7 @@
 #include "google/cloud/universe_domain_options.h"
 #include <memory>
 #include <string>
+#include <type_traits>
 
 namespace google {
 namespace cloud {
@@ -87,6 +89,10 @@ inline bool enable_server_retries(Options const& options) {
   return options.get<EnableServerRetriesOption>();
 }
 
+inline bool merge_row_mutations(Options const& options) {
+  return options.get<bigtable::experimental::MergeRowMutationsOption>();
+}
+
 inline bool RpcStreamTracingEnabled() {
   return internal::Contains(
       internal::CurrentOptions().get<LoggingComponentsOption>(), "rpc-streams");
@@ -197,6 +203,35 @@ std::string_view InstanceNameFromTableName(std::string_view table_name) {
   if (pos == std::string_view::npos) return {};
   return table_name.substr(0, pos);
 }
+
+google::bigtable::v2::PrepareQueryRequest MakePrepareQueryRequest(
+    bigtable::PrepareQueryParams const& params, Options const& options) {
+  google::bigtable::v2::PrepareQueryRequest request;
+  request.set_instance_name(params.instance.FullName());
+  request.set_app_profile_id(app_profile_id(options));
+  request.set_query(params.sql_statement.sql());
+  for (auto const& p : params.sql_statement.params()) {
+    (*request.mutable_param_types())[p.first] = p.second.type();
+  }
+  return request;
+}
+
+Status ValidatePrepareQueryResponse(
+    google::bigtable::v2::PrepareQueryResponse const& response) {
+  auto const& proto_schema = response.metadata().proto_schema();
+  if (proto_schema.columns_size() == 0) {
+    return internal::InternalError("ResultSetMetadata columns cannot be empty",
+                                   GCP_ERROR_INFO());
+  }
+  for (auto const& column : proto_schema.columns()) {
+    if (!column.has_type() ||
+        column.type().kind_case() == google::bigtable::v2::Type::KIND_NOT_SET) {
+      return internal::InternalError("Column type cannot be empty",
+                                     GCP_ERROR_INFO());
+    }
+  }
+  return {};
+}
 }  // namespace
 
 bigtable::Row TransformReadModifyWriteRowResponse(
@@ -337,7 +372,7 @@ std::vector<bigtable::FailedMutation> DataConnectionImpl::BulkApply(
       table_name, app_profile_id(*current));
   BulkMutator mutator(app_profile_id(*current), table_name,
                       *idempotency_policy(*current), std::move(mut),
-                      operation_context);
+                      operation_context, merge_row_mutations(*current));
   // We wait to allocate the policies until they are needed as a
   // micro-optimization.
   std::unique_ptr<bigtable::DataRetryPolicy> retry;
@@ -371,7 +406,7 @@ DataConnectionImpl::AsyncBulkApply(std::string const& table_name,
       retry_policy(*current), backoff_policy(*current),
       enable_server_retries(*current), *idempotency_policy(*current),
       app_profile_id(*current), table_name, std::move(mut),
-      std::move(operation_context));
+      std::move(operation_context), merge_row_mutations(*current));
 }
 
 bigtable::RowReader DataConnectionImpl::ReadRowsFull(
@@ -746,51 +781,63 @@ DataConnectionImpl::AsyncReadRow(std::string const& table_name,
 StatusOr<bigtable::PreparedQuery> DataConnectionImpl::PrepareQuery(
     bigtable::PrepareQueryParams const& params) {
   auto current = google::cloud::internal::SaveCurrentOptions();
-  google::bigtable::v2::PrepareQueryRequest request;
-  auto instance_full_name = params.instance.FullName();
-  request.set_instance_name(instance_full_name);
-  request.set_app_profile_id(app_profile_id(*current));
-  request.set_query(params.sql_statement.sql());
-  for (auto const& p : params.sql_statement.params()) {
-    (*request.mutable_param_types())[p.first] = p.second.type();
-  }
-  auto operation_context = operation_context_factory_->PrepareQuery(
-      instance_full_name, app_profile_id(*current));
-  auto stub = stub_manager_->GetStub(params.instance.FullName());
-  auto response = google::cloud::internal::RetryLoop(
-      retry_policy(*current), backoff_policy(*current),
-      Idempotency::kIdempotent,
-      [stub, operation_context](
-          grpc::ClientContext& context, Options const& options,
-          google::bigtable::v2::PrepareQueryRequest const& request) {
-        operation_context->PreCall(context);
-        auto const& result =
-            stub->PrepareQuery(context, options, request, *operation_context);
-        operation_context->PostCall(context, result.status());
-        return result;
-      },
-      *current, request, __func__);
-  operation_context->OnDone(response.status());
-  if (!response) {
-    return std::move(response).status();
-  }
-  auto const& proto_schema = response->metadata().proto_schema();
-  auto const columns_size = proto_schema.columns_size();
-  if (columns_size == 0) {
-    return internal::InternalError("ResultSetMetadata columns cannot be empty",
-                                   GCP_ERROR_INFO());
-  }
-  for (auto const& column : proto_schema.columns()) {
-    if (!column.has_type() ||
-        column.type().kind_case() == google::bigtable::v2::Type::KIND_NOT_SET) {
-      return internal::InternalError("Column type cannot be empty",
-                                     GCP_ERROR_INFO());
-    }
+  auto request = MakePrepareQueryRequest(params, *current);
+  auto const* func = __func__;
+  auto prepare = [&]() -> StatusOr<google::bigtable::v2::PrepareQueryResponse> {
+    auto operation_context = operation_context_factory_->PrepareQuery(
+        request.instance_name(), app_profile_id(*current));
+    auto stub = stub_manager_->GetStub(request.instance_name());
+    auto response = google::cloud::internal::RetryLoop(
+        retry_policy(*current), backoff_policy(*current),
+        Idempotency::kIdempotent,
+        [stub, operation_context](
+            grpc::ClientContext& context, Options const& options,
+            google::bigtable::v2::PrepareQueryRequest const& request) {
+          operation_context->PreCall(context);
+          auto const& result =
+              stub->PrepareQuery(context, options, request, *operation_context);
+          operation_context->PostCall(context, result.status());
+          return result;
+        },
+        *current, request, func);
+    operation_context->OnDone(response.status());
+    if (!response) return response;
+    auto status = ValidatePrepareQueryResponse(*response);
+    if (!status.ok()) return status;
+    return response;
+  };
+
+  auto const cache_size =
+      current->get<bigtable::experimental::QueryPlanCacheSizeOption>();
+  if (cache_size > 0) {
+    auto query_plan =
+        QueryPlanCache::Global()
+            .GetOrPrepare(QueryPlanCache::MakeKey(*current, request),
+                          cache_size,
+                          [&] { return make_ready_future(prepare()); },
+                          MakeCachedQueryPlanRefreshFn(request, func))
+            .get();
+    if (!query_plan) return std::move(query_plan).status();
+    return bigtable::PreparedQuery(params.instance, params.sql_statement,
+                                   *std::move(query_plan));
   }
+
+  auto response = prepare();
+  if (!response) return std::move(response).status();
+  auto query_plan =
+      QueryPlan::Create(background_->cq(), *std::move(response),
+                        MakeQueryPlanRefreshFn(std::move(request), func));
+  return bigtable::PreparedQuery(params.instance, params.sql_statement,
+                                 std::move(query_plan));
+}
+
+future<StatusOr<bigtable::PreparedQuery>> DataConnectionImpl::AsyncPrepareQuery(
+    bigtable::PrepareQueryParams const& params) {
+  auto current = google::cloud::internal::SaveCurrentOptions();
+  auto request = MakePrepareQueryRequest(params, *current);
   auto const* func = __func__;
-  auto refresh_fn = [this, request, func]() mutable {
-    auto current = google::cloud::internal::SaveCurrentOptions();
-    auto retry = query_plan_refresh_function_retry_policy(*current);
+  auto prepare = [this, current, request, func] {
+    auto retry = retry_policy(*current);
     auto backoff = backoff_policy(*current);
     auto operation_context = operation_context_factory_->PrepareQuery(
         request.instance_name(), app_profile_id(*current));
@@ -814,42 +861,59 @@ StatusOr<bigtable::PreparedQuery> DataConnectionImpl::PrepareQuery(
                        return s;
                      });
                },
-               std::move(current), request, func)
-        .then([operation_context](auto f) mutable {
-          StatusOr<google::bigtable::v2::PrepareQueryResponse> response =
-              f.get();
+               current, request, func)
+        .then([operation_context](auto f)
+                  -> StatusOr<google::bigtable::v2::PrepareQueryResponse> {
+          auto response = f.get();
           operation_context->OnDone(response.status());
+          if (!response) return response;
+          auto status = ValidatePrepareQueryResponse(*response);
+          if (!status.ok()) return status;
           return response;
         });
   };
-  auto query_plan = QueryPlan::Create(background_->cq(), *std::move(response),
-                                      std::move(refresh_fn));
-  return bigtable::PreparedQuery(
-      params.instance, std::move(params.sql_statement), std::move(query_plan));
+
+  auto const cache_size =
+      current->get<bigtable::experimental::QueryPlanCacheSizeOption>();
+  if (cache_size > 0) {
+    return QueryPlanCache::Global()
+        .GetOrPrepare(QueryPlanCache::MakeKey(*current, request), cache_size,
+                      prepare, MakeCachedQueryPlanRefreshFn(request, func))
+        .then([params](auto f) -> StatusOr<bigtable::PreparedQuery> {
+          auto query_plan = f.get();
+          if (!query_plan) return std::move(query_plan).status();
+          return bigtable::PreparedQuery(params.instance, params.sql_statement,
+                                         *std::move(query_plan));
+        });
+  }
+
+  return prepare().then(
+      [this, params, refresh_fn = MakeQueryPlanRefreshFn(request, func)](
+          auto f) -> StatusOr<bigtable::PreparedQuery> {
+        auto response = f.get();
+        if (!response) return std::move(response).status();
+        auto query_plan = QueryPlan::Create(background_->cq(),
+                                            *std::move(response), refresh_fn);
+        return bigtable::PreparedQuery(params.instance, params.sql_statement,
+                                       std::move(query_plan));
+      });
 }
 
-future<StatusOr<bigtable::PreparedQuery>> DataConnectionImpl::AsyncPrepareQuery(
-    bigtable::PrepareQueryParams const& params) {
+future<StatusOr<google::bigtable::v2::PrepareQueryResponse>>
+DataConnectionImpl::AsyncRefreshQueryPlan(
+    google::bigtable::v2::PrepareQueryRequest const& request,
+    char const* func) {
   auto current = google::cloud::internal::SaveCurrentOptions();
-  google::bigtable::v2::PrepareQueryRequest request;
-  auto instance_full_name = params.instance.FullName();
-  request.set_instance_name(instance_full_name);
-  request.set_app_profile_id(app_profile_id(*current));
-  request.set_query(params.sql_statement.sql());
-  for (auto const& p : params.sql_statement.params()) {
-    (*request.mutable_param_types())[p.first] = p.second.type();
-  }
-  auto retry = retry_policy(*current);
+  auto retry = query_plan_refresh_function_retry_policy(*current);
   auto backoff = backoff_policy(*current);
   auto operation_context = operation_context_factory_->PrepareQuery(
-      instance_full_name, app_profile_id(*current));
-  auto const* func = __func__;
-  auto instance_name = params.instance.FullName();
-  auto stub = stub_manager_->GetStub(instance_name);
+      request.instance_name(), app_profile_id(*current));
+  // Get a new stub here to take advantage of the pool.
+  auto stub = stub_manager_->GetStub(request.instance_name());
   return google::cloud::internal::AsyncRetryLoop(
              std::move(retry), std::move(backoff), Idempotency::kIdempotent,
              background_->cq(),
-             [stub, instance_name, operation_context](
+             [stub, operation_context](
                  CompletionQueue& cq,
                  std::shared_ptr<grpc::ClientContext> context,
                  google::cloud::internal::ImmutableOptions options,
@@ -864,74 +928,35 @@ future<StatusOr<bigtable::PreparedQuery>> DataConnectionImpl::AsyncPrepareQuery(
                      return s;
                    });
              },
-             current, request, func)
-      .then([this, instance_name, request, operation_context, current,
-             params = std::move(params),
-             func](future<StatusOr<google::bigtable::v2::PrepareQueryResponse>>
-                       future) -> StatusOr<bigtable::PreparedQuery> {
-        auto response = future.get();
+             std::move(current), request, func)
+      .then([operation_context](auto f) mutable {
+        StatusOr<google::bigtable::v2::PrepareQueryResponse> response = f.get();
         operation_context->OnDone(response.status());
-        if (!response) {
-          return std::move(response).status();
-        }
-        auto const& proto_schema = response->metadata().proto_schema();
-        auto const columns_size = proto_schema.columns_size();
-        if (columns_size == 0) {
-          return internal::InternalError(
-              "ResultSetMetadata columns cannot be empty", GCP_ERROR_INFO());
-        }
-        for (auto const& column : proto_schema.columns()) {
-          if (!column.has_type() ||
-              column.type().kind_case() ==
-                  google::bigtable::v2::Type::KIND_NOT_SET) {
-            return StatusOr<bigtable::PreparedQuery>(internal::InternalError(
-                "Column type cannot be empty", GCP_ERROR_INFO()));
-          }
-        }
-        auto refresh_fn = [this, instance_name, request, func]() mutable {
-          auto current = google::cloud::internal::SaveCurrentOptions();
-          auto retry = query_plan_refresh_function_retry_policy(*current);
-          auto backoff = backoff_policy(*current);
-          auto operation_context = operation_context_factory_->PrepareQuery(
-              request.instance_name(), app_profile_id(*current));
-          // Get a new stub here to take advantage of the pool.
-          auto stub = stub_manager_->GetStub(instance_name);
-          return google::cloud::internal::AsyncRetryLoop(
-                     std::move(retry), std::move(backoff),
-                     Idempotency::kIdempotent, background_->cq(),
-                     [stub, instance_name, operation_context](
-                         CompletionQueue& cq,
-                         std::shared_ptr<grpc::ClientContext> context,
-                         google::cloud::internal::ImmutableOptions options,
-                         google::bigtable::v2::PrepareQueryRequest const&
-                             request) {
-                       operation_context->PreCall(*context);
-                       auto f = stub->AsyncPrepareQuery(
-                           cq, context, std::move(options), request,
-                           operation_context);
-                       return f.then([operation_context,
-                                      context = std::move(context)](auto f) {
-                         auto s = f.get();
-                         operation_context->PostCall(*context, s.status());
-                         return s;
-                       });
-                     },
-                     std::move(current), request, func)
-              .then([operation_context](auto f) mutable {
-                StatusOr<google::bigtable::v2::PrepareQueryResponse> response =
-                    f.get();
-                operation_context->OnDone(response.status());
-                return response;
-              });
-        };
-
-        auto query_plan = QueryPlan::Create(background_->cq(),
-                                            *std::move(response), refresh_fn);
-        return bigtable::PreparedQuery(params.instance, params.sql_statement,
-                                       std::move(query_plan));
+        return response;
       });
 }
 
+QueryPlan::RefreshFn DataConnectionImpl::MakeQueryPlanRefreshFn(
+    google::bigtable::v2::PrepareQueryRequest request, char const* func) {
+  return [this, request = std::move(request), func] {
+    return AsyncRefreshQueryPlan(request, func);
+  };
+}
+
+QueryPlan::RefreshFn DataConnectionImpl::MakeCachedQueryPlanRefreshFn(
+    google::bigtable::v2::PrepareQueryRequest request, char const* func) {
+  // Cached plans may outlive this connection.
+  return [w = weak_from_this(), request = std::move(request), func]()
+             -> future<StatusOr<google::bigtable::v2::PrepareQueryResponse>> {
+    if (auto self = w.lock()) return self->AsyncRefreshQueryPlan(request, func);
+    return make_ready_future(
+        StatusOr<google::bigtable::v2::PrepareQueryResponse>(
+            internal::UnavailableError(
+                "the connection that prepared the query was deleted",
+                GCP_ERROR_INFO())));
+  };
+}
+
 class QueryPlanRefreshingPartialResultSource
     : public bigtable::ResultSourceInterface {
  public:
@@ -962,21 +987,15 @@ class QueryPlanRefreshingPartialResultSource
   ~QueryPlanRefreshingPartialResultSource() override = default;
 
   StatusOr<bigtable::QueryRow> NextRow() override {
-    StatusOr<bigtable::QueryRow> row;
-    do {
-      if (!query_plan_valid_) source_ = std::nullopt;
-      if (!source_.has_value() || !source_->ok()) {
-        UpdateSource();
-      }
-      row = (**source_)->NextRow();
-      if (ExecuteQueryPlanRefreshRetry::IsQueryPlanExpired(row.status())) {
-        query_plan_valid_ = false;
-        query_plan_->Invalidate(row.status(),
-                                query_plan_data_->prepared_query());
-      }
-    } while (!query_plan_refresh_retry_policy_->IsExhausted() &&
-             ExecuteQueryPlanRefreshRetry::IsQueryPlanExpired(row.status()));
-    return row;
+    return Next([](bigtable::ResultSourceInterface& source) {
+      return source.NextRow();
+    });
+  }
+
+  StatusOr<bigtable::ColumnBatch> NextBatch(std::size_t max_rows) override {
+    return Next([max_rows](bigtable::ResultSourceInterface& source) {
+      return source.NextBatch(max_rows);
+    });
   }
 
   std::optional<google::bigtable::v2::ResultSetMetadata> Metadata() override {
@@ -1005,6 +1024,27 @@ class QueryPlanRefreshingPartialResultSource
         query_plan_backoff_policy_(backoff_policy_->clone()),
         options_(std::move(options)) {}
 
+  // Fetches the next row or batch, refreshing the query plan if it expired.
+  template <typename Functor>
+  auto Next(Functor const& next) {
+    std::invoke_result_t<Functor const&, bigtable::ResultSourceInterface&>
+        result;
+    do {
+      if (!query_plan_valid_) source_ = std::nullopt;
+      if (!source_.has_value() || !source_->ok()) {
+        UpdateSource();
+      }
+      result = next(***source_);
+      if (ExecuteQueryPlanRefreshRetry::IsQueryPlanExpired(result.status())) {
+        query_plan_valid_ = false;
+        query_plan_->Invalidate(result.status(),
+                                query_plan_data_->prepared_query());
+      }
+    } while (!query_plan_refresh_retry_policy_->IsExhausted() &&
+             ExecuteQueryPlanRefreshRetry::IsQueryPlanExpired(result.status()));
+    return result;
+  }
+
   void UpdateSource() {
     internal::OptionsSpan options_span(options_);
     while (!query_plan_refresh_retry_policy_->IsExhausted()) {
@@ -1125,6 +1165,72 @@ bigtable::RowStream DataConnectionImpl::ExecuteQuery(
   return bigtable::RowStream(std::move(query_plan_refreshing_source));
 }
 
+StatusOr<std::vector<google::bigtable::v2::StreamPartition>>
+DataConnectionImpl::GenerateInitialChangeStreamPartitions(
+    std::string const& table_name) {
+  auto current = google::cloud::internal::SaveCurrentOptions();
+  google::bigtable::v2::GenerateInitialChangeStreamPartitionsRequest request;
+  request.set_app_profile_id(app_profile_id(*current));
+  request.set_table_name(table_name);
+
+  // Change streams are not instrumented by the client-side metrics.
+  auto operation_context = std::make_shared<OperationContext>();
+  auto stub = stub_manager_->GetStub(InstanceNameFromTableName(table_name));
+  std::vector<google::bigtable::v2::StreamPartition> partitions;
+  std::unique_ptr<bigtable::DataRetryPolicy> retry;
+  std::unique_ptr<BackoffPolicy> backoff;
+  while (true) {
+    auto context = std::make_shared<grpc::ClientContext>();
+    internal::ConfigureContext(*context, internal::CurrentOptions());
+    auto stream = stub->GenerateInitialChangeStreamPartitions(
+        context, Options{}, request, operation_context);
+
+    std::optional<Status> status;
+    while (true) {
+      google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse r;
+      status = stream->Read(&r);
+      if (status.has_value()) break;
+      partitions.push_back(std::move(*r.mutable_partition()));
+    }
+    if (status->ok()) break;
+    if (!retry) retry = retry_policy(*current);
+    if (!backoff) backoff = backoff_policy(*current);
+    auto delay = internal::Backoff(
+        *status, "GenerateInitialChangeStreamPartitions", *retry, *backoff,
+        Idempotency::kIdempotent, enable_server_retries(*current));
+    if (!delay) return std::move(delay).status();
+    // A new stream returns the complete set of partitions.
+    partitions.clear();
+    std::this_thread::sleep_for(*delay);
+  }
+  return partitions;
+}
+
+StreamRange<google::bigtable::v2::ReadChangeStreamResponse>
+DataConnectionImpl::ReadChangeStream(
+    google::bigtable::v2::ReadChangeStreamRequest request) {
+  auto current = google::cloud::internal::SaveCurrentOptions();
+  request.set_app_profile_id(app_profile_id(*current));
+  auto context = std::make_shared<grpc::ClientContext>();
+  internal::ConfigureContext(*context, *current);
+  auto stub =
+      stub_manager_->GetStub(InstanceNameFromTableName(request.table_name()));
+  std::shared_ptr<google::cloud::internal::StreamingReadRpc<
+      google::bigtable::v2::ReadChangeStreamResponse>>
+      stream = stub->ReadChangeStream(std::move(context), Options{}, request,
+                                      std::make_shared<OperationContext>());
+  return google::cloud::internal::MakeStreamRange<
+      google::bigtable::v2::ReadChangeStreamResponse>(
+      [stream = std::move(stream)]()
+          -> absl::variant<Status,
+                           google::bigtable::v2::ReadChangeStreamResponse> {
+        google::bigtable::v2::ReadChangeStreamResponse r;
+        auto status = stream->Read(&r);
+        if (status.has_value()) return *std::move(status);
+        return r;
+      });
+}
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace bigtable_internal
 }  // namespace cloud
@@ -21,6 +21,7 @@
 #include "google/cloud/bigtable/internal/mutate_rows_limiter.h"
 #include "google/cloud/bigtable/internal/operation_context_factory.h"
 #include "google/cloud/bigtable/internal/partial_result_set_reader.h"
+#include "google/cloud/bigtable/internal/query_plan.h"
 #include "google/cloud/bigtable/internal/stub_manager.h"
 #include "google/cloud/bigtable/prepared_query.h"
 #include "google/cloud/bigtable/result_source_interface.h"
@@ -50,7 +51,9 @@ struct InstanceChannelAffinityOption {
 bigtable::Row TransformReadModifyWriteRowResponse(
     google::bigtable::v2::ReadModifyWriteRowResponse response);
 
-class DataConnectionImpl : public bigtable::DataConnection {
+class DataConnectionImpl
+    : public bigtable::DataConnection,
+      public std::enable_shared_from_this<DataConnectionImpl> {
  public:
   ~DataConnectionImpl() override;
 
@@ -124,6 +127,12 @@ class DataConnectionImpl : public bigtable::DataConnection {
       bigtable::PrepareQueryParams const& p) override;
   bigtable::RowStream ExecuteQuery(bigtable::ExecuteQueryParams p) override;
 
+  StatusOr<std::vector<google::bigtable::v2::StreamPartition>>
+  GenerateInitialChangeStreamPartitions(std::string const& table_name) override;
+
+  StreamRange<google::bigtable::v2::ReadChangeStreamResponse> ReadChangeStream(
+      google::bigtable::v2::ReadChangeStreamRequest request) override;
+
  private:
   void AsyncReadRowsHelper(std::string const& table_name,
                            std::function<future<bool>(bigtable::Row)> on_row,
@@ -133,6 +142,19 @@ class DataConnectionImpl : public bigtable::DataConnection {
                            internal::ImmutableOptions const& current,
                            std::shared_ptr<OperationContext> operation_context);
 
+  future<StatusOr<google::bigtable::v2::PrepareQueryResponse>>
+  AsyncRefreshQueryPlan(
+      google::bigtable::v2::PrepareQueryRequest const& request,
+      char const* func);
+
+  QueryPlan::RefreshFn MakeQueryPlanRefreshFn(
+      google::bigtable::v2::PrepareQueryRequest request, char const* func);
+
+  // Cached plans may be refreshed after this connection is deleted, so the
+  // function does not capture `this`.
+  QueryPlan::RefreshFn MakeCachedQueryPlanRefreshFn(
+      google::bigtable::v2::PrepareQueryRequest request, char const* func);
+
   std::unique_ptr<BackgroundThreads> background_;
   std::unique_ptr<StubManager> stub_manager_;
   std::shared_ptr<::google::cloud::monitoring_v3::MetricServiceConnection>
@@ -66,9 +66,12 @@ using ::google::cloud::bigtable::ReverseScanOption;
 using ::google::cloud::bigtable::testing::MockAsyncReadRowsStream;
 using ::google::cloud::bigtable::testing::MockBigtableStub;
 using ::google::cloud::bigtable::testing::MockExecuteQueryStream;
+using ::google::cloud::bigtable::testing::
+    MockGenerateInitialChangeStreamPartitionsStream;
 using ::google::cloud::bigtable::testing::MockIdempotentMutationPolicy;
 using ::google::cloud::bigtable::testing::MockMutateRowsLimiter;
 using ::google::cloud::bigtable::testing::MockMutateRowsStream;
+using ::google::cloud::bigtable::testing::MockReadChangeStreamStream;
 using ::google::cloud::bigtable::testing::MockReadRowsStream;
 using ::google::cloud::bigtable::testing::MockSampleRowKeysStream;
 using ::google::cloud::testing_util::FakeCompletionQueueImpl;
@@ -2259,6 +2262,83 @@ TEST_F(DataConnectionTest, SampleRowsRetryResetsSamples) {
   EXPECT_THAT(actual.row_keys, ElementsAre("returned"));
 }
 
+TEST_F(DataConnectionTest, GenerateInitialChangeStreamPartitionsRetry) {
+  auto mock = std::make_shared<MockBigtableStub>();
+  EXPECT_CALL(*mock, GenerateInitialChangeStreamPartitions)
+      .WillOnce([](auto, auto const&,
+                   v2::GenerateInitialChangeStreamPartitionsRequest const&,
+                   auto const&) {
+        auto stream =
+            std::make_unique<MockGenerateInitialChangeStreamPartitionsStream>();
+        EXPECT_CALL(*stream, Read)
+            .WillOnce(
+                [](v2::GenerateInitialChangeStreamPartitionsResponse* r) {
+                  r->mutable_partition()->mutable_row_range()->set_end_key_open(
+                      "discarded");
+                  return std::nullopt;
+                })
+            .WillOnce(Return(TransientError()));
+        return stream;
+      })
+      .WillOnce([](auto, auto const&,
+                   v2::GenerateInitialChangeStreamPartitionsRequest const&
+                       request,
+                   auto const&) {
+        EXPECT_EQ(kAppProfile, request.app_profile_id());
+        EXPECT_EQ(kTableName, request.table_name());
+        auto stream =
+            std::make_unique<MockGenerateInitialChangeStreamPartitionsStream>();
+        EXPECT_CALL(*stream, Read)
+            .WillOnce(
+                [](v2::GenerateInitialChangeStreamPartitionsResponse* r) {
+                  r->mutable_partition()->mutable_row_range()->set_end_key_open(
+                      "returned");
+                  return std::nullopt;
+                })
+            .WillOnce(Return(Status{}));
+        return stream;
+      });
+
+  auto conn = TestConnection(std::move(mock));
+  internal::OptionsSpan span(CallOptions());
+  auto partitions = conn->GenerateInitialChangeStreamPartitions(kTableName);
+  ASSERT_STATUS_OK(partitions);
+  ASSERT_EQ(1, partitions->size());
+  EXPECT_EQ("returned", (*partitions)[0].row_range().end_key_open());
+}
+
+TEST_F(DataConnectionTest, ReadChangeStreamNoRetry) {
+  auto mock = std::make_shared<MockBigtableStub>();
+  EXPECT_CALL(*mock, ReadChangeStream)
+      .WillOnce([](auto, auto const&,
+                   v2::ReadChangeStreamRequest const& request, auto const&) {
+        EXPECT_EQ(kAppProfile, request.app_profile_id());
+        EXPECT_EQ(kTableName, request.table_name());
+        auto stream = std::make_unique<MockReadChangeStreamStream>();
+        EXPECT_CALL(*stream, Read)
+            .WillOnce([](v2::ReadChangeStreamResponse* r) {
+              r->mutable_heartbeat()->mutable_continuation_token()->set_token(
+                  "token");
+              return std::nullopt;
+            })
+            .WillOnce(Return(TransientError()));
+        return stream;
+      });
+
+  auto conn = TestConnection(std::move(mock));
+  internal::OptionsSpan span(CallOptions());
+  v2::ReadChangeStreamRequest request;
+  request.set_table_name(kTableName);
+  auto range = conn->ReadChangeStream(std::move(request));
+  auto it = range.begin();
+  ASSERT_NE(it, range.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ("token", (*it)->heartbeat().continuation_token().token());
+  ++it;
+  ASSERT_NE(it, range.end());
+  EXPECT_THAT(*it, StatusIs(StatusCode::kUnavailable));
+}
+
 TEST_F(DataConnectionTest, SampleRowsRetryExhausted) {
 #ifdef GOOGLE_CLOUD_CPP_BIGTABLE_WITH_OTEL_METRICS
   auto mock_metric = std::make_unique<MockMetric>();
@@ -3053,6 +3133,48 @@ TEST_F(DataConnectionTest, PrepareQueryPermanentError) {
   EXPECT_THAT(result, StatusIs(StatusCode::kPermissionDenied));
 }
 
+TEST_F(DataConnectionTest, PrepareQueryCacheSharedAcrossConnections) {
+  v2::PrepareQueryResponse response;
+  auto constexpr kResultMetadataText = R"pb(
+    proto_schema {
+      columns {
+        name: "row_key"
+        type { string_type {} }
+      }
+    }
+  )pb";
+  response.set_prepared_query("cached-plan");
+  *response.mutable_valid_until() = internal::ToProtoTimestamp(
+      std::chrono::system_clock::now() + std::chrono::seconds(3600));
+  ASSERT_TRUE(google::protobuf::TextFormat::ParseFromString(
+      kResultMetadataText, response.mutable_metadata()));
+
+  auto mock_1 = std::make_shared<MockBigtableStub>();
+  EXPECT_CALL(*mock_1, PrepareQuery).WillOnce(Return(response));
+  auto mock_2 = std::make_shared<MockBigtableStub>();
+  EXPECT_CALL(*mock_2, PrepareQuery).Times(0);
+  EXPECT_CALL(*mock_2, AsyncPrepareQuery).Times(0);
+
+  internal::OptionsSpan span(
+      CallOptions().set<bigtable::experimental::QueryPlanCacheSizeOption>(16));
+  // Use a query that no other test prepares, the cache is shared by the
+  // process.
+  auto params = bigtable::PrepareQueryParams{
+      bigtable::InstanceResource(google::cloud::Project("the-project"),
+                                 "the-instance"),
+      bigtable::SqlStatement("SELECT * FROM the-cached-table")};
+  auto conn_1 = TestConnection(std::move(mock_1));
+  auto pq_1 = conn_1->PrepareQuery(params);
+  ASSERT_STATUS_OK(pq_1);
+  conn_1.reset();
+
+  auto conn_2 = TestConnection(std::move(mock_2));
+  auto pq_2 = conn_2->PrepareQuery(params);
+  ASSERT_STATUS_OK(pq_2);
+  auto pq_3 = conn_2->AsyncPrepareQuery(params).get();
+  ASSERT_STATUS_OK(pq_3);
+}
+
 TEST_F(DataConnectionTest, AsyncPrepareQuerySuccess) {
 #ifdef GOOGLE_CLOUD_CPP_BIGTABLE_WITH_OTEL_METRICS
   auto mock_metric = std::make_unique<MockMetric>();
@@ -14,6 +14,7 @@
 
 #include "google/cloud/bigtable/internal/data_tracing_connection.h"
 #include "google/cloud/internal/opentelemetry.h"
+#include "google/cloud/internal/traced_stream_range.h"
 #include "traced_row_reader.h"
 
 namespace google {
@@ -204,6 +205,27 @@ class DataTracingConnection : public bigtable::DataConnection {
         });
   }
 
+  StatusOr<std::vector<google::bigtable::v2::StreamPartition>>
+  GenerateInitialChangeStreamPartitions(
+      std::string const& table_name) override {
+    auto span = internal::MakeSpan(
+        "bigtable::ChangeStreamReader::GenerateInitialChangeStreamPartitions");
+    auto scope = opentelemetry::trace::Scope(span);
+    return internal::EndSpan(
+        *span, child_->GenerateInitialChangeStreamPartitions(table_name));
+  }
+
+  StreamRange<google::bigtable::v2::ReadChangeStreamResponse> ReadChangeStream(
+      google::bigtable::v2::ReadChangeStreamRequest request) override {
+    auto span =
+        internal::MakeSpan("bigtable::ChangeStreamReader::ReadChangeStream");
+    auto scope = opentelemetry::trace::Scope(span);
+    auto sr = child_->ReadChangeStream(std::move(request));
+    return internal::MakeTracedStreamRange<
+        google::bigtable::v2::ReadChangeStreamResponse>(std::move(span),
+                                                        std::move(sr));
+  }
+
  private:
   std::shared_ptr<bigtable::DataConnection> child_;
 };
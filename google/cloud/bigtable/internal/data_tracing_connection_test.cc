@@ -15,6 +15,7 @@
 #include "google/cloud/bigtable/internal/data_tracing_connection.h"
 #include "google/cloud/bigtable/mocks/mock_data_connection.h"
 #include "google/cloud/bigtable/mocks/mock_row_reader.h"
+#include "google/cloud/mocks/mock_stream_range.h"
 #include "google/cloud/internal/make_status.h"
 #include "google/cloud/testing_util/opentelemetry_matchers.h"
 #include "google/cloud/testing_util/status_matchers.h"
@@ -641,6 +642,34 @@ TEST(DataTracingConnection, AsyncReadRowFailure) {
               OTelAttribute<bool>("gcloud.bigtable.row_found", _))))));
 }
 
+TEST(DataTracingConnection, ReadChangeStream) {
+  auto span_catcher = InstallSpanCatcher();
+
+  auto mock = std::make_shared<MockDataConnection>();
+  EXPECT_CALL(*mock, ReadChangeStream).WillOnce([] {
+    EXPECT_TRUE(ThereIsAnActiveSpan());
+    return mocks::MakeStreamRange<
+        google::bigtable::v2::ReadChangeStreamResponse>(
+        {}, internal::AbortedError("fail"));
+  });
+
+  auto under_test = MakeDataTracingConnection(mock);
+  auto stream = under_test->ReadChangeStream({});
+  auto it = stream.begin();
+  ASSERT_NE(it, stream.end());
+  EXPECT_THAT(*it, StatusIs(StatusCode::kAborted));
+  EXPECT_EQ(++it, stream.end());
+
+  EXPECT_THAT(
+      span_catcher->GetSpans(),
+      ElementsAre(AllOf(
+          SpanHasInstrumentationScope(), SpanKindIsClient(),
+          SpanNamed("bigtable::ChangeStreamReader::ReadChangeStream"),
+          SpanWithStatus(opentelemetry::trace::StatusCode::kError, "fail"),
+          SpanHasAttributes(
+              OTelAttribute<std::string>("gl-cpp.status_code", kErrorCode)))));
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace bigtable_internal
@@ -25,10 +25,13 @@
 #include "google/cloud/completion_queue.h"
 #include "google/cloud/internal/random.h"
 #include "google/cloud/version.h"
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace google {
@@ -38,7 +41,10 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 
 //
 // This class manages a pool of Stubs wrapped in a ChannelUsage object, and
-// selects one for use using a "Random Two Least Used" strategy.
+// selects one for use using a "Random Two Least Used" strategy. If a
+// LatencyAwareChannelSelectionPolicy is provided, the two random channels are
+// compared by a cost that combines their latency, error rate, and load, and
+// persistently slow channels are replaced.
 //
 // Based on usage data from the ChannelUsage object, the pool will add and
 // remove ChannelUsage<T> objects per the configuration present in the
@@ -67,11 +73,13 @@ class DynamicChannelPool
       std::shared_ptr<ConnectionRefreshState> refresh_state,
       StubFactoryFn stub_factory_fn,
       bigtable::experimental::DynamicChannelPoolSizingPolicy sizing_policy,
-      TransportType transport_type) {
+      TransportType transport_type,
+      std::optional<bigtable::experimental::LatencyAwareChannelSelectionPolicy>
+          selection_policy = std::nullopt) {
     auto pool = std::shared_ptr<DynamicChannelPool>(new DynamicChannelPool(
         std::move(instance_name), std::move(cq), std::move(initial_channels),
         std::move(refresh_state), std::move(stub_factory_fn),
-        std::move(sizing_policy), transport_type));
+        std::move(sizing_policy), transport_type, std::move(selection_policy)));
     return pool;
   }
 
@@ -85,6 +93,7 @@ class DynamicChannelPool
     if (pool_size_decrease_cooldown_timer_.valid()) {
       pool_size_decrease_cooldown_timer_.cancel();
     }
+    if (slow_channel_check_timer_.valid()) slow_channel_check_timer_.cancel();
   }
 
   // This is a snapshot aka dirty read as the size could immediately change
@@ -111,7 +120,8 @@ class DynamicChannelPool
   // Calls CheckPoolChannelHealth before picking a channel.
   //
   // Pick two random channels from channels_ and return the channel with the
-  // lower number of outstanding_rpcs. This is the "quick" path.
+  // lower number of outstanding_rpcs, or the lower cost if latency-aware
+  // selection is enabled. This is the "quick" path.
   //
   // If one or both of the random channels have been marked unhealthy after a
   // refresh, continue choosing random channels to find a pair of healthy
@@ -125,6 +135,7 @@ class DynamicChannelPool
   SelectedChannel<T> GetChannelRandomTwoLeastUsed() {
     std::scoped_lock lk(mu_);
     CheckPoolChannelHealth(lk);
+    ReplaceSlowChannel(lk);
 
     ChannelSelectionData d;
     d.iterators.reserve(channels_.size());
@@ -147,7 +158,8 @@ class DynamicChannelPool
 
     // This is the most common case so we try it first.
     if (d.channel_1_rpcs.ok() && d.channel_2_rpcs.ok()) {
-      return *d.channel_1_rpcs < *d.channel_2_rpcs
+      return PreferFirst(lk, **d.channel_1_iter, *d.channel_1_rpcs,
+                         **d.channel_2_iter, *d.channel_2_rpcs)
                  ? SelectedChannel<T>{*d.channel_1_iter, *d.channel_1_rpcs}
                  : SelectedChannel<T>{*d.channel_2_iter, *d.channel_2_rpcs};
     }
@@ -177,7 +189,9 @@ class DynamicChannelPool
       std::shared_ptr<ConnectionRefreshState> refresh_state,
       StubFactoryFn stub_factory_fn,
       bigtable::experimental::DynamicChannelPoolSizingPolicy sizing_policy,
-      TransportType transport_type)
+      TransportType transport_type,
+      std::optional<bigtable::experimental::LatencyAwareChannelSelectionPolicy>
+          selection_policy)
       : instance_name_(std::move(instance_name)),
         cq_(std::move(cq)),
         refresh_state_(std::move(refresh_state)),
@@ -185,7 +199,8 @@ class DynamicChannelPool
         channels_(std::move(initial_wrapped_channels)),
         sizing_policy_(std::move(sizing_policy)),
         next_channel_id_(static_cast<std::uint32_t>(channels_.size())),
-        transport_type_(transport_type) {
+        transport_type_(transport_type),
+        selection_policy_(std::move(selection_policy)) {
     std::scoped_lock lk(mu_);
     SetSizeDecreaseCooldownTimer(lk);
   }
@@ -234,7 +249,8 @@ class DynamicChannelPool
     int outstanding_rpcs = 0;
     if (d.channel_1_rpcs.ok() || d.channel_2_rpcs.ok()) {
       if (d.channel_1_rpcs.ok() && d.channel_2_rpcs.ok()) {
-        if (*d.channel_1_rpcs < *d.channel_2_rpcs) {
+        if (PreferFirst(lk, **d.channel_1_iter, *d.channel_1_rpcs,
+                        **d.channel_2_iter, *d.channel_2_rpcs)) {
           channel = *d.channel_1_iter;
           outstanding_rpcs = *d.channel_1_rpcs;
         } else {
@@ -391,6 +407,69 @@ class DynamicChannelPool
     }
   }
 
+  // Returns true if channel `a` should be selected over channel `b`. Without
+  // a LatencyAwareChannelSelectionPolicy, or if either channel has no latency
+  // samples, the channel with fewer outstanding RPCs is preferred. Otherwise
+  // the channel with the lower cost is preferred, where the cost is:
+  //   latency * (1 + outstanding_rpcs) * (1 + penalty * error_rate)
+  bool PreferFirst(std::scoped_lock<std::mutex> const&, ChannelUsage<T>& a,
+                   int a_rpcs, ChannelUsage<T>& b, int b_rpcs) const {
+    if (!selection_policy_) return a_rpcs < b_rpcs;
+    auto a_stats = a.instant_stats();
+    auto b_stats = b.instant_stats();
+    if (!a_stats || !b_stats || a_stats->samples == 0 ||
+        b_stats->samples == 0) {
+      return a_rpcs < b_rpcs;
+    }
+    auto cost = [this](ChannelStats const& s, int rpcs) {
+      return s.latency_us * (1 + rpcs) *
+             (1 + selection_policy_->error_rate_penalty * s.error_rate);
+    };
+    return cost(*a_stats, a_rpcs) < cost(*b_stats, b_rpcs);
+  }
+
+  // If latency-aware selection is enabled, at most once per
+  // slow_channel_check_interval, find the slowest channel with enough latency
+  // samples. If its latency exceeds slow_channel_latency_factor times the
+  // median latency of the pool, move it to draining_channels_ and schedule a
+  // replacement channel.
+  void ReplaceSlowChannel(std::scoped_lock<std::mutex> const& lk) {
+    if (!selection_policy_) return;
+    if (slow_channel_check_timer_.valid() &&
+        !slow_channel_check_timer_.is_ready()) {
+      return;
+    }
+    slow_channel_check_timer_ =
+        cq_.MakeRelativeTimer(selection_policy_->slow_channel_check_interval);
+
+    // The median is not meaningful with fewer than 3 channels.
+    std::size_t constexpr kMinimumChannels = 3;
+    std::vector<std::pair<double, std::size_t>> latencies;
+    latencies.reserve(channels_.size());
+    for (std::size_t i = 0; i != channels_.size(); ++i) {
+      auto stats = channels_[i]->instant_stats();
+      if (!stats ||
+          stats->samples < selection_policy_->minimum_samples_for_replacement) {
+        continue;
+      }
+      latencies.emplace_back(stats->latency_us, i);
+    }
+    if (latencies.size() < kMinimumChannels) return;
+    auto median = latencies.begin() + latencies.size() / 2;
+    std::nth_element(latencies.begin(), median, latencies.end());
+    auto const median_latency = median->first;
+    auto const slowest = *std::max_element(latencies.begin(), latencies.end());
+    if (slowest.first <=
+        selection_policy_->slow_channel_latency_factor * median_latency) {
+      return;
+    }
+    std::swap(channels_[slowest.second], channels_.back());
+    draining_channels_.push_back(std::move(channels_.back()));
+    channels_.pop_back();
+    ScheduleRemoveChannels(lk);
+    ScheduleAddChannels(lk);
+  }
+
   void SetSizeDecreaseCooldownTimer(std::scoped_lock<std::mutex> const&) {
     pool_size_decrease_cooldown_timer_ = cq_.MakeRelativeTimer(
         sizing_policy_.pool_size_decrease_cooldown_interval);
@@ -459,6 +538,10 @@ class DynamicChannelPool
       pool_size_decrease_cooldown_timer_;
   std::uint32_t next_channel_id_;
   TransportType const transport_type_ = TransportType::kCloudPath;
+  std::optional<bigtable::experimental::LatencyAwareChannelSelectionPolicy>
+      selection_policy_;
+  future<StatusOr<std::chrono::system_clock::time_point>>
+      slow_channel_check_timer_;
 };
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
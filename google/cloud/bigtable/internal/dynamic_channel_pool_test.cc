@@ -111,6 +111,7 @@ using ::google::cloud::testing_util::MockCompletionQueueImpl;
 using ::testing::Eq;
 using ::testing::IsEmpty;
 using ::testing::MockFunction;
+using ::testing::Ne;
 
 class DynamicChannelPoolTest : public ::testing::Test {
  public:
@@ -1259,6 +1260,102 @@ TEST_F(DynamicChannelPoolTest, TransportType) {
   EXPECT_THAT(pool_direct->transport_type(), Eq(TransportType::kDirectPath));
 }
 
+TEST_F(DynamicChannelPoolTest, LatencyAwareSelectionPrefersLowerCost) {
+  auto instance_name =
+      bigtable::InstanceResource(Project("my-project"), "my-instance")
+          .FullName();
+  DynamicChannelPoolSizingPolicy sizing_policy;
+  sizing_policy.maximum_channel_pool_size = 2;
+  sizing_policy.minimum_channel_pool_size = 2;
+  auto refresh_state = std::make_shared<ConnectionRefreshState>(
+      fake_cq_impl_, std::chrono::milliseconds(1),
+      std::chrono::milliseconds(10));
+  MockFunction<StatusOr<std::shared_ptr<ChannelUsage<BigtableStub>>>(
+      std::uint32_t, std::string const&, StubManager::Priming)>
+      stub_factory_fn;
+  EXPECT_CALL(stub_factory_fn, Call).Times(0);
+  EXPECT_CALL(*mock_cq_impl_, RunAsync).Times(0);
+
+  // The timers do not expire during the test.
+  EXPECT_CALL(*mock_cq_impl_, MakeRelativeTimer)
+      .WillRepeatedly([&](std::chrono::nanoseconds) {
+        return cq_.MakeRelativeTimer(std::chrono::seconds(600));
+      });
+
+  // The first channel has fewer outstanding RPCs, but it is much slower.
+  auto slow = std::make_shared<ChannelUsage<BigtableStub>>(
+      std::make_shared<MockBigtableStub>(), 1);
+  slow->RecordRpcResult(std::chrono::microseconds(1000), true);
+  auto fast = std::make_shared<ChannelUsage<BigtableStub>>(
+      std::make_shared<MockBigtableStub>(), 3);
+  fast->RecordRpcResult(std::chrono::microseconds(100), true);
+  std::vector<std::shared_ptr<ChannelUsage<BigtableStub>>> channels{slow,
+                                                                    fast};
+
+  auto by_load = DynamicChannelPool<BigtableStub>::Create(
+      instance_name, CompletionQueue(mock_cq_impl_), channels, refresh_state,
+      stub_factory_fn.AsStdFunction(), sizing_policy,
+      TransportType::kCloudPath);
+  EXPECT_THAT(by_load->GetChannelRandomTwoLeastUsed().channel, Eq(slow));
+
+  auto by_cost = DynamicChannelPool<BigtableStub>::Create(
+      instance_name, CompletionQueue(mock_cq_impl_), channels, refresh_state,
+      stub_factory_fn.AsStdFunction(), sizing_policy,
+      TransportType::kCloudPath,
+      bigtable::experimental::LatencyAwareChannelSelectionPolicy{});
+  auto selected = by_cost->GetChannelRandomTwoLeastUsed();
+  EXPECT_THAT(selected.channel, Eq(fast));
+  EXPECT_THAT(selected.outstanding_rpcs, Eq(3));
+
+  // Errors increase the cost of a channel.
+  for (int i = 0; i != 10; ++i) {
+    fast->RecordRpcResult(std::chrono::microseconds(100), false);
+  }
+  EXPECT_THAT(by_cost->GetChannelRandomTwoLeastUsed().channel, Eq(slow));
+}
+
+TEST_F(DynamicChannelPoolTest, LatencyAwareSelectionReplacesSlowChannel) {
+  auto instance_name =
+      bigtable::InstanceResource(Project("my-project"), "my-instance")
+          .FullName();
+  DynamicChannelPoolSizingPolicy sizing_policy;
+  sizing_policy.maximum_channel_pool_size = 3;
+  sizing_policy.minimum_channel_pool_size = 3;
+  bigtable::experimental::LatencyAwareChannelSelectionPolicy selection_policy;
+  selection_policy.minimum_samples_for_replacement = 1;
+  auto refresh_state = std::make_shared<ConnectionRefreshState>(
+      fake_cq_impl_, std::chrono::milliseconds(1),
+      std::chrono::milliseconds(10));
+  MockFunction<StatusOr<std::shared_ptr<ChannelUsage<BigtableStub>>>(
+      std::uint32_t, std::string const&, StubManager::Priming)>
+      stub_factory_fn;
+
+  // A replacement channel is scheduled.
+  EXPECT_CALL(*mock_cq_impl_, RunAsync).Times(1);
+  // The timers do not expire during the test.
+  EXPECT_CALL(*mock_cq_impl_, MakeRelativeTimer)
+      .WillRepeatedly([&](std::chrono::nanoseconds) {
+        return cq_.MakeRelativeTimer(std::chrono::seconds(600));
+      });
+
+  std::vector<std::shared_ptr<ChannelUsage<BigtableStub>>> channels;
+  for (auto latency : {100, 120, 1000}) {
+    auto c = std::make_shared<ChannelUsage<BigtableStub>>(
+        std::make_shared<MockBigtableStub>(), 2);
+    c->RecordRpcResult(std::chrono::microseconds(latency), true);
+    channels.push_back(std::move(c));
+  }
+  auto slow = channels.back();
+
+  auto pool = DynamicChannelPool<BigtableStub>::Create(
+      instance_name, CompletionQueue(mock_cq_impl_), channels, refresh_state,
+      stub_factory_fn.AsStdFunction(), sizing_policy,
+      TransportType::kCloudPath, selection_policy);
+  auto selected = pool->GetChannelRandomTwoLeastUsed();
+  EXPECT_THAT(selected.channel, Ne(slow));
+  EXPECT_THAT(pool->size(), Eq(2));
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace bigtable_internal
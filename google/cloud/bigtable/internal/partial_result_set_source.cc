@@ -13,12 +13,15 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/internal/partial_result_set_source.h"
+#include "google/cloud/bigtable/internal/column_batch_builder.h"
 #include "google/cloud/bigtable/internal/crc32c.h"
 #include "google/cloud/bigtable/options.h"
 #include "google/cloud/internal/make_status.h"
 #include "google/cloud/log.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/str_cat.h"
+#include <algorithm>
+#include <iterator>
 #include <optional>
 
 namespace google {
@@ -100,22 +103,59 @@ PartialResultSetSource::~PartialResultSetSource() {
 
 StatusOr<bigtable::QueryRow> PartialResultSetSource::NextRow() {
   operation_context_->ElementRequest(reader_->context());
-  while (rows_.empty()) {
-    if (state_ == State::kFinished) {
-      operation_context_->ElementDelivery(reader_->context());
-      return bigtable::QueryRow();
+  auto status = WaitForValues();
+  if (!status.ok()) return status;
+  if (values_.empty()) {
+    operation_context_->ElementDelivery(reader_->context());
+    return bigtable::QueryRow();
+  }
+  // Returns the row at the front of the queue
+  auto const& columns = metadata_->proto_schema().columns();
+  std::vector<bigtable::Value> values;
+  values.reserve(columns.size());
+  for (auto const& column : columns) {
+    values.push_back(FromProto(column.type(), std::move(values_.front())));
+    values_.pop_front();
+  }
+  operation_context_->ElementDelivery(reader_->context());
+  return QueryRowFriend::MakeQueryRow(std::move(values), columns_);
+}
+
+StatusOr<bigtable::ColumnBatch> PartialResultSetSource::NextBatch(
+    std::size_t max_rows) {
+  operation_context_->ElementRequest(reader_->context());
+  auto status = WaitForValues();
+  if (!status.ok()) return status;
+  if (values_.empty()) {
+    operation_context_->ElementDelivery(reader_->context());
+    return bigtable::ColumnBatch();
+  }
+  ColumnBatchBuilder builder(*metadata_);
+  auto const columns = builder.num_columns();
+  max_rows = (std::max<std::size_t>)(1, max_rows);
+  auto const rows = (std::min)(max_rows, values_.size() / columns);
+  builder.Reserve(rows);
+  for (std::size_t r = 0; r != rows; ++r) {
+    for (std::size_t c = 0; c != columns; ++c) {
+      builder.Append(c, std::move(values_.front()));
+      values_.pop_front();
     }
+    builder.FinishRow();
+  }
+  operation_context_->ElementDelivery(reader_->context());
+  return std::move(builder).Build();
+}
+
+Status PartialResultSetSource::WaitForValues() {
+  while (values_.empty()) {
+    if (state_ == State::kFinished) return {};
     internal::OptionsSpan span(options_);
     // Continue fetching if there are more rows in the stream.
     auto status = ReadFromStream();
     last_status_ = status;
     if (!status.ok()) return status;
   }
-  // Returns the row at the front of the queue
-  auto row = std::move(rows_.front());
-  rows_.pop_front();
-  operation_context_->ElementDelivery(reader_->context());
-  return row;
+  return {};
 }
 
 Status PartialResultSetSource::ReadFromStream() {
@@ -123,8 +163,9 @@ Status PartialResultSetSource::ReadFromStream() {
     return internal::InternalError("PartialResultSetSource already finished",
                                    GCP_ERROR_INFO());
   }
-  // The application should consume rows_ before calling ReadFromStream again.
-  if (!rows_.empty()) {
+  // The application should consume values_ before calling ReadFromStream
+  // again.
+  if (!values_.empty()) {
     return internal::InternalError("PartialResultSetSource has unconsumed rows",
                                    GCP_ERROR_INFO());
   }
@@ -149,9 +190,9 @@ Status PartialResultSetSource::ReadFromStream() {
       return internal::InternalError(
           "Query plan expired during a retry attempt", GCP_ERROR_INFO());
     }
-  } else if (!buffered_rows_.empty() || !read_buffer_.empty()) {
-    // buffered_rows_ and read_buffer_ are expected to be empty because the last
-    // successful read would have had a sentinel resume_token, causing
+  } else if (!buffered_values_.empty() || !read_buffer_.empty()) {
+    // buffered_values_ and read_buffer_ are expected to be empty because the
+    // last successful read would have had a sentinel resume_token, causing
     // ProcessDataFromStream to commit them.
     return internal::InternalError("Stream ended with uncommitted rows.",
                                    GCP_ERROR_INFO());
@@ -166,7 +207,7 @@ Status PartialResultSetSource::ProcessDataFromStream(
   // resume_token should be discarded.
   if (result.reset()) {
     read_buffer_.clear();
-    buffered_rows_.clear();
+    buffered_values_.clear();
   }
 
   // Reserve space of the buffer at the start of a new batch of data.
@@ -182,7 +223,7 @@ Status PartialResultSetSource::ProcessDataFromStream(
     if (bigtable_internal::Crc32c(read_buffer_) != result.batch_checksum()) {
       state_ = State::kFinished;
       read_buffer_.clear();
-      buffered_rows_.clear();
+      buffered_values_.clear();
       return internal::InternalError("Unexpected checksum mismatch",
                                      GCP_ERROR_INFO());
     }
@@ -193,17 +234,19 @@ Status PartialResultSetSource::ProcessDataFromStream(
       if (!status.ok()) return status;
     } else {
       read_buffer_.clear();
-      buffered_rows_.clear();
+      buffered_values_.clear();
       return internal::InternalError("Failed to parse ProtoRows from buffer",
                                      GCP_ERROR_INFO());
     }
   }
 
-  // Buffered rows in buffered_rows_ are ready to be committed into rows_
-  // once the resume_token is received.
+  // Buffered values in buffered_values_ are ready to be committed into
+  // values_ once the resume_token is received.
   if (!result.resume_token().empty()) {
-    rows_.insert(rows_.end(), buffered_rows_.begin(), buffered_rows_.end());
-    buffered_rows_.clear();
+    values_.insert(values_.end(),
+                   std::make_move_iterator(buffered_values_.begin()),
+                   std::make_move_iterator(buffered_values_.end()));
+    buffered_values_.clear();
     read_buffer_.clear();
     resume_token_ = AsString(result.resume_token());
   }
@@ -214,7 +257,7 @@ Status PartialResultSetSource::BufferProtoRows() {
   if (metadata_.has_value()) {
     auto const& proto_schema = metadata_->proto_schema();
     auto const columns_size = proto_schema.columns_size();
-    auto const& proto_values = proto_rows_.values();
+    auto& proto_values = *proto_rows_.mutable_values();
 
     if (proto_values.size() % columns_size != 0) {
       state_ = State::kFinished;
@@ -224,10 +267,9 @@ Status PartialResultSetSource::BufferProtoRows() {
           GCP_ERROR_INFO());
     }
 
+    // Validate the values before any of them are buffered, the conversion to
+    // `bigtable::Value` or to column buffers happens as they are consumed.
     auto parsed_value = proto_values.begin();
-    std::vector<bigtable::Value> values;
-    values.reserve(columns_size);
-
     while (parsed_value != proto_values.end()) {
       for (auto const& column : proto_schema.columns()) {
         auto type_value_match_result =
@@ -235,14 +277,11 @@ Status PartialResultSetSource::BufferProtoRows() {
         if (!type_value_match_result.ok()) {
           return type_value_match_result;
         }
-        auto value = FromProto(column.type(), *parsed_value);
-        values.push_back(std::move(value));
         ++parsed_value;
       }
-      buffered_rows_.push_back(
-          QueryRowFriend::MakeQueryRow(std::move(values), columns_));
-      values.clear();
     }
+    buffered_values_.reserve(buffered_values_.size() + proto_values.size());
+    for (auto& v : proto_values) buffered_values_.push_back(std::move(v));
   }
   return {};
 }
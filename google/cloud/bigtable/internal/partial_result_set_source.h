@@ -51,6 +51,8 @@ class PartialResultSetSource : public bigtable::ResultSourceInterface {
 
   StatusOr<bigtable::QueryRow> NextRow() override;
 
+  StatusOr<bigtable::ColumnBatch> NextBatch(std::size_t max_rows) override;
+
   std::optional<google::bigtable::v2::ResultSetMetadata> Metadata() override {
     return metadata_;
   }
@@ -64,6 +66,9 @@ class PartialResultSetSource : public bigtable::ResultSourceInterface {
   Status ReadFromStream();
   Status ProcessDataFromStream(google::bigtable::v2::PartialResultSet& result);
   Status BufferProtoRows();
+  // Reads from the stream until there are committed values or the stream
+  // ends.
+  Status WaitForValues();
   std::string read_buffer_;
 
   // Arena for the values_ field.
@@ -77,8 +82,11 @@ class PartialResultSetSource : public bigtable::ResultSourceInterface {
   std::optional<google::bigtable::v2::ResultSetMetadata> metadata_;
 
   std::shared_ptr<std::vector<std::string>> columns_;
-  std::deque<bigtable::QueryRow> rows_;
-  std::vector<bigtable::QueryRow> buffered_rows_;
+  // The values are kept in their protobuf form until they are returned, so
+  // `NextBatch()` can decode them directly into column buffers. Each row is
+  // `columns_->size()` consecutive values.
+  std::deque<google::bigtable::v2::Value> values_;
+  std::vector<google::bigtable::v2::Value> buffered_values_;
   google::bigtable::v2::ProtoRows proto_rows_;
 
   // An opaque token sent by the server to allow query resumption and signal
@@ -46,6 +46,7 @@ using ::google::cloud::testing_util::IsOk;
 using ::google::cloud::testing_util::StatusIs;
 using ::google::protobuf::TextFormat;
 using ::testing::_;
+using ::testing::ElementsAre;
 using ::testing::Return;
 using ::testing::UnitTest;
 
@@ -606,6 +607,106 @@ TEST(PartialResultSetSourceTest, ResponseWithNoValues) {
   EXPECT_THAT((*reader)->NextRow(), IsValidAndEquals(bigtable::QueryRow{}));
 }
 
+TEST(PartialResultSetSourceTest, NextBatch) {
+  auto operation_context = std::make_shared<OperationContext>();
+
+  auto constexpr kResultMetadataText = R"pb(
+    proto_schema {
+      columns {
+        name: "key"
+        type { string_type {} }
+      }
+      columns {
+        name: "count"
+        type { int64_type {} }
+      }
+      columns {
+        name: "score"
+        type { float64_type {} }
+      }
+    }
+  )pb";
+  google::bigtable::v2::ResultSetMetadata metadata;
+  ASSERT_TRUE(TextFormat::ParseFromString(kResultMetadataText, &metadata));
+  auto constexpr kProtoRowsText = R"pb(
+    values { string_value: "r1" }
+    values { int_value: 1 }
+    values { float_value: 0.5 }
+    values { string_value: "row-2" }
+    values {}
+    values { float_value: 1.5 }
+    values { string_value: "r3" }
+    values { int_value: 3 }
+    values {}
+  )pb";
+  google::bigtable::v2::ProtoRows proto_rows;
+  ASSERT_TRUE(TextFormat::ParseFromString(kProtoRowsText, &proto_rows));
+  std::string binary_batch_data = proto_rows.SerializeAsString();
+  auto correct_checksum =
+      static_cast<uint32_t>(bigtable_internal::Crc32c(binary_batch_data));
+  std::string partial_result_set_text =
+      absl::Substitute(R"pb(
+                         proto_rows_batch: {
+                           batch_data: "$0",
+                         },
+                         resume_token: "AAAAAWVyZXN1bWVfdG9rZW4=",
+                         reset: true,
+                         batch_checksum: $1
+                       )pb",
+                       binary_batch_data, correct_checksum);
+  google::bigtable::v2::PartialResultSet response;
+  ASSERT_TRUE(TextFormat::ParseFromString(partial_result_set_text, &response));
+
+  auto grpc_reader =
+      std::make_unique<bigtable_testing::MockPartialResultSetReader>();
+  EXPECT_CALL(*grpc_reader, Read(_, _))
+      .WillOnce([&response](std::optional<std::string> const&,
+                            UnownedPartialResultSet& result) {
+        result.result = response;
+        return true;
+      })
+      .WillOnce(Return(false));
+  EXPECT_CALL(*grpc_reader, Finish()).WillOnce(ResultMock(Status()));
+  EXPECT_CALL(*grpc_reader, TryCancel()).Times(0);
+  grpc::ClientContext context;
+  EXPECT_CALL(*grpc_reader, context)
+      .WillRepeatedly([&]() -> grpc::ClientContext const& { return context; });
+
+  auto reader = CreatePartialResultSetSource(
+      metadata, std::move(operation_context), std::move(grpc_reader));
+  ASSERT_STATUS_OK(reader);
+
+  auto batch = (*reader)->NextBatch(2);
+  ASSERT_STATUS_OK(batch);
+  ASSERT_EQ(2, batch->num_rows());
+  ASSERT_EQ(3, batch->columns().size());
+  auto const& key = batch->column(0);
+  EXPECT_EQ("key", key.name());
+  EXPECT_EQ(bigtable::ColumnBuffer::Kind::kString, key.kind());
+  EXPECT_EQ("r1", key.string_value(0));
+  EXPECT_EQ("row-2", key.string_value(1));
+  EXPECT_THAT(key.offsets(), ElementsAre(0, 2, 7));
+  auto const& count = batch->column(1);
+  EXPECT_EQ(bigtable::ColumnBuffer::Kind::kInt64, count.kind());
+  EXPECT_THAT(count.int64_values(), ElementsAre(1, 0));
+  EXPECT_FALSE(count.IsNull(0));
+  EXPECT_TRUE(count.IsNull(1));
+  auto const& score = batch->column(2);
+  EXPECT_EQ(bigtable::ColumnBuffer::Kind::kFloat64, score.kind());
+  EXPECT_THAT(score.float64_values(), ElementsAre(0.5, 1.5));
+
+  // The remaining row can be consumed using either API.
+  auto row = (*reader)->NextRow();
+  ASSERT_STATUS_OK(row);
+  EXPECT_EQ("r3", *row->values().at(0).get<std::string>());
+  EXPECT_EQ(3, *row->values().at(1).get<std::int64_t>());
+  EXPECT_TRUE(row->values().at(2).is_null());
+
+  batch = (*reader)->NextBatch(2);
+  ASSERT_STATUS_OK(batch);
+  EXPECT_EQ(0, batch->num_rows());
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace bigtable_internal
@@ -0,0 +1,181 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/query_plan_cache.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/credentials.h"
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/background_threads_impl.h"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// Returns a number identifying the object owned by @p p, 0 for null. Unlike
+// the object's address, the number is not reused once the object is deleted.
+std::uint64_t IdentityOf(std::weak_ptr<void> const& p) {
+  if (p.expired()) return 0;
+  using Map = std::map<std::weak_ptr<void>, std::uint64_t,
+                       std::owner_less<std::weak_ptr<void>>>;
+  static auto* const kMu = new std::mutex;
+  static auto* const kIds = new Map;
+  static std::uint64_t last_id = 0;
+  std::lock_guard<std::mutex> lk(*kMu);
+  // Forget the objects that were deleted.
+  for (auto i = kIds->begin(); i != kIds->end();) {
+    i = i->first.expired() ? kIds->erase(i) : std::next(i);
+  }
+  auto& id = (*kIds)[p];
+  if (id == 0) id = ++last_id;
+  return id;
+}
+
+}  // namespace
+
+QueryPlanCache& QueryPlanCache::Global() {
+  // Neither the cache nor its thread are ever deleted, the plans may be used,
+  // and refreshed, by connections destroyed during the program shutdown.
+  static auto* cache = [] {
+    auto* background = new internal::AutomaticallyCreatedBackgroundThreads(1);
+    return new QueryPlanCache(background->cq());
+  }();
+  return *cache;
+}
+
+std::string QueryPlanCache::MakeKey(
+    Options const& options,
+    google::bigtable::v2::PrepareQueryRequest const& request) {
+  std::vector<std::string> names;
+  names.reserve(request.param_types().size());
+  for (auto const& p : request.param_types()) names.push_back(p.first);
+  std::sort(names.begin(), names.end());
+
+  // Endpoints, instance names and app profile ids cannot contain the
+  // separator, the other fields are prefixed by their size.
+  std::string key = options.get<EndpointOption>();
+  key += '\0';
+  key += std::to_string(IdentityOf(options.get<UnifiedCredentialsOption>()));
+  key += '\0';
+  key += std::to_string(IdentityOf(options.get<GrpcCredentialOption>()));
+  key += '\0';
+  key += request.instance_name();
+  key += '\0';
+  key += request.app_profile_id();
+  key += '\0';
+  key += std::to_string(request.query().size());
+  key += '\0';
+  key += request.query();
+  for (auto const& name : names) {
+    key += '\0';
+    key += std::to_string(name.size());
+    key += '\0';
+    key += name;
+    key += request.param_types().at(name).SerializeAsString();
+  }
+  return key;
+}
+
+future<StatusOr<std::shared_ptr<QueryPlan>>> QueryPlanCache::GetOrPrepare(
+    std::string const& key, std::size_t max_entries, PrepareFn const& prepare,
+    QueryPlan::RefreshFn refresh) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    auto& entry = it->second;
+    {
+      std::lock_guard<std::mutex> holder_lk(entry.holder->mu);
+      entry.holder->fn = std::move(refresh);
+    }
+    lru_.splice(lru_.begin(), lru_, entry.lru);
+    if (entry.plan) return make_ready_future(make_status_or(entry.plan));
+    entry.waiters.emplace_back();
+    return entry.waiters.back().get_future();
+  }
+
+  Entry entry;
+  entry.holder = std::make_shared<RefreshHolder>();
+  entry.holder->fn = std::move(refresh);
+  entry.waiters.emplace_back();
+  auto f = entry.waiters.back().get_future();
+  lru_.push_front(key);
+  entry.lru = lru_.begin();
+  entries_.emplace(key, std::move(entry));
+  lk.unlock();
+
+  prepare().then([this, key, max_entries](auto r) {
+    OnPrepare(key, max_entries, r.get());
+  });
+  return f;
+}
+
+std::size_t QueryPlanCache::size() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return entries_.size();
+}
+
+void QueryPlanCache::OnPrepare(
+    std::string const& key, std::size_t max_entries,
+    StatusOr<google::bigtable::v2::PrepareQueryResponse> response) {
+  std::unique_lock<std::mutex> lk(mu_);
+  // Entries are not evicted while they are being prepared.
+  auto it = entries_.find(key);
+  auto waiters = std::move(it->second.waiters);
+  it->second.waiters.clear();
+  StatusOr<std::shared_ptr<QueryPlan>> result;
+  if (!response) {
+    result = std::move(response).status();
+    lru_.erase(it->second.lru);
+    entries_.erase(it);
+  } else {
+    auto holder = it->second.holder;
+    it->second.plan =
+        QueryPlan::Create(cq_, *std::move(response), [holder]() {
+          QueryPlan::RefreshFn fn;
+          {
+            std::lock_guard<std::mutex> holder_lk(holder->mu);
+            fn = holder->fn;
+          }
+          return fn();
+        });
+    result = it->second.plan;
+    Evict(lk, max_entries);
+  }
+  lk.unlock();
+  for (auto& w : waiters) w.set_value(result);
+}
+
+void QueryPlanCache::Evict(std::unique_lock<std::mutex> const&,
+                           std::size_t max_entries) {
+  auto i = lru_.end();
+  while (entries_.size() > max_entries && i != lru_.begin()) {
+    --i;
+    auto e = entries_.find(*i);
+    if (!e->second.plan) continue;
+    entries_.erase(e);
+    i = lru_.erase(i);
+  }
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+}  // namespace cloud
+}  // namespace google
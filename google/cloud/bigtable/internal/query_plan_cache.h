@@ -0,0 +1,104 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_QUERY_PLAN_CACHE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_QUERY_PLAN_CACHE_H
+
+#include "google/cloud/bigtable/internal/query_plan.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status_or.h"
+#include "google/bigtable/v2/bigtable.pb.h"
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * A bounded cache of `QueryPlan`s, shared by all the connections.
+ *
+ * Concurrent lookups for a missing key share a single call to the prepare
+ * function. Failed preparations are not cached. The plans keep refreshing
+ * themselves before they expire (see `QueryPlan`), using the refresh function
+ * of the most recent lookup, so a plan outlives the connection that prepared
+ * it.
+ */
+class QueryPlanCache {
+ public:
+  using PrepareFn = std::function<
+      future<StatusOr<google::bigtable::v2::PrepareQueryResponse>>()>;
+
+  // The queue runs the refresh timers of the cached plans.
+  explicit QueryPlanCache(CompletionQueue cq) : cq_(std::move(cq)) {}
+
+  // The cache shared by all the connections in the process.
+  static QueryPlanCache& Global();
+
+  // Returns the cache key for @p request, sent with @p options. Plans are
+  // only shared by connections with the same endpoint and credentials.
+  static std::string MakeKey(
+      Options const& options,
+      google::bigtable::v2::PrepareQueryRequest const& request);
+
+  // Returns the plan cached for @p key, calling @p prepare to create it if
+  // needed. Evicts the least recently used plans to keep at most
+  // @p max_entries plans.
+  future<StatusOr<std::shared_ptr<QueryPlan>>> GetOrPrepare(
+      std::string const& key, std::size_t max_entries, PrepareFn const& prepare,
+      QueryPlan::RefreshFn refresh);
+
+  std::size_t size() const;
+
+ private:
+  struct RefreshHolder {
+    std::mutex mu;
+    QueryPlan::RefreshFn fn;
+  };
+
+  struct Entry {
+    std::shared_ptr<RefreshHolder> holder;
+    // Null while the plan is being prepared.
+    std::shared_ptr<QueryPlan> plan;
+    std::vector<promise<StatusOr<std::shared_ptr<QueryPlan>>>> waiters;
+    std::list<std::string>::iterator lru;
+  };
+
+  void OnPrepare(std::string const& key, std::size_t max_entries,
+                 StatusOr<google::bigtable::v2::PrepareQueryResponse> response);
+  void Evict(std::unique_lock<std::mutex> const&, std::size_t max_entries);
+
+  CompletionQueue cq_;
+  mutable std::mutex mu_;
+  // Most recently used first.
+  std::list<std::string> lru_;                      // GUARDED_BY(mu_)
+  std::unordered_map<std::string, Entry> entries_;  // GUARDED_BY(mu_)
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_QUERY_PLAN_CACHE_H
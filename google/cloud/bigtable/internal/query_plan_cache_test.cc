@@ -0,0 +1,243 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/query_plan_cache.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/credentials.h"
+#include "google/cloud/internal/make_status.h"
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <google/protobuf/text_format.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::bigtable::v2::PrepareQueryRequest;
+using ::google::bigtable::v2::PrepareQueryResponse;
+using ::google::cloud::testing_util::FakeCompletionQueueImpl;
+using ::google::cloud::testing_util::StatusIs;
+using ::google::protobuf::TextFormat;
+
+PrepareQueryResponse MakeResponse(std::string const& id) {
+  PrepareQueryResponse response;
+  response.set_prepared_query(id);
+  response.mutable_valid_until()->set_seconds(
+      std::chrono::duration_cast<std::chrono::seconds>(
+          (std::chrono::system_clock::now() + std::chrono::hours(1))
+              .time_since_epoch())
+          .count());
+  return response;
+}
+
+QueryPlan::RefreshFn MakeRefresh(std::string const& id) {
+  return [id] { return make_ready_future(make_status_or(MakeResponse(id))); };
+}
+
+QueryPlanCache::PrepareFn MakePrepare(std::string const& id, int& calls) {
+  return [id, &calls] {
+    ++calls;
+    return make_ready_future(make_status_or(MakeResponse(id)));
+  };
+}
+
+TEST(QueryPlanCacheTest, ReusesPlan) {
+  auto fake_cq_impl = std::make_shared<FakeCompletionQueueImpl>();
+  QueryPlanCache cache{CompletionQueue(fake_cq_impl)};
+
+  int calls = 0;
+  auto p0 =
+      cache.GetOrPrepare("k", 10, MakePrepare("id", calls), MakeRefresh("id"))
+          .get();
+  ASSERT_STATUS_OK(p0);
+  auto p1 =
+      cache.GetOrPrepare("k", 10, MakePrepare("id", calls), MakeRefresh("id"))
+          .get();
+  ASSERT_STATUS_OK(p1);
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(*p0, *p1);
+  EXPECT_EQ("id", (*p1)->response()->prepared_query());
+  EXPECT_EQ(1, cache.size());
+
+  fake_cq_impl->SimulateCompletion(false);
+}
+
+TEST(QueryPlanCacheTest, SingleFlight) {
+  auto fake_cq_impl = std::make_shared<FakeCompletionQueueImpl>();
+  QueryPlanCache cache{CompletionQueue(fake_cq_impl)};
+
+  int calls = 0;
+  promise<StatusOr<PrepareQueryResponse>> pending;
+  auto prepare = [&] {
+    ++calls;
+    return pending.get_future();
+  };
+  auto f0 = cache.GetOrPrepare("k", 10, prepare, MakeRefresh("id"));
+  auto f1 = cache.GetOrPrepare("k", 10, prepare, MakeRefresh("id"));
+  auto f2 = cache.GetOrPrepare("k", 10, prepare, MakeRefresh("id"));
+  EXPECT_EQ(1, calls);
+  EXPECT_FALSE(f0.is_ready());
+  EXPECT_FALSE(f1.is_ready());
+  EXPECT_FALSE(f2.is_ready());
+
+  pending.set_value(MakeResponse("id"));
+  auto p0 = f0.get();
+  auto p1 = f1.get();
+  auto p2 = f2.get();
+  ASSERT_STATUS_OK(p0);
+  ASSERT_STATUS_OK(p1);
+  ASSERT_STATUS_OK(p2);
+  EXPECT_EQ(*p0, *p1);
+  EXPECT_EQ(*p0, *p2);
+
+  fake_cq_impl->SimulateCompletion(false);
+}
+
+TEST(QueryPlanCacheTest, FailuresAreNotCached) {
+  auto fake_cq_impl = std::make_shared<FakeCompletionQueueImpl>();
+  QueryPlanCache cache{CompletionQueue(fake_cq_impl)};
+
+  int calls = 0;
+  auto fail = [&] {
+    ++calls;
+    return make_ready_future(StatusOr<PrepareQueryResponse>(
+        internal::UnavailableError("try-again")));
+  };
+  auto p0 = cache.GetOrPrepare("k", 10, fail, MakeRefresh("id")).get();
+  EXPECT_THAT(p0, StatusIs(StatusCode::kUnavailable));
+  EXPECT_EQ(0, cache.size());
+
+  auto p1 =
+      cache.GetOrPrepare("k", 10, MakePrepare("id", calls), MakeRefresh("id"))
+          .get();
+  ASSERT_STATUS_OK(p1);
+  EXPECT_EQ(2, calls);
+  EXPECT_EQ(1, cache.size());
+
+  fake_cq_impl->SimulateCompletion(false);
+}
+
+TEST(QueryPlanCacheTest, EvictsLeastRecentlyUsed) {
+  auto fake_cq_impl = std::make_shared<FakeCompletionQueueImpl>();
+  QueryPlanCache cache{CompletionQueue(fake_cq_impl)};
+
+  int calls = 0;
+  auto get = [&](std::string const& key) {
+    return cache
+        .GetOrPrepare(key, 2, MakePrepare(key, calls), MakeRefresh(key))
+        .get();
+  };
+  ASSERT_STATUS_OK(get("a"));
+  ASSERT_STATUS_OK(get("b"));
+  ASSERT_STATUS_OK(get("a"));
+  EXPECT_EQ(2, calls);
+  // "b" is the least recently used plan.
+  ASSERT_STATUS_OK(get("c"));
+  EXPECT_EQ(3, calls);
+  EXPECT_EQ(2, cache.size());
+  ASSERT_STATUS_OK(get("a"));
+  EXPECT_EQ(3, calls);
+  ASSERT_STATUS_OK(get("b"));
+  EXPECT_EQ(4, calls);
+  EXPECT_EQ(2, cache.size());
+
+  fake_cq_impl->SimulateCompletion(false);
+}
+
+TEST(QueryPlanCacheTest, RefreshUsesLatestFunction) {
+  auto fake_cq_impl = std::make_shared<FakeCompletionQueueImpl>();
+  QueryPlanCache cache{CompletionQueue(fake_cq_impl)};
+
+  int calls = 0;
+  auto p0 = cache
+                .GetOrPrepare("k", 10, MakePrepare("original", calls),
+                              MakeRefresh("first"))
+                .get();
+  ASSERT_STATUS_OK(p0);
+  auto p1 = cache
+                .GetOrPrepare("k", 10, MakePrepare("original", calls),
+                              MakeRefresh("second"))
+                .get();
+  ASSERT_STATUS_OK(p1);
+
+  (*p1)->Invalidate(internal::FailedPreconditionError("expired"), "original");
+  auto response = (*p1)->response();
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ("second", response->prepared_query());
+
+  fake_cq_impl->SimulateCompletion(false);
+}
+
+TEST(QueryPlanCacheTest, MakeKey) {
+  auto constexpr kRequestText = R"pb(
+    instance_name: "projects/p/instances/i"
+    app_profile_id: "profile"
+    query: "SELECT * FROM t WHERE k = @k"
+    param_types {
+      key: "k"
+      value { string_type {} }
+    }
+  )pb";
+  PrepareQueryRequest request;
+  ASSERT_TRUE(TextFormat::ParseFromString(kRequestText, &request));
+  auto const options = Options{};
+  auto const key = QueryPlanCache::MakeKey(options, request);
+  EXPECT_EQ(key, QueryPlanCache::MakeKey(options, request));
+
+  auto other = request;
+  (*other.mutable_param_types())["k"].mutable_bytes_type();
+  EXPECT_NE(key, QueryPlanCache::MakeKey(options, other));
+
+  other = request;
+  other.set_app_profile_id("other");
+  EXPECT_NE(key, QueryPlanCache::MakeKey(options, other));
+
+  other = request;
+  other.set_instance_name("projects/p/instances/other");
+  EXPECT_NE(key, QueryPlanCache::MakeKey(options, other));
+
+  other = request;
+  other.set_query("SELECT * FROM t");
+  EXPECT_NE(key, QueryPlanCache::MakeKey(options, other));
+
+  auto const credentials = MakeInsecureCredentials();
+  auto const with_credentials =
+      Options{}.set<UnifiedCredentialsOption>(credentials);
+  auto const key_with_credentials =
+      QueryPlanCache::MakeKey(with_credentials, request);
+  EXPECT_NE(key, key_with_credentials);
+  EXPECT_EQ(key_with_credentials,
+            QueryPlanCache::MakeKey(with_credentials, request));
+  EXPECT_NE(key_with_credentials,
+            QueryPlanCache::MakeKey(
+                Options{}.set<UnifiedCredentialsOption>(
+                    MakeInsecureCredentials()),
+                request));
+
+  EXPECT_NE(key, QueryPlanCache::MakeKey(
+                     Options{}.set<EndpointOption>("other.googleapis.com"),
+                     request));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+}  // namespace cloud
+}  // namespace google
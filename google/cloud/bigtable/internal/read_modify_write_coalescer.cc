@@ -0,0 +1,167 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/read_modify_write_coalescer.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+namespace v2 = ::google::bigtable::v2;
+
+void MergeReadModifyWriteRule(std::vector<v2::ReadModifyWriteRule>& rules,
+                              v2::ReadModifyWriteRule rule) {
+  auto last = std::find_if(
+      rules.rbegin(), rules.rend(), [&rule](v2::ReadModifyWriteRule const& r) {
+        return r.family_name() == rule.family_name() &&
+               r.column_qualifier() == rule.column_qualifier();
+      });
+  if (last == rules.rend() || last->rule_case() != rule.rule_case()) {
+    rules.push_back(std::move(rule));
+    return;
+  }
+  switch (rule.rule_case()) {
+    case v2::ReadModifyWriteRule::kIncrementAmount:
+      // The service treats the cell as a 64-bit two's complement integer, use
+      // unsigned arithmetic to get the same wrap around behavior.
+      last->set_increment_amount(static_cast<std::int64_t>(
+          static_cast<std::uint64_t>(last->increment_amount()) +
+          static_cast<std::uint64_t>(rule.increment_amount())));
+      return;
+    case v2::ReadModifyWriteRule::kAppendValue:
+      last->mutable_append_value()->append(rule.append_value());
+      return;
+    default:
+      rules.push_back(std::move(rule));
+      return;
+  }
+}
+
+future<StatusOr<bigtable::Row>> ReadModifyWriteCoalescer::Apply(
+    std::string row_key, v2::ReadModifyWriteRule rule) {
+  promise<StatusOr<bigtable::Row>> p;
+  auto f = p.get_future();
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& state = rows_[row_key];
+  if (state.pending.empty()) state.pending.emplace_back();
+  auto* batch = &state.pending.back();
+  MergeReadModifyWriteRule(batch->rules, std::move(rule));
+  if (batch->rules.size() > max_operations_per_row_) {
+    // The rule was not merged, and does not fit in the batch.
+    Batch next;
+    next.rules.push_back(std::move(batch->rules.back()));
+    batch->rules.pop_back();
+    state.pending.push_back(std::move(next));
+    batch = &state.pending.back();
+  }
+  batch->waiters.push_back(std::move(p));
+  // Any operations received while a request is in flight are sent when the
+  // request completes.
+  if (state.in_flight) return f;
+
+  auto const size = state.pending.front().waiters.size();
+  if (state.pending.size() > 1 || size >= max_operations_per_row_ ||
+      max_hold_time_ == std::chrono::milliseconds(0)) {
+    auto r = TakeBatch(row_key, state);
+    lk.unlock();
+    if (r) Send(*std::move(r));
+    return f;
+  }
+  if (size != 1) return f;
+  auto const generation = state.generation;
+  lk.unlock();
+  cq_.MakeRelativeTimer(max_hold_time_)
+      .then([self = shared_from_this(), row_key = std::move(row_key),
+             generation](auto) { self->OnTimer(row_key, generation); });
+  return f;
+}
+
+void ReadModifyWriteCoalescer::Flush() {
+  std::vector<Request> requests;
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto& kv : rows_) {
+    if (kv.second.in_flight) continue;
+    auto r = TakeBatch(kv.first, kv.second);
+    if (r) requests.push_back(*std::move(r));
+  }
+  lk.unlock();
+  for (auto& r : requests) Send(std::move(r));
+}
+
+std::optional<ReadModifyWriteCoalescer::Request>
+ReadModifyWriteCoalescer::TakeBatch(std::string const& row_key,
+                                    RowState& state) {
+  if (state.pending.empty()) return std::nullopt;
+  auto& batch = state.pending.front();
+  Request r;
+  r.request.set_row_key(row_key);
+  for (auto& rule : batch.rules) {
+    *r.request.add_rules() = std::move(rule);
+  }
+  r.waiters = std::move(batch.waiters);
+  state.pending.pop_front();
+  // Invalidate any timers set for the batch we are about to send.
+  ++state.generation;
+  state.in_flight = true;
+  return r;
+}
+
+void ReadModifyWriteCoalescer::Send(Request r) {
+  auto row_key = r.request.row_key();
+  apply_(std::move(r.request))
+      .then([self = shared_from_this(), row_key = std::move(row_key),
+             waiters = std::move(r.waiters)](
+                future<StatusOr<bigtable::Row>> f) mutable {
+        self->OnDone(row_key, std::move(waiters), f.get());
+      });
+}
+
+void ReadModifyWriteCoalescer::OnTimer(std::string const& row_key,
+                                       std::uint64_t generation) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto i = rows_.find(row_key);
+  if (i == rows_.end() || i->second.in_flight ||
+      i->second.generation != generation) {
+    return;
+  }
+  auto r = TakeBatch(row_key, i->second);
+  lk.unlock();
+  if (r) Send(*std::move(r));
+}
+
+void ReadModifyWriteCoalescer::OnDone(
+    std::string const& row_key,
+    std::vector<promise<StatusOr<bigtable::Row>>> waiters,
+    StatusOr<bigtable::Row> const& result) {
+  for (auto& w : waiters) w.set_value(result);
+
+  std::unique_lock<std::mutex> lk(mu_);
+  auto i = rows_.find(row_key);
+  if (i == rows_.end()) return;
+  i->second.in_flight = false;
+  auto r = TakeBatch(row_key, i->second);
+  if (!r) {
+    rows_.erase(i);
+    return;
+  }
+  lk.unlock();
+  Send(*std::move(r));
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+}  // namespace cloud
+}  // namespace google
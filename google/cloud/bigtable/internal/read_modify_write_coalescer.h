@@ -0,0 +1,134 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_MODIFY_WRITE_COALESCER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_MODIFY_WRITE_COALESCER_H
+
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include "google/bigtable/v2/bigtable.pb.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Merge @p rule into the list of rules for a single row.
+ *
+ * If the last rule for the same column has the same kind (increment or
+ * append) the two are combined: increments are summed and appends are
+ * concatenated. Otherwise @p rule is added at the end of @p rules, which
+ * preserves the relative order of operations on each column.
+ */
+void MergeReadModifyWriteRule(
+    std::vector<google::bigtable::v2::ReadModifyWriteRule>& rules,
+    google::bigtable::v2::ReadModifyWriteRule rule);
+
+/**
+ * Combines `ReadModifyWriteRow` operations on the same row into one RPC.
+ *
+ * Operations are buffered per row key. A buffer is sent when it holds
+ * `max_operations_per_row` operations, when `max_hold_time` elapses after its
+ * first operation, or when `Flush()` is called. At most one RPC per row is in
+ * flight at a time, so appends are applied in the order they were received.
+ * Operations that arrive while an RPC is in flight are sent as soon as it
+ * completes.
+ *
+ * Each RPC has at most `max_operations_per_row` rules, after merging the
+ * rules for the same column. Any other buffered operations for the row are
+ * sent in the following RPCs.
+ *
+ * All the operations combined into one RPC are satisfied with the same result,
+ * that is, the contents of the modified cells after all the operations are
+ * applied.
+ */
+class ReadModifyWriteCoalescer
+    : public std::enable_shared_from_this<ReadModifyWriteCoalescer> {
+ public:
+  using ApplyFunction = std::function<future<StatusOr<bigtable::Row>>(
+      google::bigtable::v2::ReadModifyWriteRowRequest)>;
+
+  ReadModifyWriteCoalescer(CompletionQueue cq, ApplyFunction apply,
+                           std::size_t max_operations_per_row,
+                           std::chrono::milliseconds max_hold_time)
+      : cq_(std::move(cq)),
+        apply_(std::move(apply)),
+        max_operations_per_row_(max_operations_per_row),
+        max_hold_time_(max_hold_time) {}
+
+  future<StatusOr<bigtable::Row>> Apply(
+      std::string row_key, google::bigtable::v2::ReadModifyWriteRule rule);
+
+  /// Send all the buffered operations that are not waiting on another RPC.
+  void Flush();
+
+ private:
+  struct Batch {
+    std::vector<google::bigtable::v2::ReadModifyWriteRule> rules;
+    std::vector<promise<StatusOr<bigtable::Row>>> waiters;
+  };
+
+  struct RowState {
+    // The buffered operations, each batch with at most
+    // `max_operations_per_row_` rules.
+    std::deque<Batch> pending;
+    // Invalidates the timers set for batches that were already sent.
+    std::uint64_t generation = 0;
+    bool in_flight = false;
+  };
+
+  struct Request {
+    google::bigtable::v2::ReadModifyWriteRowRequest request;
+    std::vector<promise<StatusOr<bigtable::Row>>> waiters;
+  };
+
+  /// Take the first pending batch for @p row_key. Must be called with `mu_`
+  /// held.
+  static std::optional<Request> TakeBatch(std::string const& row_key,
+                                           RowState& state);
+  void Send(Request r);
+  void OnTimer(std::string const& row_key, std::uint64_t generation);
+  void OnDone(std::string const& row_key,
+              std::vector<promise<StatusOr<bigtable::Row>>> waiters,
+              StatusOr<bigtable::Row> const& result);
+
+  CompletionQueue cq_;
+  ApplyFunction apply_;
+  std::size_t const max_operations_per_row_;
+  std::chrono::milliseconds const max_hold_time_;
+
+  std::mutex mu_;
+  std::unordered_map<std::string, RowState> rows_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_MODIFY_WRITE_COALESCER_H
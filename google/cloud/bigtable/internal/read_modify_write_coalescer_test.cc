@@ -0,0 +1,288 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/read_modify_write_coalescer.h"
+#include "google/cloud/testing_util/is_proto_equal.h"
+#include "google/cloud/testing_util/mock_completion_queue_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <deque>
+#include <limits>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace v2 = ::google::bigtable::v2;
+using ::google::cloud::testing_util::IsOkAndHolds;
+using ::google::cloud::testing_util::IsProtoEqual;
+using ::google::cloud::testing_util::MockCompletionQueueImpl;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::MockFunction;
+using ::testing::Property;
+
+using TimerPromise = promise<StatusOr<std::chrono::system_clock::time_point>>;
+
+v2::ReadModifyWriteRule Increment(std::string column, std::int64_t amount) {
+  v2::ReadModifyWriteRule r;
+  r.set_family_name("fam");
+  r.set_column_qualifier(std::move(column));
+  r.set_increment_amount(amount);
+  return r;
+}
+
+v2::ReadModifyWriteRule Append(std::string column, std::string value) {
+  v2::ReadModifyWriteRule r;
+  r.set_family_name("fam");
+  r.set_column_qualifier(std::move(column));
+  r.set_append_value(std::move(value));
+  return r;
+}
+
+bigtable::Row TestRow(std::string row_key) {
+  return bigtable::Row(std::move(row_key),
+                       {bigtable::Cell("row", "fam", "c1", 0, "v")});
+}
+
+auto RowKeyIs(std::string const& row_key) {
+  return IsOkAndHolds(Property(&bigtable::Row::row_key, row_key));
+}
+
+TEST(MergeReadModifyWriteRule, SumsIncrements) {
+  std::vector<v2::ReadModifyWriteRule> rules;
+  MergeReadModifyWriteRule(rules, Increment("c1", 1));
+  MergeReadModifyWriteRule(rules, Increment("c2", 10));
+  MergeReadModifyWriteRule(rules, Increment("c1", 2));
+  MergeReadModifyWriteRule(rules, Increment("c1", -5));
+  EXPECT_THAT(rules, ElementsAre(IsProtoEqual(Increment("c1", -2)),
+                                 IsProtoEqual(Increment("c2", 10))));
+}
+
+TEST(MergeReadModifyWriteRule, IncrementWrapsAround) {
+  std::vector<v2::ReadModifyWriteRule> rules;
+  MergeReadModifyWriteRule(
+      rules, Increment("c1", std::numeric_limits<std::int64_t>::max()));
+  MergeReadModifyWriteRule(rules, Increment("c1", 1));
+  EXPECT_THAT(rules, ElementsAre(IsProtoEqual(Increment(
+                         "c1", std::numeric_limits<std::int64_t>::min()))));
+}
+
+TEST(MergeReadModifyWriteRule, ConcatenatesAppends) {
+  std::vector<v2::ReadModifyWriteRule> rules;
+  MergeReadModifyWriteRule(rules, Append("c1", "a"));
+  MergeReadModifyWriteRule(rules, Append("c2", "x"));
+  MergeReadModifyWriteRule(rules, Append("c1", "b"));
+  MergeReadModifyWriteRule(rules, Append("c1", "c"));
+  EXPECT_THAT(rules, ElementsAre(IsProtoEqual(Append("c1", "abc")),
+                                 IsProtoEqual(Append("c2", "x"))));
+}
+
+TEST(MergeReadModifyWriteRule, PreservesOrderForMixedRules) {
+  std::vector<v2::ReadModifyWriteRule> rules;
+  MergeReadModifyWriteRule(rules, Increment("c1", 1));
+  MergeReadModifyWriteRule(rules, Append("c1", "a"));
+  MergeReadModifyWriteRule(rules, Increment("c1", 2));
+  MergeReadModifyWriteRule(rules, Increment("c1", 3));
+  EXPECT_THAT(rules, ElementsAre(IsProtoEqual(Increment("c1", 1)),
+                                 IsProtoEqual(Append("c1", "a")),
+                                 IsProtoEqual(Increment("c1", 5))));
+}
+
+TEST(ReadModifyWriteCoalescer, FlushOnCount) {
+  auto mock_cq = std::make_shared<MockCompletionQueueImpl>();
+  TimerPromise timer;
+  EXPECT_CALL(*mock_cq, MakeRelativeTimer)
+      .WillOnce([&timer](auto) { return timer.get_future(); });
+
+  MockFunction<future<StatusOr<bigtable::Row>>(v2::ReadModifyWriteRowRequest)>
+      mock;
+  EXPECT_CALL(mock, Call).WillOnce([](v2::ReadModifyWriteRowRequest const& r) {
+    EXPECT_EQ(r.row_key(), "row");
+    EXPECT_THAT(r.rules(), ElementsAre(IsProtoEqual(Increment("c1", 6))));
+    return make_ready_future(make_status_or(TestRow("row")));
+  });
+
+  auto coalescer = std::make_shared<ReadModifyWriteCoalescer>(
+      CompletionQueue(mock_cq), mock.AsStdFunction(), 3,
+      std::chrono::milliseconds(10));
+  auto f1 = coalescer->Apply("row", Increment("c1", 1));
+  auto f2 = coalescer->Apply("row", Increment("c1", 2));
+  EXPECT_EQ(f1.wait_for(std::chrono::milliseconds(0)),
+            std::future_status::timeout);
+  auto f3 = coalescer->Apply("row", Increment("c1", 3));
+  EXPECT_THAT(f1.get(), RowKeyIs("row"));
+  EXPECT_THAT(f2.get(), RowKeyIs("row"));
+  EXPECT_THAT(f3.get(), RowKeyIs("row"));
+
+  // A stale timer does not send an empty request.
+  timer.set_value(std::chrono::system_clock::now());
+}
+
+TEST(ReadModifyWriteCoalescer, FlushOnTimer) {
+  auto mock_cq = std::make_shared<MockCompletionQueueImpl>();
+  std::deque<TimerPromise> timers;
+  EXPECT_CALL(*mock_cq, MakeRelativeTimer).Times(2).WillRepeatedly([&](auto) {
+    timers.emplace_back();
+    return timers.back().get_future();
+  });
+
+  MockFunction<future<StatusOr<bigtable::Row>>(v2::ReadModifyWriteRowRequest)>
+      mock;
+  EXPECT_CALL(mock, Call).Times(2).WillRepeatedly(
+      [](v2::ReadModifyWriteRowRequest const& r) {
+        EXPECT_THAT(r.rules(), ElementsAre(IsProtoEqual(Append("c1", "ab"))));
+        return make_ready_future(make_status_or(TestRow(r.row_key())));
+      });
+
+  auto coalescer = std::make_shared<ReadModifyWriteCoalescer>(
+      CompletionQueue(mock_cq), mock.AsStdFunction(), 100,
+      std::chrono::milliseconds(10));
+  auto r1a = coalescer->Apply("r1", Append("c1", "a"));
+  auto r2a = coalescer->Apply("r2", Append("c1", "a"));
+  auto r1b = coalescer->Apply("r1", Append("c1", "b"));
+  auto r2b = coalescer->Apply("r2", Append("c1", "b"));
+  ASSERT_EQ(timers.size(), 2);
+
+  timers[0].set_value(std::chrono::system_clock::now());
+  EXPECT_THAT(r1a.get(), RowKeyIs("r1"));
+  EXPECT_THAT(r1b.get(), RowKeyIs("r1"));
+  EXPECT_EQ(r2a.wait_for(std::chrono::milliseconds(0)),
+            std::future_status::timeout);
+
+  timers[1].set_value(std::chrono::system_clock::now());
+  EXPECT_THAT(r2a.get(), RowKeyIs("r2"));
+  EXPECT_THAT(r2b.get(), RowKeyIs("r2"));
+}
+
+TEST(ReadModifyWriteCoalescer, OneRequestInFlightPerRow) {
+  auto mock_cq = std::make_shared<MockCompletionQueueImpl>();
+  EXPECT_CALL(*mock_cq, MakeRelativeTimer).Times(0);
+
+  std::deque<promise<StatusOr<bigtable::Row>>> responses;
+  MockFunction<future<StatusOr<bigtable::Row>>(v2::ReadModifyWriteRowRequest)>
+      mock;
+  ::testing::InSequence sequence;
+  EXPECT_CALL(mock, Call).WillOnce([&](v2::ReadModifyWriteRowRequest const& r) {
+    EXPECT_THAT(r.rules(), ElementsAre(IsProtoEqual(Append("c1", "a"))));
+    responses.emplace_back();
+    return responses.back().get_future();
+  });
+  EXPECT_CALL(mock, Call).WillOnce([&](v2::ReadModifyWriteRowRequest const& r) {
+    EXPECT_THAT(r.rules(), ElementsAre(IsProtoEqual(Append("c1", "bc"))));
+    responses.emplace_back();
+    return responses.back().get_future();
+  });
+
+  // A zero hold time sends each operation immediately, unless a request for
+  // the same row is already in flight.
+  auto coalescer = std::make_shared<ReadModifyWriteCoalescer>(
+      CompletionQueue(mock_cq), mock.AsStdFunction(), 100,
+      std::chrono::milliseconds(0));
+  auto fa = coalescer->Apply("row", Append("c1", "a"));
+  auto fb = coalescer->Apply("row", Append("c1", "b"));
+  auto fc = coalescer->Apply("row", Append("c1", "c"));
+  ASSERT_EQ(responses.size(), 1);
+
+  responses[0].set_value(Status(StatusCode::kUnavailable, "try-again"));
+  EXPECT_THAT(fa.get(), StatusIs(StatusCode::kUnavailable));
+  ASSERT_EQ(responses.size(), 2);
+
+  responses[1].set_value(TestRow("row"));
+  EXPECT_THAT(fb.get(), RowKeyIs("row"));
+  EXPECT_THAT(fc.get(), RowKeyIs("row"));
+}
+
+TEST(ReadModifyWriteCoalescer, CapsRulesPerRequest) {
+  auto mock_cq = std::make_shared<MockCompletionQueueImpl>();
+  EXPECT_CALL(*mock_cq, MakeRelativeTimer).Times(0);
+
+  std::deque<promise<StatusOr<bigtable::Row>>> responses;
+  std::vector<v2::ReadModifyWriteRowRequest> requests;
+  MockFunction<future<StatusOr<bigtable::Row>>(v2::ReadModifyWriteRowRequest)>
+      mock;
+  EXPECT_CALL(mock, Call).Times(4).WillRepeatedly(
+      [&](v2::ReadModifyWriteRowRequest const& r) {
+        requests.push_back(r);
+        responses.emplace_back();
+        return responses.back().get_future();
+      });
+
+  auto coalescer = std::make_shared<ReadModifyWriteCoalescer>(
+      CompletionQueue(mock_cq), mock.AsStdFunction(), 2,
+      std::chrono::milliseconds(0));
+  auto first = coalescer->Apply("row", Increment("c0", 1));
+  ASSERT_EQ(requests.size(), 1);
+
+  // Flood the row with operations on distinct columns while the first request
+  // is in flight.
+  std::vector<future<StatusOr<bigtable::Row>>> flood;
+  for (auto const* column : {"c1", "c2", "c3", "c1", "c4", "c5"}) {
+    flood.push_back(coalescer->Apply("row", Increment(column, 1)));
+  }
+  ASSERT_EQ(requests.size(), 1);
+
+  responses[0].set_value(TestRow("row"));
+  EXPECT_THAT(first.get(), RowKeyIs("row"));
+  ASSERT_EQ(requests.size(), 2);
+  EXPECT_THAT(requests[1].rules(),
+              ElementsAre(IsProtoEqual(Increment("c1", 1)),
+                          IsProtoEqual(Increment("c2", 1))));
+
+  responses[1].set_value(TestRow("row"));
+  ASSERT_EQ(requests.size(), 3);
+  EXPECT_THAT(requests[2].rules(),
+              ElementsAre(IsProtoEqual(Increment("c3", 1)),
+                          IsProtoEqual(Increment("c1", 1))));
+
+  responses[2].set_value(TestRow("row"));
+  ASSERT_EQ(requests.size(), 4);
+  EXPECT_THAT(requests[3].rules(),
+              ElementsAre(IsProtoEqual(Increment("c4", 1)),
+                          IsProtoEqual(Increment("c5", 1))));
+
+  responses[3].set_value(TestRow("row"));
+  for (auto& f : flood) EXPECT_THAT(f.get(), RowKeyIs("row"));
+}
+
+TEST(ReadModifyWriteCoalescer, Flush) {
+  auto mock_cq = std::make_shared<MockCompletionQueueImpl>();
+  TimerPromise timer;
+  EXPECT_CALL(*mock_cq, MakeRelativeTimer)
+      .WillOnce([&timer](auto) { return timer.get_future(); });
+
+  MockFunction<future<StatusOr<bigtable::Row>>(v2::ReadModifyWriteRowRequest)>
+      mock;
+  EXPECT_CALL(mock, Call).WillOnce([](v2::ReadModifyWriteRowRequest const& r) {
+    EXPECT_THAT(r.rules(), ElementsAre(IsProtoEqual(Increment("c1", 42))));
+    return make_ready_future(make_status_or(TestRow(r.row_key())));
+  });
+
+  auto coalescer = std::make_shared<ReadModifyWriteCoalescer>(
+      CompletionQueue(mock_cq), mock.AsStdFunction(), 100,
+      std::chrono::milliseconds(10));
+  auto f = coalescer->Apply("row", Increment("c1", 42));
+  coalescer->Flush();
+  EXPECT_THAT(f.get(), RowKeyIs("row"));
+
+  timer.set_value(std::chrono::system_clock::now());
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+}  // namespace cloud
+}  // namespace google
@@ -133,6 +133,15 @@ class MockDataConnection : public bigtable::DataConnection {
 
   MOCK_METHOD(bigtable::RowStream, ExecuteQuery,
               (bigtable::ExecuteQueryParams params), (override));
+
+  MOCK_METHOD(StatusOr<std::vector<google::bigtable::v2::StreamPartition>>,
+              GenerateInitialChangeStreamPartitions,
+              (std::string const& table_name), (override));
+
+  MOCK_METHOD(StreamRange<google::bigtable::v2::ReadChangeStreamResponse>,
+              ReadChangeStream,
+              (google::bigtable::v2::ReadChangeStreamRequest request),
+              (override));
 };
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
@@ -47,6 +47,8 @@
 #include "google/cloud/grpc_options.h"
 #include "google/cloud/options.h"
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -176,6 +178,40 @@ struct QueryPlanRefreshFunctionRetryPolicyOption {
   using Type = std::shared_ptr<DataRetryPolicy>;
 };
 
+/**
+ * Merge the mutations for the same row in `BulkApply()` and `AsyncBulkApply()`.
+ *
+ * When enabled, all the mutations for a row in a `BulkMutation` are sent as a
+ * single entry, in their original order. `SetCell` mutations that are deleted
+ * by a later mutation in the same batch are not sent. The service may apply
+ * the entries of a batch in any order, so this does not change the semantics
+ * of the batch, but the merged mutations succeed or fail as a unit. A failure
+ * is reported for each of the original `SingleRowMutation`s.
+ *
+ * The default is `false`.
+ */
+struct MergeRowMutationsOption {
+  using Type = bool;
+};
+
+/**
+ * Share prepared query plans across all the connections in the process.
+ *
+ * `PrepareQuery()` and `AsyncPrepareQuery()` look up the plan in a process-wide
+ * cache, keyed by the endpoint, credentials, instance, app profile, SQL
+ * statement, and parameter types. Only connections with the same endpoint and
+ * credentials object share plans. Concurrent calls for the same query share a
+ * single `PrepareQuery` RPC, and cached plans are refreshed in the background
+ * before they expire.
+ *
+ * The value is the maximum number of plans kept in the cache, the least
+ * recently used plans are evicted first. The default is 0, which disables the
+ * cache.
+ */
+struct QueryPlanCacheSizeOption {
+  using Type = std::size_t;
+};
+
 /**
  * If `MakeDataConnection(std::vector<InstanceResource>, Options)` is called,
  * then all connections will be managed by a Dynamic Channel Pool. The
@@ -213,6 +249,46 @@ struct DynamicChannelPoolSizingPolicyOption {
   using Type = DynamicChannelPoolSizingPolicy;
 };
 
+/**
+ * Configures latency-aware channel selection in the Dynamic Channel Pool.
+ *
+ * By default the pool picks the less loaded of two random channels. With this
+ * policy each channel also tracks an exponentially weighted moving average of
+ * its RPC latency and error rate, and the pool picks the channel with the
+ * lower cost, where the cost grows with the latency, the number of outstanding
+ * RPCs, and the error rate. Channels without latency samples are compared by
+ * load only.
+ *
+ * Channels that remain much slower than the rest of the pool are replaced
+ * with new channels.
+ */
+struct LatencyAwareChannelSelectionPolicy {
+  // Scales the cost of a channel by `1 + error_rate_penalty * error_rate`.
+  double error_rate_penalty = 10.0;
+
+  // How often the pool looks for slow channels.
+  std::chrono::milliseconds slow_channel_check_interval =
+      std::chrono::seconds(10);
+
+  // A channel is replaced if its average latency is higher than this factor
+  // times the median latency of the pool.
+  double slow_channel_latency_factor = 3.0;
+
+  // Only channels with at least this many latency samples are considered for
+  // replacement.
+  std::int64_t minimum_samples_for_replacement = 100;
+};
+
+/**
+ * Enables latency-aware channel selection in the Dynamic Channel Pool.
+ *
+ * This option only has an effect if the connection uses a Dynamic Channel
+ * Pool, see `DynamicChannelPoolSizingPolicy`.
+ */
+struct LatencyAwareChannelSelectionOption {
+  using Type = LatencyAwareChannelSelectionPolicy;
+};
+
 enum class DirectPathMode {
   kDisabled,  // Default.
   kEnabled,
@@ -332,7 +408,10 @@ using DataPolicyOptionList =
     OptionList<DataRetryPolicyOption, DataBackoffPolicyOption, DeadlineOption,
                IdempotentMutationPolicyOption, EnableMetricsOption,
                MetricsPeriodOption,
-               experimental::DynamicChannelPoolSizingPolicyOption>;
+               experimental::DynamicChannelPoolSizingPolicyOption,
+               experimental::LatencyAwareChannelSelectionOption,
+               experimental::MergeRowMutationsOption,
+               experimental::QueryPlanCacheSizeOption>;
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace bigtable
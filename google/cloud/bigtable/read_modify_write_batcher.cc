@@ -0,0 +1,64 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_modify_write_batcher.h"
+#include "google/cloud/bigtable/internal/read_modify_write_coalescer.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+// Cloud Bigtable doesn't accept more than this many rules in a single request.
+auto constexpr kBigtableRulesLimit = 100000;
+auto constexpr kDefaultMaxOperationsPerRow = 1000;
+auto constexpr kDefaultMaxHoldTime = std::chrono::milliseconds(10);
+
+ReadModifyWriteBatcher::Options::Options()
+    : max_operations_per_row(kDefaultMaxOperationsPerRow),
+      max_hold_time(kDefaultMaxHoldTime) {}
+
+ReadModifyWriteBatcher::Options&
+ReadModifyWriteBatcher::Options::SetMaxOperationsPerRow(
+    std::size_t max_operations_per_row_arg) {
+  max_operations_per_row = (std::max<std::size_t>)(
+      1, (std::min<std::size_t>)(max_operations_per_row_arg,
+                                 kBigtableRulesLimit));
+  return *this;
+}
+
+ReadModifyWriteBatcher::ReadModifyWriteBatcher(Table table, CompletionQueue cq,
+                                               Options options)
+    : impl_(std::make_shared<bigtable_internal::ReadModifyWriteCoalescer>(
+          std::move(cq),
+          [table = std::move(table)](
+              google::bigtable::v2::ReadModifyWriteRowRequest request) mutable {
+            return table.AsyncReadModifyWriteRowImpl(std::move(request), {});
+          },
+          options.max_operations_per_row, options.max_hold_time)) {}
+
+ReadModifyWriteBatcher::~ReadModifyWriteBatcher() { impl_->Flush(); }
+
+future<StatusOr<Row>> ReadModifyWriteBatcher::AsyncReadModifyWriteRow(
+    std::string row_key, ReadModifyWriteRule rule) {
+  return impl_->Apply(std::move(row_key), std::move(rule).as_proto());
+}
+
+void ReadModifyWriteBatcher::Flush() { impl_->Flush(); }
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
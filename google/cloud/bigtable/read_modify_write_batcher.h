@@ -0,0 +1,124 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_MODIFY_WRITE_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_MODIFY_WRITE_BATCHER_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/read_modify_write_rule.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+class ReadModifyWriteCoalescer;
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+namespace bigtable {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+/**
+ * Objects of this class combine `ReadModifyWriteRow` operations on hot rows.
+ *
+ * Applications that increment the same counters many times per second send
+ * one `ReadModifyWriteRow` RPC per increment, which can create hotspots in the
+ * service. This class buffers the operations for each row and sends them as a
+ * single RPC: increments to the same column are summed, and appends to the
+ * same column are concatenated in the order they were received.
+ *
+ * A row's buffer is sent when it holds `max_operations_per_row` operations, or
+ * when `max_hold_time` elapses after the first operation in the buffer. At
+ * most one RPC per row is outstanding, operations received while it runs are
+ * sent in the next RPC.
+ *
+ * @note All the operations combined in a single RPC are satisfied with the
+ *     same `Row`, which contains the values of the modified cells after *all*
+ *     of these operations are applied. Applications cannot observe the
+ *     intermediate values.
+ *
+ * @par Idempotency
+ * The combined operations are not idempotent, and are not retried.
+ *
+ * @par Thread-safety
+ * Instances of this class are guaranteed to work when accessed concurrently
+ * from multiple threads.
+ *
+ * @code
+ * bigtable::CompletionQueue cq;
+ * std::thread cq_runner([&cq]() { cq.Run(); });
+ * bigtable::ReadModifyWriteBatcher batcher(table, cq);
+ * auto f = batcher.AsyncReadModifyWriteRow(
+ *     "counter-row", bigtable::ReadModifyWriteRule::IncrementAmount(
+ *                        "fam", "hits", 1));
+ * @endcode
+ */
+class ReadModifyWriteBatcher {
+ public:
+  /// Configuration for `ReadModifyWriteBatcher`.
+  struct Options {
+    Options();
+
+    /// A row's operations are sent once this many are buffered.
+    Options& SetMaxOperationsPerRow(std::size_t max_operations_per_row_arg);
+
+    /**
+     * Operations are buffered at most this long before they are sent.
+     *
+     * A zero value disables the timer, operations are only combined while
+     * a previous RPC for the same row is outstanding.
+     */
+    Options& SetMaxHoldTime(std::chrono::milliseconds max_hold_time_arg) {
+      max_hold_time = max_hold_time_arg;
+      return *this;
+    }
+
+    std::size_t max_operations_per_row;
+    std::chrono::milliseconds max_hold_time;
+  };
+
+  ReadModifyWriteBatcher(Table table, CompletionQueue cq,
+                         Options options = Options());
+
+  /// Sends any buffered operations.
+  ~ReadModifyWriteBatcher();
+
+  /**
+   * Asynchronously apply @p rule to the row @p row_key.
+   *
+   * @returns a future satisfied with the contents of all the cells modified by
+   *     the RPC that included this operation.
+   */
+  future<StatusOr<Row>> AsyncReadModifyWriteRow(std::string row_key,
+                                                ReadModifyWriteRule rule);
+
+  /// Send all buffered operations without waiting for `max_hold_time`.
+  void Flush();
+
+ private:
+  std::shared_ptr<bigtable_internal::ReadModifyWriteCoalescer> impl_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_MODIFY_WRITE_BATCHER_H
@@ -0,0 +1,86 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_modify_write_batcher.h"
+#include "google/cloud/bigtable/mocks/mock_data_connection.h"
+#include "google/cloud/testing_util/mock_completion_queue_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace v2 = ::google::bigtable::v2;
+using ::google::cloud::bigtable_mocks::MockDataConnection;
+using ::google::cloud::testing_util::MockCompletionQueueImpl;
+using ::testing::Return;
+
+auto const* const kTableName =
+    "projects/test-project/instances/test-instance/tables/test-table";
+
+TEST(ReadModifyWriteBatcherOptions, Defaults) {
+  ReadModifyWriteBatcher::Options options;
+  EXPECT_LT(0, options.max_operations_per_row);
+  EXPECT_LT(std::chrono::milliseconds(0), options.max_hold_time);
+
+  options.SetMaxOperationsPerRow(0);
+  EXPECT_EQ(1, options.max_operations_per_row);
+}
+
+TEST(ReadModifyWriteBatcher, CombinesIncrements) {
+  auto mock = std::make_shared<MockDataConnection>();
+  EXPECT_CALL(*mock, options).WillRepeatedly(Return(Options{}));
+  EXPECT_CALL(*mock, AsyncReadModifyWriteRow)
+      .WillOnce([](v2::ReadModifyWriteRowRequest const& request) {
+        EXPECT_EQ(kTableName, request.table_name());
+        EXPECT_EQ("test-profile", request.app_profile_id());
+        EXPECT_EQ("row", request.row_key());
+        EXPECT_EQ(1, request.rules_size());
+        EXPECT_EQ(3, request.rules(0).increment_amount());
+        return make_ready_future(make_status_or(
+            Row("row", {Cell("row", "fam", "col", 0, std::int64_t{3})})));
+      });
+
+  auto mock_cq = std::make_shared<MockCompletionQueueImpl>();
+  promise<StatusOr<std::chrono::system_clock::time_point>> timer;
+  EXPECT_CALL(*mock_cq, MakeRelativeTimer)
+      .WillOnce([&timer](auto) { return timer.get_future(); });
+
+  auto table = Table(mock, TableResource("test-project", "test-instance",
+                                         "test-table"),
+                     Options{}.set<AppProfileIdOption>("test-profile"));
+  ReadModifyWriteBatcher batcher(
+      std::move(table), CompletionQueue(mock_cq),
+      ReadModifyWriteBatcher::Options{}.SetMaxOperationsPerRow(2));
+  auto f1 = batcher.AsyncReadModifyWriteRow(
+      "row", ReadModifyWriteRule::IncrementAmount("fam", "col", 1));
+  auto f2 = batcher.AsyncReadModifyWriteRow(
+      "row", ReadModifyWriteRule::IncrementAmount("fam", "col", 2));
+  for (auto* f : {&f1, &f2}) {
+    auto row = f->get();
+    ASSERT_STATUS_OK(row);
+    EXPECT_EQ("row", row->row_key());
+    EXPECT_EQ(1, row->cells().size());
+  }
+  timer.set_value(std::chrono::system_clock::now());
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
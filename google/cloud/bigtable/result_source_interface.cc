@@ -0,0 +1,51 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/result_source_interface.h"
+#include "google/cloud/bigtable/internal/column_batch_builder.h"
+#include "google/cloud/internal/make_status.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+StatusOr<ColumnBatch> ResultSourceInterface::NextBatch(std::size_t max_rows) {
+  auto metadata = Metadata();
+  bigtable_internal::ColumnBatchBuilder builder(
+      metadata.value_or(google::bigtable::v2::ResultSetMetadata{}));
+  max_rows = (std::max<std::size_t>)(1, max_rows);
+  while (builder.num_rows() < max_rows) {
+    auto row = NextRow();
+    if (!row) return std::move(row).status();
+    if (row->size() == 0) break;
+    if (row->size() != builder.num_columns()) {
+      return google::cloud::internal::InternalError(
+          "The number of values in the row does not match the metadata",
+          GCP_ERROR_INFO());
+    }
+    auto values = std::move(*row).values();
+    for (std::size_t i = 0; i != values.size(); ++i) {
+      builder.Append(i, std::move(values[i]));
+    }
+    builder.FinishRow();
+  }
+  return std::move(builder).Build();
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -15,9 +15,11 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_RESULT_SOURCE_INTERFACE_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_RESULT_SOURCE_INTERFACE_H
 
+#include "google/cloud/bigtable/column_batch.h"
 #include "google/cloud/bigtable/query_row.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/status_or.h"
+#include <cstddef>
 #include <memory>
 
 namespace google {
@@ -52,6 +54,19 @@ class ResultSourceInterface {
    *     for more information.
    */
   virtual std::optional<google::bigtable::v2::ResultSetMetadata> Metadata() = 0;
+
+  /**
+   * Returns up to @p max_rows rows, stored by column.
+   *
+   * @return if the stream is interrupted due to a failure the
+   *   `StatusOr<bigtable::ColumnBatch>` contains the error. A batch with no
+   *   rows indicates end-of-stream.
+   *
+   * The default implementation gathers the rows returned by `NextRow()`.
+   * Implementations that receive `ProtoRows` should override it to decode the
+   * values without creating a `QueryRow` per row.
+   */
+  virtual StatusOr<bigtable::ColumnBatch> NextBatch(std::size_t max_rows);
 };
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
@@ -15,11 +15,13 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_STREAM_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_STREAM_H
 
+#include "google/cloud/bigtable/column_batch.h"
 #include "google/cloud/bigtable/query_row.h"
 #include "google/cloud/bigtable/result_source_interface.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/make_status.h"
 #include "google/cloud/status_or.h"
+#include <cstddef>
 #include <functional>
 #include <iterator>
 #include <memory>
@@ -114,6 +116,35 @@ class RowStream {
   /// Returns a `RowStreamIterator` defining the end of this range.
   static RowStreamIterator end() { return {}; }
 
+  /**
+   * Returns up to @p max_rows rows decoded into typed column buffers.
+   *
+   * This is an alternative to iterating over the stream for applications that
+   * process results in bulk. `STRING`, `BYTES`, `INT64`, `FLOAT32`, `FLOAT64`
+   * and `BOOL` values are decoded directly into the buffers of each
+   * `ColumnBuffer`, without creating a `QueryRow` or `Value` per cell.
+   *
+   * The batch may hold fewer than @p max_rows rows, as only the rows already
+   * received from the service are returned. A batch with no rows indicates
+   * the end of the stream. Do not mix calls to `NextBatch()` with iteration
+   * over the same stream.
+   *
+   * @par Example
+   * @code
+   * auto stream = client.ExecuteQuery(std::move(bound_query));
+   * for (;;) {
+   *   auto batch = stream.NextBatch(1024);
+   *   if (!batch) throw std::move(batch).status();
+   *   if (batch->num_rows() == 0) break;
+   *   auto const& ids = batch->column(0).int64_values();
+   *   ...
+   * }
+   * @endcode
+   */
+  StatusOr<ColumnBatch> NextBatch(std::size_t max_rows) {
+    return source_->NextBatch(max_rows);
+  }
+
  private:
   std::unique_ptr<ResultSourceInterface> source_;
 };
@@ -853,7 +853,9 @@ class Table {
   void ChangePolicies() {}
   ///@}
 
+  friend class ChangeStreamReader;
   friend class MutationBatcher;
+  friend class ReadModifyWriteBatcher;
   TableResource table_;
   std::string table_name_;
   std::shared_ptr<RPCRetryPolicy const> rpc_retry_policy_prototype_;
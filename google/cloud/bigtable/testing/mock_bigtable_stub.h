@@ -69,6 +69,21 @@ class MockBigtableStub : public bigtable_internal::BigtableStub {
                google::bigtable::v2::ReadModifyWriteRowRequest const&,
                bigtable_internal::OperationContext&),
               (override));
+  MOCK_METHOD(
+      std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+          google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse>>,
+      GenerateInitialChangeStreamPartitions,
+      (std::shared_ptr<grpc::ClientContext>, Options const&,
+       google::bigtable::v2::GenerateInitialChangeStreamPartitionsRequest const&,
+       std::shared_ptr<bigtable_internal::OperationContext>),
+      (override));
+  MOCK_METHOD(std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+                  google::bigtable::v2::ReadChangeStreamResponse>>,
+              ReadChangeStream,
+              (std::shared_ptr<grpc::ClientContext>, Options const&,
+               google::bigtable::v2::ReadChangeStreamRequest const&,
+               std::shared_ptr<bigtable_internal::OperationContext>),
+              (override));
   MOCK_METHOD(StatusOr<google::bigtable::v2::PrepareQueryResponse>,
               PrepareQuery,
               (grpc::ClientContext&, Options const&,
@@ -225,6 +240,30 @@ class MockExecuteQueryStream : public google::cloud::internal::StreamingReadRpc<
               (const, override));
 };
 
+class MockGenerateInitialChangeStreamPartitionsStream
+    : public google::cloud::internal::StreamingReadRpc<
+          google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse> {
+ public:
+  MOCK_METHOD(void, Cancel, (), (override));
+  MOCK_METHOD(
+      std::optional<Status>, Read,
+      (google::bigtable::v2::GenerateInitialChangeStreamPartitionsResponse*),
+      (override));
+  MOCK_METHOD(google::cloud::RpcMetadata, GetRequestMetadata, (),
+              (const, override));
+};
+
+class MockReadChangeStreamStream
+    : public google::cloud::internal::StreamingReadRpc<
+          google::bigtable::v2::ReadChangeStreamResponse> {
+ public:
+  MOCK_METHOD(void, Cancel, (), (override));
+  MOCK_METHOD(std::optional<Status>, Read,
+              (google::bigtable::v2::ReadChangeStreamResponse*), (override));
+  MOCK_METHOD(google::cloud::RpcMetadata, GetRequestMetadata, (),
+              (const, override));
+};
+
 using MockAsyncMutateRowsStream =
     google::cloud::testing_util::MockAsyncStreamingReadRpc<
         google::bigtable::v2::MutateRowsResponse>;
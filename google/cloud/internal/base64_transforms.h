@@ -102,6 +102,27 @@ Status ValidateBase64String(std::string const& input);
 StatusOr<std::vector<std::uint8_t>> Base64DecodeToBytes(
     std::string const& input);
 
+/// Returns the base64 encoding of the @p size octets at @p data.
+std::string Base64Encode(void const* data, std::size_t size);
+
+/**
+ * Returns the number of octets encoded by @p input.
+ *
+ * The result is exact when @p input is valid, and only its last 4-character
+ * chunk contains padding. Otherwise it is an upper bound.
+ */
+std::size_t Base64DecodedSize(std::string const& input);
+
+/**
+ * Decodes @p input into @p buffer, which must have room for at least
+ * `Base64DecodedSize(input)` octets.
+ *
+ * Returns the number of octets written, or an error if @p input is not valid
+ * base64, in which case the contents of @p buffer are unspecified.
+ */
+StatusOr<std::size_t> Base64DecodeInto(std::string const& input,
+                                       unsigned char* buffer);
+
 /**
  * Returns a Base64-encoded version of @p bytes. Using the URL- and
  * filesystem-safe alphabet, retaining trailing '=' padding characters.
@@ -143,6 +143,59 @@ TEST(Base64, ValidateBase64StringFailures) {
   }
 }
 
+TEST(Base64, BlockRoundTrip) {
+  // Cover all the remainders, and the 4-chunk fast path.
+  std::string plain;
+  for (int i = 0; i != 200; ++i) {
+    Base64Encoder enc;
+    for (auto c : plain) enc.PushBack(c);
+    auto const expected = std::move(enc).FlushAndPad();
+    auto const encoded = Base64Encode(plain.data(), plain.size());
+    EXPECT_EQ(encoded, expected) << "i=" << i;
+    EXPECT_EQ(Base64DecodedSize(encoded), plain.size());
+
+    std::string decoded(Base64DecodedSize(encoded), '\0');
+    auto n = Base64DecodeInto(
+        encoded, reinterpret_cast<unsigned char*>(&decoded[0]));
+    ASSERT_STATUS_OK(n);
+    EXPECT_EQ(*n, plain.size());
+    EXPECT_EQ(decoded, plain);
+    EXPECT_STATUS_OK(ValidateBase64String(encoded));
+
+    plain.push_back(static_cast<char>(i * 37));
+  }
+}
+
+TEST(Base64, DecodeIntoFailures) {
+  std::string const valid = "YWJjZGVmZ2hpamtsbW5vcHFyc3R1dnd4";
+  std::vector<unsigned char> buffer(Base64DecodedSize(valid));
+  // An invalid character in each position of the fast path.
+  for (std::size_t i = 0; i != valid.size(); ++i) {
+    auto input = valid;
+    input[i] = '.';
+    auto const offset = std::to_string(i / 4 * 4);
+    EXPECT_THAT(Base64DecodeInto(input, buffer.data()),
+                StatusIs(Not(StatusCode::kOk),
+                         ContainsRegex("Invalid base64.*at offset " + offset)));
+    EXPECT_THAT(ValidateBase64String(input),
+                StatusIs(Not(StatusCode::kOk),
+                         ContainsRegex("Invalid base64.*at offset " + offset)));
+  }
+  EXPECT_THAT(Base64DecodeInto(valid + "xx", buffer.data()),
+              StatusIs(Not(StatusCode::kOk),
+                       ContainsRegex("Invalid base64.*at offset 32")));
+}
+
+TEST(Base64, DecodeIntoInteriorPadding) {
+  // Accepted, as with the other decoders, though the size is only a bound.
+  std::string const input = "YQ==YWI=YWJj";
+  EXPECT_EQ(Base64DecodedSize(input), 9);
+  std::vector<unsigned char> buffer(Base64DecodedSize(input));
+  auto n = Base64DecodeInto(input, buffer.data());
+  ASSERT_STATUS_OK(n);
+  EXPECT_EQ(std::string(buffer.begin(), buffer.begin() + *n), "aababc");
+}
+
 TEST(Base64, UrlsafeBase64Encode) {
   // Produced input using:
   //     echo 'TG9yZ+W0gaXBz/dW1cMACg==' | openssl base64 -d | od -t x1
@@ -17,6 +17,7 @@
 
 #include "google/cloud/pubsub/version.h"
 #include <functional>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -24,6 +25,7 @@ namespace pubsub {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 class Message;
 class AckHandler;
+class BatchAckHandler;
 class ExactlyOnceAckHandler;
 
 /**
@@ -47,6 +49,19 @@ using ApplicationCallback = std::function<void(Message, AckHandler)>;
 using ExactlyOnceApplicationCallback =
     std::function<void(pubsub::Message, ExactlyOnceAckHandler)>;
 
+/**
+ * Defines the interface for application-level callbacks receiving batches of
+ * messages.
+ *
+ * Applications provide a callable compatible with this type to receive
+ * messages in batches, with a single dispatch for each batch.  They
+ * acknowledge (or reject) all the messages in the batch using
+ * `BatchAckHandler`.  This is a move-only type to support asynchronous
+ * acknowledgments.
+ */
+using BatchApplicationCallback =
+    std::function<void(std::vector<pubsub::Message>, BatchAckHandler)>;
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace pubsub
 }  // namespace cloud
@@ -0,0 +1,69 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/batch_ack_handler.h"
+#include "google/cloud/pubsub/mocks/mock_batch_ack_handler.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace pubsub {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::testing::Return;
+
+TEST(BatchAckHandlerTest, AutoNack) {
+  auto mock = std::make_unique<pubsub_mocks::MockBatchAckHandler>();
+  EXPECT_CALL(*mock, nack()).Times(1);
+  { BatchAckHandler handler(std::move(mock)); }
+}
+
+TEST(BatchAckHandlerTest, AutoNackMove) {
+  auto mock = std::make_unique<pubsub_mocks::MockBatchAckHandler>();
+  EXPECT_CALL(*mock, ack()).Times(1);
+  {
+    BatchAckHandler handler(std::move(mock));
+    BatchAckHandler moved = std::move(handler);
+    std::move(moved).ack();
+  }
+}
+
+TEST(BatchAckHandlerTest, Size) {
+  auto mock = std::make_unique<pubsub_mocks::MockBatchAckHandler>();
+  EXPECT_CALL(*mock, size()).WillOnce(Return(42));
+  EXPECT_CALL(*mock, nack()).Times(1);
+  BatchAckHandler handler(std::move(mock));
+  EXPECT_EQ(42, handler.size());
+}
+
+TEST(BatchAckHandlerTest, Ack) {
+  auto mock = std::make_unique<pubsub_mocks::MockBatchAckHandler>();
+  EXPECT_CALL(*mock, ack()).Times(1);
+  BatchAckHandler handler(std::move(mock));
+  ASSERT_NO_FATAL_FAILURE(std::move(handler).ack());
+}
+
+TEST(BatchAckHandlerTest, Nack) {
+  auto mock = std::make_unique<pubsub_mocks::MockBatchAckHandler>();
+  EXPECT_CALL(*mock, nack()).Times(1);
+  BatchAckHandler handler(std::move(mock));
+  ASSERT_NO_FATAL_FAILURE(std::move(handler).nack());
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,982 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/defaults.h"
+#include "google/cloud/pubsub/message.h"
+#include "google/cloud/pubsub/options.h"
+#include "google/cloud/pubsub/publisher.h"
+#include "google/cloud/pubsub/publisher_connection.h"
+#include "google/cloud/pubsub/subscriber.h"
+#include "google/cloud/pubsub/subscriber_connection.h"
+#include "google/cloud/pubsub/testing/mock_publisher_stub.h"
+#include "google/cloud/pubsub/testing/mock_subscriber_stub.h"
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/format_time_point.h"
+#include "google/cloud/internal/getenv.h"
+#include "google/cloud/internal/make_status.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/testing_util/allocation_counter.h"
+#include "google/cloud/testing_util/command_line_parsing.h"
+#include "google/cloud/testing_util/timer.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_format.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+namespace pubsub = ::google::cloud::pubsub;
+using ::google::cloud::CompletionQueue;
+using ::google::cloud::future;
+using ::google::cloud::make_ready_future;
+using ::google::cloud::make_status_or;
+using ::google::cloud::Status;
+using ::google::cloud::StatusOr;
+using ::google::cloud::testing_util::FormatSize;
+using ::google::cloud::testing_util::kMiB;
+
+auto constexpr kDescription = R"""(
+An offline throughput vs. CPU benchmark for the Cloud Pub/Sub C++ client
+library.
+
+Unlike the `throughput` benchmark, this benchmark does not need a Cloud project
+or the emulator. The `pubsub::Publisher` and `pubsub::Subscriber` objects run
+over in-process fakes of the `google.pubsub.v1.Publisher` and
+`google.pubsub.v1.Subscriber` services:
+
+- The fake publisher service responds to each `Publish()` RPC after a
+  configurable latency.
+- The fake subscriber service generates messages of a configurable size, at a
+  configurable rate, on each `StreamingPull()` stream. It respects the flow
+  control limits sent by the client, and responds to the `Acknowledge()` and
+  `ModifyAckDeadline()` RPCs after a configurable latency.
+
+The publisher and subscriber are independent, the subscriber does not receive
+the messages sent by the publisher.
+
+For each iteration the benchmark reports the throughput, the CPU time and the
+heap allocations per message, and the latency percentiles. For the publisher
+the latency is the time from `Publish()` until the future is satisfied. For the
+subscriber it is the time from the generation of the message, in the fake
+service, until the application callback runs.
+
+The CPU time and the allocations are measured for the whole process, including
+the fakes. Run only one of the publisher or subscriber for meaningful results.
+Compare the results of different settings, or of a change, on the same
+machine.
+)""";
+
+auto constexpr kSendTimeAttribute = "sendTime";
+
+struct Config {
+  std::int64_t payload_size = 1024;
+  std::chrono::seconds iteration_duration = std::chrono::seconds(1);
+
+  bool publisher = true;
+  int publisher_thread_count = 1;
+  int publisher_io_threads = 0;
+  int publisher_channels = 1;
+  int publisher_max_batch_size = 1000;
+  std::int64_t publisher_max_batch_bytes = 10 * kMiB;
+  std::int64_t publisher_max_pending_bytes = 64 * kMiB;
+  int publisher_shards = 0;
+  int publisher_max_in_flight = 0;
+  std::int64_t publisher_target_messages_per_second = 0;
+  std::chrono::microseconds publish_latency = std::chrono::milliseconds(10);
+
+  bool subscriber = true;
+  int subscriber_thread_count = 1;
+  int subscriber_io_threads = 0;
+  int subscriber_max_outstanding_messages = 0;
+  std::int64_t subscriber_max_outstanding_bytes = 100 * kMiB;
+  int subscriber_max_concurrency = 0;
+  std::chrono::milliseconds subscriber_ack_hold_time{0};
+  std::chrono::microseconds subscriber_handler_time{0};
+  std::int64_t subscriber_target_messages_per_second = 0;
+  int pull_batch_size = 100;
+  std::chrono::microseconds ack_latency = std::chrono::milliseconds(10);
+
+  std::int64_t minimum_samples = 3;
+  std::int64_t maximum_samples = (std::numeric_limits<std::int64_t>::max)();
+  std::chrono::seconds minimum_runtime = std::chrono::seconds(3);
+  std::chrono::seconds maximum_runtime = std::chrono::seconds(60);
+
+  bool show_help = false;
+};
+
+void Print(std::ostream& os, Config const&);
+
+StatusOr<Config> ParseArgs(std::vector<std::string> args);
+
+void PublisherTask(Config const& config);
+void SubscriberTask(Config const& config);
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto config = ParseArgs({argv, argv + argc});
+  if (!config) {
+    std::cerr << "Error parsing command-line arguments\n";
+    std::cerr << config.status() << "\n";
+    return 1;
+  }
+  if (config->show_help) return 0;
+
+  Print(std::cout, *config);
+
+  std::cout << "timestamp,elapsed(us),op,iteration,count,msgs/s,bytes,MB/s"
+            << ",cpu(us)/msg,allocs/msg,p50(us),p90(us),p99(us),p99.9(us)"
+            << std::endl;
+
+  std::vector<std::thread> tasks;
+  if (config->publisher) {
+    tasks.emplace_back(PublisherTask, *config);
+  }
+  if (config->subscriber) {
+    tasks.emplace_back(SubscriberTask, *config);
+  }
+  for (auto& t : tasks) t.join();
+
+  return 0;
+}
+
+namespace {
+
+using ::google::cloud::pubsub_internal::MessageSize;
+using ::google::cloud::testing_util::AllocationCounter;
+using ::google::cloud::testing_util::Timer;
+
+std::mutex cout_mu;
+
+/**
+ * A histogram of latencies, safe to update from many threads.
+ *
+ * Latencies under 8us have their own bucket, larger latencies are split in 8
+ * buckets per power of 2, so the reported percentiles are within 12.5% of the
+ * actual value.
+ */
+class LatencyHistogram {
+ public:
+  void Record(std::chrono::microseconds latency) {
+    counts_[Bucket(latency.count())].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Returns the percentiles of the latencies recorded since the last call.
+  std::vector<std::int64_t> Collect(std::vector<double> const& percentiles) {
+    std::array<std::int64_t, kBuckets> counts;
+    std::int64_t total = 0;
+    for (std::size_t i = 0; i != kBuckets; ++i) {
+      counts[i] = counts_[i].exchange(0, std::memory_order_relaxed);
+      total += counts[i];
+    }
+    std::vector<std::int64_t> result;
+    for (auto p : percentiles) {
+      auto const threshold = static_cast<std::int64_t>(
+          std::ceil(p / 100.0 * static_cast<double>(total)));
+      std::int64_t cumulative = 0;
+      std::size_t i = 0;
+      for (; i != kBuckets - 1; ++i) {
+        cumulative += counts[i];
+        if (cumulative >= threshold) break;
+      }
+      result.push_back(total == 0 ? 0 : UpperBound(i));
+    }
+    return result;
+  }
+
+ private:
+  static std::size_t constexpr kLinear = 8;
+  static std::size_t constexpr kBuckets = kLinear + kLinear * 40;
+
+  static std::size_t Bucket(std::int64_t us) {
+    if (us < static_cast<std::int64_t>(kLinear)) {
+      return static_cast<std::size_t>((std::max)(us, std::int64_t{0}));
+    }
+    std::size_t e = 0;
+    for (auto v = us; v >= static_cast<std::int64_t>(2 * kLinear); v >>= 1) {
+      ++e;
+    }
+    auto const sub = static_cast<std::size_t>(us >> e) - kLinear;
+    return (std::min)(kLinear + e * kLinear + sub, kBuckets - 1);
+  }
+
+  static std::int64_t UpperBound(std::size_t bucket) {
+    if (bucket < kLinear) return static_cast<std::int64_t>(bucket);
+    auto const e = (bucket - kLinear) / kLinear;
+    auto const sub = (bucket - kLinear) % kLinear;
+    return (static_cast<std::int64_t>(kLinear + sub + 1) << e) - 1;
+  }
+
+  std::array<std::atomic<std::int64_t>, kBuckets> counts_{};
+};
+
+std::vector<double> const kPercentiles{50, 90, 99, 99.9};
+
+bool Done(Config const& config, std::int64_t samples,
+          std::chrono::steady_clock::time_point start) {
+  auto const now = std::chrono::steady_clock::now();
+  if (now >= start + config.maximum_runtime) return true;
+  if (samples >= config.maximum_samples) return true;
+  if (now < start + config.minimum_runtime) return false;
+  return samples >= config.minimum_samples;
+}
+
+std::string Timestamp() {
+  return google::cloud::internal::FormatRfc3339(
+      std::chrono::system_clock::now());
+}
+
+void PrintResult(std::string const& operation, int iteration,
+                 std::int64_t count, std::int64_t bytes,
+                 std::int64_t allocations, Timer::Snapshot const& usage,
+                 std::vector<std::int64_t> const& latencies) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+
+  auto const elapsed_us = duration_cast<microseconds>(usage.elapsed_time);
+  auto const per_message = [count](double value) {
+    if (count == 0) return std::string("0");
+    return absl::StrFormat("%.02f", value / static_cast<double>(count));
+  };
+  auto const mbs =
+      absl::StrFormat("%.02f", static_cast<double>(bytes) /
+                                   static_cast<double>(elapsed_us.count()));
+  auto const msgs =
+      absl::StrFormat("%.02f", static_cast<double>(count) * 1000000.0 /
+                                   static_cast<double>(elapsed_us.count()));
+  std::lock_guard<std::mutex> lk(cout_mu);
+  std::cout << Timestamp() << ',' << elapsed_us.count() << ',' << operation
+            << ',' << iteration << ',' << count << ',' << msgs << ',' << bytes
+            << ',' << mbs << ','
+            << per_message(static_cast<double>(usage.cpu_time.count()))
+            << ',' << per_message(static_cast<double>(allocations));
+  for (auto l : latencies) std::cout << ',' << l;
+  std::cout << std::endl;
+}
+
+/// A fake `google.pubsub.v1.Publisher` service.
+class FakePublisherStub
+    : public google::cloud::pubsub_testing::MockPublisherStub {
+ public:
+  explicit FakePublisherStub(std::chrono::microseconds latency)
+      : latency_(latency) {}
+
+  future<StatusOr<google::pubsub::v1::PublishResponse>> AsyncPublish(
+      CompletionQueue& cq, std::shared_ptr<grpc::ClientContext>,
+      google::cloud::internal::ImmutableOptions,
+      google::pubsub::v1::PublishRequest const& request) override {
+    google::pubsub::v1::PublishResponse response;
+    auto const first = next_id_.fetch_add(request.messages_size());
+    for (int i = 0; i != request.messages_size(); ++i) {
+      response.add_message_ids(std::to_string(first + i));
+    }
+    if (latency_.count() == 0) {
+      return make_ready_future(make_status_or(std::move(response)));
+    }
+    return cq.MakeRelativeTimer(latency_).then(
+        [r = std::move(response)](auto) mutable {
+          return make_status_or(std::move(r));
+        });
+  }
+
+ private:
+  std::chrono::microseconds const latency_;
+  std::atomic<std::int64_t> next_id_{0};
+};
+
+/**
+ * The state of a subscription in the fake `google.pubsub.v1.Subscriber`.
+ *
+ * Generates the messages for all the streams of a subscriber, paced to the
+ * target rate, and keeps the number of outstanding messages under the flow
+ * control limits of the streams.
+ */
+class FakeSubscription {
+ public:
+  explicit FakeSubscription(Config const& config)
+      : data_(google::cloud::internal::Sample(
+            generator_, static_cast<int>(config.payload_size), "0123456789")),
+        batch_size_(config.pull_batch_size),
+        batch_period_(
+            config.subscriber_target_messages_per_second == 0
+                ? std::chrono::nanoseconds(0)
+                : std::chrono::nanoseconds(std::chrono::seconds(1)) *
+                      config.pull_batch_size /
+                      config.subscriber_target_messages_per_second),
+        next_batch_(std::chrono::steady_clock::now()) {}
+
+  void SetFlowControl(std::int64_t max_messages, std::int64_t max_bytes) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (max_messages > 0) max_messages_ = max_messages;
+    if (max_bytes > 0) {
+      max_messages_ = (std::min)(
+          max_messages_,
+          (std::max)(max_bytes / static_cast<std::int64_t>(data_.size() + 1),
+                     std::int64_t{1}));
+    }
+  }
+
+  /// Returns how long to wait before generating the next batch.
+  std::chrono::microseconds NextBatchDelay() {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto const now = std::chrono::steady_clock::now();
+    if (outstanding_ >= max_messages_) return std::chrono::microseconds(100);
+    next_batch_ = (std::max)(next_batch_, now) + batch_period_;
+    return std::chrono::duration_cast<std::chrono::microseconds>(next_batch_ -
+                                                                 now);
+  }
+
+  google::pubsub::v1::StreamingPullResponse Generate() {
+    google::pubsub::v1::StreamingPullResponse response;
+    std::int64_t first;
+    std::int64_t count;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      count = (std::min)(static_cast<std::int64_t>(batch_size_),
+                         max_messages_ - outstanding_);
+      if (count <= 0) return response;
+      outstanding_ += count;
+      first = next_id_;
+      next_id_ += count;
+    }
+    auto const send_time = std::to_string(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+    for (std::int64_t i = 0; i != count; ++i) {
+      auto const id = std::to_string(first + i);
+      auto& m = *response.add_received_messages();
+      m.set_ack_id("ack-" + id);
+      auto& message = *m.mutable_message();
+      message.set_message_id(id);
+      message.set_data(data_);
+      (*message.mutable_attributes())[kSendTimeAttribute] = send_time;
+    }
+    return response;
+  }
+
+  void Release(std::int64_t count) {
+    std::lock_guard<std::mutex> lk(mu_);
+    outstanding_ -= count;
+  }
+
+ private:
+  google::cloud::internal::DefaultPRNG generator_ =
+      google::cloud::internal::MakeDefaultPRNG();
+  std::string const data_;
+  int const batch_size_;
+  std::chrono::nanoseconds const batch_period_;
+  std::mutex mu_;
+  std::chrono::steady_clock::time_point next_batch_;
+  std::int64_t max_messages_ = (std::numeric_limits<std::int64_t>::max)();
+  std::int64_t outstanding_ = 0;
+  std::int64_t next_id_ = 0;
+};
+
+/// A fake `StreamingPull()` stream, delivering the messages of a subscription.
+class FakePullStream
+    : public google::cloud::pubsub_testing::MockSubscriberStub::
+          StreamingPullStream {
+ public:
+  using Response = ::google::pubsub::v1::StreamingPullResponse;
+
+  FakePullStream(CompletionQueue cq,
+                 std::shared_ptr<FakeSubscription> subscription)
+      : cq_(std::move(cq)), subscription_(std::move(subscription)) {}
+
+  void Cancel() override { cancelled_ = true; }
+  future<bool> Start() override { return make_ready_future(true); }
+
+  future<std::optional<Response>> Read() override {
+    if (cancelled_) return make_ready_future(std::optional<Response>{});
+    return cq_.MakeRelativeTimer(subscription_->NextBatchDelay())
+        .then([s = subscription_](auto) {
+          return std::make_optional(s->Generate());
+        });
+  }
+
+  future<bool> Write(google::pubsub::v1::StreamingPullRequest const& request,
+                     grpc::WriteOptions) override {
+    if (!request.subscription().empty()) {
+      subscription_->SetFlowControl(request.max_outstanding_messages(),
+                                    request.max_outstanding_bytes());
+    }
+    auto released = request.ack_ids_size();
+    for (auto s : request.modify_deadline_seconds()) released += s == 0;
+    subscription_->Release(released);
+    return make_ready_future(true);
+  }
+
+  future<bool> WritesDone() override { return make_ready_future(true); }
+  future<Status> Finish() override { return make_ready_future(Status{}); }
+
+ private:
+  CompletionQueue cq_;
+  std::shared_ptr<FakeSubscription> subscription_;
+  std::atomic<bool> cancelled_{false};
+};
+
+/// A fake `google.pubsub.v1.Subscriber` service.
+class FakeSubscriberStub
+    : public google::cloud::pubsub_testing::MockSubscriberStub {
+ public:
+  explicit FakeSubscriberStub(Config const& config)
+      : latency_(config.ack_latency),
+        subscription_(std::make_shared<FakeSubscription>(config)) {}
+
+  std::unique_ptr<StreamingPullStream> AsyncStreamingPull(
+      CompletionQueue const& cq, std::shared_ptr<grpc::ClientContext>,
+      google::cloud::internal::ImmutableOptions) override {
+    return std::make_unique<FakePullStream>(cq, subscription_);
+  }
+
+  future<Status> AsyncAcknowledge(
+      CompletionQueue& cq, std::shared_ptr<grpc::ClientContext>,
+      google::cloud::internal::ImmutableOptions,
+      google::pubsub::v1::AcknowledgeRequest const& request) override {
+    return Respond(cq, request.ack_ids_size());
+  }
+
+  future<Status> AsyncModifyAckDeadline(
+      CompletionQueue& cq, std::shared_ptr<grpc::ClientContext>,
+      google::cloud::internal::ImmutableOptions,
+      google::pubsub::v1::ModifyAckDeadlineRequest const& request) override {
+    // Only nacks release the messages.
+    return Respond(
+        cq, request.ack_deadline_seconds() == 0 ? request.ack_ids_size() : 0);
+  }
+
+ private:
+  future<Status> Respond(CompletionQueue& cq, std::int64_t released) {
+    if (latency_.count() == 0) {
+      subscription_->Release(released);
+      return make_ready_future(Status{});
+    }
+    return cq.MakeRelativeTimer(latency_).then(
+        [s = subscription_, released](auto) {
+          s->Release(released);
+          return Status{};
+        });
+  }
+
+  std::chrono::microseconds const latency_;
+  std::shared_ptr<FakeSubscription> subscription_;
+};
+
+pubsub::Publisher CreatePublisher(Config const& config) {
+  namespace gc = ::google::cloud;
+  auto options =
+      gc::Options{}
+          .set<pubsub::MaxBatchMessagesOption>(config.publisher_max_batch_size)
+          .set<pubsub::MaxBatchBytesOption>(
+              static_cast<std::size_t>(config.publisher_max_batch_bytes))
+          .set<pubsub::MaxPendingBytesOption>(
+              static_cast<std::size_t>(config.publisher_max_pending_bytes))
+          .set<pubsub::FullPublisherActionOption>(
+              pubsub::FullPublisherAction::kBlocks);
+  if (config.publisher_io_threads != 0) {
+    options.set<gc::GrpcBackgroundThreadPoolSizeOption>(
+        config.publisher_io_threads);
+  }
+  if (config.publisher_shards != 0) {
+    options.set<pubsub::PublisherShardsOption>(config.publisher_shards);
+  }
+  if (config.publisher_max_in_flight != 0) {
+    options.set<pubsub::MaxInFlightPublishesOption>(
+        config.publisher_max_in_flight);
+  }
+  options = gc::pubsub_internal::DefaultPublisherOptions(std::move(options));
+
+  // Each fake stub stands in for a gRPC channel.
+  std::vector<std::shared_ptr<gc::pubsub_internal::PublisherStub>> stubs;
+  std::generate_n(std::back_inserter(stubs), config.publisher_channels, [&] {
+    return std::make_shared<FakePublisherStub>(config.publish_latency);
+  });
+  return pubsub::Publisher(gc::pubsub_internal::MakeTestPublisherConnection(
+      pubsub::Topic("fake-project", "fake-topic"), std::move(options),
+      std::move(stubs)));
+}
+
+std::atomic<std::int64_t> publish_count{0};
+std::atomic<std::int64_t> publish_bytes{0};
+std::atomic<std::int64_t> error_count{0};
+LatencyHistogram publish_latency;
+
+void PublishLoop(Config const& config, pubsub::Publisher publisher,
+                 std::atomic<bool> const& shutdown) {
+  auto gen = google::cloud::internal::DefaultPRNG(std::random_device{}());
+  auto const data = google::cloud::internal::Sample(
+      gen, static_cast<int>(config.payload_size), "0123456789");
+
+  using std::chrono::steady_clock;
+
+  // Sleeping for each message does not work at high rates, pace every
+  // kPacingCount messages instead.
+  auto constexpr kPacingCount = 1024;
+  auto const enable_pacing = config.publisher_target_messages_per_second != 0;
+  auto const pacing_period = [&] {
+    using std::chrono::microseconds;
+    if (!enable_pacing) return microseconds(0);
+    return microseconds(std::chrono::seconds(1)) * kPacingCount /
+           config.publisher_target_messages_per_second;
+  }();
+
+  auto pacing_time = steady_clock::now() + pacing_period;
+  for (std::int64_t i = 0; !shutdown.load(); ++i) {
+    auto message = pubsub::MessageBuilder{}.SetData(data).Build();
+    auto const bytes = static_cast<std::int64_t>(MessageSize(message));
+    auto const start = steady_clock::now();
+    publisher.Publish(std::move(message))
+        .then([start, bytes](future<StatusOr<std::string>> f) {
+          publish_latency.Record(
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  steady_clock::now() - start));
+          if (!f.get()) ++error_count;
+          ++publish_count;
+          publish_bytes.fetch_add(bytes);
+        });
+    if (enable_pacing && (i + 1) % kPacingCount == 0) {
+      auto const now = steady_clock::now();
+      if (now < pacing_time) std::this_thread::sleep_for(pacing_time - now);
+      pacing_time = (std::max)(now, pacing_time) + pacing_period;
+    }
+  }
+}
+
+void PublisherTask(Config const& config) {
+  auto publisher = CreatePublisher(config);
+  std::atomic<bool> shutdown{false};
+  std::vector<std::thread> workers;
+  std::generate_n(std::back_inserter(workers), config.publisher_thread_count,
+                  [&] {
+                    return std::thread(PublishLoop, std::cref(config),
+                                       publisher, std::cref(shutdown));
+                  });
+
+  auto const start = std::chrono::steady_clock::now();
+  for (int i = 0; !Done(config, i, start); ++i) {
+    auto timer = Timer::PerProcess();
+    auto const allocations = AllocationCounter::PerProcess();
+    auto const start_count = publish_count.load();
+    auto const start_bytes = publish_bytes.load();
+    std::this_thread::sleep_for(config.iteration_duration);
+    auto const count = publish_count.load() - start_count;
+    auto const bytes = publish_bytes.load() - start_bytes;
+    auto const usage = timer.Sample();
+    PrintResult("Pub", i, count, bytes, allocations.Sample(), usage,
+                publish_latency.Collect(kPercentiles));
+  }
+
+  shutdown = true;
+  for (auto& t : workers) t.join();
+  publisher.Flush();
+  std::lock_guard<std::mutex> lk(cout_mu);
+  std::cout << "# Publisher: error_count=" << error_count
+            << ", publish_count=" << publish_count << std::endl;
+}
+
+pubsub::Subscriber CreateSubscriber(Config const& config) {
+  namespace gc = ::google::cloud;
+  auto options =
+      gc::Options{}
+          .set<pubsub::MaxOutstandingBytesOption>(
+              config.subscriber_max_outstanding_bytes)
+          .set<gc::GrpcCredentialOption>(grpc::InsecureChannelCredentials());
+  if (config.subscriber_max_outstanding_messages != 0) {
+    options.set<pubsub::MaxOutstandingMessagesOption>(
+        config.subscriber_max_outstanding_messages);
+  }
+  if (config.subscriber_max_concurrency != 0) {
+    options.set<pubsub::MaxConcurrencyOption>(
+        config.subscriber_max_concurrency);
+  }
+  if (config.subscriber_ack_hold_time.count() != 0) {
+    options.set<pubsub::MaxAckHoldTimeOption>(config.subscriber_ack_hold_time);
+  }
+  if (config.subscriber_io_threads != 0) {
+    options.set<gc::GrpcBackgroundThreadPoolSizeOption>(
+        config.subscriber_io_threads);
+  }
+  options = gc::pubsub_internal::DefaultSubscriberOptions(std::move(options));
+
+  std::vector<std::shared_ptr<gc::pubsub_internal::SubscriberStub>> stubs{
+      std::make_shared<FakeSubscriberStub>(config)};
+  return pubsub::Subscriber(gc::pubsub_internal::MakeTestSubscriberConnection(
+      pubsub::Subscription("fake-project", "fake-subscription"),
+      std::move(options), std::move(stubs)));
+}
+
+void SubscriberTask(Config const& config) {
+  std::vector<pubsub::Subscriber> subscribers;
+  std::generate_n(std::back_inserter(subscribers),
+                  config.subscriber_thread_count,
+                  [config] { return CreateSubscriber(config); });
+
+  std::atomic<std::int64_t> received_count{0};
+  std::atomic<std::int64_t> received_bytes{0};
+  LatencyHistogram latency;
+  auto handler = [&](pubsub::Message const& m, pubsub::AckHandler h) {
+    using std::chrono::steady_clock;
+    auto const now = steady_clock::now();
+    auto const send_time = m.attributes_view().find(kSendTimeAttribute);
+    std::int64_t ns;
+    if (send_time && absl::SimpleAtoi(*send_time, &ns)) {
+      latency.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+          now - steady_clock::time_point(std::chrono::nanoseconds(ns))));
+    }
+    if (config.subscriber_handler_time.count() != 0) {
+      std::this_thread::sleep_for(config.subscriber_handler_time);
+    }
+    ++received_count;
+    received_bytes.fetch_add(static_cast<std::int64_t>(MessageSize(m)));
+    std::move(h).ack();
+  };
+
+  std::vector<future<Status>> sessions;
+  std::transform(
+      subscribers.begin(), subscribers.end(), std::back_inserter(sessions),
+      [&handler](pubsub::Subscriber s) { return s.Subscribe(handler); });
+
+  auto const start = std::chrono::steady_clock::now();
+  for (int i = 0; !Done(config, i, start); ++i) {
+    auto timer = Timer::PerProcess();
+    auto const allocations = AllocationCounter::PerProcess();
+    auto const start_count = received_count.load();
+    auto const start_bytes = received_bytes.load();
+    std::this_thread::sleep_for(config.iteration_duration);
+    auto const count = received_count.load() - start_count;
+    auto const bytes = received_bytes.load() - start_bytes;
+    auto const usage = timer.Sample();
+    PrintResult("Sub", i, count, bytes, allocations.Sample(), usage,
+                latency.Collect(kPercentiles));
+  }
+  for (auto& s : sessions) s.cancel();
+  for (auto& s : sessions) {
+    auto status = s.get();
+    std::lock_guard<std::mutex> lk(cout_mu);
+    std::cout << "# Subscriber: status=" << status
+              << ", received_count=" << received_count.load() << std::endl;
+  }
+}
+
+void PrintPublisher(std::ostream& os, Config const& config) {
+  os << "\n# Publisher: " << std::boolalpha << config.publisher
+     << "\n# Publisher Threads: " << config.publisher_thread_count
+     << "\n# Publisher I/O Threads: " << config.publisher_io_threads
+     << "\n# Publisher Channels: " << config.publisher_channels
+     << "\n# Publisher Max Batch Size: " << config.publisher_max_batch_size
+     << "\n# Publisher Max Batch Bytes: "
+     << FormatSize(config.publisher_max_batch_bytes)
+     << "\n# Publisher Max Pending Bytes: "
+     << FormatSize(config.publisher_max_pending_bytes)
+     << "\n# Publisher Shards: " << config.publisher_shards
+     << "\n# Publisher Max In-Flight: " << config.publisher_max_in_flight
+     << "\n# Publisher Target messages/s: "
+     << config.publisher_target_messages_per_second
+     << "\n# Publish Latency: " << config.publish_latency.count() << "us";
+}
+
+void PrintSubscriber(std::ostream& os, Config const& config) {
+  os << "\n# Subscriber: " << std::boolalpha << config.subscriber
+     << "\n# Subscriber Threads: " << config.subscriber_thread_count
+     << "\n# Subscriber I/O Threads: " << config.subscriber_io_threads
+     << "\n# Subscriber Max Outstanding Messages: "
+     << config.subscriber_max_outstanding_messages
+     << "\n# Subscriber Max Outstanding Bytes: "
+     << FormatSize(config.subscriber_max_outstanding_bytes)
+     << "\n# Subscriber Max Concurrency: " << config.subscriber_max_concurrency
+     << "\n# Subscriber Ack Hold Time: "
+     << config.subscriber_ack_hold_time.count() << "ms"
+     << "\n# Subscriber Handler Time: "
+     << config.subscriber_handler_time.count() << "us"
+     << "\n# Subscriber Target messages/s: "
+     << config.subscriber_target_messages_per_second
+     << "\n# Pull Batch Size: " << config.pull_batch_size
+     << "\n# Ack Latency: " << config.ack_latency.count() << "us";
+}
+
+void Print(std::ostream& os, Config const& config) {
+  os << "# Running offline Cloud Pub/Sub experiment"
+     << "\n# Start time: "
+     << google::cloud::internal::FormatRfc3339(std::chrono::system_clock::now())
+     << "\n# Payload Size: " << FormatSize(config.payload_size)
+     << "\n# Iteration_Duration: " << config.iteration_duration.count() << "s"
+     << "\n# Minimum Samples: " << config.minimum_samples
+     << "\n# Maximum Samples: " << config.maximum_samples
+     << "\n# Minimum Runtime: " << config.minimum_runtime.count() << "s"
+     << "\n# Maximum Runtime: " << config.maximum_runtime.count() << "s";
+  if (config.publisher) PrintPublisher(os, config);
+  if (config.subscriber) PrintSubscriber(os, config);
+  os << std::endl;
+}
+
+using ::google::cloud::internal::GetEnv;
+using ::google::cloud::testing_util::OptionDescriptor;
+using ::google::cloud::testing_util::ParseBoolean;
+using ::google::cloud::testing_util::ParseDuration;
+using ::google::cloud::testing_util::ParseSize;
+
+google::cloud::StatusOr<Config> ParseArgsImpl(std::vector<std::string> args,
+                                              std::string const& description) {
+  Config options;
+  bool show_help = false;
+  bool show_description = false;
+
+  std::vector<OptionDescriptor> desc{
+      {"--help", "print usage information",
+       [&show_help](std::string const&) { show_help = true; }},
+      {"--description", "print benchmark description",
+       [&show_description](std::string const&) { show_description = true; }},
+
+      {"--payload-size", "set the size of the message payload",
+       [&options](std::string const& val) {
+         options.payload_size = ParseSize(val);
+       }},
+      {"--iteration-duration",
+       "measurement interval, report throughput every X seconds",
+       [&options](std::string const& val) {
+         options.iteration_duration = ParseDuration(val);
+       }},
+
+      {"--publisher", "run a publisher in this program",
+       [&options](std::string const& val) {
+         options.publisher = ParseBoolean(val).value_or(true);
+       }},
+      {"--publisher-thread-count", "number of publisher tasks",
+       [&options](std::string const& val) {
+         options.publisher_thread_count = std::stoi(val);
+       }},
+      {"--publisher-io-threads",
+       "number of publisher I/O threads, set to 0 to use the library "
+       "default",
+       [&options](std::string const& val) {
+         options.publisher_io_threads = std::stoi(val);
+       }},
+      {"--publisher-channels", "number of fake publisher channels",
+       [&options](std::string const& val) {
+         options.publisher_channels = std::stoi(val);
+       }},
+      {"--publisher-max-batch-size", "configure batching parameters",
+       [&options](std::string const& val) {
+         options.publisher_max_batch_size = std::stoi(val);
+       }},
+      {"--publisher-max-batch-bytes", "configure batching parameters",
+       [&options](std::string const& val) {
+         options.publisher_max_batch_bytes = ParseSize(val);
+       }},
+      {"--publisher-max-pending-bytes",
+       "configure publisher flow control, the publishing threads block when "
+       "the pending messages exceed this size",
+       [&options](std::string const& val) {
+         options.publisher_max_pending_bytes = ParseSize(val);
+       }},
+      {"--publisher-shards",
+       "number of partial batches, set to 0 to use the library default",
+       [&options](std::string const& val) {
+         options.publisher_shards = std::stoi(val);
+       }},
+      {"--publisher-max-in-flight",
+       "maximum number of concurrent Publish() RPCs, set to 0 to use the "
+       "library default",
+       [&options](std::string const& val) {
+         options.publisher_max_in_flight = std::stoi(val);
+       }},
+      {"--publisher-target-messages-per-second",
+       "limit the number of messages generated per second."
+       " If set to 0 this flow control feature is disabled.",
+       [&options](std::string const& val) {
+         options.publisher_target_messages_per_second = std::stol(val);
+       }},
+      {"--publish-latency-us",
+       "the latency of the fake Publish() RPC, in microseconds",
+       [&options](std::string const& val) {
+         options.publish_latency = std::chrono::microseconds(std::stol(val));
+       }},
+
+      {"--subscriber", "run a subscriber in this program",
+       [&options](std::string const& val) {
+         options.subscriber = ParseBoolean(val).value_or(true);
+       }},
+      {"--subscriber-thread-count", "number of subscriber tasks",
+       [&options](std::string const& val) {
+         options.subscriber_thread_count = std::stoi(val);
+       }},
+      {"--subscriber-io-threads",
+       "number of subscriber I/O threads, set to 0 to use the library "
+       "default",
+       [&options](std::string const& val) {
+         options.subscriber_io_threads = std::stoi(val);
+       }},
+      {"--subscriber-max-outstanding-messages",
+       "configure message flow control",
+       [&options](std::string const& val) {
+         options.subscriber_max_outstanding_messages = std::stoi(val);
+       }},
+      {"--subscriber-max-outstanding-bytes", "configure message flow control",
+       [&options](std::string const& val) {
+         options.subscriber_max_outstanding_bytes = ParseSize(val);
+       }},
+      {"--subscriber-max-concurrency", "configure message flow control",
+       [&options](std::string const& val) {
+         options.subscriber_max_concurrency = std::stoi(val);
+       }},
+      {"--subscriber-ack-hold-time-ms",
+       "how long to hold acks before sending them, in milliseconds",
+       [&options](std::string const& val) {
+         options.subscriber_ack_hold_time =
+             std::chrono::milliseconds(std::stol(val));
+       }},
+      {"--subscriber-handler-time-us",
+       "simulated processing time in the subscriber callback, in "
+       "microseconds",
+       [&options](std::string const& val) {
+         options.subscriber_handler_time =
+             std::chrono::microseconds(std::stol(val));
+       }},
+      {"--subscriber-target-messages-per-second",
+       "limit the number of messages generated per second by each fake "
+       "subscription. If set to 0 this flow control feature is disabled.",
+       [&options](std::string const& val) {
+         options.subscriber_target_messages_per_second = std::stol(val);
+       }},
+      {"--pull-batch-size",
+       "the number of messages in each fake StreamingPull() response",
+       [&options](std::string const& val) {
+         options.pull_batch_size = std::stoi(val);
+       }},
+      {"--ack-latency-us",
+       "the latency of the fake Acknowledge() and ModifyAckDeadline() RPCs, "
+       "in microseconds",
+       [&options](std::string const& val) {
+         options.ack_latency = std::chrono::microseconds(std::stol(val));
+       }},
+
+      {"--minimum-samples", "minimum number of samples to capture",
+       [&options](std::string const& val) {
+         options.minimum_samples = std::stol(val);
+       }},
+      {"--maximum-samples", "maximum number of samples to capture",
+       [&options](std::string const& val) {
+         options.maximum_samples = std::stol(val);
+       }},
+      {"--minimum-runtime", "run for at least this time",
+       [&options](std::string const& val) {
+         options.minimum_runtime = ParseDuration(val);
+       }},
+      {"--maximum-runtime", "run for at most this time",
+       [&options](std::string const& val) {
+         options.maximum_runtime = ParseDuration(val);
+       }},
+  };
+  auto const usage = BuildUsage(desc, args[0]);
+  auto unparsed = OptionsParse(desc, args);
+
+  if (show_description) {
+    std::cout << description << "\n\n";
+  }
+
+  if (show_help) {
+    std::cout << usage << "\n";
+    options.show_help = true;
+    return options;
+  }
+
+  if (options.payload_size <= 0) {
+    return google::cloud::internal::InvalidArgumentError(
+        "invalid --payload-size option");
+  }
+  if (options.publisher_channels <= 0) {
+    return google::cloud::internal::InvalidArgumentError(
+        "invalid --publisher-channels option");
+  }
+  if (options.pull_batch_size <= 0) {
+    return google::cloud::internal::InvalidArgumentError(
+        "invalid --pull-batch-size option");
+  }
+
+  return options;
+}
+
+google::cloud::StatusOr<Config> SelfTest(std::string const& cmd) {
+  auto error = [](std::string m,
+                  google::cloud::internal::ErrorInfoBuilder info) {
+    return google::cloud::internal::UnknownError(std::move(m), std::move(info));
+  };
+  auto config = ParseArgsImpl({cmd, "--help"}, kDescription);
+  if (!config || !config->show_help) {
+    return error("--help parsing", GCP_ERROR_INFO());
+  }
+  config = ParseArgsImpl({cmd, "--description", "--help"}, kDescription);
+  if (!config || !config->show_help) {
+    return error("--description parsing", GCP_ERROR_INFO());
+  }
+  config = ParseArgsImpl({cmd, "--pull-batch-size=0"}, kDescription);
+  if (config) return error("--pull-batch-size validation", GCP_ERROR_INFO());
+
+  return ParseArgsImpl(
+      {
+          cmd,
+          "--publisher=true",
+          "--publisher-thread-count=2",
+          "--publisher-io-threads=1",
+          "--publisher-channels=2",
+          "--publisher-max-batch-size=100",
+          "--publisher-max-batch-bytes=1MiB",
+          "--publisher-max-pending-bytes=8MiB",
+          "--publisher-shards=2",
+          "--publisher-max-in-flight=4",
+          "--publisher-target-messages-per-second=100000",
+          "--publish-latency-us=1000",
+          "--subscriber=true",
+          "--subscriber-thread-count=1",
+          "--subscriber-io-threads=1",
+          "--subscriber-max-outstanding-messages=1000",
+          "--subscriber-max-outstanding-bytes=100MiB",
+          "--subscriber-max-concurrency=4",
+          "--subscriber-ack-hold-time-ms=5",
+          "--subscriber-handler-time-us=0",
+          "--subscriber-target-messages-per-second=100000",
+          "--pull-batch-size=100",
+          "--ack-latency-us=1000",
+          "--iteration-duration=1s",
+          "--payload-size=1KiB",
+          "--minimum-samples=1",
+          "--maximum-samples=2",
+          "--minimum-runtime=0s",
+          "--maximum-runtime=2s",
+      },
+      kDescription);
+}
+
+google::cloud::StatusOr<Config> ParseArgs(std::vector<std::string> args) {
+  bool auto_run =
+      GetEnv("GOOGLE_CLOUD_CPP_AUTO_RUN_EXAMPLES").value_or("") == "yes";
+  if (auto_run) return SelfTest(args[0]);
+  return ParseArgsImpl(std::move(args), kDescription);
+}
+
+}  // namespace
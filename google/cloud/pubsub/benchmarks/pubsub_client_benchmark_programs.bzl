@@ -18,5 +18,6 @@
 
 pubsub_client_benchmark_programs = [
     "endurance.cc",
+    "offline_throughput.cc",
     "throughput.cc",
 ]
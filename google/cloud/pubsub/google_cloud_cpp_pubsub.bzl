@@ -48,11 +48,14 @@ google_cloud_cpp_pubsub_hdrs = [
     "admin/topic_admin_options.h",
     "application_callback.h",
     "backoff_policy.h",
+    "batch_ack_handler.h",
     "blocking_publisher.h",
     "blocking_publisher_connection.h",
     "connection_options.h",
     "exactly_once_ack_handler.h",
+    "internal/ack_coalescer.h",
     "internal/ack_handler_wrapper.h",
+    "internal/ack_latency_distribution.h",
     "internal/batch_callback.h",
     "internal/batch_callback_wrapper.h",
     "internal/batch_sink.h",
@@ -60,6 +63,7 @@ google_cloud_cpp_pubsub_hdrs = [
     "internal/batching_publisher_tracing_connection.h",
     "internal/blocking_publisher_connection_impl.h",
     "internal/blocking_publisher_tracing_connection.h",
+    "internal/concurrency_limited_batch_sink.h",
     "internal/containing_publisher_connection.h",
     "internal/create_channel.h",
     "internal/default_batch_callback.h",
@@ -101,11 +105,13 @@ google_cloud_cpp_pubsub_hdrs = [
     "internal/schema_tracing_stub.h",
     "internal/sequential_batch_sink.h",
     "internal/session_shutdown_manager.h",
+    "internal/sharded_batching_publisher_connection.h",
     "internal/span.h",
     "internal/streaming_subscription_batch_source.h",
     "internal/subscriber_auth_decorator.h",
     "internal/subscriber_connection_impl.h",
     "internal/subscriber_logging_decorator.h",
+    "internal/subscriber_memory_budget.h",
     "internal/subscriber_metadata_decorator.h",
     "internal/subscriber_round_robin_decorator.h",
     "internal/subscriber_stub.h",
@@ -179,15 +185,19 @@ google_cloud_cpp_pubsub_srcs = [
     "admin/topic_admin_client.cc",
     "admin/topic_admin_connection.cc",
     "admin/topic_admin_connection_idempotency_policy.cc",
+    "batch_ack_handler.cc",
     "blocking_publisher.cc",
     "blocking_publisher_connection.cc",
     "connection_options.cc",
     "exactly_once_ack_handler.cc",
+    "internal/ack_coalescer.cc",
     "internal/ack_handler_wrapper.cc",
+    "internal/ack_latency_distribution.cc",
     "internal/batching_publisher_connection.cc",
     "internal/batching_publisher_tracing_connection.cc",
     "internal/blocking_publisher_connection_impl.cc",
     "internal/blocking_publisher_tracing_connection.cc",
+    "internal/concurrency_limited_batch_sink.cc",
     "internal/create_channel.cc",
     "internal/default_batch_sink.cc",
     "internal/default_pull_ack_handler.cc",
@@ -222,10 +232,12 @@ google_cloud_cpp_pubsub_srcs = [
     "internal/schema_tracing_stub.cc",
     "internal/sequential_batch_sink.cc",
     "internal/session_shutdown_manager.cc",
+    "internal/sharded_batching_publisher_connection.cc",
     "internal/streaming_subscription_batch_source.cc",
     "internal/subscriber_auth_decorator.cc",
     "internal/subscriber_connection_impl.cc",
     "internal/subscriber_logging_decorator.cc",
+    "internal/subscriber_memory_budget.cc",
     "internal/subscriber_metadata_decorator.cc",
     "internal/subscriber_round_robin_decorator.cc",
     "internal/subscriber_stub.cc",
@@ -20,6 +20,7 @@ google_cloud_cpp_pubsub_mocks_hdrs = [
     "admin/mocks/mock_subscription_admin_connection.h",
     "admin/mocks/mock_topic_admin_connection.h",
     "mocks/mock_ack_handler.h",
+    "mocks/mock_batch_ack_handler.h",
     "mocks/mock_blocking_publisher_connection.h",
     "mocks/mock_exactly_once_ack_handler.h",
     "mocks/mock_publisher_connection.h",
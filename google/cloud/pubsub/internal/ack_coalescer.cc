@@ -0,0 +1,87 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/ack_coalescer.h"
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+bool AckCoalescer::Ack(std::string ack_id) {
+  auto const it = modacks_.find(ack_id);
+  auto const canceled = it != modacks_.end() && it->second.count() != 0;
+  if (it != modacks_.end()) modacks_.erase(it);
+  acks_.insert(std::move(ack_id));
+  return canceled;
+}
+
+bool AckCoalescer::Nack(std::string ack_id) {
+  if (acks_.count(ack_id) != 0) return false;
+  auto& deadline = modacks_[std::move(ack_id)];
+  auto const canceled = deadline.count() != 0;
+  deadline = std::chrono::seconds(0);
+  return canceled;
+}
+
+bool AckCoalescer::Modack(std::string ack_id, std::chrono::seconds deadline) {
+  if (acks_.count(ack_id) != 0) return false;
+  auto const loc = modacks_.emplace(std::move(ack_id), deadline);
+  if (loc.second) return true;
+  // A pending nack takes precedence, otherwise the latest deadline wins.
+  if (loc.first->second.count() == 0) return false;
+  loc.first->second = deadline;
+  return true;
+}
+
+AckCoalescer::Requests AckCoalescer::Flush(std::string const& subscription,
+                                           int max_ack_ids) {
+  Requests requests;
+  for (auto i = acks_.begin(); i != acks_.end();) {
+    if (requests.acks.empty() ||
+        requests.acks.back().ack_ids_size() >= max_ack_ids) {
+      requests.acks.emplace_back();
+      requests.acks.back().set_subscription(subscription);
+    }
+    requests.acks.back().add_ack_ids(std::move(acks_.extract(i++).value()));
+  }
+
+  std::map<std::chrono::seconds, std::vector<std::string>> by_deadline;
+  for (auto i = modacks_.begin(); i != modacks_.end();) {
+    auto node = modacks_.extract(i++);
+    by_deadline[node.mapped()].push_back(std::move(node.key()));
+  }
+  auto const max = static_cast<std::size_t>(max_ack_ids);
+  for (auto& kv : by_deadline) {
+    auto const deadline = static_cast<std::int32_t>(kv.first.count());
+    for (std::size_t i = 0; i != kv.second.size(); ++i) {
+      if (i % max == 0) {
+        requests.modacks.emplace_back();
+        requests.modacks.back().set_subscription(subscription);
+        requests.modacks.back().set_ack_deadline_seconds(deadline);
+      }
+      requests.modacks.back().add_ack_ids(std::move(kv.second[i]));
+    }
+  }
+  return requests;
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
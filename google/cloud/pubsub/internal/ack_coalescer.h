@@ -0,0 +1,90 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_COALESCER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_COALESCER_H
+
+#include "google/cloud/pubsub/version.h"
+#include "google/pubsub/v1/pubsub.pb.h"
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Buffers acks, nacks and lease extensions until they are flushed.
+ *
+ * Sending each acknowledgement as soon as the application produces it can
+ * generate as much traffic as the messages themselves. This class merges the
+ * pending operations for a subscription so they can be sent in as few requests
+ * as possible:
+ * - an ack or nack replaces any pending lease extension for the same message,
+ * - lease extensions for messages that are already acked or nacked are
+ *   dropped,
+ * - lease extensions (and nacks) with the same deadline share a request.
+ *
+ * This class is not thread-safe, the caller must serialize access to it.
+ */
+class AckCoalescer {
+ public:
+  /// The requests produced by `Flush()`.
+  struct Requests {
+    std::vector<google::pubsub::v1::AcknowledgeRequest> acks;
+    std::vector<google::pubsub::v1::ModifyAckDeadlineRequest> modacks;
+  };
+
+  /// Buffer an ack, returns true if it cancels a pending lease extension.
+  bool Ack(std::string ack_id);
+
+  /// Buffer a nack, returns true if it cancels a pending lease extension.
+  bool Nack(std::string ack_id);
+
+  /**
+   * Buffer a lease extension.
+   *
+   * Returns false if the message is already acked or nacked, in which case the
+   * extension is dropped.
+   */
+  bool Modack(std::string ack_id, std::chrono::seconds deadline);
+
+  /// The number of buffered operations.
+  std::size_t size() const { return acks_.size() + modacks_.size(); }
+  bool empty() const { return size() == 0; }
+
+  /**
+   * Return the buffered operations as requests, and clear the buffers.
+   *
+   * Each request has at most @p max_ack_ids ack ids.
+   */
+  Requests Flush(std::string const& subscription, int max_ack_ids);
+
+ private:
+  std::unordered_set<std::string> acks_;
+  // The pending deadline for each message, nacks have a zero deadline.
+  std::unordered_map<std::string, std::chrono::seconds> modacks_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_COALESCER_H
@@ -0,0 +1,151 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/ack_coalescer.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+using ::testing::UnorderedElementsAre;
+using ::testing::UnorderedElementsAreArray;
+
+std::vector<std::string> AckIds(
+    google::protobuf::RepeatedPtrField<std::string> const& ids) {
+  return {ids.begin(), ids.end()};
+}
+
+TEST(AckCoalescerTest, Empty) {
+  AckCoalescer tested;
+  EXPECT_TRUE(tested.empty());
+  auto requests = tested.Flush("test-subscription", 10);
+  EXPECT_THAT(requests.acks, IsEmpty());
+  EXPECT_THAT(requests.modacks, IsEmpty());
+}
+
+TEST(AckCoalescerTest, MergesByDeadline) {
+  AckCoalescer tested;
+  EXPECT_TRUE(tested.Modack("m0", std::chrono::seconds(10)));
+  EXPECT_TRUE(tested.Modack("m1", std::chrono::seconds(10)));
+  EXPECT_TRUE(tested.Modack("m2", std::chrono::seconds(20)));
+  EXPECT_FALSE(tested.Nack("n0"));
+  EXPECT_FALSE(tested.Ack("a0"));
+  EXPECT_FALSE(tested.Ack("a1"));
+  EXPECT_EQ(tested.size(), 6);
+
+  auto requests = tested.Flush("test-subscription", 10);
+  EXPECT_TRUE(tested.empty());
+  ASSERT_THAT(requests.acks, SizeIs(1));
+  EXPECT_EQ(requests.acks[0].subscription(), "test-subscription");
+  EXPECT_THAT(AckIds(requests.acks[0].ack_ids()),
+              UnorderedElementsAre("a0", "a1"));
+
+  // The requests are sorted by deadline.
+  ASSERT_THAT(requests.modacks, SizeIs(3));
+  EXPECT_EQ(requests.modacks[0].subscription(), "test-subscription");
+  EXPECT_EQ(requests.modacks[0].ack_deadline_seconds(), 0);
+  EXPECT_THAT(AckIds(requests.modacks[0].ack_ids()), ElementsAre("n0"));
+  EXPECT_EQ(requests.modacks[1].ack_deadline_seconds(), 10);
+  EXPECT_THAT(AckIds(requests.modacks[1].ack_ids()),
+              UnorderedElementsAre("m0", "m1"));
+  EXPECT_EQ(requests.modacks[2].ack_deadline_seconds(), 20);
+  EXPECT_THAT(AckIds(requests.modacks[2].ack_ids()), ElementsAre("m2"));
+}
+
+TEST(AckCoalescerTest, AckCancelsModack) {
+  AckCoalescer tested;
+  EXPECT_TRUE(tested.Modack("a0", std::chrono::seconds(10)));
+  EXPECT_TRUE(tested.Ack("a0"));
+  EXPECT_FALSE(tested.Modack("a0", std::chrono::seconds(10)));
+  EXPECT_FALSE(tested.Nack("a0"));
+  EXPECT_EQ(tested.size(), 1);
+
+  auto requests = tested.Flush("test-subscription", 10);
+  ASSERT_THAT(requests.acks, SizeIs(1));
+  EXPECT_THAT(AckIds(requests.acks[0].ack_ids()), ElementsAre("a0"));
+  EXPECT_THAT(requests.modacks, IsEmpty());
+}
+
+TEST(AckCoalescerTest, NackCancelsModack) {
+  AckCoalescer tested;
+  EXPECT_TRUE(tested.Modack("n0", std::chrono::seconds(10)));
+  EXPECT_TRUE(tested.Nack("n0"));
+  EXPECT_FALSE(tested.Modack("n0", std::chrono::seconds(10)));
+  EXPECT_EQ(tested.size(), 1);
+
+  auto requests = tested.Flush("test-subscription", 10);
+  EXPECT_THAT(requests.acks, IsEmpty());
+  ASSERT_THAT(requests.modacks, SizeIs(1));
+  EXPECT_EQ(requests.modacks[0].ack_deadline_seconds(), 0);
+  EXPECT_THAT(AckIds(requests.modacks[0].ack_ids()), ElementsAre("n0"));
+}
+
+TEST(AckCoalescerTest, LatestModackWins) {
+  AckCoalescer tested;
+  EXPECT_TRUE(tested.Modack("m0", std::chrono::seconds(10)));
+  EXPECT_TRUE(tested.Modack("m0", std::chrono::seconds(20)));
+  EXPECT_EQ(tested.size(), 1);
+
+  auto requests = tested.Flush("test-subscription", 10);
+  ASSERT_THAT(requests.modacks, SizeIs(1));
+  EXPECT_EQ(requests.modacks[0].ack_deadline_seconds(), 20);
+  EXPECT_THAT(AckIds(requests.modacks[0].ack_ids()), ElementsAre("m0"));
+}
+
+TEST(AckCoalescerTest, SplitsLargeRequests) {
+  AckCoalescer tested;
+  std::vector<std::string> acks;
+  std::vector<std::string> modacks;
+  for (int i = 0; i != 7; ++i) {
+    acks.push_back("a" + std::to_string(i));
+    tested.Ack(acks.back());
+    modacks.push_back("m" + std::to_string(i));
+    tested.Modack(modacks.back(), std::chrono::seconds(10));
+  }
+
+  auto requests = tested.Flush("test-subscription", 3);
+  std::vector<std::string> actual_acks;
+  ASSERT_THAT(requests.acks, SizeIs(3));
+  for (auto const& r : requests.acks) {
+    EXPECT_LE(r.ack_ids_size(), 3);
+    actual_acks.insert(actual_acks.end(), r.ack_ids().begin(),
+                       r.ack_ids().end());
+  }
+  EXPECT_THAT(actual_acks, UnorderedElementsAreArray(acks));
+
+  std::vector<std::string> actual_modacks;
+  ASSERT_THAT(requests.modacks, SizeIs(3));
+  for (auto const& r : requests.modacks) {
+    EXPECT_LE(r.ack_ids_size(), 3);
+    EXPECT_EQ(r.ack_deadline_seconds(), 10);
+    actual_modacks.insert(actual_modacks.end(), r.ack_ids().begin(),
+                          r.ack_ids().end());
+  }
+  EXPECT_THAT(actual_modacks, UnorderedElementsAreArray(modacks));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,59 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/ack_latency_distribution.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+std::chrono::seconds constexpr AckLatencyDistribution::kMaxLatency;
+
+AckLatencyDistribution::AckLatencyDistribution()
+    : buckets_(static_cast<std::size_t>(kMaxLatency.count())) {}
+
+void AckLatencyDistribution::Record(std::chrono::milliseconds latency) {
+  auto const seconds =
+      std::chrono::ceil<std::chrono::seconds>(latency).count();
+  auto const bucket =
+      std::clamp<std::int64_t>(seconds, 1, kMaxLatency.count()) - 1;
+  ++buckets_[static_cast<std::size_t>(bucket)];
+  ++count_;
+}
+
+std::optional<std::chrono::seconds> AckLatencyDistribution::Percentile(
+    double percentile) const {
+  if (count_ == 0) return std::nullopt;
+  percentile = std::clamp(percentile, 0.0, 100.0);
+  auto const target = (std::max)(
+      std::int64_t{1},
+      static_cast<std::int64_t>(std::ceil(count_ * percentile / 100.0)));
+  std::int64_t total = 0;
+  for (std::size_t i = 0; i != buckets_.size(); ++i) {
+    total += buckets_[i];
+    if (total >= target) {
+      return std::chrono::seconds(static_cast<std::int64_t>(i) + 1);
+    }
+  }
+  return kMaxLatency;
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
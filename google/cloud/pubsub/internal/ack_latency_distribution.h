@@ -0,0 +1,67 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_LATENCY_DISTRIBUTION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_LATENCY_DISTRIBUTION_H
+
+#include "google/cloud/pubsub/version.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * A histogram of the time taken to ack or nack messages.
+ *
+ * The latencies are rounded up to whole seconds, and clamped to the range
+ * supported for ack deadlines, that is, between 1 second and 10 minutes. This
+ * class is not thread-safe, the caller must serialize access to it.
+ */
+class AckLatencyDistribution {
+ public:
+  static auto constexpr kMaxLatency = std::chrono::seconds(600);
+
+  AckLatencyDistribution();
+
+  /// Record the time taken to handle a message.
+  void Record(std::chrono::milliseconds latency);
+
+  /**
+   * The smallest latency that is larger than or equal to @p percentile percent
+   * of the recorded latencies.
+   *
+   * Returns an empty optional if nothing has been recorded.
+   */
+  std::optional<std::chrono::seconds> Percentile(double percentile) const;
+
+  /// The number of recorded latencies.
+  std::int64_t count() const { return count_; }
+
+ private:
+  // The number of latencies in each 1-second bucket.
+  std::vector<std::int64_t> buckets_;
+  std::int64_t count_ = 0;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_LATENCY_DISTRIBUTION_H
@@ -0,0 +1,61 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/ack_latency_distribution.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::std::chrono::milliseconds;
+using ::std::chrono::seconds;
+
+TEST(AckLatencyDistributionTest, Empty) {
+  AckLatencyDistribution tested;
+  EXPECT_EQ(tested.count(), 0);
+  EXPECT_FALSE(tested.Percentile(99).has_value());
+}
+
+TEST(AckLatencyDistributionTest, Percentiles) {
+  AckLatencyDistribution tested;
+  for (int i = 1; i <= 100; ++i) tested.Record(seconds(i));
+  EXPECT_EQ(tested.count(), 100);
+  EXPECT_EQ(tested.Percentile(0), seconds(1));
+  EXPECT_EQ(tested.Percentile(50), seconds(50));
+  EXPECT_EQ(tested.Percentile(99), seconds(99));
+  EXPECT_EQ(tested.Percentile(99.5), seconds(100));
+  EXPECT_EQ(tested.Percentile(100), seconds(100));
+  EXPECT_EQ(tested.Percentile(200), seconds(100));
+}
+
+TEST(AckLatencyDistributionTest, RoundsUpAndClamps) {
+  AckLatencyDistribution tested;
+  tested.Record(milliseconds(0));
+  EXPECT_EQ(tested.Percentile(100), seconds(1));
+  tested.Record(milliseconds(1001));
+  EXPECT_EQ(tested.Percentile(100), seconds(2));
+  tested.Record(seconds(3600));
+  EXPECT_EQ(tested.Percentile(100), AckLatencyDistribution::kMaxLatency);
+  EXPECT_EQ(tested.count(), 3);
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,126 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/concurrency_limited_batch_sink.h"
+#include "google/cloud/pubsub/message.h"
+#include "google/cloud/internal/make_status.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+std::size_t RequestSize(google::pubsub::v1::PublishRequest const& request) {
+  return std::accumulate(request.messages().begin(), request.messages().end(),
+                         std::size_t{0},
+                         [](std::size_t a,
+                            google::pubsub::v1::PubsubMessage const& m) {
+                           return a + MessageProtoSize(m);
+                         });
+}
+
+}  // namespace
+
+ConcurrencyLimitedBatchSink::ConcurrencyLimitedBatchSink(
+    std::shared_ptr<BatchSink> sink, std::size_t max_requests,
+    std::size_t max_bytes)
+    : sink_(std::move(sink)),
+      max_requests_((std::max)(max_requests, std::size_t{1})),
+      max_bytes_(max_bytes) {}
+
+ConcurrencyLimitedBatchSink::~ConcurrencyLimitedBatchSink() {
+  // The completions of the in-flight batches can no longer send these.
+  for (auto& pr : queue_) {
+    pr.promise.set_value(internal::CancelledError(
+        "the publisher was destroyed before the batch was sent",
+        GCP_ERROR_INFO()));
+  }
+}
+
+void ConcurrencyLimitedBatchSink::AddMessage(pubsub::Message const& m) {
+  sink_->AddMessage(m);
+}
+
+future<StatusOr<google::pubsub::v1::PublishResponse>>
+ConcurrencyLimitedBatchSink::AsyncPublish(
+    google::pubsub::v1::PublishRequest request) {
+  auto const bytes = RequestSize(request);
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    // Queue behind any pending batches, to send them in order.
+    if (!queue_.empty() || !HasCapacity(bytes, lk)) {
+      // NOLINTNEXTLINE(modernize-use-emplace) - brace initializer
+      queue_.push_back({std::move(request), bytes, {}});
+      return queue_.back().promise.get_future();
+    }
+    ++in_flight_;
+    in_flight_bytes_ += bytes;
+  }
+  return Send(std::move(request), bytes);
+}
+
+void ConcurrencyLimitedBatchSink::ResumePublish(
+    std::string const& ordering_key) {
+  sink_->ResumePublish(ordering_key);
+}
+
+bool ConcurrencyLimitedBatchSink::HasCapacity(
+    std::size_t bytes, std::lock_guard<std::mutex> const&) const {
+  if (in_flight_ == 0) return true;
+  if (in_flight_ >= max_requests_) return false;
+  return max_bytes_ == 0 || in_flight_bytes_ + bytes <= max_bytes_;
+}
+
+future<StatusOr<google::pubsub::v1::PublishResponse>>
+ConcurrencyLimitedBatchSink::Send(PublishRequest request, std::size_t bytes) {
+  auto weak = WeakFromThis();
+  return sink_->AsyncPublish(std::move(request))
+      .then([weak, bytes](future<StatusOr<PublishResponse>> f) {
+        auto r = f.get();
+        if (auto self = weak.lock()) self->OnPublish(bytes);
+        return r;
+      });
+}
+
+void ConcurrencyLimitedBatchSink::OnPublish(std::size_t bytes) {
+  std::vector<PendingRequest> ready;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    --in_flight_;
+    in_flight_bytes_ -= bytes;
+    while (!queue_.empty() && HasCapacity(queue_.front().bytes, lk)) {
+      ++in_flight_;
+      in_flight_bytes_ += queue_.front().bytes;
+      ready.push_back(std::move(queue_.front()));
+      queue_.pop_front();
+    }
+  }
+  for (auto& pr : ready) {
+    Send(std::move(pr.request), pr.bytes)
+        .then([p = std::move(pr.promise)](auto f) mutable {
+          p.set_value(f.get());
+        });
+  }
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,106 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_CONCURRENCY_LIMITED_BATCH_SINK_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_CONCURRENCY_LIMITED_BATCH_SINK_H
+
+#include "google/cloud/pubsub/internal/batch_sink.h"
+#include "google/cloud/pubsub/version.h"
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Limits the number of concurrent batches sent through a `BatchSink`.
+ *
+ * At most `max_requests` batches, with at most `max_bytes` of messages in
+ * total, are in flight at a time. A batch larger than `max_bytes` is sent
+ * when no other batch is in flight. Additional batches are queued, and sent in
+ * order as the previous batches complete.
+ *
+ * The queue is not bounded here. The queued batches are part of the messages
+ * pending in the publisher, so the publisher's flow control bounds them (see
+ * `pubsub::MaxPendingBytesOption`). Batches still queued when the sink is
+ * destroyed fail with `StatusCode::kCancelled`.
+ *
+ * A value of 0 for `max_bytes` disables the byte limit.
+ */
+class ConcurrencyLimitedBatchSink
+    : public BatchSink,
+      public std::enable_shared_from_this<ConcurrencyLimitedBatchSink> {
+ public:
+  static std::shared_ptr<ConcurrencyLimitedBatchSink> Create(
+      std::shared_ptr<BatchSink> sink, std::size_t max_requests,
+      std::size_t max_bytes) {
+    return std::shared_ptr<ConcurrencyLimitedBatchSink>(
+        new ConcurrencyLimitedBatchSink(std::move(sink), max_requests,
+                                        max_bytes));
+  }
+
+  ~ConcurrencyLimitedBatchSink() override;
+
+  void AddMessage(pubsub::Message const& m) override;
+  future<StatusOr<google::pubsub::v1::PublishResponse>> AsyncPublish(
+      google::pubsub::v1::PublishRequest request) override;
+  void ResumePublish(std::string const& ordering_key) override;
+
+  // Useful for testing.
+  std::size_t QueueDepth() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return queue_.size();
+  }
+
+ private:
+  ConcurrencyLimitedBatchSink(std::shared_ptr<BatchSink> sink,
+                              std::size_t max_requests, std::size_t max_bytes);
+
+  using PublishResponse = ::google::pubsub::v1::PublishResponse;
+  using PublishRequest = ::google::pubsub::v1::PublishRequest;
+
+  bool HasCapacity(std::size_t bytes, std::lock_guard<std::mutex> const&) const;
+  future<StatusOr<PublishResponse>> Send(PublishRequest request,
+                                         std::size_t bytes);
+  void OnPublish(std::size_t bytes);
+  std::weak_ptr<ConcurrencyLimitedBatchSink> WeakFromThis() {
+    return shared_from_this();
+  }
+
+  struct PendingRequest {
+    PublishRequest request;
+    std::size_t bytes;
+    google::cloud::promise<StatusOr<PublishResponse>> promise;
+  };
+
+  std::shared_ptr<BatchSink> const sink_;
+  std::size_t const max_requests_;
+  std::size_t const max_bytes_;
+  std::mutex mu_;
+  std::deque<PendingRequest> queue_;
+  std::size_t in_flight_ = 0;
+  std::size_t in_flight_bytes_ = 0;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_CONCURRENCY_LIMITED_BATCH_SINK_H
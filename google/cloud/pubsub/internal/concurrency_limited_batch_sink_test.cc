@@ -0,0 +1,230 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/concurrency_limited_batch_sink.h"
+#include "google/cloud/pubsub/testing/mock_batch_sink.h"
+#include "google/cloud/pubsub/topic.h"
+#include "google/cloud/testing_util/async_sequencer.h"
+#include "google/cloud/testing_util/is_proto_equal.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::testing_util::AsyncSequencer;
+using ::google::cloud::testing_util::IsOk;
+using ::google::cloud::testing_util::IsProtoEqual;
+using ::google::cloud::testing_util::StatusIs;
+
+pubsub::Topic TestTopic() {
+  return pubsub::Topic("test-project", "test-topic");
+}
+
+google::pubsub::v1::PublishRequest MakeRequest(int n,
+                                               std::size_t data_size = 0) {
+  google::pubsub::v1::PublishRequest request;
+  request.set_topic(TestTopic().FullName());
+
+  for (int i = 0; i != n; ++i) {
+    auto& m = *request.add_messages();
+    m.set_message_id("message-" + std::to_string(i));
+    m.set_data(std::string(data_size, 'x'));
+  }
+  return request;
+}
+
+google::pubsub::v1::PublishResponse MakeResponse(
+    google::pubsub::v1::PublishRequest const& request) {
+  google::pubsub::v1::PublishResponse response;
+  for (auto const& m : request.messages()) {
+    response.add_message_ids("id-" + m.message_id());
+  }
+  return response;
+}
+
+std::size_t RequestBytes(google::pubsub::v1::PublishRequest const& request) {
+  std::size_t bytes = 0;
+  for (auto const& m : request.messages()) bytes += MessageProtoSize(m);
+  return bytes;
+}
+
+TEST(ConcurrencyLimitedBatchSinkTest, LimitsRequests) {
+  AsyncSequencer<void> sequencer;
+
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  EXPECT_CALL(*mock, AsyncPublish)
+      .Times(4)
+      .WillRepeatedly([&](google::pubsub::v1::PublishRequest const& r) {
+        return sequencer.PushBack().then(
+            [r](future<void>) { return make_status_or(MakeResponse(r)); });
+      });
+
+  auto uut = ConcurrencyLimitedBatchSink::Create(mock, 2, 0);
+  auto f1 = uut->AsyncPublish(MakeRequest(1));
+  auto f2 = uut->AsyncPublish(MakeRequest(2));
+  auto f3 = uut->AsyncPublish(MakeRequest(3));
+  auto f4 = uut->AsyncPublish(MakeRequest(4));
+  EXPECT_EQ(2, uut->QueueDepth());
+
+  // Completing any request starts the next one in the queue.
+  sequencer.PopFront().set_value();
+  auto r1 = f1.get();
+  ASSERT_THAT(r1, IsOk());
+  EXPECT_THAT(*r1, IsProtoEqual(MakeResponse(MakeRequest(1))));
+  EXPECT_EQ(1, uut->QueueDepth());
+
+  sequencer.PopFront().set_value();
+  auto r2 = f2.get();
+  ASSERT_THAT(r2, IsOk());
+  EXPECT_THAT(*r2, IsProtoEqual(MakeResponse(MakeRequest(2))));
+  EXPECT_EQ(0, uut->QueueDepth());
+
+  sequencer.PopFront().set_value();
+  sequencer.PopFront().set_value();
+  auto r3 = f3.get();
+  ASSERT_THAT(r3, IsOk());
+  EXPECT_THAT(*r3, IsProtoEqual(MakeResponse(MakeRequest(3))));
+  auto r4 = f4.get();
+  ASSERT_THAT(r4, IsOk());
+  EXPECT_THAT(*r4, IsProtoEqual(MakeResponse(MakeRequest(4))));
+}
+
+TEST(ConcurrencyLimitedBatchSinkTest, LimitsBytes) {
+  AsyncSequencer<void> sequencer;
+
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  EXPECT_CALL(*mock, AsyncPublish)
+      .Times(3)
+      .WillRepeatedly([&](google::pubsub::v1::PublishRequest const& r) {
+        return sequencer.PushBack().then(
+            [r](future<void>) { return make_status_or(MakeResponse(r)); });
+      });
+
+  // Two requests fit in the limit, a third one does not.
+  auto const max_bytes = 2 * RequestBytes(MakeRequest(1, 100));
+  auto uut = ConcurrencyLimitedBatchSink::Create(mock, 10, max_bytes);
+  auto f1 = uut->AsyncPublish(MakeRequest(1, 100));
+  auto f2 = uut->AsyncPublish(MakeRequest(1, 100));
+  auto f3 = uut->AsyncPublish(MakeRequest(1, 100));
+  EXPECT_EQ(1, uut->QueueDepth());
+
+  sequencer.PopFront().set_value();
+  ASSERT_THAT(f1.get(), IsOk());
+  EXPECT_EQ(0, uut->QueueDepth());
+  sequencer.PopFront().set_value();
+  ASSERT_THAT(f2.get(), IsOk());
+  sequencer.PopFront().set_value();
+  ASSERT_THAT(f3.get(), IsOk());
+}
+
+TEST(ConcurrencyLimitedBatchSinkTest, LargeRequest) {
+  AsyncSequencer<void> sequencer;
+
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  EXPECT_CALL(*mock, AsyncPublish)
+      .Times(2)
+      .WillRepeatedly([&](google::pubsub::v1::PublishRequest const& r) {
+        return sequencer.PushBack().then(
+            [r](future<void>) { return make_status_or(MakeResponse(r)); });
+      });
+
+  // A request larger than the limit is sent when nothing else is in flight.
+  auto uut = ConcurrencyLimitedBatchSink::Create(mock, 10, 16);
+  auto f1 = uut->AsyncPublish(MakeRequest(2, 100));
+  auto f2 = uut->AsyncPublish(MakeRequest(2, 100));
+  EXPECT_EQ(1, uut->QueueDepth());
+
+  sequencer.PopFront().set_value();
+  ASSERT_THAT(f1.get(), IsOk());
+  EXPECT_EQ(0, uut->QueueDepth());
+  sequencer.PopFront().set_value();
+  ASSERT_THAT(f2.get(), IsOk());
+}
+
+TEST(ConcurrencyLimitedBatchSinkTest, ErrorsReleaseCapacity) {
+  AsyncSequencer<void> sequencer;
+
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([&](google::pubsub::v1::PublishRequest const&) {
+        return sequencer.PushBack().then([](future<void>) {
+          return StatusOr<google::pubsub::v1::PublishResponse>(
+              Status{StatusCode::kPermissionDenied, "uh-oh"});
+        });
+      })
+      .WillOnce([&](google::pubsub::v1::PublishRequest const& r) {
+        return sequencer.PushBack().then(
+            [r](future<void>) { return make_status_or(MakeResponse(r)); });
+      });
+
+  auto uut = ConcurrencyLimitedBatchSink::Create(mock, 1, 0);
+  auto f1 = uut->AsyncPublish(MakeRequest(1));
+  auto f2 = uut->AsyncPublish(MakeRequest(2));
+  EXPECT_EQ(1, uut->QueueDepth());
+
+  sequencer.PopFront().set_value();
+  EXPECT_THAT(f1.get(), StatusIs(StatusCode::kPermissionDenied, "uh-oh"));
+  EXPECT_EQ(0, uut->QueueDepth());
+  sequencer.PopFront().set_value();
+  auto r2 = f2.get();
+  ASSERT_THAT(r2, IsOk());
+  EXPECT_THAT(*r2, IsProtoEqual(MakeResponse(MakeRequest(2))));
+}
+
+TEST(ConcurrencyLimitedBatchSinkTest, DestroyFailsQueuedRequests) {
+  AsyncSequencer<void> sequencer;
+
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([&](google::pubsub::v1::PublishRequest const& r) {
+        return sequencer.PushBack().then(
+            [r](future<void>) { return make_status_or(MakeResponse(r)); });
+      });
+
+  auto uut = ConcurrencyLimitedBatchSink::Create(mock, 1, 0);
+  auto f1 = uut->AsyncPublish(MakeRequest(1));
+  auto f2 = uut->AsyncPublish(MakeRequest(2));
+  EXPECT_EQ(1, uut->QueueDepth());
+
+  // Nothing can send the queued request once the sink is gone.
+  uut.reset();
+  EXPECT_THAT(f2.get(), StatusIs(StatusCode::kCancelled));
+
+  // The in-flight request still completes.
+  sequencer.PopFront().set_value();
+  auto r1 = f1.get();
+  ASSERT_THAT(r1, IsOk());
+  EXPECT_THAT(*r1, IsProtoEqual(MakeResponse(MakeRequest(1))));
+}
+
+TEST(ConcurrencyLimitedBatchSinkTest, ForwardsToChild) {
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  EXPECT_CALL(*mock, AddMessage).Times(1);
+  EXPECT_CALL(*mock, ResumePublish("test-key")).Times(1);
+
+  auto uut = ConcurrencyLimitedBatchSink::Create(mock, 1, 0);
+  uut->AddMessage(pubsub::MessageBuilder().SetData("test-data").Build());
+  uut->ResumePublish("test-key");
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,204 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/sharded_batching_publisher_connection.h"
+#include "google/cloud/pubsub/options.h"
+#include "google/cloud/internal/make_status.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+// Satisfies the waiters for the messages in a request.
+struct ShardedBatch {
+  std::vector<promise<StatusOr<std::string>>> waiters;
+
+  void operator()(future<StatusOr<google::pubsub::v1::PublishResponse>> f) {
+    auto response = f.get();
+    if (!response) return SatisfyAllWaiters(response.status());
+    if (static_cast<std::size_t>(response->message_ids_size()) !=
+        waiters.size()) {
+      return SatisfyAllWaiters(internal::UnknownError(
+          "mismatched message id count", GCP_ERROR_INFO()));
+    }
+    int idx = 0;
+    for (auto& w : waiters) {
+      w.set_value(std::move(*response->mutable_message_ids(idx++)));
+    }
+  }
+
+  void SatisfyAllWaiters(Status const& status) {
+    for (auto& w : waiters) w.set_value(status);
+  }
+};
+
+}  // namespace
+
+ShardedBatchingPublisherConnection::ShardedBatchingPublisherConnection(
+    pubsub::Topic const& topic, Options opts, std::size_t shards,
+    std::shared_ptr<BatchSink> sink, CompletionQueue cq)
+    : topic_full_name_(topic.FullName()),
+      opts_(std::move(opts)),
+      max_batch_messages_(opts_.get<pubsub::MaxBatchMessagesOption>()),
+      max_batch_bytes_(opts_.get<pubsub::MaxBatchBytesOption>()),
+      sink_(std::move(sink)),
+      cq_(std::move(cq)),
+      shards_([shards] {
+        std::vector<std::unique_ptr<Shard>> v(
+            (std::max)(shards, std::size_t{1}));
+        for (auto& s : v) s = std::make_unique<Shard>();
+        return v;
+      }()) {}
+
+ShardedBatchingPublisherConnection::~ShardedBatchingPublisherConnection() {
+  std::lock_guard<std::mutex> lk(flush_mu_);
+  if (timer_.valid()) timer_.cancel();
+}
+
+future<StatusOr<std::string>> ShardedBatchingPublisherConnection::Publish(
+    PublishParams p) {
+  sink_->AddMessage(p.message);
+  auto const bytes = MessageSize(p.message);
+  PendingMessage pending{ToProto(std::move(p.message)), bytes, {}};
+  auto f = pending.waiter.get_future();
+  auto& shard = CurrentShard();
+  std::int64_t messages;
+  std::int64_t total_bytes;
+  {
+    // Count the message with the shard locked, so a flush that drains the
+    // message also sees it in the totals.
+    std::lock_guard<std::mutex> lk(shard.mu);
+    shard.pending.push_back(std::move(pending));
+    messages = ++pending_messages_;
+    total_bytes = pending_bytes_ += static_cast<std::int64_t>(bytes);
+  }
+  if (messages >= static_cast<std::int64_t>(max_batch_messages_) ||
+      total_bytes >= static_cast<std::int64_t>(max_batch_bytes_)) {
+    ScheduleFlush();
+  } else if (messages == 1) {
+    StartTimer();
+  }
+  return f;
+}
+
+void ShardedBatchingPublisherConnection::Flush(FlushParams) {
+  FlushImpl(std::unique_lock<std::mutex>(flush_mu_));
+}
+
+ShardedBatchingPublisherConnection::Shard&
+ShardedBatchingPublisherConnection::CurrentShard() {
+  auto const h = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  return *shards_[h % shards_.size()];
+}
+
+void ShardedBatchingPublisherConnection::StartTimer() {
+  std::unique_lock<std::mutex> lk(flush_mu_);
+  auto const expiration = batch_expiration_ =
+      std::chrono::system_clock::now() + opts_.get<pubsub::MaxHoldTimeOption>();
+  lk.unlock();
+  // A weak_ptr<> avoids a cycle, as this class owns the completion queue.
+  auto weak =
+      std::weak_ptr<ShardedBatchingPublisherConnection>(shared_from_this());
+  auto timer =
+      cq_.MakeDeadlineTimer(expiration)
+          .then(
+              [weak](future<StatusOr<std::chrono::system_clock::time_point>>) {
+                if (auto self = weak.lock()) self->OnTimer();
+              });
+  lk.lock();
+  timer_ = std::move(timer);
+}
+
+void ShardedBatchingPublisherConnection::OnTimer() {
+  std::unique_lock<std::mutex> lk(flush_mu_);
+  // Timers for batches that were flushed because they were full are not
+  // canceled, ignore them.
+  if (std::chrono::system_clock::now() < batch_expiration_) return;
+  FlushImpl(std::move(lk));
+}
+
+void ShardedBatchingPublisherConnection::ScheduleFlush() {
+  if (flush_scheduled_.exchange(true)) return;
+  auto weak =
+      std::weak_ptr<ShardedBatchingPublisherConnection>(shared_from_this());
+  cq_.RunAsync([weak] {
+    auto self = weak.lock();
+    if (!self) return;
+    self->flush_scheduled_ = false;
+    self->FlushImpl(std::unique_lock<std::mutex>(self->flush_mu_));
+  });
+}
+
+void ShardedBatchingPublisherConnection::FlushImpl(
+    std::unique_lock<std::mutex> lk) {
+  std::vector<PendingMessage> drained;
+  for (auto& shard : shards_) {
+    std::unique_lock<std::mutex> shard_lk(shard->mu);
+    if (drained.empty()) {
+      drained.swap(shard->pending);
+      continue;
+    }
+    std::move(shard->pending.begin(), shard->pending.end(),
+              std::back_inserter(drained));
+    shard->pending.clear();
+  }
+  std::int64_t drained_bytes = 0;
+  for (auto const& m : drained) {
+    drained_bytes += static_cast<std::int64_t>(m.bytes);
+  }
+  auto const remaining = pending_messages_ -=
+      static_cast<std::int64_t>(drained.size());
+  pending_bytes_ -= drained_bytes;
+  lk.unlock();
+  // Messages added to a shard after it was drained are still pending. Their
+  // publishers did not see an empty batch, so no one else starts the timer.
+  if (remaining > 0) StartTimer();
+
+  // Split the merged messages into requests within the batch limits. As in
+  // `BatchingPublisherConnection`, an oversized message gets its own request.
+  google::pubsub::v1::PublishRequest request;
+  ShardedBatch batch;
+  std::size_t request_bytes = 0;
+  auto send = [&] {
+    if (batch.waiters.empty()) return;
+    request.set_topic(topic_full_name_);
+    sink_->AsyncPublish(std::move(request)).then(std::move(batch));
+    request = {};
+    batch = {};
+    request_bytes = 0;
+  };
+  for (auto& m : drained) {
+    if (!batch.waiters.empty() &&
+        (batch.waiters.size() >= max_batch_messages_ ||
+         request_bytes + m.bytes > max_batch_bytes_)) {
+      send();
+    }
+    *request.add_messages() = std::move(m.message);
+    batch.waiters.push_back(std::move(m.waiter));
+    request_bytes += m.bytes;
+  }
+  send();
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,117 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SHARDED_BATCHING_PUBLISHER_CONNECTION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SHARDED_BATCHING_PUBLISHER_CONNECTION_H
+
+#include "google/cloud/pubsub/internal/batch_sink.h"
+#include "google/cloud/pubsub/publisher_connection.h"
+#include "google/cloud/pubsub/version.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * A batching publisher for many concurrent publishing threads.
+ *
+ * `BatchingPublisherConnection` keeps a single pending batch, guarded by a
+ * single mutex. When many threads publish to the same topic they contend on
+ * this mutex. This class keeps one partial batch per shard, and each thread
+ * adds its messages to the shard selected by its thread id. The shards are
+ * merged when the batch is flushed, and split again into requests that respect
+ * the `MaxBatchMessagesOption` and `MaxBatchBytesOption` limits. The limits,
+ * and `MaxHoldTimeOption`, apply to the sum of all the shards.
+ *
+ * Batches flushed because they are full are sent from the completion queue
+ * threads, not from the publishing threads.
+ *
+ * This class does not support ordering keys.
+ */
+class ShardedBatchingPublisherConnection
+    : public pubsub::PublisherConnection,
+      public std::enable_shared_from_this<ShardedBatchingPublisherConnection> {
+ public:
+  ~ShardedBatchingPublisherConnection() override;
+
+  static std::shared_ptr<ShardedBatchingPublisherConnection> Create(
+      pubsub::Topic topic, Options opts, std::size_t shards,
+      std::shared_ptr<BatchSink> sink, CompletionQueue cq) {
+    return std::shared_ptr<ShardedBatchingPublisherConnection>(
+        new ShardedBatchingPublisherConnection(std::move(topic),
+                                               std::move(opts), shards,
+                                               std::move(sink), std::move(cq)));
+  }
+
+  future<StatusOr<std::string>> Publish(PublishParams p) override;
+  void Flush(FlushParams) override;
+
+ private:
+  ShardedBatchingPublisherConnection(pubsub::Topic const& topic, Options opts,
+                                     std::size_t shards,
+                                     std::shared_ptr<BatchSink> sink,
+                                     CompletionQueue cq);
+
+  struct PendingMessage {
+    google::pubsub::v1::PubsubMessage message;
+    std::size_t bytes;
+    promise<StatusOr<std::string>> waiter;
+  };
+
+  struct Shard {
+    std::mutex mu;
+    std::vector<PendingMessage> pending;  // GUARDED_BY(mu)
+  };
+
+  Shard& CurrentShard();
+  void StartTimer();
+  void OnTimer();
+  void ScheduleFlush();
+  void FlushImpl(std::unique_lock<std::mutex> lk);
+
+  std::string const topic_full_name_;
+  Options const opts_;
+  std::size_t const max_batch_messages_;
+  std::size_t const max_batch_bytes_;
+  std::shared_ptr<BatchSink> const sink_;
+  CompletionQueue cq_;
+  std::vector<std::unique_ptr<Shard>> const shards_;
+
+  // The totals across all the shards. Publishers update them with the shard
+  // locked, so they include every message in the shards.
+  std::atomic<std::int64_t> pending_messages_{0};
+  std::atomic<std::int64_t> pending_bytes_{0};
+  std::atomic<bool> flush_scheduled_{false};
+
+  // Serializes flushes, and guards the batch timer.
+  std::mutex flush_mu_;
+  std::chrono::system_clock::time_point batch_expiration_;
+  future<void> timer_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SHARDED_BATCHING_PUBLISHER_CONNECTION_H
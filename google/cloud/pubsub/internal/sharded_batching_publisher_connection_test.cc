@@ -0,0 +1,293 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/sharded_batching_publisher_connection.h"
+#include "google/cloud/pubsub/internal/defaults.h"
+#include "google/cloud/pubsub/options.h"
+#include "google/cloud/pubsub/testing/mock_batch_sink.h"
+#include "google/cloud/future.h"
+#include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::_;
+using ::testing::AtLeast;
+using ::testing::HasSubstr;
+using ::testing::UnorderedElementsAre;
+
+auto constexpr kShards = 4;
+
+std::vector<std::string> MessagesData(
+    google::pubsub::v1::PublishRequest const& request) {
+  std::vector<std::string> data(request.messages_size());
+  std::transform(request.messages().begin(), request.messages().end(),
+                 data.begin(), [](google::pubsub::v1::PubsubMessage const& m) {
+                   return std::string(m.data());
+                 });
+  return data;
+}
+
+future<StatusOr<google::pubsub::v1::PublishResponse>> AckForData(
+    google::pubsub::v1::PublishRequest const& request) {
+  google::pubsub::v1::PublishResponse response;
+  for (auto const& m : request.messages()) {
+    response.add_message_ids("ack-for-" + std::string(m.data()));
+  }
+  return make_ready_future(make_status_or(response));
+}
+
+future<Status> PublishData(ShardedBatchingPublisherConnection& publisher,
+                           std::string const& data) {
+  return publisher.Publish({pubsub::MessageBuilder{}.SetData(data).Build()})
+      .then([data](future<StatusOr<std::string>> f) {
+        auto r = f.get();
+        if (!r) return std::move(r).status();
+        EXPECT_EQ("ack-for-" + data, *r);
+        return Status{};
+      });
+}
+
+TEST(ShardedBatchingPublisherConnectionTest, MergesShards) {
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  EXPECT_CALL(*mock, AddMessage(_)).Times(AtLeast(1));
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([&](google::pubsub::v1::PublishRequest const& request) {
+        EXPECT_EQ(topic.FullName(), request.topic());
+        EXPECT_THAT(MessagesData(request),
+                    UnorderedElementsAre("test-data-0", "test-data-1",
+                                         "test-data-2", "test-data-3"));
+        return AckForData(request);
+      });
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  // Make these so large that only `Flush()` sends the messages.
+  auto publisher = ShardedBatchingPublisherConnection::Create(
+      topic,
+      DefaultPublisherOptions(
+          Options{}
+              .set<pubsub::MaxBatchMessagesOption>(100)
+              .set<pubsub::MaxHoldTimeOption>(std::chrono::hours(24))),
+      kShards, mock, background.cq());
+
+  // Publish from different threads, so the messages likely use different
+  // shards.
+  std::vector<future<Status>> results(4);
+  std::vector<std::thread> workers;
+  for (int i = 0; i != 4; ++i) {
+    workers.emplace_back([&results, &publisher, i] {
+      results[i] = PublishData(*publisher, "test-data-" + std::to_string(i));
+    });
+  }
+  for (auto& w : workers) w.join();
+  publisher->Flush({});
+  for (auto& r : results) EXPECT_STATUS_OK(r.get());
+}
+
+TEST(ShardedBatchingPublisherConnectionTest, BatchByMessageCount) {
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  EXPECT_CALL(*mock, AddMessage(_)).Times(AtLeast(1));
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([&](google::pubsub::v1::PublishRequest const& request) {
+        EXPECT_EQ(topic.FullName(), request.topic());
+        EXPECT_THAT(MessagesData(request),
+                    UnorderedElementsAre("test-data-0", "test-data-1"));
+        return AckForData(request);
+      });
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto publisher = ShardedBatchingPublisherConnection::Create(
+      topic,
+      DefaultPublisherOptions(
+          Options{}
+              .set<pubsub::MaxBatchMessagesOption>(2)
+              .set<pubsub::MaxHoldTimeOption>(std::chrono::hours(24))),
+      kShards, mock, background.cq());
+
+  auto r0 = PublishData(*publisher, "test-data-0");
+  auto r1 = PublishData(*publisher, "test-data-1");
+  EXPECT_STATUS_OK(r0.get());
+  EXPECT_STATUS_OK(r1.get());
+  background.cq().CancelAll();
+}
+
+TEST(ShardedBatchingPublisherConnectionTest, BatchByMaximumHoldTime) {
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  EXPECT_CALL(*mock, AddMessage(_)).Times(AtLeast(1));
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([&](google::pubsub::v1::PublishRequest const& request) {
+        EXPECT_THAT(MessagesData(request),
+                    UnorderedElementsAre("test-data-0", "test-data-1"));
+        return AckForData(request);
+      });
+
+  // Start with an inactive completion queue, so both messages are pending when
+  // the timer expires.
+  CompletionQueue cq;
+  auto publisher = ShardedBatchingPublisherConnection::Create(
+      topic,
+      DefaultPublisherOptions(
+          Options{}
+              .set<pubsub::MaxBatchMessagesOption>(4)
+              .set<pubsub::MaxHoldTimeOption>(std::chrono::milliseconds(5))),
+      kShards, mock, cq);
+  auto r0 = PublishData(*publisher, "test-data-0");
+  auto r1 = PublishData(*publisher, "test-data-1");
+
+  std::thread t{[](CompletionQueue cq) { cq.Run(); }, cq};
+  EXPECT_STATUS_OK(r0.get());
+  EXPECT_STATUS_OK(r1.get());
+  cq.Shutdown();
+  t.join();
+}
+
+TEST(ShardedBatchingPublisherConnectionTest, PublishDuringTimerFlush) {
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  EXPECT_CALL(*mock, AddMessage(_)).Times(AtLeast(1));
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillRepeatedly([](google::pubsub::v1::PublishRequest const& request) {
+        return AckForData(request);
+      });
+
+  // Only the timer flushes the messages, and it fires often, so many messages
+  // are added to a shard after a flush has drained it. Those must not wait for
+  // the next publisher to start the timer.
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background(4);
+  auto publisher = ShardedBatchingPublisherConnection::Create(
+      topic,
+      DefaultPublisherOptions(
+          Options{}
+              .set<pubsub::MaxBatchMessagesOption>(1000 * 1000)
+              .set<pubsub::MaxBatchBytesOption>(1000 * 1000 * 1000)
+              .set<pubsub::MaxHoldTimeOption>(std::chrono::microseconds(100))),
+      kShards, mock, background.cq());
+
+  auto constexpr kThreads = 8;
+  auto constexpr kIterations = 500;
+  auto worker = [&](int id) {
+    std::vector<future<Status>> results;
+    for (int i = 0; i != kIterations; ++i) {
+      results.push_back(PublishData(
+          *publisher, std::to_string(id) + "-" + std::to_string(i)));
+    }
+    for (auto& r : results) {
+      ASSERT_EQ(r.wait_for(std::chrono::seconds(30)),
+                std::future_status::ready);
+      EXPECT_STATUS_OK(r.get());
+    }
+  };
+  std::vector<std::thread> workers;
+  for (int i = 0; i != kThreads; ++i) workers.emplace_back(worker, i);
+  for (auto& w : workers) w.join();
+}
+
+TEST(ShardedBatchingPublisherConnectionTest, BatchTorture) {
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  auto constexpr kMaxMessages = 20;
+  auto constexpr kMaxPayload = 16 * 1024;
+  auto constexpr kPayload = 1024;
+
+  std::atomic<int> published{0};
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  EXPECT_CALL(*mock, AddMessage(_)).Times(AtLeast(1));
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillRepeatedly([&](google::pubsub::v1::PublishRequest const& request) {
+        EXPECT_EQ(topic.FullName(), request.topic());
+        EXPECT_LE(request.messages_size(), kMaxMessages);
+        std::size_t size = 0;
+        for (auto const& m : request.messages()) size += MessageProtoSize(m);
+        EXPECT_LE(size, kMaxPayload);
+        published += request.messages_size();
+        return AckForData(request);
+      });
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background(4);
+  auto publisher = ShardedBatchingPublisherConnection::Create(
+      topic,
+      DefaultPublisherOptions(
+          Options{}
+              .set<pubsub::MaxBatchMessagesOption>(kMaxMessages)
+              .set<pubsub::MaxBatchBytesOption>(kMaxPayload)),
+      kShards, mock, background.cq());
+
+  auto constexpr kThreads = 8;
+  auto constexpr kIterations = 500;
+  auto worker = [&](int id) {
+    std::vector<future<Status>> results;
+    for (int i = 0; i != kIterations; ++i) {
+      auto data = std::to_string(id) + "-" + std::to_string(i);
+      data.resize(kPayload, '.');
+      results.push_back(PublishData(*publisher, data));
+    }
+    for (auto& r : results) EXPECT_STATUS_OK(r.get());
+  };
+  std::vector<std::thread> workers;
+  for (int i = 0; i != kThreads; ++i) workers.emplace_back(worker, i);
+  for (auto& w : workers) w.join();
+  EXPECT_EQ(published.load(), kThreads * kIterations);
+}
+
+TEST(ShardedBatchingPublisherConnectionTest, HandleError) {
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  auto const error_status = Status(StatusCode::kPermissionDenied, "uh-oh");
+  EXPECT_CALL(*mock, AddMessage(_)).Times(AtLeast(1));
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillRepeatedly([&](google::pubsub::v1::PublishRequest const&) {
+        return make_ready_future(
+            StatusOr<google::pubsub::v1::PublishResponse>(error_status));
+      });
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto publisher = ShardedBatchingPublisherConnection::Create(
+      topic,
+      DefaultPublisherOptions(Options{}.set<pubsub::MaxBatchMessagesOption>(2)),
+      kShards, mock, background.cq());
+  auto r0 = PublishData(*publisher, "test-data-0");
+  auto r1 = PublishData(*publisher, "test-data-1");
+
+  EXPECT_THAT(r0.get(),
+              StatusIs(StatusCode::kPermissionDenied, HasSubstr("uh-oh")));
+  EXPECT_THAT(r1.get(),
+              StatusIs(StatusCode::kPermissionDenied, HasSubstr("uh-oh")));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -15,6 +15,7 @@
 #include "google/cloud/pubsub/internal/streaming_subscription_batch_source.h"
 #include "google/cloud/pubsub/internal/exactly_once_policies.h"
 #include "google/cloud/pubsub/internal/extend_leases_with_retry.h"
+#include "google/cloud/pubsub/message.h"
 #include "google/cloud/pubsub/options.h"
 #include "google/cloud/internal/async_retry_loop.h"
 #include "google/cloud/internal/make_status.h"
@@ -29,6 +30,7 @@ namespace cloud {
 namespace pubsub_internal {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
+
 // NOLINTNEXTLINE(misc-no-recursion)
 future<std::vector<Status>> WaitAll(std::vector<future<Status>> v) {
   if (v.empty()) return make_ready_future(std::vector<Status>{});
@@ -58,7 +60,8 @@ StreamingSubscriptionBatchSource::StreamingSubscriptionBatchSource(
     CompletionQueue cq,
     std::shared_ptr<SessionShutdownManager> shutdown_manager,
     std::shared_ptr<SubscriberStub> stub, std::string subscription_full_name,
-    std::string client_id, Options opts)
+    std::string client_id, Options opts,
+    std::shared_ptr<SubscriberMemoryBudget> memory_budget)
     : cq_(std::move(cq)),
       shutdown_manager_(std::move(shutdown_manager)),
       stub_(std::move(stub)),
@@ -70,7 +73,18 @@ StreamingSubscriptionBatchSource::StreamingSubscriptionBatchSource(
       max_outstanding_bytes_(
           options_->get<pubsub::MaxOutstandingBytesOption>()),
       min_deadline_time_(options_->get<pubsub::MinDeadlineExtensionOption>()),
-      max_deadline_time_(options_->get<pubsub::MaxDeadlineTimeOption>()) {}
+      max_deadline_time_(options_->get<pubsub::MaxDeadlineTimeOption>()),
+      ack_hold_time_(options_->get<pubsub::MaxAckHoldTimeOption>()),
+      ack_hold_count_(options_->get<pubsub::MaxAckHoldCountOption>() == 0
+                          ? kMaxAckIdsPerMessage
+                          : options_->get<pubsub::MaxAckHoldCountOption>()),
+      memory_limit_(options_->get<pubsub::SubscriberMemoryBudgetOption>()),
+      memory_budget_(std::move(memory_budget)) {}
+
+StreamingSubscriptionBatchSource::~StreamingSubscriptionBatchSource() {
+  // Return the budget of any messages that were never acked or nacked.
+  for (auto const& kv : message_bytes_) memory_budget_->Release(kv.second);
+}
 
 void StreamingSubscriptionBatchSource::Start(
     std::shared_ptr<BatchCallback> callback) {
@@ -88,10 +102,19 @@ void StreamingSubscriptionBatchSource::Start(
 void StreamingSubscriptionBatchSource::Shutdown() {
   internal::OptionsSpan span(options_);
 
+  // Send any buffered acknowledgements, the application may still produce
+  // more, and those are sent when the hold time expires.
+  FlushAcks(std::unique_lock<std::mutex>(mu_));
+
   std::unique_lock<std::mutex> lk(mu_);
   if (shutdown_ || !stream_) return;
   shutdown_ = true;
   if (stream_) stream_->Cancel();
+  if (!read_paused_) return;
+  // Drain the canceled stream, even if the subscriber is over its budget.
+  read_paused_ = false;
+  lk.unlock();
+  ReadLoop();
 }
 
 future<Status> StreamingSubscriptionBatchSource::AckMessage(
@@ -102,6 +125,13 @@ future<Status> StreamingSubscriptionBatchSource::AckMessage(
   *request.add_ack_ids() = ack_id;
 
   std::unique_lock<std::mutex> lk(mu_);
+  ReleaseMemory(ack_id, lk);
+  if (CoalesceAcks(lk)) {
+    auto const canceled = coalescer_.Ack(ack_id);
+    OnCoalescedAck(std::move(lk));
+    if (canceled) callback_->ModackEnd(ack_id);
+    return make_ready_future(Status{});
+  }
   if (exactly_once_delivery_enabled_.value_or(false)) {
     lk.unlock();
     auto retry = std::make_unique<ExactlyOnceRetryPolicy>(ack_id);
@@ -141,6 +171,13 @@ future<Status> StreamingSubscriptionBatchSource::NackMessage(
   request.set_ack_deadline_seconds(0);
 
   std::unique_lock<std::mutex> lk(mu_);
+  ReleaseMemory(ack_id, lk);
+  if (CoalesceAcks(lk)) {
+    auto const canceled = coalescer_.Nack(ack_id);
+    OnCoalescedAck(std::move(lk));
+    if (canceled) callback_->ModackEnd(ack_id);
+    return make_ready_future(Status{});
+  }
   if (exactly_once_delivery_enabled_.value_or(false)) {
     lk.unlock();
     auto retry = std::make_unique<ExactlyOnceRetryPolicy>(ack_id);
@@ -173,6 +210,10 @@ future<Status> StreamingSubscriptionBatchSource::NackMessage(
 
 future<Status> StreamingSubscriptionBatchSource::BulkNack(
     std::vector<std::string> ack_ids) {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (auto const& a : ack_ids) ReleaseMemory(a, lk);
+  }
   google::pubsub::v1::ModifyAckDeadlineRequest request;
   request.set_subscription(subscription_full_name_);
   for (auto& a : ack_ids) *request.add_ack_ids() = std::move(a);
@@ -222,6 +263,15 @@ void StreamingSubscriptionBatchSource::ExtendLeases(
     request.add_ack_ids(std::move(a));
   }
   std::unique_lock<std::mutex> lk(mu_);
+  if (CoalesceAcks(lk)) {
+    std::vector<std::string> dropped;
+    for (auto const& a : request.ack_ids()) {
+      if (!coalescer_.Modack(a, extension)) dropped.push_back(a);
+    }
+    OnCoalescedAck(std::move(lk));
+    for (auto const& a : dropped) callback_->ModackEnd(a);
+    return;
+  }
   auto split = SplitModifyAckDeadline(request, kMaxAckIdsPerMessage);
   if (exactly_once_delivery_enabled_.value_or(false)) {
     lk.unlock();
@@ -421,6 +471,10 @@ void StreamingSubscriptionBatchSource::OnRetryFailure(Status status) {
 void StreamingSubscriptionBatchSource::ReadLoop() {
   std::unique_lock<std::mutex> lk(mu_);
   if (stream_state_ != StreamState::kActive) return;
+  if (memory_limit_ != 0 && !shutdown_ &&
+      memory_budget_->Exceeds(memory_limit_)) {
+    return PauseRead(std::move(lk));
+  }
   pending_read_ = true;
   auto stream = stream_;
   lk.unlock();
@@ -431,6 +485,33 @@ void StreamingSubscriptionBatchSource::ReadLoop() {
   });
 }
 
+void StreamingSubscriptionBatchSource::PauseRead(
+    std::unique_lock<std::mutex> lk) {
+  read_paused_ = true;
+  // Acks and nacks from this subscriber resume reading, but other subscribers
+  // may also release their budget.
+  if (budget_waiter_pending_) return;
+  budget_waiter_pending_ = true;
+  lk.unlock();
+  // The budget may call this with the locks of another subscriber held, so
+  // do not resume reading in the calling thread.
+  memory_budget_->NotifyBelow(
+      memory_limit_, [cq = cq_, weak = WeakFromThis()]() mutable {
+        cq.RunAsync([weak] {
+          if (auto self = weak.lock()) self->OnMemoryReleased();
+        });
+      });
+}
+
+void StreamingSubscriptionBatchSource::OnMemoryReleased() {
+  std::unique_lock<std::mutex> lk(mu_);
+  budget_waiter_pending_ = false;
+  if (!read_paused_) return;
+  read_paused_ = false;
+  lk.unlock();
+  ReadLoop();
+}
+
 void StreamingSubscriptionBatchSource::OnRead(
     std::optional<google::pubsub::v1::StreamingPullResponse> response) {
   auto weak = WeakFromThis();
@@ -446,6 +527,7 @@ void StreamingSubscriptionBatchSource::OnRead(
         update_stream_deadline = true;
       }
     }
+    AcquireMemory(*response, lk);
     lk.unlock();
     callback_->callback(
         BatchCallback::StreamingPullResponse{*std::move(response)});
@@ -467,6 +549,8 @@ void StreamingSubscriptionBatchSource::ShutdownStream(
     return;
   }
   ChangeState(lk, StreamState::kDisconnecting, __func__, reason);
+  // A paused stream has no pending reads, and must not resume reading.
+  read_paused_ = false;
   if (pending_read_ || pending_write_) return;
 
   auto stream = stream_;
@@ -558,6 +642,96 @@ void StreamingSubscriptionBatchSource::ChangeState(
   stream_state_ = s;
 }
 
+bool StreamingSubscriptionBatchSource::CoalesceAcks(
+    std::unique_lock<std::mutex> const&) const {
+  return ack_hold_time_.count() != 0 &&
+         !exactly_once_delivery_enabled_.value_or(false);
+}
+
+void StreamingSubscriptionBatchSource::OnCoalescedAck(
+    std::unique_lock<std::mutex> lk) {
+  if (coalescer_.size() >= ack_hold_count_) return FlushAcks(std::move(lk));
+  if (flush_scheduled_) return;
+  flush_scheduled_ = true;
+  lk.unlock();
+  // Keep the source alive until the timer expires, so the buffered acks are
+  // sent even if the session is destroyed.
+  cq_.MakeRelativeTimer(ack_hold_time_).then([self = shared_from_this()](auto) {
+    self->FlushAcks(std::unique_lock<std::mutex>(self->mu_));
+  });
+}
+
+void StreamingSubscriptionBatchSource::FlushAcks(
+    std::unique_lock<std::mutex> lk) {
+  flush_scheduled_ = false;
+  if (coalescer_.empty()) return;
+  auto requests =
+      coalescer_.Flush(subscription_full_name_, kMaxAckIdsPerMessage);
+  lk.unlock();
+
+  for (auto& r : requests.acks) {
+    (void)stub_
+        ->AsyncAcknowledge(cq_, std::make_shared<grpc::ClientContext>(),
+                           options_, r)
+        .then([cb = callback_, r](auto f) {
+          auto result = f.get();
+          for (auto const& ack_id : r.ack_ids()) cb->AckEnd(ack_id);
+          return result;
+        });
+  }
+  for (auto& r : requests.modacks) {
+    if (r.ack_deadline_seconds() == 0) {
+      (void)stub_
+          ->AsyncModifyAckDeadline(
+              cq_, std::make_shared<grpc::ClientContext>(), options_, r)
+          .then([cb = callback_, r](auto f) {
+            auto result = f.get();
+            for (auto const& ack_id : r.ack_ids()) cb->NackEnd(ack_id);
+            return result;
+          });
+      continue;
+    }
+    Span modack_span = callback_->StartModackSpan(r);
+    (void)stub_
+        ->AsyncModifyAckDeadline(cq_, std::make_shared<grpc::ClientContext>(),
+                                 options_, r)
+        .then([cb = callback_, modack_span, r](auto f) {
+          auto result = f.get();
+          for (auto const& ack_id : r.ack_ids()) cb->ModackEnd(ack_id);
+          cb->EndModackSpan(modack_span);
+          return result;
+        });
+  }
+}
+
+void StreamingSubscriptionBatchSource::AcquireMemory(
+    google::pubsub::v1::StreamingPullResponse const& response,
+    std::unique_lock<std::mutex> const&) {
+  if (memory_limit_ == 0) return;
+  std::size_t total = 0;
+  for (auto const& m : response.received_messages()) {
+    auto const bytes = MessageProtoSize(m.message());
+    if (!message_bytes_.emplace(m.ack_id(), bytes).second) continue;
+    total += bytes;
+  }
+  memory_budget_->Acquire(total);
+}
+
+void StreamingSubscriptionBatchSource::ReleaseMemory(
+    std::string const& ack_id, std::unique_lock<std::mutex> const&) {
+  if (memory_limit_ == 0) return;
+  auto i = message_bytes_.find(ack_id);
+  if (i == message_bytes_.end()) return;
+  memory_budget_->Release(i->second);
+  message_bytes_.erase(i);
+  if (!read_paused_ || memory_budget_->Exceeds(memory_limit_)) return;
+  read_paused_ = false;
+  auto weak = WeakFromThis();
+  cq_.RunAsync([weak] {
+    if (auto self = weak.lock()) self->ReadLoop();
+  });
+}
+
 std::vector<google::pubsub::v1::ModifyAckDeadlineRequest>
 SplitModifyAckDeadline(google::pubsub::v1::ModifyAckDeadlineRequest request,
                        int max_ack_ids) {
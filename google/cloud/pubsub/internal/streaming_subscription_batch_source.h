@@ -16,8 +16,10 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_STREAMING_SUBSCRIPTION_BATCH_SOURCE_H
 
 #include "google/cloud/pubsub/backoff_policy.h"
+#include "google/cloud/pubsub/internal/ack_coalescer.h"
 #include "google/cloud/pubsub/internal/batch_callback.h"
 #include "google/cloud/pubsub/internal/session_shutdown_manager.h"
+#include "google/cloud/pubsub/internal/subscriber_memory_budget.h"
 #include "google/cloud/pubsub/internal/subscriber_stub.h"
 #include "google/cloud/pubsub/internal/subscription_batch_source.h"
 #include "google/cloud/pubsub/retry_policy.h"
@@ -27,10 +29,12 @@
 #include "google/cloud/status_or.h"
 #include "google/pubsub/v1/pubsub.pb.h"
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iosfwd>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace google {
@@ -46,9 +50,11 @@ class StreamingSubscriptionBatchSource
       CompletionQueue cq,
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       std::shared_ptr<SubscriberStub> stub, std::string subscription_full_name,
-      std::string client_id, Options opts);
+      std::string client_id, Options opts,
+      std::shared_ptr<SubscriberMemoryBudget> memory_budget =
+          SubscriberMemoryBudget::Global());
 
-  ~StreamingSubscriptionBatchSource() override = default;
+  ~StreamingSubscriptionBatchSource() override;
 
   void Start(std::shared_ptr<BatchCallback> callback) override;
 
@@ -110,6 +116,8 @@ class StreamingSubscriptionBatchSource
   void OnRetryFailure(Status status);
 
   void ReadLoop();
+  void PauseRead(std::unique_lock<std::mutex> lk);
+  void OnMemoryReleased();
 
   void OnRead(
       std::optional<google::pubsub::v1::StreamingPullResponse> response);
@@ -122,6 +130,15 @@ class StreamingSubscriptionBatchSource
   void ChangeState(std::unique_lock<std::mutex> const& lk, StreamState s,
                    char const* where, char const* reason);
 
+  bool CoalesceAcks(std::unique_lock<std::mutex> const& lk) const;
+  void OnCoalescedAck(std::unique_lock<std::mutex> lk);
+  void FlushAcks(std::unique_lock<std::mutex> lk);
+
+  void AcquireMemory(google::pubsub::v1::StreamingPullResponse const& response,
+                     std::unique_lock<std::mutex> const& lk);
+  void ReleaseMemory(std::string const& ack_id,
+                     std::unique_lock<std::mutex> const& lk);
+
   CompletionQueue cq_;
   std::shared_ptr<SessionShutdownManager> const shutdown_manager_;
   std::shared_ptr<SubscriberStub> const stub_;
@@ -132,6 +149,10 @@ class StreamingSubscriptionBatchSource
   std::int64_t const max_outstanding_bytes_;
   std::chrono::seconds const min_deadline_time_;
   std::chrono::seconds const max_deadline_time_;
+  std::chrono::milliseconds const ack_hold_time_;
+  std::size_t const ack_hold_count_;
+  std::size_t const memory_limit_;
+  std::shared_ptr<SubscriberMemoryBudget> const memory_budget_;
 
   std::mutex mu_;
   std::shared_ptr<BatchCallback> callback_;
@@ -143,6 +164,12 @@ class StreamingSubscriptionBatchSource
   std::shared_ptr<AsyncPullStream> stream_;
   std::optional<bool> exactly_once_delivery_enabled_;
   std::vector<std::pair<std::string, std::chrono::seconds>> deadlines_queue_;
+  AckCoalescer coalescer_;
+  bool flush_scheduled_ = false;
+  // The size of each message counted in `memory_budget_`.
+  std::unordered_map<std::string, std::size_t> message_bytes_;
+  bool read_paused_ = false;
+  bool budget_waiter_pending_ = false;
 };
 
 std::ostream& operator<<(std::ostream& os,
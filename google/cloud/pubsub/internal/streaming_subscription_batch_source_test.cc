@@ -28,8 +28,10 @@
 #include "google/cloud/testing_util/mock_completion_queue_impl.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <atomic>
 #include <deque>
 #include <sstream>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -54,6 +56,7 @@ using ::testing::ElementsAreArray;
 using ::testing::HasSubstr;
 using ::testing::Property;
 using ::testing::Return;
+using ::testing::UnorderedElementsAre;
 using ::testing::Unused;
 
 using AckRequest = ::google::pubsub::v1::AcknowledgeRequest;
@@ -119,17 +122,20 @@ class FakeStream {
 
 std::shared_ptr<StreamingSubscriptionBatchSource> MakeTestBatchSource(
     CompletionQueue cq, std::shared_ptr<SessionShutdownManager> shutdown,
-    std::shared_ptr<SubscriberStub> mock) {
+    std::shared_ptr<SubscriberStub> mock, Options opts = {},
+    std::shared_ptr<SubscriberMemoryBudget> memory_budget =
+        SubscriberMemoryBudget::Global()) {
   auto subscription = pubsub::Subscription("test-project", "test-subscription");
-  auto opts = DefaultSubscriberOptions(pubsub_testing::MakeTestOptions(
-      Options{}
+  opts = DefaultSubscriberOptions(pubsub_testing::MakeTestOptions(
+      std::move(opts)
           .set<UnifiedCredentialsOption>(MakeInsecureCredentials())
           .set<pubsub::MaxOutstandingMessagesOption>(100)
           .set<pubsub::MaxOutstandingBytesOption>(100 * 1024 * 1024L)
           .set<pubsub::MaxHoldTimeOption>(std::chrono::seconds(300))));
   return std::make_shared<StreamingSubscriptionBatchSource>(
       std::move(cq), std::move(shutdown), std::move(mock),
-      std::move(subscription).FullName(), "test-client-id", std::move(opts));
+      std::move(subscription).FullName(), "test-client-id", std::move(opts),
+      std::move(memory_budget));
 }
 
 TEST(StreamingSubscriptionBatchSourceTest, Start) {
@@ -607,6 +613,251 @@ TEST(StreamingSubscriptionBatchSourceTest, AckMany) {
   EXPECT_THAT(done.get(), IsOk());
 }
 
+TEST(StreamingSubscriptionBatchSourceTest, AckCoalescing) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+
+  FakeStream success_stream(Status{});
+  EXPECT_CALL(*mock, AsyncStreamingPull)
+      .WillOnce([&](google::cloud::CompletionQueue const& cq, auto context,
+                    auto options) {
+        return success_stream.MakeWriteFailureStream(cq, std::move(context),
+                                                     std::move(options));
+      });
+  std::atomic<int> requests{0};
+  auto on_ack = [&](auto&, auto, auto, AckRequest const&) {
+    ++requests;
+    return make_ready_future(Status{});
+  };
+  auto on_modify = [&](auto&, auto, auto, ModifyRequest const&) {
+    ++requests;
+    return make_ready_future(Status{});
+  };
+  EXPECT_CALL(*mock,
+              AsyncAcknowledge(_, _, _,
+                               Property(&AckRequest::ack_ids,
+                                        UnorderedElementsAre("fake-001",
+                                                             "fake-002"))))
+      .WillOnce(on_ack);
+  EXPECT_CALL(*mock, AsyncModifyAckDeadline(
+                         _, _, _,
+                         AllOf(Property(&ModifyRequest::ack_ids,
+                                        ElementsAre("fake-003")),
+                               Property(&ModifyRequest::ack_deadline_seconds,
+                                        0))))
+      .WillOnce(on_modify);
+  // The lease extension for "fake-004" is canceled by its ack.
+  EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _,
+                                      Property(&AckRequest::ack_ids,
+                                               ElementsAre("fake-004"))))
+      .WillOnce(on_ack);
+  EXPECT_CALL(*mock, AsyncModifyAckDeadline(
+                         _, _, _,
+                         AllOf(Property(&ModifyRequest::ack_ids,
+                                        ElementsAre("fake-005")),
+                               Property(&ModifyRequest::ack_deadline_seconds,
+                                        123))))
+      .WillOnce(on_modify);
+
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  auto uut = MakeTestBatchSource(
+      background.cq(), shutdown, mock,
+      Options{}
+          .set<pubsub::MaxAckHoldTimeOption>(std::chrono::seconds(300))
+          .set<pubsub::MaxAckHoldCountOption>(3));
+
+  auto done = shutdown->Start({});
+  auto mock_batch_callback =
+      std::make_shared<pubsub_testing::MockBatchCallback>();
+  EXPECT_CALL(*mock_batch_callback, callback).Times(1);
+  EXPECT_CALL(*mock_batch_callback, AckStart).Times(3);
+  EXPECT_CALL(*mock_batch_callback, AckEnd).Times(3);
+  EXPECT_CALL(*mock_batch_callback, NackStart).Times(1);
+  EXPECT_CALL(*mock_batch_callback, NackEnd).Times(1);
+  EXPECT_CALL(*mock_batch_callback, StartModackSpan).Times(1);
+  EXPECT_CALL(*mock_batch_callback, EndModackSpan).Times(1);
+  EXPECT_CALL(*mock_batch_callback, ModackStart).Times(2);
+  EXPECT_CALL(*mock_batch_callback, ModackEnd).Times(2);
+  uut->Start(mock_batch_callback);
+  success_stream.WaitForAction().set_value(true);  // Start()
+  success_stream.WaitForAction().set_value(true);  // Write()
+  success_stream.WaitForAction().set_value(true);  // Read()
+  auto last_read = success_stream.WaitForAction();
+
+  // The first three operations are sent as soon as they reach the count.
+  uut->AckMessage("fake-001");
+  uut->AckMessage("fake-002");
+  EXPECT_EQ(requests.load(), 0);
+  uut->NackMessage("fake-003");
+  EXPECT_EQ(requests.load(), 2);
+
+  // These are held until the source shuts down.
+  uut->ExtendLeases({"fake-004", "fake-005"}, std::chrono::seconds(123));
+  uut->AckMessage("fake-004");
+  EXPECT_EQ(requests.load(), 2);
+
+  shutdown->MarkAsShutdown("test", {});
+  uut->Shutdown();
+  EXPECT_EQ(requests.load(), 4);
+  last_read.set_value(false);                      // Read()
+  success_stream.WaitForAction().set_value(true);  // Finish()
+
+  EXPECT_THAT(done.get(), IsOk());
+}
+
+TEST(StreamingSubscriptionBatchSourceTest, MemoryBudget) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+
+  AsyncSequencer<bool> aseq;
+  std::atomic<int> reads{0};
+  EXPECT_CALL(*mock, AsyncStreamingPull).WillOnce([&](auto, auto, auto) {
+    using Response = ::google::pubsub::v1::StreamingPullResponse;
+    auto stream = std::make_unique<pubsub_testing::MockAsyncPullStream>();
+    EXPECT_CALL(*stream, Start).WillOnce([&] {
+      return aseq.PushBack("Start");
+    });
+    EXPECT_CALL(*stream, Write).WillRepeatedly([&](auto const&, auto) {
+      return aseq.PushBack("Write");
+    });
+    EXPECT_CALL(*stream, Read).WillRepeatedly([&] {
+      auto const n = reads++;
+      return aseq.PushBack("Read").then([n](future<bool> g) {
+        if (!g.get()) return std::optional<Response>{};
+        Response response;
+        for (int i = 0; i != 2; ++i) {
+          auto& m = *response.add_received_messages();
+          m.set_ack_id("ack-" + std::to_string(2 * n + i));
+          m.mutable_message()->set_data(std::string(1000, 'x'));
+        }
+        return std::make_optional(std::move(response));
+      });
+    });
+    EXPECT_CALL(*stream, Cancel).Times(AtMost(1));
+    EXPECT_CALL(*stream, Finish).WillOnce([&] {
+      return aseq.PushBack("Finish").then([](auto) { return Status{}; });
+    });
+    return stream;
+  });
+  EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _,
+                                      Property(&AckRequest::ack_ids,
+                                               ElementsAre("ack-0"))))
+      .WillOnce(OnAck);
+
+  auto budget = std::make_shared<SubscriberMemoryBudget>();
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  auto uut = MakeTestBatchSource(
+      background.cq(), shutdown, mock,
+      Options{}.set<pubsub::SubscriberMemoryBudgetOption>(1500), budget);
+
+  auto done = shutdown->Start({});
+  auto mock_batch_callback =
+      std::make_shared<pubsub_testing::MockBatchCallback>();
+  EXPECT_CALL(*mock_batch_callback, callback).Times(1);
+  EXPECT_CALL(*mock_batch_callback, AckStart).Times(1);
+  EXPECT_CALL(*mock_batch_callback, AckEnd).Times(1);
+  uut->Start(mock_batch_callback);
+  aseq.PopFrontWithName().first.set_value(true);  // Start()
+  aseq.PopFrontWithName().first.set_value(true);  // Write()
+  auto read = aseq.PopFrontWithName();
+  EXPECT_EQ(read.second, "Read");
+  read.first.set_value(true);
+
+  // The messages exceed the budget, so the source stops reading.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(reads.load(), 1);
+  EXPECT_GE(budget->bytes(), 2000U);
+
+  // Acking one message brings the total under the budget.
+  uut->AckMessage("ack-0");
+  read = aseq.PopFrontWithName();
+  EXPECT_EQ(read.second, "Read");
+  EXPECT_EQ(reads.load(), 2);
+  EXPECT_GE(budget->bytes(), 1000U);
+  EXPECT_LT(budget->bytes(), 2000U);
+
+  shutdown->MarkAsShutdown("test", {});
+  uut->Shutdown();
+  read.first.set_value(false);                    // Read()
+  aseq.PopFrontWithName().first.set_value(true);  // Finish()
+  EXPECT_THAT(done.get(), IsOk());
+
+  // The messages never acked or nacked are released with the source.
+  background.Shutdown();
+  uut.reset();
+  EXPECT_EQ(budget->bytes(), 0U);
+}
+
+TEST(StreamingSubscriptionBatchSourceTest, MemoryBudgetReleasedElsewhere) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+
+  AsyncSequencer<bool> aseq;
+  std::atomic<int> reads{0};
+  EXPECT_CALL(*mock, AsyncStreamingPull).WillOnce([&](auto, auto, auto) {
+    using Response = ::google::pubsub::v1::StreamingPullResponse;
+    auto stream = std::make_unique<pubsub_testing::MockAsyncPullStream>();
+    EXPECT_CALL(*stream, Start).WillOnce([&] {
+      return aseq.PushBack("Start");
+    });
+    EXPECT_CALL(*stream, Write).WillRepeatedly([&](auto const&, auto) {
+      return aseq.PushBack("Write");
+    });
+    EXPECT_CALL(*stream, Read).WillRepeatedly([&] {
+      ++reads;
+      return aseq.PushBack("Read").then([](future<bool> g) {
+        if (!g.get()) return std::optional<Response>{};
+        Response response;
+        auto& m = *response.add_received_messages();
+        m.set_ack_id("ack-0");
+        m.mutable_message()->set_data(std::string(1000, 'x'));
+        return std::make_optional(std::move(response));
+      });
+    });
+    EXPECT_CALL(*stream, Cancel).Times(AtMost(1));
+    EXPECT_CALL(*stream, Finish).WillOnce([&] {
+      return aseq.PushBack("Finish").then([](auto) { return Status{}; });
+    });
+    return stream;
+  });
+
+  // Another subscriber holds most of the budget.
+  auto budget = std::make_shared<SubscriberMemoryBudget>();
+  budget->Acquire(3000);
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  auto uut = MakeTestBatchSource(
+      background.cq(), shutdown, mock,
+      Options{}.set<pubsub::SubscriberMemoryBudgetOption>(3500), budget);
+
+  auto done = shutdown->Start({});
+  auto mock_batch_callback =
+      std::make_shared<pubsub_testing::MockBatchCallback>();
+  EXPECT_CALL(*mock_batch_callback, callback).Times(1);
+  uut->Start(mock_batch_callback);
+  aseq.PopFrontWithName().first.set_value(true);  // Start()
+  aseq.PopFrontWithName().first.set_value(true);  // Write()
+  auto read = aseq.PopFrontWithName();
+  EXPECT_EQ(read.second, "Read");
+  read.first.set_value(true);
+
+  // The messages exceed the budget, so the source stops reading.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(reads.load(), 1);
+
+  // The other subscriber releases its memory, which resumes reading.
+  budget->Release(3000);
+  read = aseq.PopFrontWithName();
+  EXPECT_EQ(read.second, "Read");
+  EXPECT_EQ(reads.load(), 2);
+
+  shutdown->MarkAsShutdown("test", {});
+  uut->Shutdown();
+  read.first.set_value(false);                    // Read()
+  aseq.PopFrontWithName().first.set_value(true);  // Finish()
+  EXPECT_THAT(done.get(), IsOk());
+  background.Shutdown();
+}
+
 CompletionQueue MakeMockCompletionQueue(AsyncSequencer<bool>& aseq) {
   auto mock_cq = std::make_shared<MockCompletionQueueImpl>();
   EXPECT_CALL(*mock_cq, MakeRelativeTimer)
@@ -51,6 +51,13 @@ future<Status> SubscriberConnectionImpl::ExactlyOnceSubscribe(
                                    std::move(p.callback));
 }
 
+future<Status> SubscriberConnectionImpl::BatchSubscribe(
+    BatchSubscribeParams p) {
+  return CreateSubscriptionSession(google::cloud::internal::CurrentOptions(),
+                                   stub_, background_->cq(), MakeClientId(),
+                                   std::move(p.callback));
+}
+
 StatusOr<pubsub::PullResponse> SubscriberConnectionImpl::Pull() {
   auto const& current = internal::CurrentOptions();
   auto subscription = current.get<pubsub::SubscriptionOption>();
@@ -38,6 +38,8 @@ class SubscriberConnectionImpl : public pubsub::SubscriberConnection {
 
   future<Status> ExactlyOnceSubscribe(ExactlyOnceSubscribeParams p) override;
 
+  future<Status> BatchSubscribe(BatchSubscribeParams p) override;
+
   StatusOr<pubsub::PullResponse> Pull() override;
 
   Options options() override;
@@ -0,0 +1,64 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/subscriber_memory_budget.h"
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+std::shared_ptr<SubscriberMemoryBudget> SubscriberMemoryBudget::Global() {
+  // Never deleted, subscribers may outlive other static objects.
+  static auto* const kBudget = new std::shared_ptr<SubscriberMemoryBudget>(
+      std::make_shared<SubscriberMemoryBudget>());
+  return *kBudget;
+}
+
+void SubscriberMemoryBudget::Release(std::size_t bytes) {
+  // Sequentially consistent with `NotifyBelow()`: either it sees the new
+  // total, or this sees its waiter.
+  auto const total = bytes_.fetch_sub(bytes) - bytes;
+  if (!has_waiters_.load()) return;
+  std::unique_lock<std::mutex> lk(mu_);
+  auto first = waiters_.upper_bound(total);
+  std::vector<std::function<void()>> ready;
+  for (auto i = first; i != waiters_.end(); ++i) {
+    ready.push_back(std::move(i->second));
+  }
+  waiters_.erase(first, waiters_.end());
+  has_waiters_.store(!waiters_.empty());
+  lk.unlock();
+  for (auto& callback : ready) callback();
+}
+
+void SubscriberMemoryBudget::NotifyBelow(std::size_t limit,
+                                         std::function<void()> callback) {
+  std::unique_lock<std::mutex> lk(mu_);
+  has_waiters_.store(true);
+  if (bytes_.load() >= limit) {
+    waiters_.emplace(limit, std::move(callback));
+    return;
+  }
+  has_waiters_.store(!waiters_.empty());
+  lk.unlock();
+  callback();
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,79 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIBER_MEMORY_BUDGET_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIBER_MEMORY_BUDGET_H
+
+#include "google/cloud/pubsub/version.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Tracks the size of the messages held by subscribers.
+ *
+ * Each subscriber acquires the size of the messages as it receives them from
+ * the service, and releases it when the messages are acked or nacked. A
+ * subscriber stops reading from its streams while the total exceeds its limit,
+ * see `pubsub::SubscriberMemoryBudgetOption`, and uses `NotifyBelow()` to
+ * resume once any subscriber releases enough memory.
+ */
+class SubscriberMemoryBudget {
+ public:
+  SubscriberMemoryBudget() = default;
+
+  /// The budget shared by all the subscribers in the process.
+  static std::shared_ptr<SubscriberMemoryBudget> Global();
+
+  void Acquire(std::size_t bytes) {
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+  void Release(std::size_t bytes);
+
+  std::size_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+  bool Exceeds(std::size_t limit) const { return bytes() >= limit; }
+
+  /**
+   * Calls @p callback once, when the total is below @p limit.
+   *
+   * The callback is called right away if the total is already below the
+   * limit. Otherwise it is called by the thread releasing the memory, which
+   * may hold locks of another subscriber, so it must not block.
+   */
+  void NotifyBelow(std::size_t limit, std::function<void()> callback);
+
+ private:
+  std::atomic<std::size_t> bytes_{0};
+  // Lets `Release()` skip the mutex when nobody waits.
+  std::atomic<bool> has_waiters_{false};
+  std::mutex mu_;
+  // The callbacks registered by `NotifyBelow()`, indexed by their limit.
+  // GUARDED_BY(mu_)
+  std::multimap<std::size_t, std::function<void()>> waiters_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIBER_MEMORY_BUDGET_H
@@ -0,0 +1,79 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/subscriber_memory_budget.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+TEST(SubscriberMemoryBudgetTest, AcquireRelease) {
+  SubscriberMemoryBudget budget;
+  EXPECT_EQ(budget.bytes(), 0U);
+  EXPECT_FALSE(budget.Exceeds(100));
+
+  budget.Acquire(60);
+  budget.Acquire(40);
+  EXPECT_EQ(budget.bytes(), 100U);
+  EXPECT_TRUE(budget.Exceeds(100));
+  EXPECT_FALSE(budget.Exceeds(101));
+
+  budget.Release(60);
+  EXPECT_EQ(budget.bytes(), 40U);
+  EXPECT_FALSE(budget.Exceeds(100));
+}
+
+TEST(SubscriberMemoryBudgetTest, NotifyBelow) {
+  SubscriberMemoryBudget budget;
+  int below_100 = 0;
+  int below_50 = 0;
+  budget.NotifyBelow(100, [&] { ++below_100; });
+  EXPECT_EQ(below_100, 1);
+
+  budget.Acquire(150);
+  budget.NotifyBelow(100, [&] { ++below_100; });
+  budget.NotifyBelow(50, [&] { ++below_50; });
+  budget.Release(40);
+  EXPECT_EQ(below_100, 1);
+  EXPECT_EQ(below_50, 0);
+
+  budget.Release(20);
+  EXPECT_EQ(below_100, 2);
+  EXPECT_EQ(below_50, 0);
+
+  // Each callback is called once.
+  budget.Release(90);
+  EXPECT_EQ(below_100, 2);
+  EXPECT_EQ(below_50, 1);
+  budget.Acquire(10);
+  budget.Release(10);
+  EXPECT_EQ(below_100, 2);
+  EXPECT_EQ(below_50, 1);
+}
+
+TEST(SubscriberMemoryBudgetTest, Global) {
+  auto a = SubscriberMemoryBudget::Global();
+  auto b = SubscriberMemoryBudget::Global();
+  ASSERT_NE(a, nullptr);
+  EXPECT_EQ(a, b);
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -107,6 +107,10 @@ class SubscriberTracingConnection : public pubsub::SubscriberConnection {
     return child_->ExactlyOnceSubscribe(p);
   };
 
+  future<Status> BatchSubscribe(BatchSubscribeParams p) override {
+    return child_->BatchSubscribe(p);
+  };
+
   StatusOr<pubsub::PullResponse> Pull() override {
     auto span = StartPullSpan();
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/pubsub/internal/subscription_concurrency_control.h"
+#include "google/cloud/pubsub/batch_ack_handler.h"
 #include "google/cloud/pubsub/exactly_once_ack_handler.h"
 #include "google/cloud/pubsub/internal/batch_callback_wrapper.h"
 #include "google/cloud/pubsub/internal/default_batch_callback.h"
@@ -62,15 +63,48 @@ class AckHandlerImpl : public pubsub::ExactlyOnceAckHandler::Impl {
   std::int32_t delivery_attempt_;
 };
 
+class BatchAckHandlerImpl : public pubsub::BatchAckHandler::Impl {
+ public:
+  BatchAckHandlerImpl(std::weak_ptr<SubscriptionConcurrencyControl> w,
+                      std::vector<std::string> ack_ids)
+      : source_(std::move(w)), ack_ids_(std::move(ack_ids)) {}
+  ~BatchAckHandlerImpl() override = default;
+
+  void ack() override {
+    if (auto s = source_.lock()) s->AckMessages(ack_ids_);
+  }
+  void nack() override {
+    if (auto s = source_.lock()) s->NackMessages(ack_ids_);
+  }
+  std::size_t size() const override { return ack_ids_.size(); }
+
+ private:
+  std::weak_ptr<SubscriptionConcurrencyControl> source_;
+  std::vector<std::string> ack_ids_;
+};
+
 }  // namespace
 
 void SubscriptionConcurrencyControl::Start(std::shared_ptr<BatchCallback> cb) {
+  Start(std::move(cb), {});
+}
+
+void SubscriptionConcurrencyControl::Start(
+    std::shared_ptr<BatchCallback> cb,
+    pubsub::BatchApplicationCallback batch_application_callback) {
   std::unique_lock<std::mutex> lk(mu_);
   if (callback_) return;
 
+  batch_application_callback_ = std::move(batch_application_callback);
   callback_ = std::make_shared<BatchCallbackWrapper>(
       std::move(cb), [w = WeakFromThis()](BatchCallback::ReceivedMessage r) {
-        if (auto self = w.lock()) self->OnMessage(std::move(r.message));
+        auto self = w.lock();
+        if (!self) return;
+        if (self->batch_application_callback_) {
+          self->OnBatch(std::move(r.message));
+        } else {
+          self->OnMessage(std::move(r.message));
+        }
       });
 
   auto const& current = internal::CurrentOptions();
@@ -106,10 +140,22 @@ future<Status> SubscriptionConcurrencyControl::NackMessage(
   return r;
 }
 
-void SubscriptionConcurrencyControl::MessageHandled() {
+void SubscriptionConcurrencyControl::AckMessages(
+    std::vector<std::string> const& ack_ids) {
+  for (auto const& id : ack_ids) source_->AckMessage(id);
+  MessagesHandled(ack_ids.size());
+}
+
+void SubscriptionConcurrencyControl::NackMessages(
+    std::vector<std::string> const& ack_ids) {
+  for (auto const& id : ack_ids) source_->NackMessage(id);
+  MessagesHandled(ack_ids.size());
+}
+
+void SubscriptionConcurrencyControl::MessagesHandled(std::size_t count) {
   if (shutdown_manager_->FinishedOperation("handler")) return;
   std::unique_lock<std::mutex> lk(mu_);
-  --message_count_;
+  message_count_ -= count;
   if (total_messages() < max_concurrency_) {
     auto const read_count = max_concurrency_ - total_messages();
     messages_requested_ += read_count;
@@ -150,6 +196,51 @@ void SubscriptionConcurrencyControl::OnMessageAsync(
   shutdown_manager_->FinishedOperation("callback");
 }
 
+void SubscriptionConcurrencyControl::OnBatch(
+    google::pubsub::v1::ReceivedMessage m) {
+  callback_->StartConcurrencyControl(m.ack_id());
+  std::unique_lock<std::mutex> lk(mu_);
+  if (messages_requested_ > 0) --messages_requested_;
+  ++message_count_;
+  batch_.push_back(std::move(m));
+  if (batch_scheduled_) return;
+  batch_scheduled_ = true;
+  lk.unlock();
+
+  // A single callback delivers all the messages received until it runs.
+  std::weak_ptr<SubscriptionConcurrencyControl> w = shared_from_this();
+  shutdown_manager_->StartAsyncOperation(
+      __func__, "callback", cq_, [w = std::move(w)] {
+        if (auto s = w.lock()) s->OnBatchAsync(std::move(w));
+      });
+}
+
+void SubscriptionConcurrencyControl::OnBatchAsync(
+    std::weak_ptr<SubscriptionConcurrencyControl> w) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto batch = std::move(batch_);
+  batch_.clear();
+  batch_scheduled_ = false;
+  lk.unlock();
+
+  shutdown_manager_->StartOperation(__func__, "handler", [&] {
+    std::vector<pubsub::Message> messages;
+    std::vector<std::string> ack_ids;
+    messages.reserve(batch.size());
+    ack_ids.reserve(batch.size());
+    for (auto& m : batch) {
+      callback_->EndConcurrencyControl(m.ack_id());
+      messages.push_back(FromProto(std::move(*m.mutable_message())));
+      ack_ids.push_back(std::move(*m.mutable_ack_id()));
+    }
+    batch_application_callback_(
+        std::move(messages),
+        pubsub::BatchAckHandler(std::make_unique<BatchAckHandlerImpl>(
+            std::move(w), std::move(ack_ids))));
+  });
+  shutdown_manager_->FinishedOperation("callback");
+}
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace pubsub_internal
 }  // namespace cloud
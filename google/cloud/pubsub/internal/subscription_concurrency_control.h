@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIPTION_CONCURRENCY_CONTROL_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIPTION_CONCURRENCY_CONTROL_H
 
+#include "google/cloud/pubsub/application_callback.h"
 #include "google/cloud/pubsub/exactly_once_ack_handler.h"
 #include "google/cloud/pubsub/internal/batch_callback.h"
 #include "google/cloud/pubsub/internal/session_shutdown_manager.h"
@@ -24,6 +25,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -45,9 +47,18 @@ class SubscriptionConcurrencyControl
   }
 
   void Start(std::shared_ptr<BatchCallback> cb);
+  /**
+   * Deliver the messages to @p batch_application_callback, in batches, instead
+   * of one at a time via `cb->user_callback()`. All the messages received
+   * while a batch is waiting to be scheduled join that batch.
+   */
+  void Start(std::shared_ptr<BatchCallback> cb,
+             pubsub::BatchApplicationCallback batch_application_callback);
   void Shutdown();
   future<Status> AckMessage(std::string const& ack_id);
   future<Status> NackMessage(std::string const& ack_id);
+  void AckMessages(std::vector<std::string> const& ack_ids);
+  void NackMessages(std::vector<std::string> const& ack_ids);
 
  private:
   SubscriptionConcurrencyControl(
@@ -61,10 +72,13 @@ class SubscriptionConcurrencyControl
         subscription_(std::move(subscription)),
         max_concurrency_(max_concurrency) {}
 
-  void MessageHandled();
+  void MessageHandled() { MessagesHandled(1); }
+  void MessagesHandled(std::size_t count);
   void OnMessage(google::pubsub::v1::ReceivedMessage m);
   void OnMessageAsync(google::pubsub::v1::ReceivedMessage m,
                       std::weak_ptr<SubscriptionConcurrencyControl> w);
+  void OnBatch(google::pubsub::v1::ReceivedMessage m);
+  void OnBatchAsync(std::weak_ptr<SubscriptionConcurrencyControl> w);
 
   std::weak_ptr<SubscriptionConcurrencyControl> WeakFromThis() {
     return shared_from_this();
@@ -82,8 +96,12 @@ class SubscriptionConcurrencyControl
 
   std::mutex mu_;
   std::shared_ptr<BatchCallback> callback_;
+  pubsub::BatchApplicationCallback batch_application_callback_;
   std::size_t message_count_ = 0;
   std::size_t messages_requested_ = 0;
+  // The messages waiting for the next batch callback, if any.
+  std::vector<google::pubsub::v1::ReceivedMessage> batch_;
+  bool batch_scheduled_ = false;
 };
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
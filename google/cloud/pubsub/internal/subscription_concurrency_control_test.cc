@@ -13,10 +13,12 @@
 // limitations under the License.
 
 #include "google/cloud/pubsub/internal/subscription_concurrency_control.h"
+#include "google/cloud/pubsub/batch_ack_handler.h"
 #include "google/cloud/pubsub/exactly_once_ack_handler.h"
 #include "google/cloud/pubsub/internal/subscription_session.h"
 #include "google/cloud/pubsub/testing/mock_batch_callback.h"
 #include "google/cloud/pubsub/testing/mock_subscription_message_source.h"
+#include "google/cloud/completion_queue.h"
 #include "google/cloud/internal/background_threads_impl.h"
 #include "google/cloud/log.h"
 #include "google/cloud/testing_util/status_matchers.h"
@@ -25,6 +27,7 @@
 #include <deque>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -37,6 +40,7 @@ using ::google::cloud::testing_util::IsOk;
 using ::testing::AtLeast;
 using ::testing::ByMove;
 using ::testing::Return;
+using ::testing::SizeIs;
 using ::testing::StartsWith;
 
 using Handler = std::unique_ptr<ExactlyOnceAckHandler::Impl>;
@@ -581,6 +585,82 @@ TEST_F(SubscriptionConcurrencyControlTest, MessageContents) {
   EXPECT_THAT(done.get(), IsOk());
 }
 
+/// @test Verify SubscriptionConcurrencyControl delivers messages in batches.
+TEST_F(SubscriptionConcurrencyControlTest, BatchCallbacks) {
+  auto source =
+      std::make_shared<pubsub_testing::MockSubscriptionMessageSource>();
+
+  PrepareMessages("ack-0-", 3);
+  PrepareMessages("ack-1-", 2);
+  EXPECT_CALL(*source, Shutdown).Times(1);
+  std::shared_ptr<BatchCallback> batch_callback;
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*source, Start)
+        .WillOnce([&batch_callback](std::shared_ptr<BatchCallback> cb) {
+          batch_callback = std::move(cb);
+        });
+    auto push_messages = [&](std::size_t n) {
+      PushMessages(batch_callback, n);
+    };
+    EXPECT_CALL(*source, Read(10)).WillOnce(push_messages);
+    // Handling the batch frees up all of its messages at once.
+    EXPECT_CALL(*source, Read(5)).Times(1);
+  }
+  EXPECT_CALL(*source, AckMessage)
+      .Times(5)
+      .WillRepeatedly(
+          [](std::string const&) { return make_ready_future(Status{}); });
+
+  // Do not run the completion queue until all the messages are pushed, so
+  // they are all delivered in a single batch.
+  google::cloud::CompletionQueue cq;
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  auto uut = SubscriptionConcurrencyControl::Create(
+      cq, shutdown, source, pubsub::Subscription("test-project", "test-sub"),
+      /*max_concurrency=*/10);
+
+  std::mutex callback_mu;
+  std::condition_variable callback_cv;
+  std::vector<std::vector<pubsub::Message>> batches;
+  std::vector<pubsub::BatchAckHandler> handlers;
+  auto mock_batch_callback =
+      std::make_shared<pubsub_testing::MockBatchCallback>();
+  EXPECT_CALL(*mock_batch_callback, StartConcurrencyControl).Times(5);
+  EXPECT_CALL(*mock_batch_callback, EndConcurrencyControl).Times(5);
+  EXPECT_CALL(*mock_batch_callback, user_callback).Times(0);
+  auto callback = [&](std::vector<pubsub::Message> m,
+                      pubsub::BatchAckHandler h) {
+    std::lock_guard<std::mutex> lk(callback_mu);
+    batches.push_back(std::move(m));
+    handlers.push_back(std::move(h));
+    callback_cv.notify_one();
+  };
+
+  auto done = shutdown->Start({});
+  uut->Start(mock_batch_callback, callback);
+  std::thread runner([&cq] { cq.Run(); });
+
+  std::unique_lock<std::mutex> lk(callback_mu);
+  callback_cv.wait(lk, [&] { return !batches.empty(); });
+  ASSERT_THAT(batches, SizeIs(1));
+  ASSERT_THAT(batches[0], SizeIs(5));
+  EXPECT_EQ(handlers[0].size(), batches[0].size());
+  for (auto const& m : batches[0]) {
+    EXPECT_THAT(m.message_id(), StartsWith("message:"));
+    auto const suffix = m.message_id().substr(sizeof("message:") - 1);
+    EXPECT_EQ(m.data(), "data:" + suffix);
+  }
+  std::move(handlers[0]).ack();
+  lk.unlock();
+
+  shutdown->MarkAsShutdown(__func__, {});
+  uut->Shutdown();
+  EXPECT_THAT(done.get(), IsOk());
+  cq.Shutdown();
+  runner.join();
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace pubsub_internal
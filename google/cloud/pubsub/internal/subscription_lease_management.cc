@@ -14,6 +14,7 @@
 
 #include "google/cloud/pubsub/internal/subscription_lease_management.h"
 #include "google/cloud/pubsub/internal/batch_callback_wrapper.h"
+#include <algorithm>
 #include <chrono>
 
 namespace google {
@@ -45,7 +46,7 @@ void SubscriptionLeaseManagement::Shutdown() {
 future<Status> SubscriptionLeaseManagement::AckMessage(
     std::string const& ack_id) {
   std::unique_lock<std::mutex> lk(mu_);
-  leases_.erase(ack_id);
+  OnHandled(ack_id, lk);
   lk.unlock();
   return child_->AckMessage(ack_id);
 }
@@ -53,7 +54,7 @@ future<Status> SubscriptionLeaseManagement::AckMessage(
 future<Status> SubscriptionLeaseManagement::NackMessage(
     std::string const& ack_id) {
   std::unique_lock<std::mutex> lk(mu_);
-  leases_.erase(ack_id);
+  OnHandled(ack_id, lk);
   lk.unlock();
   return child_->NackMessage(ack_id);
 }
@@ -86,8 +87,8 @@ void SubscriptionLeaseManagement::OnRead(
   auto const estimated_server_deadline = now + std::chrono::seconds(10);
   auto const handling_deadline = now + max_deadline_time_;
   for (auto const& rm : response->received_messages()) {
-    leases_.emplace(rm.ack_id(),
-                    LeaseStatus{estimated_server_deadline, handling_deadline});
+    leases_.emplace(rm.ack_id(), LeaseStatus{estimated_server_deadline,
+                                             handling_deadline, now});
   }
   // Setup a timer to refresh the message leases. We do not want to immediately
   // refresh them because there is a good chance they will be handled before
@@ -105,7 +106,7 @@ void SubscriptionLeaseManagement::RefreshMessageLeases(
 
   std::vector<std::string> ack_ids;
   ack_ids.reserve(leases_.size());
-  auto extension = max_deadline_extension_;
+  auto extension = DeadlineExtension(lk);
   auto const now = std::chrono::system_clock::now();
   for (auto const& kv : leases_) {
     // This message lease cannot be extended any further, and we do not want to
@@ -182,6 +183,26 @@ void SubscriptionLeaseManagement::NackAll(std::unique_lock<std::mutex> lk) {
   BulkNack(std::move(ack_ids));
 }
 
+void SubscriptionLeaseManagement::OnHandled(
+    std::string const& ack_id, std::unique_lock<std::mutex> const&) {
+  auto i = leases_.find(ack_id);
+  if (i == leases_.end()) return;
+  if (deadline_percentile_ > 0) {
+    latencies_.Record(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now() - i->second.received));
+  }
+  leases_.erase(i);
+}
+
+std::chrono::seconds SubscriptionLeaseManagement::DeadlineExtension(
+    std::unique_lock<std::mutex> const&) const {
+  if (deadline_percentile_ <= 0) return max_deadline_extension_;
+  auto const p = latencies_.Percentile(deadline_percentile_);
+  // Until some messages are handled there is no information to adapt to.
+  if (!p) return max_deadline_extension_;
+  return std::clamp(*p, min_deadline_extension_, max_deadline_extension_);
+}
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace pubsub_internal
 }  // namespace cloud
@@ -15,11 +15,13 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIPTION_LEASE_MANAGEMENT_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIPTION_LEASE_MANAGEMENT_H
 
+#include "google/cloud/pubsub/internal/ack_latency_distribution.h"
 #include "google/cloud/pubsub/internal/batch_callback.h"
 #include "google/cloud/pubsub/internal/session_shutdown_manager.h"
 #include "google/cloud/pubsub/internal/subscriber_stub.h"
 #include "google/cloud/pubsub/internal/subscription_batch_source.h"
 #include "google/cloud/pubsub/version.h"
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -38,16 +40,27 @@ class SubscriptionLeaseManagement
   static auto constexpr kAckDeadlineSlack = std::chrono::seconds(2);
   static auto constexpr kMinimumAckDeadline = std::chrono::seconds(10);
 
+  /**
+   * Create a new lease manager.
+   *
+   * With a non-zero @p deadline_percentile the leases are extended by that
+   * percentile of the time taken to ack or nack previous messages, clamped
+   * between @p min_deadline_extension and @p max_deadline_extension.
+   * Otherwise they are extended by @p max_deadline_extension.
+   */
   static std::shared_ptr<SubscriptionLeaseManagement> Create(
       google::cloud::CompletionQueue cq,
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       std::shared_ptr<SubscriptionBatchSource> child,
       std::chrono::seconds max_deadline_time,
-      std::chrono::seconds max_deadline_extension) {
+      std::chrono::seconds max_deadline_extension,
+      std::chrono::seconds min_deadline_extension = kMinimumAckDeadline,
+      double deadline_percentile = 0) {
     return std::shared_ptr<SubscriptionLeaseManagement>(
         new SubscriptionLeaseManagement(
             std::move(cq), std::move(shutdown_manager), std::move(child),
-            max_deadline_time, max_deadline_extension));
+            max_deadline_time, max_deadline_extension, min_deadline_extension,
+            deadline_percentile));
   }
 
   void Start(std::shared_ptr<BatchCallback> cb) override;
@@ -64,12 +77,16 @@ class SubscriptionLeaseManagement
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       std::shared_ptr<SubscriptionBatchSource> child,
       std::chrono::seconds max_deadline_time,
-      std::chrono::seconds max_deadline_extension)
+      std::chrono::seconds max_deadline_extension,
+      std::chrono::seconds min_deadline_extension, double deadline_percentile)
       : cq_(std::move(cq)),
         child_(std::move(child)),
         shutdown_manager_(std::move(shutdown_manager)),
         max_deadline_time_(max_deadline_time),
-        max_deadline_extension_(max_deadline_extension) {}
+        max_deadline_extension_(max_deadline_extension),
+        min_deadline_extension_(
+            (std::min)(min_deadline_extension, max_deadline_extension)),
+        deadline_percentile_(deadline_percentile) {}
 
   void OnRead(
       StatusOr<google::pubsub::v1::StreamingPullResponse> const& response);
@@ -87,11 +104,21 @@ class SubscriptionLeaseManagement
 
   void NackAll(std::unique_lock<std::mutex> lk);
 
+  /// Stop tracking @p ack_id, recording how long it took to handle it.
+  void OnHandled(std::string const& ack_id,
+                 std::unique_lock<std::mutex> const& lk);
+
+  /// The extension for the message leases.
+  std::chrono::seconds DeadlineExtension(
+      std::unique_lock<std::mutex> const& lk) const;
+
   google::cloud::CompletionQueue cq_;
   std::shared_ptr<SubscriptionBatchSource> const child_;
   std::shared_ptr<SessionShutdownManager> const shutdown_manager_;
   std::chrono::seconds const max_deadline_time_;
   std::chrono::seconds const max_deadline_extension_;
+  std::chrono::seconds const min_deadline_extension_;
+  double const deadline_percentile_;
   std::shared_ptr<BatchCallback> callback_;
 
   std::mutex mu_;
@@ -99,8 +126,10 @@ class SubscriptionLeaseManagement
   struct LeaseStatus {
     std::chrono::system_clock::time_point estimated_server_deadline;
     std::chrono::system_clock::time_point handling_deadline;
+    std::chrono::system_clock::time_point received;
   };
   std::unordered_map<std::string, LeaseStatus> leases_;
+  AckLatencyDistribution latencies_;
 
   bool refreshing_leases_ = false;
   future<void> refresh_timer_;
@@ -231,6 +231,66 @@ TEST(SubscriptionLeaseManagementTest, UsesDeadlineExtension) {
   EXPECT_THAT(done.get(), IsOk());
 }
 
+TEST(SubscriptionLeaseManagementTest, UsesDeadlinePercentile) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  std::shared_ptr<BatchCallback> batch_callback;
+  EXPECT_CALL(*mock, Start).WillOnce([&](std::shared_ptr<BatchCallback> cb) {
+    batch_callback = std::move(cb);
+  });
+
+  auto mock_batch_callback =
+      std::make_shared<pubsub_testing::MockBatchCallback>();
+  EXPECT_CALL(*mock_batch_callback, callback).Times(1);
+
+  auto constexpr kTestDeadline = std::chrono::seconds(345);
+  auto constexpr kTestMaxExtension = std::chrono::seconds(100);
+  auto constexpr kTestMinExtension = std::chrono::seconds(20);
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*mock, AckMessage("ack-0-0")).WillOnce(SimpleAckNack);
+    // The first message was acked right away, so the extension for the second
+    // message is the minimum.
+    EXPECT_CALL(*mock, ExtendLeases)
+        .WillOnce([&](std::vector<std::string> const& ack_ids,
+                      std::chrono::seconds extension) {
+          EXPECT_THAT(ack_ids, UnorderedElementsAre("ack-0-1"));
+          EXPECT_EQ(extension, kTestMinExtension);
+          return make_ready_future(Status{});
+        });
+    EXPECT_CALL(*mock, BulkNack(UnorderedElementsAre("ack-0-1")))
+        .WillOnce([](std::vector<std::string> const&) {
+          return make_ready_future(Status{});
+        });
+    EXPECT_CALL(*mock, Shutdown).Times(1);
+  }
+
+  auto fake_cq = std::make_shared<FakeCompletionQueueImpl>();
+  CompletionQueue cq(fake_cq);
+
+  auto shutdown_manager = std::make_shared<SessionShutdownManager>();
+  auto uut = SubscriptionLeaseManagement::Create(
+      cq, shutdown_manager, mock, kTestDeadline, kTestMaxExtension,
+      kTestMinExtension, /*deadline_percentile=*/99);
+
+  auto done = shutdown_manager->Start({});
+  uut->Start(mock_batch_callback);
+  batch_callback->callback(
+      BatchCallback::StreamingPullResponse{GenerateMessages("0-", 2)});
+  ASSERT_EQ(1U, fake_cq->size());
+  uut->AckMessage("ack-0-0");
+
+  // Fire the timer. This will extend the deadline.
+  fake_cq->SimulateCompletion(true);
+  // RunAsync, drain the deferred OnRefreshTimer
+  fake_cq->SimulateCompletion(true);
+  ASSERT_EQ(1U, fake_cq->size());
+
+  shutdown_manager->MarkAsShutdown(__func__, Status{});
+  uut->Shutdown();
+  while (!fake_cq->empty()) fake_cq->SimulateCompletion(true);
+  EXPECT_THAT(done.get(), IsOk());
+}
+
 TEST(SubscriptionLeaseManagementTest, ExpiredMessage) {
   auto mock = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
   std::shared_ptr<BatchCallback> batch_callback;
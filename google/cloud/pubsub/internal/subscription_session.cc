@@ -20,6 +20,7 @@
 #include "google/cloud/pubsub/internal/default_batch_callback.h"
 #include "google/cloud/pubsub/internal/default_message_callback.h"
 #include "google/cloud/pubsub/internal/message_callback.h"
+#include "google/cloud/pubsub/internal/noop_message_callback.h"
 #include "google/cloud/pubsub/internal/streaming_subscription_batch_source.h"
 #include "google/cloud/pubsub/internal/subscription_lease_management.h"
 #include "google/cloud/pubsub/internal/subscription_message_queue.h"
@@ -43,7 +44,8 @@ class SubscriptionSessionImpl
       Options const& opts, CompletionQueue cq,
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       std::shared_ptr<SubscriptionBatchSource> source,
-      std::shared_ptr<MessageCallback> callback) {
+      std::shared_ptr<MessageCallback> callback,
+      pubsub::BatchApplicationCallback batch_application_callback = {}) {
     if (opts.get<OpenTelemetryTracingOption>()) {
       callback = MakeTracingMessageCallback(std::move(callback), opts);
     }
@@ -73,7 +75,8 @@ class SubscriptionSessionImpl
     // 2) When the completion queue is shutdown, the timer is canceled and
     //    `self` gets a chance to shut down the pipeline.
     self->ScheduleTimer();
-    self->pipeline_->Start(std::move(batch_callback));
+    self->pipeline_->Start(std::move(batch_callback),
+                           std::move(batch_application_callback));
     return result.then([weak](future<Status> f) {
       if (auto self = weak.lock()) self->ShutdownCompleted();
       return f.get();
@@ -115,6 +118,18 @@ class SubscriptionSessionImpl
                   std::move(source), std::move(callback));
   }
 
+  static future<Status> Create(
+      Options const& opts, CompletionQueue cq,
+      std::shared_ptr<SessionShutdownManager> shutdown_manager,
+      std::shared_ptr<SubscriptionBatchSource> source,
+      pubsub::BatchApplicationCallback application_callback) {
+    // The messages are delivered to `application_callback`, in batches,
+    // instead of through the `MessageCallback`.
+    return Create(opts, std::move(cq), std::move(shutdown_manager),
+                  std::move(source), std::make_shared<NoopMessageCallback>(),
+                  std::move(application_callback));
+  }
+
   SubscriptionSessionImpl(
       CompletionQueue cq,
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
@@ -210,12 +225,11 @@ class SubscriptionSessionImpl
   future<void> timer_;
 };
 
-}  // namespace
-
-future<Status> CreateSubscriptionSession(
-    Options const& opts, std::shared_ptr<SubscriberStub> const& stub,
-    CompletionQueue const& cq, std::string client_id,
-    pubsub::ApplicationCallback application_callback) {
+template <typename ApplicationCallback>
+future<Status> CreateSession(Options const& opts,
+                             std::shared_ptr<SubscriberStub> const& stub,
+                             CompletionQueue const& cq, std::string client_id,
+                             ApplicationCallback application_callback) {
   auto shutdown_manager = std::make_shared<SessionShutdownManager>();
   auto batch = std::make_shared<StreamingSubscriptionBatchSource>(
       cq, shutdown_manager, stub,
@@ -224,30 +238,39 @@ future<Status> CreateSubscriptionSession(
   auto lease_management = SubscriptionLeaseManagement::Create(
       cq, shutdown_manager, std::move(batch),
       opts.get<pubsub::MaxDeadlineTimeOption>(),
-      opts.get<pubsub::MaxDeadlineExtensionOption>());
+      opts.get<pubsub::MaxDeadlineExtensionOption>(),
+      opts.get<pubsub::MinDeadlineExtensionOption>(),
+      opts.get<pubsub::DeadlineExtensionPercentileOption>());
 
   return SubscriptionSessionImpl::Create(opts, cq, std::move(shutdown_manager),
                                          std::move(lease_management),
                                          std::move(application_callback));
 }
 
+}  // namespace
+
+future<Status> CreateSubscriptionSession(
+    Options const& opts, std::shared_ptr<SubscriberStub> const& stub,
+    CompletionQueue const& cq, std::string client_id,
+    pubsub::ApplicationCallback application_callback) {
+  return CreateSession(opts, stub, cq, std::move(client_id),
+                       std::move(application_callback));
+}
+
 future<Status> CreateSubscriptionSession(
     Options const& opts, std::shared_ptr<SubscriberStub> const& stub,
     CompletionQueue const& cq, std::string client_id,
     pubsub::ExactlyOnceApplicationCallback application_callback) {
-  auto shutdown_manager = std::make_shared<SessionShutdownManager>();
-  auto batch = std::make_shared<StreamingSubscriptionBatchSource>(
-      cq, shutdown_manager, stub,
-      opts.get<pubsub::SubscriptionOption>().FullName(), std::move(client_id),
-      opts);
-  auto lease_management = SubscriptionLeaseManagement::Create(
-      cq, shutdown_manager, std::move(batch),
-      opts.get<pubsub::MaxDeadlineTimeOption>(),
-      opts.get<pubsub::MaxDeadlineExtensionOption>());
+  return CreateSession(opts, stub, cq, std::move(client_id),
+                       std::move(application_callback));
+}
 
-  return SubscriptionSessionImpl::Create(opts, cq, std::move(shutdown_manager),
-                                         std::move(lease_management),
-                                         std::move(application_callback));
+future<Status> CreateSubscriptionSession(
+    Options const& opts, std::shared_ptr<SubscriberStub> const& stub,
+    CompletionQueue const& cq, std::string client_id,
+    pubsub::BatchApplicationCallback application_callback) {
+  return CreateSession(opts, stub, cq, std::move(client_id),
+                       std::move(application_callback));
 }
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
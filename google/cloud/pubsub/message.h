@@ -19,9 +19,13 @@
 #include "absl/strings/string_view.h"
 #include "google/pubsub/v1/pubsub.pb.h"
 #include <chrono>
+#include <cstddef>
 #include <iosfwd>
+#include <iterator>
 #include <map>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace google {
@@ -76,6 +80,87 @@ class MessageBuilder;
 using PubsubMessageDataType = std::decay_t<
     decltype(std::declval<google::pubsub::v1::PubsubMessage>().data())>;
 
+/**
+ * A read-only view of the attributes in a `Message`.
+ *
+ * Unlike `Message::attributes()`, creating and iterating this view does not
+ * copy the attributes. The view, and the `absl::string_view` values it
+ * returns, are only valid while the `Message` is alive and unmodified.
+ *
+ * @par Example
+ * @code
+ * for (auto kv : m.attributes_view()) {
+ *   std::cout << kv.first << "=" << kv.second << "\n";
+ * }
+ * @endcode
+ */
+class MessageAttributesView {
+  using Map = google::protobuf::Map<std::string, std::string>;
+
+ public:
+  using value_type = std::pair<absl::string_view, absl::string_view>;
+
+  /**
+   * Iterates over the attributes, in unspecified order.
+   *
+   * This is an input iterator, dereferencing it returns the attribute by
+   * value.
+   */
+  class const_iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = MessageAttributesView::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type;
+    using pointer = void;
+
+    const_iterator() = default;
+
+    value_type operator*() const { return {it_->first, it_->second}; }
+    const_iterator& operator++() {
+      ++it_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto tmp = *this;
+      ++it_;
+      return tmp;
+    }
+
+    friend bool operator==(const_iterator const& a, const_iterator const& b) {
+      return a.it_ == b.it_;
+    }
+    friend bool operator!=(const_iterator const& a, const_iterator const& b) {
+      return !(a == b);
+    }
+
+   private:
+    friend class MessageAttributesView;
+    explicit const_iterator(Map::const_iterator it) : it_(std::move(it)) {}
+
+    Map::const_iterator it_;
+  };
+
+  const_iterator begin() const { return const_iterator(attributes_->begin()); }
+  const_iterator end() const { return const_iterator(attributes_->end()); }
+  std::size_t size() const { return attributes_->size(); }
+  bool empty() const { return attributes_->empty(); }
+
+  /// Returns the value of the attribute @p key, if present.
+  std::optional<absl::string_view> find(std::string const& key) const {
+    auto it = attributes_->find(key);
+    if (it == attributes_->end()) return std::nullopt;
+    return absl::string_view(it->second);
+  }
+
+ private:
+  friend class Message;
+  explicit MessageAttributesView(Map const& attributes)
+      : attributes_(&attributes) {}
+
+  Map const* attributes_;
+};
+
 /**
  * The C++ representation for a Cloud Pub/Sub messages.
  *
@@ -101,6 +186,10 @@ class Message {
     }
     return r;
   }
+  /// Returns a view of the attributes that does not copy them.
+  MessageAttributesView attributes_view() const {
+    return MessageAttributesView(proto_.attributes());
+  }
   ///@}
 
   ///@{
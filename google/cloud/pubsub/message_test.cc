@@ -17,8 +17,13 @@
 #include <google/protobuf/text_format.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <iterator>
 #include <sstream>
+#include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -286,6 +291,39 @@ TEST(Message, GetAttributeFriend) {
   EXPECT_THAT(v1, IsEmpty());
 }
 
+TEST(Message, AttributesView) {
+  auto const m0 =
+      MessageBuilder{}.SetAttributes({{"k0", "v0"}, {"k1", "v1"}}).Build();
+
+  auto const view = m0.attributes_view();
+  EXPECT_EQ(view.size(), 2U);
+  EXPECT_FALSE(view.empty());
+  std::vector<std::pair<std::string, std::string>> actual;
+  for (auto kv : view) actual.emplace_back(kv.first, kv.second);
+  EXPECT_THAT(actual, UnorderedElementsAre(Pair("k0", "v0"), Pair("k1", "v1")));
+
+  // The view refers to the message, it does not copy the attributes.
+  auto const v0 = view.find("k0");
+  ASSERT_TRUE(v0.has_value());
+  EXPECT_EQ(*v0, "v0");
+  auto const& proto = pubsub_internal::ToProto(m0);
+  EXPECT_EQ(v0->data(), proto.attributes().at("k0").data());
+  EXPECT_FALSE(view.find("k2").has_value());
+
+  auto const m1 = MessageBuilder{}.Build();
+  auto const empty = m1.attributes_view();
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(empty.begin(), empty.end());
+
+  // The iterator returns values, so it cannot be a forward iterator.
+  using Traits = std::iterator_traits<MessageAttributesView::const_iterator>;
+  static_assert(std::is_same<Traits::iterator_category,
+                             std::input_iterator_tag>::value,
+                "");
+  std::vector<MessageAttributesView::value_type> copy(view.begin(), view.end());
+  EXPECT_EQ(copy.size(), 2U);
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace pubsub
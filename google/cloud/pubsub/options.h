@@ -246,12 +246,67 @@ struct MaxOtelLinkCountOption {
   using Type = std::size_t;
 };
 
+/**
+ * The number of partial batches kept by each publisher.
+ *
+ * By default, a publisher adds all messages to a single pending batch, guarded
+ * by a single mutex. When many application threads publish to the same topic
+ * they contend on this mutex. With a value larger than 1, the publisher keeps
+ * this many partial batches, each thread adds its messages to one of them, and
+ * the partial batches are merged when the batch is sent. The merged batch
+ * still respects `MaxHoldTimeOption`, `MaxBatchMessagesOption` and
+ * `MaxBatchBytesOption`. In this mode, full batches are sent from the
+ * background threads instead of the publishing threads.
+ *
+ * Publishers with `MessageOrderingOption` ignore this option.
+ *
+ * @ingroup google-cloud-pubsub-options
+ */
+struct PublisherShardsOption {
+  using Type = std::size_t;
+};
+
+/**
+ * The maximum number of concurrent `Publish()` RPCs for each publisher.
+ *
+ * By default, a publisher sends each batch as soon as it is ready, without
+ * waiting for the previous batches to complete, and the requests are spread
+ * across the gRPC channels (see `GrpcNumChannelsOption`). With a non-zero
+ * value, at most this many batches are in flight at a time, and additional
+ * batches wait, in order, until a previous batch completes. The waiting
+ * batches hold their messages, use `MaxPendingBytesOption` and
+ * `MaxPendingMessagesOption` to bound them.
+ *
+ * Batches with the same ordering key are always sent one at a time.
+ *
+ * @ingroup google-cloud-pubsub-options
+ */
+struct MaxInFlightPublishesOption {
+  using Type = std::size_t;
+};
+
+/**
+ * The maximum size of the messages in concurrent `Publish()` RPCs.
+ *
+ * Only used if `MaxInFlightPublishesOption` is set. The total size of the
+ * messages in flight is kept under this limit, except that a batch larger than
+ * the limit is sent when no other batch is in flight. A value of 0 disables
+ * this limit.
+ *
+ * @ingroup google-cloud-pubsub-options
+ */
+struct MaxInFlightPublishBytesOption {
+  using Type = std::size_t;
+};
+
 /// The list of options specific to publishers.
 using PublisherOptionList =
     OptionList<MaxHoldTimeOption, MaxBatchMessagesOption, MaxBatchBytesOption,
                MaxPendingMessagesOption, MaxPendingBytesOption,
                MessageOrderingOption, FullPublisherActionOption,
-               CompressionThresholdOption, MaxOtelLinkCountOption>;
+               CompressionThresholdOption, MaxOtelLinkCountOption,
+               PublisherShardsOption, MaxInFlightPublishesOption,
+               MaxInFlightPublishBytesOption>;
 
 /**
  * The maximum deadline for each incoming message.
@@ -314,6 +369,29 @@ struct MinDeadlineExtensionOption {
   using Type = std::chrono::seconds;
 };
 
+/**
+ * Extend message leases based on the observed time to handle them.
+ *
+ * By default the library extends the deadline of each pending message by
+ * `MaxDeadlineExtensionOption`. When this option is set to a value in the
+ * `(0, 100]` range, the library keeps a histogram of how long the application
+ * takes to ack or nack each message, and extends the deadlines by this
+ * percentile of the histogram instead. The extension is still clamped between
+ * `MinDeadlineExtensionOption` and `MaxDeadlineExtensionOption`.
+ *
+ * Shorter extensions let the service redeliver abandoned messages sooner,
+ * while longer extensions require fewer lease renewals. For example, a value
+ * of `99` avoids most redeliveries of slow messages while keeping the
+ * extensions close to the actual processing time.
+ *
+ * The default value, `0`, disables the adaptive extensions.
+ *
+ * @ingroup google-cloud-pubsub-options
+ */
+struct DeadlineExtensionPercentileOption {
+  using Type = double;
+};
+
 /**
  * The maximum number of outstanding messages per streaming pull.
  *
@@ -391,6 +469,59 @@ struct ShutdownPollingPeriodOption {
   using Type = std::chrono::milliseconds;
 };
 
+/**
+ * How long the subscriber holds acknowledgements before sending them.
+ *
+ * By default the library sends each ack, nack, and lease extension as soon as
+ * it is available. With a non-zero value, these operations are buffered for up
+ * to this period and then sent in as few requests as possible: lease
+ * extensions with the same deadline share a request, and a pending lease
+ * extension is dropped when the message is acked or nacked. At high message
+ * rates this significantly reduces the number of requests.
+ *
+ * Subscriptions with exactly-once delivery ignore this option, as each ack
+ * reports its own result.
+ *
+ * @ingroup google-cloud-pubsub-options
+ */
+struct MaxAckHoldTimeOption {
+  using Type = std::chrono::milliseconds;
+};
+
+/**
+ * The maximum number of acknowledgements held before sending them.
+ *
+ * When `MaxAckHoldTimeOption` is set, the buffered operations are sent as soon
+ * as this many are buffered, without waiting for the hold time to expire. A
+ * value of 0 uses the maximum number of ack ids in a single request.
+ *
+ * @ingroup google-cloud-pubsub-options
+ */
+struct MaxAckHoldCountOption {
+  using Type = std::size_t;
+};
+
+/**
+ * The maximum size of the messages held by all the subscribers in the process.
+ *
+ * `MaxOutstandingMessagesOption` and `MaxOutstandingBytesOption` limit the
+ * messages delivered to the application callbacks. Subscribers also hold
+ * messages that are not yet delivered, for example, messages waiting for
+ * earlier messages with the same ordering key. With a non-zero value, the
+ * subscriber stops reading from the service while the messages held, but not
+ * yet acked or nacked, by all the subscribers in the process with this option
+ * exceed this size. The service then stops sending messages to this
+ * subscriber, until enough messages are acked or nacked.
+ *
+ * Subscribers with different values for this option share the same total, and
+ * each one stops reading when the total exceeds its own limit.
+ *
+ * @ingroup google-cloud-pubsub-options
+ */
+struct SubscriberMemoryBudgetOption {
+  using Type = std::size_t;
+};
+
 /**
  * Override the default subscription for a request.
  *
@@ -408,9 +539,11 @@ struct SubscriptionOption {
 /// @ingroup google-cloud-pubsub-options
 using SubscriberOptionList =
     OptionList<MaxDeadlineTimeOption, MaxDeadlineExtensionOption,
-               MinDeadlineExtensionOption, MaxOutstandingMessagesOption,
-               MaxOutstandingBytesOption, MaxConcurrencyOption,
-               ShutdownPollingPeriodOption, SubscriptionOption>;
+               MinDeadlineExtensionOption, DeadlineExtensionPercentileOption,
+               MaxOutstandingMessagesOption, MaxOutstandingBytesOption,
+               MaxConcurrencyOption, ShutdownPollingPeriodOption,
+               MaxAckHoldTimeOption, MaxAckHoldCountOption,
+               SubscriberMemoryBudgetOption, SubscriptionOption>;
 
 /**
  * Convenience function to initialize a
@@ -15,6 +15,7 @@
 #include "google/cloud/pubsub/publisher_connection.h"
 #include "google/cloud/pubsub/internal/batching_publisher_connection.h"
 #include "google/cloud/pubsub/internal/batching_publisher_tracing_connection.h"
+#include "google/cloud/pubsub/internal/concurrency_limited_batch_sink.h"
 #include "google/cloud/pubsub/internal/containing_publisher_connection.h"
 #include "google/cloud/pubsub/internal/create_channel.h"
 #include "google/cloud/pubsub/internal/default_batch_sink.h"
@@ -26,6 +27,7 @@
 #include "google/cloud/pubsub/internal/publisher_tracing_connection.h"
 #include "google/cloud/pubsub/internal/rejects_with_ordering_key.h"
 #include "google/cloud/pubsub/internal/sequential_batch_sink.h"
+#include "google/cloud/pubsub/internal/sharded_batching_publisher_connection.h"
 #include "google/cloud/pubsub/internal/tracing_batch_sink.h"
 #include "google/cloud/pubsub/options.h"
 #include "google/cloud/credentials.h"
@@ -51,6 +53,12 @@ std::shared_ptr<pubsub::PublisherConnection> ConnectionFromDecoratedStub(
     if (google::cloud::internal::TracingEnabled(opts)) {
       sink = MakeTracingBatchSink(topic, std::move(sink), opts);
     }
+    auto const max_in_flight = opts.get<pubsub::MaxInFlightPublishesOption>();
+    if (max_in_flight != 0) {
+      sink = pubsub_internal::ConcurrencyLimitedBatchSink::Create(
+          std::move(sink), max_in_flight,
+          opts.get<pubsub::MaxInFlightPublishBytesOption>());
+    }
     if (opts.get<pubsub::MessageOrderingOption>()) {
       auto factory = [topic, opts, sink, cq](std::string const& key) {
         auto used_sink = sink;
@@ -65,6 +73,12 @@ std::shared_ptr<pubsub::PublisherConnection> ConnectionFromDecoratedStub(
       return pubsub_internal::OrderingKeyPublisherConnection::Create(
           std::move(factory));
     }
+    auto const shards = opts.get<pubsub::PublisherShardsOption>();
+    if (shards > 1) {
+      return pubsub_internal::RejectsWithOrderingKey::Create(
+          pubsub_internal::ShardedBatchingPublisherConnection::Create(
+              topic, opts, shards, std::move(sink), std::move(cq)));
+    }
     return pubsub_internal::RejectsWithOrderingKey::Create(
         pubsub_internal::BatchingPublisherConnection::Create(
             topic, opts, {}, std::move(sink), std::move(cq)));
@@ -18,13 +18,17 @@
 
 pubsub_client_unit_tests = [
     "ack_handler_test.cc",
+    "batch_ack_handler_test.cc",
     "blocking_publisher_connection_test.cc",
     "blocking_publisher_test.cc",
     "exactly_once_ack_handler_test.cc",
+    "internal/ack_coalescer_test.cc",
     "internal/ack_handler_wrapper_test.cc",
+    "internal/ack_latency_distribution_test.cc",
     "internal/batching_publisher_connection_test.cc",
     "internal/batching_publisher_tracing_connection_test.cc",
     "internal/blocking_publisher_tracing_connection_test.cc",
+    "internal/concurrency_limited_batch_sink_test.cc",
     "internal/default_batch_sink_test.cc",
     "internal/default_pull_ack_handler_test.cc",
     "internal/default_pull_lease_manager_test.cc",
@@ -43,8 +47,10 @@ pubsub_client_unit_tests = [
     "internal/rejects_with_ordering_key_test.cc",
     "internal/sequential_batch_sink_test.cc",
     "internal/session_shutdown_manager_test.cc",
+    "internal/sharded_batching_publisher_connection_test.cc",
     "internal/streaming_subscription_batch_source_test.cc",
     "internal/subscriber_connection_impl_test.cc",
+    "internal/subscriber_memory_budget_test.cc",
     "internal/subscriber_stub_factory_test.cc",
     "internal/subscriber_tracing_connection_test.cc",
     "internal/subscription_concurrency_control_test.cc",
@@ -36,6 +36,12 @@ future<Status> Subscriber::Subscribe(ExactlyOnceApplicationCallback cb,
   return connection_->ExactlyOnceSubscribe({std::move(cb)});
 }
 
+future<Status> Subscriber::Subscribe(BatchApplicationCallback cb,
+                                     Options opts) {
+  internal::OptionsSpan span(internal::MergeOptions(std::move(opts), options_));
+  return connection_->BatchSubscribe({std::move(cb)});
+}
+
 StatusOr<PullResponse> Subscriber::Pull(Options opts) {
   internal::OptionsSpan span(internal::MergeOptions(std::move(opts), options_));
   return connection_->Pull();
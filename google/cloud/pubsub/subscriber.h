@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_SUBSCRIBER_H
 
 #include "google/cloud/pubsub/ack_handler.h"
+#include "google/cloud/pubsub/batch_ack_handler.h"
 #include "google/cloud/pubsub/exactly_once_ack_handler.h"
 #include "google/cloud/pubsub/message.h"
 #include "google/cloud/pubsub/subscriber_connection.h"
@@ -157,6 +158,47 @@ class Subscriber {
   future<Status> Subscribe(ExactlyOnceApplicationCallback cb,
                            Options opts = {});
 
+  /**
+   * Creates a new session to receive batches of messages from
+   * @p subscription.
+   *
+   * The library invokes @p cb once for each batch of messages, rather than
+   * once for each message. The messages in a batch are those available when
+   * the callback is scheduled, typically all the messages in a streaming pull
+   * response (subject to `MaxConcurrencyOption`), and all of them are
+   * acknowledged or rejected together using the `BatchAckHandler`. This
+   * amortizes the cost of scheduling the callbacks and of tracking their
+   * acknowledgements for applications with high message rates.
+   *
+   * Each message counts against the `MaxConcurrencyOption` until its batch is
+   * acknowledged or rejected. With ordering keys, a batch contains at most
+   * one message for each key.
+   *
+   * @par Idempotency
+   * @parblock
+   * This is an idempotent operation; it only reads messages from the service.
+   * Will make multiple attempts to start a connection to the service, subject
+   * to the retry policies configured in the `SubscriberConnection`. Once a
+   * successful connection is established the library will try to resume the
+   * connection even if the connection fails with a permanent error. Resuming
+   * the connection is subject to the retry policies as described earlier.
+   *
+   * Note that calling `BatchAckHandler::ack()` and/or
+   * `BatchAckHandler::nack()` is handled differently with respect to
+   * retrying. Check the documentation of these functions for details.
+   * @endparblock
+   *
+   * @param cb the callable invoked when batches of messages are received.
+   * @param opts any option overrides to use in this call.  These options take
+   *   precedence over the options passed in the constructor, and over any
+   *   options provided in the `PublisherConnection` initialization.
+   * @return a future that is satisfied when the session will no longer receive
+   *     messages. For example, because there was an unrecoverable error trying
+   *     to receive data. Calling `.cancel()` in this object will (eventually)
+   *     terminate the session and satisfy the future.
+   */
+  future<Status> Subscribe(BatchApplicationCallback cb, Options opts = {});
+
   /**
    * Pulls one message from @p subscription.
    *
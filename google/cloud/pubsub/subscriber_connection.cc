@@ -70,6 +70,12 @@ future<Status> SubscriberConnection::ExactlyOnceSubscribe(
       internal::UnimplementedError("needs-override", GCP_ERROR_INFO()));
 }
 
+// NOLINTNEXTLINE(performance-unnecessary-value-param)
+future<Status> SubscriberConnection::BatchSubscribe(BatchSubscribeParams) {
+  return make_ready_future(
+      internal::UnimplementedError("needs-override", GCP_ERROR_INFO()));
+}
+
 StatusOr<pubsub::PullResponse> SubscriberConnection::Pull() {
   return internal::UnimplementedError("needs-override", GCP_ERROR_INFO());
 }
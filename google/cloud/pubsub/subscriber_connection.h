@@ -79,6 +79,19 @@ class SubscriberConnection {
    */
   virtual future<Status> ExactlyOnceSubscribe(ExactlyOnceSubscribeParams p);
 
+  struct BatchSubscribeParams {
+    BatchApplicationCallback callback;
+  };
+
+  /**
+   * Defines the interface for
+   * `Subscriber::Subscribe(BatchApplicationCallback)`.
+   *
+   * We use a different name for this function (as opposed to an overload) to
+   * simplify the use of mocks.
+   */
+  virtual future<Status> BatchSubscribe(BatchSubscribeParams p);
+
   virtual StatusOr<PullResponse> Pull();
 
   /// Returns the configuration parameters for this object
@@ -14,6 +14,7 @@
 
 #include "google/cloud/pubsub/subscriber.h"
 #include "google/cloud/pubsub/mocks/mock_ack_handler.h"
+#include "google/cloud/pubsub/mocks/mock_batch_ack_handler.h"
 #include "google/cloud/pubsub/mocks/mock_subscriber_connection.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
@@ -91,6 +92,33 @@ TEST(SubscriberTest, SubscribeWithOptions) {
   ASSERT_STATUS_OK(status);
 }
 
+/// @test Verify Subscriber::Subscribe() works with batch callbacks.
+TEST(SubscriberTest, SubscribeBatch) {
+  Subscription const subscription("test-project", "test-subscription");
+  auto mock = std::make_shared<pubsub_mocks::MockSubscriberConnection>();
+  EXPECT_CALL(*mock, options);
+  EXPECT_CALL(*mock, BatchSubscribe)
+      .WillOnce([&](SubscriberConnection::BatchSubscribeParams const& p) {
+        auto ack = std::make_unique<pubsub_mocks::MockBatchAckHandler>();
+        EXPECT_CALL(*ack, size()).WillRepeatedly(Return(2));
+        EXPECT_CALL(*ack, ack()).Times(1);
+        p.callback({pubsub::MessageBuilder{}.SetData("m0").Build(),
+                    pubsub::MessageBuilder{}.SetData("m1").Build()},
+                   BatchAckHandler(std::move(ack)));
+        return make_ready_future(Status{});
+      });
+
+  Subscriber subscriber(mock);
+  auto status =
+      subscriber
+          .Subscribe([&](std::vector<Message> const& m, BatchAckHandler h) {
+            EXPECT_EQ(m.size(), h.size());
+            std::move(h).ack();
+          })
+          .get();
+  ASSERT_STATUS_OK(status);
+}
+
 TEST(SubscriberTest, OptionsNoOverrides) {
   Subscription const subscription("test-project", "test-subscription");
   auto mock = std::make_shared<pubsub_mocks::MockSubscriberConnection>();
@@ -643,7 +643,7 @@ class ReadExperiment : public BasicExperiment<Traits> {
       auto rows = client.Read(this->table_name_, key, column_names);
       int row_count = 0;
       Status status;
-      for (auto& row : spanner::StreamOf<RowType>(rows)) {
+      for (auto& row : spanner::DecodeStreamOf<RowType>(rows)) {
         if (!row) {
           status = std::move(row).status();
           break;
@@ -792,7 +792,7 @@ class SelectExperiment : public BasicExperiment<Traits> {
                       {"end", spanner::Value(key + config.query_size)}}));
       int row_count = 0;
       Status status;
-      for (auto& row : spanner::StreamOf<RowType>(rows)) {
+      for (auto& row : spanner::DecodeStreamOf<RowType>(rows)) {
         if (!row) {
           status = std::move(row).status();
           break;
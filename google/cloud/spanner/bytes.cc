@@ -27,6 +27,12 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 
 using ::google::cloud::internal::Base64Decoder;
 
+std::size_t Bytes::CopyTo(std::uint8_t* buffer) const {
+  // The representation is always valid, and without interior padding.
+  auto n = google::cloud::internal::Base64DecodeInto(base64_rep_, buffer);
+  return n ? *n : 0;
+}
+
 // Prints the bytes in the form B"...", where printable bytes are output
 // normally, double quotes are backslash escaped, and non-printable characters
 // are printed as a 3-digit octal escape sequence.
@@ -74,6 +80,14 @@ struct BytesInternals {
 StatusOr<spanner::Bytes> BytesFromBase64(std::string input) {
   auto status = google::cloud::internal::ValidateBase64String(input);
   if (!status.ok()) return status;
+  // Padding is accepted in any chunk, but `Bytes` relies on it being only in
+  // the last one, as produced by any real encoder, so re-encode otherwise.
+  auto const padding = input.find('=');
+  if (padding != std::string::npos && padding + 2 < input.size()) {
+    auto decoded = google::cloud::internal::Base64DecodeToBytes(input);
+    if (!decoded) return std::move(decoded).status();
+    return spanner::Bytes(*decoded);
+  }
   return BytesInternals::Create(std::move(input));
 }
 
@@ -20,14 +20,42 @@
 #include "google/cloud/status_or.h"
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <ostream>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace google {
 namespace cloud {
 namespace spanner_internal {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 struct BytesInternals;
+
+// Containers with contiguous storage of octets, which can be encoded from,
+// or decoded into, in a single pass.
+template <typename C>
+using ContiguousElement =
+    std::remove_pointer_t<decltype(std::data(std::declval<C&>()))>;
+
+template <typename C, typename = void>
+struct IsContiguousOctets : std::false_type {};
+template <typename C>
+struct IsContiguousOctets<
+    C, std::void_t<ContiguousElement<C>,
+                   decltype(std::size(std::declval<C&>()))>>
+    : std::integral_constant<bool,
+                             std::is_integral<ContiguousElement<C>>::value &&
+                                 sizeof(ContiguousElement<C>) == 1> {};
+
+template <typename C, typename = void>
+struct IsResizableOctets : std::false_type {};
+template <typename C>
+struct IsResizableOctets<
+    C, std::void_t<decltype(std::declval<C&>().resize(std::size_t{}))>>
+    : IsContiguousOctets<C> {};
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner_internal
 
@@ -39,6 +67,10 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
  *
  * A `Bytes` value can be constructed from, and converted to any sequence of
  * octets. `Bytes` values can be compared for equality.
+ *
+ * The value is held in its base64 wire format, and only decoded on demand,
+ * either into a container with `get()`, or into a caller-provided buffer with
+ * `CopyTo()`.
  */
 class Bytes {
  public:
@@ -49,20 +81,59 @@ class Bytes {
   ///@{
   template <typename InputIt>
   Bytes(InputIt first, InputIt last) {
-    google::cloud::internal::Base64Encoder encoder;
-    while (first != last) encoder.PushBack(*first++);
-    base64_rep_ = std::move(encoder).FlushAndPad();
+    if constexpr (std::is_pointer<InputIt>::value && sizeof(*first) == 1) {
+      base64_rep_ = google::cloud::internal::Base64Encode(
+          first, static_cast<std::size_t>(last - first));
+    } else {
+      google::cloud::internal::Base64Encoder encoder;
+      while (first != last) encoder.PushBack(*first++);
+      base64_rep_ = std::move(encoder).FlushAndPad();
+    }
   }
   template <typename Container>
-  explicit Bytes(Container const& c) : Bytes(std::begin(c), std::end(c)) {}
+  explicit Bytes(Container const& c) {
+    using spanner_internal::IsContiguousOctets;
+    if constexpr (IsContiguousOctets<Container const>::value) {
+      base64_rep_ =
+          google::cloud::internal::Base64Encode(std::data(c), std::size(c));
+    } else {
+      *this = Bytes(std::begin(c), std::end(c));
+    }
+  }
   ///@}
 
   /// Conversion to a sequence of octets.  The `Container` must support
   /// construction from a range specified as a pair of input iterators.
   template <typename Container>
   Container get() const {
-    google::cloud::internal::Base64Decoder decoder(base64_rep_);
-    return Container(decoder.begin(), decoder.end());
+    if constexpr (spanner_internal::IsResizableOctets<Container>::value) {
+      Container c;
+      c.resize(size());
+      CopyTo(reinterpret_cast<std::uint8_t*>(std::data(c)));
+      return c;
+    } else {
+      google::cloud::internal::Base64Decoder decoder(base64_rep_);
+      return Container(decoder.begin(), decoder.end());
+    }
+  }
+
+  /// The number of octets, computed without decoding them.
+  std::size_t size() const {
+    return google::cloud::internal::Base64DecodedSize(base64_rep_);
+  }
+
+  /**
+   * Decodes the octets into @p buffer, which must have room for at least
+   * `size()` octets.
+   *
+   * Unlike `get()`, this allows the application to reuse its buffers when
+   * reading many large values.
+   *
+   * @return the number of octets written, that is, `size()`.
+   */
+  std::size_t CopyTo(std::uint8_t* buffer) const;
+  std::size_t CopyTo(char* buffer) const {
+    return CopyTo(reinterpret_cast<std::uint8_t*>(buffer));
   }
 
   /// @name Relational operators
@@ -22,18 +22,20 @@ namespace spanner {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
 
-// Run on (6 X 2300 MHz CPU s)
+// Run on (1 X 2000 MHz CPU )
 // CPU Caches:
-//   L1 Data 32K (x3)
-//   L1 Instruction 32K (x3)
-//   L2 Unified 256K (x3)
-//   L3 Unified 46080K (x1)
-// Load Average: 0.22, 0.24, 0.26
-// ----------------------------------------------------------------
-// Benchmark            Time       CPU   Iterations UserCounters...
-// ----------------------------------------------------------------
-// BM_BytesCtor      8386 ns   8318 ns        82963 bytes_per_second=167.843M/s
-// BM_BytesGet       6094 ns   6057 ns       115399 bytes_per_second=307.34M/s
+//   L1 Data 48 KiB (x1)
+//   L1 Instruction 32 KiB (x1)
+//   L2 Unified 2048 KiB (x1)
+//   L3 Unified 107520 KiB (x1)
+// Load Average: 0.72, 0.62, 0.59
+// ------------------------------------------------------------------------
+// Benchmark             Time     CPU Iterations UserCounters...
+// ------------------------------------------------------------------------
+// BM_BytesCtor       1966 ns 1935 ns     337181 bytes_per_second=770.68M/s
+// BM_BytesGet        1277 ns 1264 ns     460988 bytes_per_second=1.53802G/s
+// BM_BytesCopyTo     1393 ns 1332 ns     467496 bytes_per_second=1.45978G/s
+// BM_BytesFromBase64  995 ns  978 ns     649549 bytes_per_second=1.98768G/s
 
 std::string const kText = R"""(
     Four score and seven years ago our fathers brought forth on this
@@ -81,6 +83,27 @@ void BM_BytesGet(benchmark::State& state) {
 }
 BENCHMARK(BM_BytesGet);
 
+void BM_BytesCopyTo(benchmark::State& state) {
+  Bytes b(kText);
+  std::string buffer(b.size(), '\0');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(b.CopyTo(&buffer[0]));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          spanner_internal::BytesToBase64(b).size());
+}
+BENCHMARK(BM_BytesCopyTo);
+
+void BM_BytesFromBase64(benchmark::State& state) {
+  auto const rep = spanner_internal::BytesToBase64(Bytes(kText));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spanner_internal::BytesFromBase64(rep));
+  }
+  state.SetBytesProcessed(state.iterations() * rep.size());
+}
+BENCHMARK(BM_BytesFromBase64);
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner
@@ -111,6 +111,34 @@ TEST(Bytes, Conversions) {
   EXPECT_EQ(v_plain, bytes->get<std::vector<std::uint8_t>>());
 }
 
+TEST(Bytes, SizeAndCopyTo) {
+  std::string plain;
+  for (int i = 0; i != 100; ++i) {
+    Bytes bytes(plain);
+    EXPECT_EQ(plain.size(), bytes.size());
+
+    std::vector<char> buffer(bytes.size() + 1, '*');
+    EXPECT_EQ(plain.size(), bytes.CopyTo(buffer.data()));
+    EXPECT_EQ(plain, std::string(buffer.data(), plain.size()));
+    EXPECT_EQ('*', buffer.back());
+
+    std::vector<std::uint8_t> octets(bytes.size());
+    EXPECT_EQ(plain.size(), bytes.CopyTo(octets.data()));
+    EXPECT_EQ(octets, bytes.get<std::vector<std::uint8_t>>());
+
+    plain.push_back(static_cast<char>(i * 101));
+  }
+}
+
+TEST(Bytes, FromBase64InteriorPadding) {
+  auto bytes = spanner_internal::BytesFromBase64("YQ==YWI=YWJj");
+  ASSERT_STATUS_OK(bytes);
+  EXPECT_EQ(6, bytes->size());
+  EXPECT_EQ("aababc", bytes->get<std::string>());
+  EXPECT_EQ(Bytes(std::string("aababc")), *bytes);
+  EXPECT_EQ("YWFiYWJj", spanner_internal::BytesToBase64(*bytes));
+}
+
 TEST(Bytes, RelationalOperators) {
   std::string const s_plain = "The quick brown fox jumps over the lazy dog.";
   std::deque<char> const d_plain(s_plain.begin(), s_plain.end());
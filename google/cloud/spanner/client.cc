@@ -14,8 +14,10 @@
 #include "google/cloud/internal/disable_deprecation_warnings.inc"
 #include "google/cloud/spanner/client.h"
 #include "google/cloud/spanner/internal/connection_impl.h"
+#include "google/cloud/spanner/internal/query_cache_connection.h"
 #include "google/cloud/spanner/internal/spanner_stub_factory.h"
 #include "google/cloud/spanner/internal/status_utils.h"
+#include "google/cloud/spanner/internal/transaction_scheduler.h"
 #include "google/cloud/spanner/options.h"
 #include "google/cloud/spanner/retry_policy.h"
 #include "google/cloud/spanner/transaction.h"
@@ -251,6 +253,16 @@ StatusOr<CommitResult> Client::Commit(
   auto const txn_opts = Transaction::ReadWriteOptions().WithTag(
       internal::FetchOption<TransactionTagOption>(internal::CurrentOptions()));
   Transaction txn = MakeReadWriteTransaction(txn_opts);
+  // Hold the declared keys, if any, across all the reruns.
+  std::shared_ptr<spanner_internal::TransactionScheduler> scheduler;
+  std::optional<spanner_internal::TransactionScheduler::Ticket> ticket;
+  if (internal::CurrentOptions().has<TransactionKeySetOption>()) {
+    scheduler = spanner_internal::GetTransactionScheduler(conn_);
+    auto admitted = scheduler->Admit(
+        internal::CurrentOptions().get<TransactionKeySetOption>());
+    if (!admitted) return std::move(admitted).status();
+    ticket.emplace(*std::move(admitted));
+  }
   for (;;) {
     StatusOr<Mutations> mutations;
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
@@ -279,6 +291,7 @@ StatusOr<CommitResult> Client::Commit(
     if (RerunnablePolicy::IsOk(status)) {
       auto result = Commit(txn, *mutations, internal::CurrentOptions());
       status = result.status();
+      if (ticket) ticket->OnCommit(status);
       if (!RerunnablePolicy::IsTransientFailure(status)) {
         return result;
       }
@@ -379,6 +392,60 @@ Status Client::Rollback(Transaction transaction, Options opts) {
   return conn_->Rollback({std::move(transaction)});
 }
 
+future<StatusOr<DmlResult>> Client::AsyncExecuteDml(Transaction transaction,
+                                                    SqlStatement statement,
+                                                    Options opts) {
+  internal::OptionsSpan span(internal::MergeOptions(std::move(opts), opts_));
+  return conn_->AsyncExecuteDml({std::move(transaction), std::move(statement),
+                                 QueryOptions(internal::CurrentOptions()),
+                                 std::nullopt, false,
+                                 DirectedReadOption::Type{}});
+}
+
+future<StatusOr<CommitResult>> Client::AsyncCommit(Transaction transaction,
+                                                   Mutations mutations,
+                                                   Options opts) {
+  internal::OptionsSpan span(internal::MergeOptions(std::move(opts), opts_));
+  return conn_->AsyncCommit({std::move(transaction), std::move(mutations),
+                             CommitOptions(internal::CurrentOptions())});
+}
+
+future<StatusOr<CommitResult>> Client::AsyncCommit(
+    std::function<future<StatusOr<Mutations>>(Transaction)> mutator,
+    std::unique_ptr<TransactionRerunPolicy> rerun_policy,
+    std::unique_ptr<BackoffPolicy> backoff_policy, Options opts) {
+  internal::OptionsSpan span(internal::MergeOptions(std::move(opts), opts_));
+  return conn_->AsyncRunTransaction({std::move(mutator),
+                                     std::move(rerun_policy),
+                                     std::move(backoff_policy)});
+}
+
+future<StatusOr<CommitResult>> Client::AsyncCommit(
+    std::function<future<StatusOr<Mutations>>(Transaction)> mutator,
+    Options opts) {
+  internal::OptionsSpan span(internal::MergeOptions(std::move(opts), opts_));
+  auto const rerun_maximum_duration = std::chrono::minutes(10);
+  auto default_commit_rerun_policy =
+      LimitedTimeTransactionRerunPolicy(rerun_maximum_duration).clone();
+
+  auto const backoff_initial_delay = std::chrono::milliseconds(100);
+  auto const backoff_maximum_delay = std::chrono::minutes(5);
+  auto const backoff_scaling = 2.0;
+  auto default_commit_backoff_policy =
+      ExponentialBackoffPolicy(backoff_initial_delay, backoff_maximum_delay,
+                               backoff_scaling)
+          .clone();
+
+  return conn_->AsyncRunTransaction({std::move(mutator),
+                                     std::move(default_commit_rerun_policy),
+                                     std::move(default_commit_backoff_policy)});
+}
+
+future<Status> Client::AsyncRollback(Transaction transaction, Options opts) {
+  internal::OptionsSpan span(internal::MergeOptions(std::move(opts), opts_));
+  return conn_->AsyncRollback({std::move(transaction)});
+}
+
 StatusOr<PartitionedDmlResult> Client::ExecutePartitionedDml(
     SqlStatement statement, Options opts) {
   internal::OptionsSpan span(internal::MergeOptions(std::move(opts), opts_));
@@ -391,7 +458,7 @@ std::shared_ptr<spanner::Connection> MakeConnection(spanner::Database const& db,
   internal::CheckExpectedOptions<
       CommonOptionList, GrpcOptionList, UnifiedCredentialsOptionList,
       SessionPoolOptionList, spanner_internal::SessionPoolClockOption,
-      SpannerPolicyOptionList>(opts, __func__);
+      SpannerPolicyOptionList, QueryCacheMaxBytesOption>(opts, __func__);
   opts = spanner_internal::DefaultOptions(std::move(opts));
 
   auto background = internal::MakeBackgroundThreadsFactory(opts)();
@@ -402,8 +469,15 @@ std::shared_ptr<spanner::Connection> MakeConnection(spanner::Database const& db,
   std::generate(stubs.begin(), stubs.end(), [&db, &auth, &opts, &id] {
     return spanner_internal::CreateDefaultSpannerStub(db, auth, opts, id++);
   });
-  return std::make_shared<spanner_internal::ConnectionImpl>(
-      std::move(db), std::move(background), std::move(stubs), std::move(opts));
+  auto const cache_bytes = opts.has<QueryCacheMaxBytesOption>()
+                               ? opts.get<QueryCacheMaxBytesOption>()
+                               : std::size_t{0};
+  std::shared_ptr<Connection> conn =
+      std::make_shared<spanner_internal::ConnectionImpl>(
+          db, std::move(background), std::move(stubs), std::move(opts));
+  if (cache_bytes == 0) return conn;
+  return std::make_shared<spanner_internal::QueryCacheConnection>(
+      db.FullName(), std::move(conn), cache_bytes);
 }
 
 std::shared_ptr<Connection> MakeConnection(
@@ -36,6 +36,7 @@
 #include "google/cloud/spanner/transaction.h"
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/backoff_policy.h"
+#include "google/cloud/future.h"
 #include "google/cloud/internal/non_constructible.h"
 #include "google/cloud/options.h"
 #include "google/cloud/status.h"
@@ -530,6 +531,13 @@ class Client {
    * the transaction is no longer usable (e.g., it was aborted). Otherwise
    * the transaction will be leaked.
    *
+   * If the @p opts include a `TransactionKeySetOption`, `Commit()` first waits
+   * for any transactions on overlapping keys to finish, and holds those keys
+   * until it returns. A `Commit()` declaring keys that is called from the
+   * @p mutator of another such `Commit()` fails with
+   * `StatusCode::kFailedPrecondition`, as waiting for more keys while holding
+   * some could deadlock.
+   *
    * @par Example
    * @snippet samples.cc commit-with-policies
    *
@@ -541,6 +549,7 @@ class Client {
    *     include any of the following types:
    *       - `google::cloud::spanner::CommitReturnStatsOption`
    *       - `google::cloud::spanner::RequestPriorityOption`
+   *       - `google::cloud::spanner::TransactionKeySetOption`
    *       - `google::cloud::spanner::TransactionTagOption`
    *
    * @throw Rethrows any exception thrown by @p `mutator` (after rolling back
@@ -716,6 +725,64 @@ class Client {
   StatusOr<PartitionedDmlResult> ExecutePartitionedDml(SqlStatement statement,
                                                        Options opts = {});
 
+  /**
+   * @name Asynchronous operations
+   *
+   * These functions return a `future<>` that is satisfied when the operation
+   * completes, instead of blocking the calling thread. The futures can be
+   * chained with `.then()`, or awaited with `co_await` in C++20 coroutines
+   * (see `google/cloud/future_coroutines.h`).
+   *
+   * Acquiring a session from the session pool may block the calling thread.
+   */
+  ///@{
+  /// Asynchronously executes a SQL DML statement in an existing transaction.
+  future<StatusOr<DmlResult>> AsyncExecuteDml(Transaction transaction,
+                                              SqlStatement statement,
+                                              Options opts = {});
+
+  /**
+   * Asynchronously commits a read-write transaction.
+   *
+   * The asynchronous version of `Commit(Transaction, Mutations, Options)`.
+   */
+  future<StatusOr<CommitResult>> AsyncCommit(Transaction transaction,
+                                             Mutations mutations,
+                                             Options opts = {});
+
+  /**
+   * Asynchronously runs a read-write transaction.
+   *
+   * The asynchronous version of the `Commit()` rerun loop. The @p mutator
+   * returns a future satisfied with the mutations to commit, and is called
+   * again with a new transaction if the transaction aborts, subject to the
+   * @p rerun_policy and @p backoff_policy. The client does not block any
+   * thread while it waits between reruns.
+   *
+   * @param mutator the function called to create mutations
+   * @param rerun_policy controls for how long (or how many times) the mutator
+   *     will be rerun after the transaction aborts.
+   * @param backoff_policy controls how long to wait between reruns.
+   * @param opts (optional) The options to use for this call.  Expected options
+   *     include any of the following types:
+   *       - `google::cloud::spanner::CommitReturnStatsOption`
+   *       - `google::cloud::spanner::RequestPriorityOption`
+   *       - `google::cloud::spanner::TransactionTagOption`
+   */
+  future<StatusOr<CommitResult>> AsyncCommit(
+      std::function<future<StatusOr<Mutations>>(Transaction)> mutator,
+      std::unique_ptr<TransactionRerunPolicy> rerun_policy,
+      std::unique_ptr<BackoffPolicy> backoff_policy, Options opts = {});
+
+  /// Same as above, but uses the default rerun and backoff policies.
+  future<StatusOr<CommitResult>> AsyncCommit(
+      std::function<future<StatusOr<Mutations>>(Transaction)> mutator,
+      Options opts = {});
+
+  /// Asynchronously rolls back a read-write transaction.
+  future<Status> AsyncRollback(Transaction transaction, Options opts = {});
+  ///@}
+
   ///@{
   /// @name Backwards compatibility for ReadOptions.
   /**
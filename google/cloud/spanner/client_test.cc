@@ -29,10 +29,12 @@
 #include <google/protobuf/text_format.h>
 #include <gmock/gmock.h>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -449,6 +451,76 @@ TEST(ClientTest, RollbackError) {
               StatusIs(StatusCode::kInvalidArgument, HasSubstr("oops")));
 }
 
+TEST(ClientTest, AsyncExecuteDml) {
+  auto conn = std::make_shared<MockConnection>();
+  Client client(conn);
+
+  EXPECT_CALL(*conn, AsyncExecuteDml)
+      .WillOnce(Return(ByMove(make_ready_future(StatusOr<DmlResult>(
+          Status(StatusCode::kPermissionDenied, "uh-oh"))))));
+
+  auto txn = MakeReadWriteTransaction();
+  EXPECT_THAT(
+      client.AsyncExecuteDml(txn, SqlStatement("DELETE FROM T")).get(),
+      StatusIs(StatusCode::kPermissionDenied, HasSubstr("uh-oh")));
+}
+
+TEST(ClientTest, AsyncCommit) {
+  auto conn = std::make_shared<MockConnection>();
+
+  auto ts = MakeTimestamp(std::chrono::system_clock::from_time_t(123)).value();
+  CommitResult result;
+  result.commit_timestamp = ts;
+
+  Client client(conn);
+  EXPECT_CALL(*conn, AsyncCommit)
+      .WillOnce(Return(ByMove(make_ready_future(make_status_or(result)))));
+
+  auto txn = MakeReadWriteTransaction();
+  auto commit = client.AsyncCommit(txn, {}).get();
+  ASSERT_STATUS_OK(commit);
+  EXPECT_EQ(ts, commit->commit_timestamp);
+}
+
+TEST(ClientTest, AsyncRollback) {
+  auto conn = std::make_shared<MockConnection>();
+
+  Client client(conn);
+  EXPECT_CALL(*conn, AsyncRollback)
+      .WillOnce(Return(ByMove(make_ready_future(
+          Status(StatusCode::kInvalidArgument, "oops")))));
+
+  auto txn = MakeReadWriteTransaction();
+  EXPECT_THAT(client.AsyncRollback(txn).get(),
+              StatusIs(StatusCode::kInvalidArgument, HasSubstr("oops")));
+}
+
+TEST(ClientTest, AsyncCommitMutator) {
+  auto conn = std::make_shared<MockConnection>();
+
+  auto ts = MakeTimestamp(std::chrono::system_clock::from_time_t(123)).value();
+  EXPECT_CALL(*conn, AsyncRunTransaction)
+      .WillOnce([&ts](Connection::AsyncRunTransactionParams const& p) {
+        EXPECT_NE(nullptr, p.rerun_policy);
+        EXPECT_NE(nullptr, p.backoff_policy);
+        auto mutations = p.mutator(MakeReadWriteTransaction()).get();
+        EXPECT_STATUS_OK(mutations);
+        EXPECT_THAT(*mutations, SizeIs(1));
+        return make_ready_future(
+            make_status_or(CommitResult{ts, std::nullopt}));
+      });
+
+  auto mutator = [](Transaction const&) {
+    return make_ready_future(make_status_or(
+        Mutations{MakeDeleteMutation("table", KeySet::All())}));
+  };
+
+  Client client(conn);
+  auto result = client.AsyncCommit(mutator).get();
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(ts, result->commit_timestamp);
+}
+
 TEST(ClientTest, CommitMutatorSuccess) {
   auto timestamp =
       spanner_internal::TimestampFromRFC3339("2019-08-14T21:16:21.123Z");
@@ -681,6 +753,65 @@ TEST(ClientTest, CommitMutatorRerunTransientFailures) {
   EXPECT_EQ(*timestamp, result->commit_timestamp);
 }
 
+TEST(ClientTest, CommitMutatorKeySetRunsInTurn) {
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Commit)
+      .Times(4)
+      .WillRepeatedly([&running](Connection::CommitParams const&) {
+        --running;
+        return CommitResult{};
+      });
+
+  auto mutator = [&](Transaction const&) -> StatusOr<Mutations> {
+    auto const n = ++running;
+    auto m = max_running.load();
+    while (n > m && !max_running.compare_exchange_weak(m, n)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    return Mutations{MakeDeleteMutation("table", KeySet().AddKey(MakeKey(1)))};
+  };
+
+  // Copies of the client share the scheduler of their connection.
+  Client client(conn);
+  auto const opts = Options{}.set<TransactionKeySetOption>(
+      {{"table", KeySet().AddKey(MakeKey(1))}});
+  std::vector<std::thread> threads;
+  for (int i = 0; i != 4; ++i) {
+    threads.emplace_back([client, &mutator, &opts]() mutable {
+      EXPECT_STATUS_OK(client.Commit(mutator, opts));
+    });
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(max_running.load(), 1);
+}
+
+TEST(ClientTest, CommitMutatorNestedKeySetFails) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Commit).WillOnce([](Connection::CommitParams const&) {
+    return CommitResult{};
+  });
+
+  Client client(conn);
+  auto const opts = Options{}.set<TransactionKeySetOption>(
+      {{"table", KeySet().AddKey(MakeKey(1))}});
+  auto mutator = [&](Transaction const&) -> StatusOr<Mutations> {
+    // Waiting for more keys while holding some could deadlock.
+    auto nested = client.Commit(
+        [](Transaction const&) -> StatusOr<Mutations> {
+          ADD_FAILURE() << "the nested mutator should not run";
+          return Mutations{};
+        },
+        Options{}.set<TransactionKeySetOption>(
+            {{"other-table", KeySet().AddKey(MakeKey(2))}}));
+    EXPECT_THAT(nested, StatusIs(StatusCode::kFailedPrecondition));
+    return Mutations{MakeDeleteMutation("table", KeySet().AddKey(MakeKey(1)))};
+  };
+  EXPECT_STATUS_OK(client.Commit(mutator, opts));
+}
+
 TEST(ClientTest, CommitMutatorTooManyFailures) {
   int commit_attempts = 0;
   int const maximum_failures = 2;
@@ -111,6 +111,30 @@ BatchedCommitResultStream Connection::BatchWrite(BatchWriteParams) {
       [] { return Status(StatusCode::kUnimplemented, "not implemented"); });
 }
 
+// NOLINTNEXTLINE(performance-unnecessary-value-param)
+future<StatusOr<DmlResult>> Connection::AsyncExecuteDml(SqlParams) {
+  return make_ready_future(StatusOr<DmlResult>(
+      Status(StatusCode::kUnimplemented, "not implemented")));
+}
+
+// NOLINTNEXTLINE(performance-unnecessary-value-param)
+future<StatusOr<CommitResult>> Connection::AsyncCommit(CommitParams) {
+  return make_ready_future(StatusOr<CommitResult>(
+      Status(StatusCode::kUnimplemented, "not implemented")));
+}
+
+// NOLINTNEXTLINE(performance-unnecessary-value-param)
+future<Status> Connection::AsyncRollback(RollbackParams) {
+  return make_ready_future(
+      Status(StatusCode::kUnimplemented, "not implemented"));
+}
+
+future<StatusOr<CommitResult>> Connection::AsyncRunTransaction(
+    AsyncRunTransactionParams) {  // NOLINT(performance-unnecessary-value-param)
+  return make_ready_future(StatusOr<CommitResult>(
+      Status(StatusCode::kUnimplemented, "not implemented")));
+}
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner
 }  // namespace cloud
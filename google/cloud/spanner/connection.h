@@ -28,12 +28,17 @@
 #include "google/cloud/spanner/query_options.h"
 #include "google/cloud/spanner/read_options.h"
 #include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/retry_policy.h"
 #include "google/cloud/spanner/sql_statement.h"
 #include "google/cloud/spanner/transaction.h"
 #include "google/cloud/spanner/version.h"
+#include "google/cloud/backoff_policy.h"
+#include "google/cloud/future.h"
 #include "google/cloud/optional.h"
 #include "google/cloud/options.h"
 #include "google/cloud/status_or.h"
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -141,6 +146,13 @@ class Connection {
     std::vector<Mutations> mutation_groups;
     Options options;
   };
+
+  /// Wrap the arguments to `AsyncRunTransaction()`.
+  struct AsyncRunTransactionParams {
+    std::function<future<StatusOr<Mutations>>(Transaction)> mutator;
+    std::unique_ptr<TransactionRerunPolicy> rerun_policy;
+    std::unique_ptr<BackoffPolicy> backoff_policy;
+  };
   ///@}
 
   /// Returns the options used by the Connection.
@@ -187,6 +199,19 @@ class Connection {
 
   /// Defines the interface for batched `Client::CommitAtLeastOnce()`
   virtual BatchedCommitResultStream BatchWrite(BatchWriteParams);
+
+  /// Defines the interface for `Client::AsyncExecuteDml()`
+  virtual future<StatusOr<DmlResult>> AsyncExecuteDml(SqlParams);
+
+  /// Defines the interface for `Client::AsyncCommit()`
+  virtual future<StatusOr<CommitResult>> AsyncCommit(CommitParams);
+
+  /// Defines the interface for `Client::AsyncRollback()`
+  virtual future<Status> AsyncRollback(RollbackParams);
+
+  /// Defines the interface for `Client::AsyncCommit()` with a mutator
+  virtual future<StatusOr<CommitResult>> AsyncRunTransaction(
+      AsyncRunTransactionParams);
 };
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
@@ -75,6 +75,8 @@ google_cloud_cpp_spanner_hdrs = [
     "internal/partial_result_set_reader.h",
     "internal/partial_result_set_resume.h",
     "internal/partial_result_set_source.h",
+    "internal/query_cache_connection.h",
+    "internal/resume_buffer_budget.h",
     "internal/route_to_leader.h",
     "internal/session.h",
     "internal/session_pool.h",
@@ -86,11 +88,13 @@ google_cloud_cpp_spanner_hdrs = [
     "internal/spanner_tracing_stub.h",
     "internal/status_utils.h",
     "internal/transaction_impl.h",
+    "internal/transaction_scheduler.h",
     "internal/tuple_utils.h",
     "interval.h",
     "json.h",
     "keys.h",
     "lock_hint.h",
+    "mutation_batcher.h",
     "mutations.h",
     "numeric.h",
     "oid.h",
@@ -98,6 +102,7 @@ google_cloud_cpp_spanner_hdrs = [
     "order_by.h",
     "partition_options.h",
     "partitioned_dml_result.h",
+    "partitioned_executor.h",
     "polling_policy.h",
     "proto_enum.h",
     "proto_message.h",
@@ -166,6 +171,8 @@ google_cloud_cpp_spanner_srcs = [
     "internal/merge_chunk.cc",
     "internal/partial_result_set_resume.cc",
     "internal/partial_result_set_source.cc",
+    "internal/query_cache_connection.cc",
+    "internal/resume_buffer_budget.cc",
     "internal/route_to_leader.cc",
     "internal/session.cc",
     "internal/session_pool.cc",
@@ -177,11 +184,14 @@ google_cloud_cpp_spanner_srcs = [
     "internal/spanner_tracing_stub.cc",
     "internal/status_utils.cc",
     "internal/transaction_impl.cc",
+    "internal/transaction_scheduler.cc",
     "interval.cc",
     "keys.cc",
+    "mutation_batcher.cc",
     "mutations.cc",
     "numeric.cc",
     "partition_options.cc",
+    "partitioned_executor.cc",
     "query_options.cc",
     "query_partition.cc",
     "read_options.cc",
@@ -26,14 +26,17 @@
 #include "google/cloud/common_options.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/internal/algorithm.h"
+#include "google/cloud/internal/async_retry_loop.h"
 #include "google/cloud/internal/make_status.h"
 #include "google/cloud/internal/resumable_streaming_read_rpc.h"
 #include "google/cloud/internal/retry_loop.h"
 #include "google/cloud/internal/streaming_read_rpc.h"
+#include "google/cloud/log.h"
 #include "google/cloud/options.h"
 #include <google/protobuf/util/time_util.h>
 #include <grpcpp/grpcpp.h>
 #include <algorithm>
+#include <chrono>
 #include <functional>
 
 namespace google {
@@ -356,6 +359,88 @@ spanner::BatchedCommitResult FromProto(
   return result;
 }
 
+// Builds the `ExecuteSqlRequest` for @p params in the given session and
+// transaction.
+google::spanner::v1::ExecuteSqlRequest MakeExecuteSqlRequest(
+    std::string const& session_name,
+    google::spanner::v1::TransactionSelector const& selector,
+    TransactionContext const& ctx, spanner::Connection::SqlParams params,
+    google::spanner::v1::ExecuteSqlRequest::QueryMode query_mode) {
+  google::spanner::v1::ExecuteSqlRequest request;
+  request.set_session(session_name);
+  *request.mutable_transaction() = selector;
+  auto sql_statement = ToProto(std::move(params.statement));
+  request.set_sql(std::move(*sql_statement.mutable_sql()));
+  *request.mutable_params() = std::move(*sql_statement.mutable_params());
+  *request.mutable_param_types() =
+      std::move(*sql_statement.mutable_param_types());
+  request.set_seqno(ctx.seqno);
+  request.set_query_mode(query_mode);
+  if (params.partition_token) {
+    request.set_partition_token(*std::move(params.partition_token));
+    if (params.partition_data_boost) {
+      request.set_data_boost_enabled(true);
+    }
+  }
+  if (params.query_options.optimizer_version()) {
+    request.mutable_query_options()->set_optimizer_version(
+        *params.query_options.optimizer_version());
+  }
+  if (params.query_options.optimizer_statistics_package()) {
+    request.mutable_query_options()->set_optimizer_statistics_package(
+        *params.query_options.optimizer_statistics_package());
+  }
+  request.mutable_request_options()->set_priority(
+      ProtoRequestPriority(params.query_options.request_priority()));
+  if (params.query_options.request_tag().has_value()) {
+    request.mutable_request_options()->set_request_tag(
+        *params.query_options.request_tag());
+  }
+  request.mutable_request_options()->set_transaction_tag(ctx.tag);
+  absl::visit(DirectedReadVisitor([&request] {
+                return request.mutable_directed_read_options();
+              }),
+              params.directed_read_option);
+  return request;
+}
+
+// Builds the `CommitRequest` for @p params, without the transaction.
+google::spanner::v1::CommitRequest MakeCommitRequest(
+    std::string const& session_name, TransactionContext const& ctx,
+    spanner::Connection::CommitParams params) {
+  google::spanner::v1::CommitRequest request;
+  request.set_session(session_name);
+  for (auto&& m : params.mutations) {
+    *request.add_mutations() = std::move(m).as_proto();
+  }
+  request.set_return_commit_stats(params.options.return_stats());
+  request.mutable_request_options()->set_priority(
+      ProtoRequestPriority(params.options.request_priority()));
+  if (params.options.max_commit_delay().has_value()) {
+    *request.mutable_max_commit_delay() =
+        google::protobuf::util::TimeUtil::MillisecondsToDuration(
+            params.options.max_commit_delay()->count());
+  }
+
+  // params.options.transaction_tag() was either already used to set
+  // ctx.tag (for a library-generated transaction), or it is ignored
+  // (for a user-supplied transaction).
+  request.mutable_request_options()->set_transaction_tag(ctx.tag);
+  return request;
+}
+
+// Converts a `CommitResponse` proto to a `spanner::CommitResult`.
+spanner::CommitResult FromProto(
+    google::spanner::v1::CommitResponse const& response) {
+  spanner::CommitResult r;
+  r.commit_timestamp = MakeTimestamp(response.commit_timestamp());
+  if (response.has_commit_stats()) {
+    r.commit_stats.emplace(
+        spanner::CommitStats{response.commit_stats().mutation_count()});
+  }
+  return r;
+}
+
 template <typename T>
 std::optional<T> GetRandomElement(
     google::protobuf::RepeatedPtrField<T> const& m) {
@@ -366,6 +451,313 @@ std::optional<T> GetRandomElement(
   return m[index];
 }
 
+// Asynchronous version of `ConnectionImpl::BeginTransaction()`.
+future<StatusOr<google::spanner::v1::Transaction>> AsyncBeginTransactionRpc(
+    CompletionQueue cq, std::shared_ptr<SpannerStub> const& stub,
+    internal::ImmutableOptions const& options, SessionHolder& session,
+    google::spanner::v1::TransactionOptions transaction_options,
+    std::string request_tag, TransactionContext& ctx,
+    std::optional<google::spanner::v1::Mutation> mutation, char const* func) {
+  google::spanner::v1::BeginTransactionRequest begin;
+  begin.set_session(session->session_name());
+  *begin.mutable_options() = std::move(transaction_options);
+  begin.mutable_request_options()->set_request_tag(std::move(request_tag));
+  begin.mutable_request_options()->set_transaction_tag(ctx.tag);
+  if (mutation) {
+    *begin.mutable_mutation_key() = *std::move(mutation);
+  }
+  return google::cloud::internal::AsyncRetryLoop(
+             RetryPolicyPrototype(*options)->clone(),
+             BackoffPolicyPrototype(*options)->clone(),
+             Idempotency::kIdempotent, std::move(cq),
+             [stub, route_to_leader = ctx.route_to_leader](
+                 CompletionQueue& cq,
+                 std::shared_ptr<grpc::ClientContext> context,
+                 internal::ImmutableOptions options,
+                 google::spanner::v1::BeginTransactionRequest const& request) {
+               if (route_to_leader) RouteToLeader(*context);
+               return stub->AsyncBeginTransaction(cq, std::move(context),
+                                                  std::move(options), request);
+             },
+             options, std::move(begin), func)
+      .then([&session,
+             &ctx](future<StatusOr<google::spanner::v1::Transaction>> f) {
+        auto response = f.get();
+        if (!response) {
+          if (IsSessionNotFound(response.status())) session->set_bad();
+          return response;
+        }
+        if (response->has_precommit_token()) {
+          ctx.precommit_token = response->precommit_token();
+        }
+        return response;
+      });
+}
+
+// Runs @p request using the unary `ExecuteSql()` RPC. As in
+// `ConnectionImpl::ExecuteSqlImpl()`, if the request fails to begin the
+// transaction, the transaction is begun explicitly, and the request is sent
+// again with the new transaction ID.
+future<StatusOr<google::spanner::v1::ResultSet>> AsyncExecuteSqlRpc(
+    CompletionQueue cq, std::shared_ptr<SpannerStub> stub,
+    internal::ImmutableOptions options, SessionHolder& session,
+    StatusOr<google::spanner::v1::TransactionSelector>& selector,
+    TransactionContext& ctx,
+    std::shared_ptr<google::spanner::v1::ExecuteSqlRequest> request,
+    char const* func) {
+  using Response = StatusOr<google::spanner::v1::ResultSet>;
+  return google::cloud::internal::AsyncRetryLoop(
+             RetryPolicyPrototype(*options)->clone(),
+             BackoffPolicyPrototype(*options)->clone(),
+             Idempotency::kIdempotent, cq,
+             [stub, route_to_leader = ctx.route_to_leader](
+                 CompletionQueue& cq,
+                 std::shared_ptr<grpc::ClientContext> context,
+                 internal::ImmutableOptions options,
+                 google::spanner::v1::ExecuteSqlRequest const& request) {
+               if (route_to_leader) RouteToLeader(*context);
+               return stub->AsyncExecuteSql(cq, std::move(context),
+                                            std::move(options), request);
+             },
+             options, *request, func)
+      .then([cq, stub, options, &session, &selector, &ctx, request,
+             func](future<Response> f) mutable -> future<Response> {
+        auto response = f.get();
+        if (!response && IsSessionNotFound(response.status())) {
+          session->set_bad();
+        }
+        if (response && response->has_precommit_token()) {
+          ctx.precommit_token = response->precommit_token();
+        }
+        if (!selector->has_begin()) {
+          return make_ready_future(std::move(response));
+        }
+        if (response) {
+          if (!response->metadata().has_transaction()) {
+            selector = MissingTransactionStatus(func);
+            return make_ready_future(Response(selector.status()));
+          }
+          selector->set_id(response->metadata().transaction().id());
+          return make_ready_future(std::move(response));
+        }
+        auto status = std::move(response).status();
+        auto request_tag = request->request_options().request_tag();
+        return AsyncBeginTransactionRpc(cq, stub, options, session,
+                                        selector->begin(),
+                                        std::move(request_tag), ctx,
+                                        std::nullopt, func)
+            .then([cq, stub, options, &session, &selector, &ctx, request, func,
+                   status](future<StatusOr<google::spanner::v1::Transaction>>
+                               g) mutable {
+              auto begin = g.get();
+              if (!begin) {
+                selector = begin.status();  // invalidate the transaction
+                return make_ready_future(Response(std::move(status)));
+              }
+              selector->set_id(begin->id());
+              *request->mutable_transaction() = *selector;
+              return AsyncExecuteSqlRpc(std::move(cq), std::move(stub),
+                                        std::move(options), session, selector,
+                                        ctx, std::move(request), func);
+            });
+      });
+}
+
+// Runs @p request using the `Commit()` RPC. As in `ConnectionImpl::Commit()`,
+// the commit is sent again (without the mutations) while the service responds
+// with a new precommit token.
+future<StatusOr<google::spanner::v1::CommitResponse>> AsyncCommitRpc(
+    CompletionQueue cq, std::shared_ptr<SpannerStub> stub,
+    internal::ImmutableOptions options, SessionHolder& session,
+    TransactionContext& ctx,
+    std::shared_ptr<google::spanner::v1::CommitRequest> request,
+    char const* func) {
+  using Response = StatusOr<google::spanner::v1::CommitResponse>;
+  if (ctx.precommit_token.has_value()) {
+    *request->mutable_precommit_token() = *ctx.precommit_token;
+  }
+  return google::cloud::internal::AsyncRetryLoop(
+             RetryPolicyPrototype(*options)->clone(),
+             BackoffPolicyPrototype(*options)->clone(),
+             Idempotency::kIdempotent, cq,
+             [stub](CompletionQueue& cq,
+                    std::shared_ptr<grpc::ClientContext> context,
+                    internal::ImmutableOptions options,
+                    google::spanner::v1::CommitRequest const& request) {
+               RouteToLeader(*context);  // always for Commit()
+               return stub->AsyncCommit(cq, std::move(context),
+                                        std::move(options), request);
+             },
+             options, *request, func)
+      .then([cq, stub, options, &session, &ctx, request,
+             func](future<Response> f) mutable -> future<Response> {
+        auto response = f.get();
+        if (!response) {
+          if (IsSessionNotFound(response.status())) session->set_bad();
+          return make_ready_future(std::move(response));
+        }
+        if (!response->has_precommit_token()) {
+          return make_ready_future(std::move(response));
+        }
+        ctx.precommit_token = response->precommit_token();
+        request->mutable_mutations()->Clear();
+        return AsyncCommitRpc(std::move(cq), std::move(stub),
+                              std::move(options), session, ctx,
+                              std::move(request), func);
+      });
+}
+
+// Runs the `Rollback()` RPC for the transaction @p transaction_id.
+future<Status> AsyncRollbackRpc(CompletionQueue cq,
+                                std::shared_ptr<SpannerStub> const& stub,
+                                internal::ImmutableOptions const& options,
+                                SessionHolder& session,
+                                std::string transaction_id, char const* func) {
+  google::spanner::v1::RollbackRequest request;
+  request.set_session(session->session_name());
+  request.set_transaction_id(std::move(transaction_id));
+  return google::cloud::internal::AsyncRetryLoop(
+             RetryPolicyPrototype(*options)->clone(),
+             BackoffPolicyPrototype(*options)->clone(),
+             Idempotency::kIdempotent, std::move(cq),
+             [stub](CompletionQueue& cq,
+                    std::shared_ptr<grpc::ClientContext> context,
+                    internal::ImmutableOptions options,
+                    google::spanner::v1::RollbackRequest const& request) {
+               RouteToLeader(*context);  // always for Rollback()
+               return stub->AsyncRollback(cq, std::move(context),
+                                          std::move(options), request);
+             },
+             options, std::move(request), func)
+      .then([&session](future<Status> f) {
+        auto status = f.get();
+        if (IsSessionNotFound(status)) session->set_bad();
+        return status;
+      });
+}
+
+// The asynchronous version of the rerun loop in `Client::Commit()`.
+class AsyncTransactionRunner
+    : public std::enable_shared_from_this<AsyncTransactionRunner> {
+ public:
+  AsyncTransactionRunner(std::weak_ptr<spanner::Connection> conn,
+                         CompletionQueue cq,
+                         spanner::Connection::AsyncRunTransactionParams params)
+      : conn_(std::move(conn)),
+        cq_(std::move(cq)),
+        options_(internal::SaveCurrentOptions()),
+        mutator_(std::move(params.mutator)),
+        rerun_policy_(std::move(params.rerun_policy)),
+        backoff_policy_(std::move(params.backoff_policy)),
+        txn_opts_(spanner::Transaction::ReadWriteOptions().WithTag(
+            internal::FetchOption<spanner::TransactionTagOption>(*options_))),
+        txn_(spanner::MakeReadWriteTransaction(txn_opts_)) {}
+
+  future<StatusOr<spanner::CommitResult>> Start() {
+    auto f = promise_.get_future();
+    RunMutator();
+    return f;
+  }
+
+ private:
+  // The status-code discriminator of TransactionRerunPolicy.
+  using RerunnablePolicy = SafeTransactionRerun;
+
+  void RunMutator() {
+    internal::OptionsSpan span(options_);
+    mutator_(txn_).then(
+        [self = shared_from_this()](future<StatusOr<spanner::Mutations>> f) {
+          self->OnMutations(f.get());
+        });
+  }
+
+  void OnMutations(StatusOr<spanner::Mutations> mutations) {
+    auto conn = conn_.lock();
+    if (!conn) return promise_.set_value(ConnectionGone());
+    internal::OptionsSpan span(options_);
+    if (RerunnablePolicy::IsOk(mutations.status())) {
+      conn->AsyncCommit({txn_, *std::move(mutations),
+                         spanner::CommitOptions(*options_)})
+          .then([self = shared_from_this()](
+                    future<StatusOr<spanner::CommitResult>> f) {
+            self->OnCommit(f.get());
+          });
+      return;
+    }
+    auto status = std::move(mutations).status();
+    if (RerunnablePolicy::IsTransientFailure(status)) {
+      return OnTransientFailure(std::move(status));
+    }
+    conn->AsyncRollback({txn_}).then(
+        [self = shared_from_this(), status](future<Status> f) {
+          auto rb_status = f.get();
+          if (!RerunnablePolicy::IsOk(rb_status)) {
+            GCP_LOG(WARNING) << "Rollback() failure in AsyncRunTransaction(): "
+                             << rb_status.message();
+          }
+          self->promise_.set_value(status);
+        });
+  }
+
+  void OnCommit(StatusOr<spanner::CommitResult> result) {
+    if (!RerunnablePolicy::IsTransientFailure(result.status())) {
+      return promise_.set_value(std::move(result));
+    }
+    OnTransientFailure(std::move(result).status());
+  }
+
+  void OnTransientFailure(Status status) {
+    if (!rerun_policy_->OnFailure(status)) {
+      return promise_.set_value(std::move(status));  // reruns exhausted
+    }
+    if (IsSessionNotFound(status)) {
+      // Marks the session bad and creates a new Transaction for the next loop.
+      Visit(txn_, [](SessionHolder& s,
+                     StatusOr<google::spanner::v1::TransactionSelector> const&,
+                     TransactionContext const&) {
+        if (s) s->set_bad();
+        return true;
+      });
+      txn_ = spanner::MakeReadWriteTransaction(txn_opts_);
+    } else {
+      // Create a new transaction for the next loop, but reuse the session
+      // so that we have a slightly better chance of avoiding another abort.
+      txn_ = spanner::MakeReadWriteTransaction(txn_, txn_opts_);
+    }
+    std::chrono::nanoseconds delay = backoff_policy_->OnCompletion();
+    if (options_->get<EnableServerRetriesOption>()) {
+      if (auto retry_info = internal::GetRetryInfo(status)) {
+        // Heed the `RetryInfo` from the service.
+        delay = retry_info->retry_delay();
+      }
+    }
+    cq_.MakeRelativeTimer(delay).then(
+        [self = shared_from_this()](
+            future<StatusOr<std::chrono::system_clock::time_point>> f) {
+          auto timer = f.get();
+          if (!timer) return self->promise_.set_value(timer.status());
+          self->RunMutator();
+        });
+  }
+
+  static Status ConnectionGone() {
+    return internal::CancelledError(
+        "the connection was destroyed before the transaction completed",
+        GCP_ERROR_INFO());
+  }
+
+  std::weak_ptr<spanner::Connection> conn_;
+  CompletionQueue cq_;
+  internal::ImmutableOptions options_;
+  std::function<future<StatusOr<spanner::Mutations>>(spanner::Transaction)>
+      mutator_;
+  std::unique_ptr<spanner::TransactionRerunPolicy> rerun_policy_;
+  std::unique_ptr<spanner::BackoffPolicy> backoff_policy_;
+  spanner::Transaction::ReadWriteOptions txn_opts_;
+  spanner::Transaction txn_;
+  promise<StatusOr<spanner::CommitResult>> promise_;
+};
+
 }  // namespace
 
 using ::google::cloud::Idempotency;
@@ -512,6 +904,56 @@ spanner::BatchedCommitResultStream ConnectionImpl::BatchWrite(
   return BatchWriteImpl(std::move(params));  // no client-side transaction
 }
 
+future<StatusOr<spanner::DmlResult>> ConnectionImpl::AsyncExecuteDml(
+    SqlParams params) {
+  auto txn = params.transaction;
+  return AsyncVisit(
+      txn, [self = shared_from_this(), params = std::move(params)](
+               SessionHolder& session,
+               StatusOr<google::spanner::v1::TransactionSelector>& s,
+               TransactionContext& ctx) mutable {
+        return self->AsyncExecuteSqlImpl(session, s, ctx, std::move(params))
+            .then([](future<StatusOr<google::spanner::v1::ResultSet>> f)
+                      -> StatusOr<spanner::DmlResult> {
+              auto response = f.get();
+              if (!response) return std::move(response).status();
+              auto source = DmlResultSetSource::Create(*std::move(response));
+              if (!source) return std::move(source).status();
+              return spanner::DmlResult(*std::move(source));
+            });
+      });
+}
+
+future<StatusOr<spanner::CommitResult>> ConnectionImpl::AsyncCommit(
+    CommitParams params) {
+  auto txn = params.transaction;
+  return AsyncVisit(
+      txn, [self = shared_from_this(), params = std::move(params)](
+               SessionHolder& session,
+               StatusOr<google::spanner::v1::TransactionSelector>& s,
+               TransactionContext& ctx) mutable {
+        return self->AsyncCommitImpl(session, s, ctx, std::move(params));
+      });
+}
+
+future<Status> ConnectionImpl::AsyncRollback(RollbackParams params) {
+  return AsyncVisit(
+      params.transaction,
+      [self = shared_from_this()](
+          SessionHolder& session,
+          StatusOr<google::spanner::v1::TransactionSelector>& s,
+          TransactionContext& ctx) {
+        return self->AsyncRollbackImpl(session, s, ctx);
+      });
+}
+
+future<StatusOr<spanner::CommitResult>> ConnectionImpl::AsyncRunTransaction(
+    AsyncRunTransactionParams params) {
+  auto runner = std::make_shared<AsyncTransactionRunner>(
+      weak_from_this(), background_threads_->cq(), std::move(params));
+  return runner->Start();
+}
+
 /**
  * Helper function that ensures `session` holds a valid `Session`, or returns
  * an error if `session` is empty and no `Session` can be allocated.
@@ -794,41 +1236,8 @@ StatusOr<ResultType> ConnectionImpl::ExecuteSqlImpl(
         retry_resume_fn) {
   if (!selector.ok()) return selector.status();
 
-  google::spanner::v1::ExecuteSqlRequest request;
-  request.set_session(session->session_name());
-  *request.mutable_transaction() = *selector;
-  auto sql_statement = ToProto(std::move(params.statement));
-  request.set_sql(std::move(*sql_statement.mutable_sql()));
-  *request.mutable_params() = std::move(*sql_statement.mutable_params());
-  *request.mutable_param_types() =
-      std::move(*sql_statement.mutable_param_types());
-  request.set_seqno(ctx.seqno);
-  request.set_query_mode(query_mode);
-  if (params.partition_token) {
-    request.set_partition_token(*std::move(params.partition_token));
-    if (params.partition_data_boost) {
-      request.set_data_boost_enabled(true);
-    }
-  }
-  if (params.query_options.optimizer_version()) {
-    request.mutable_query_options()->set_optimizer_version(
-        *params.query_options.optimizer_version());
-  }
-  if (params.query_options.optimizer_statistics_package()) {
-    request.mutable_query_options()->set_optimizer_statistics_package(
-        *params.query_options.optimizer_statistics_package());
-  }
-  request.mutable_request_options()->set_priority(
-      ProtoRequestPriority(params.query_options.request_priority()));
-  if (params.query_options.request_tag().has_value()) {
-    request.mutable_request_options()->set_request_tag(
-        *params.query_options.request_tag());
-  }
-  request.mutable_request_options()->set_transaction_tag(ctx.tag);
-  absl::visit(DirectedReadVisitor([&request] {
-                return request.mutable_directed_read_options();
-              }),
-              params.directed_read_option);
+  auto request = MakeExecuteSqlRequest(session->session_name(), *selector,
+                                       ctx, std::move(params), query_mode);
 
   for (;;) {
     auto reader = retry_resume_fn(request);
@@ -1220,24 +1629,8 @@ StatusOr<spanner::CommitResult> ConnectionImpl::CommitImpl(
     return prepare_status;
   }
 
-  google::spanner::v1::CommitRequest request;
-  request.set_session(session->session_name());
-  for (auto&& m : params.mutations) {
-    *request.add_mutations() = std::move(m).as_proto();
-  }
-  request.set_return_commit_stats(params.options.return_stats());
-  request.mutable_request_options()->set_priority(
-      ProtoRequestPriority(params.options.request_priority()));
-  if (params.options.max_commit_delay().has_value()) {
-    *request.mutable_max_commit_delay() =
-        google::protobuf::util::TimeUtil::MillisecondsToDuration(
-            params.options.max_commit_delay()->count());
-  }
-
-  // params.options.transaction_tag() was either already used to set
-  // ctx.tag (for a library-generated transaction), or it is ignored
-  // (for a user-supplied transaction).
-  request.mutable_request_options()->set_transaction_tag(ctx.tag);
+  auto request =
+      MakeCommitRequest(session->session_name(), ctx, std::move(params));
 
   switch (selector->selector_case()) {
     case google::spanner::v1::TransactionSelector::kSingleUse: {
@@ -1315,13 +1708,7 @@ StatusOr<spanner::CommitResult> ConnectionImpl::CommitImpl(
     }
   } while (response->has_precommit_token());
 
-  spanner::CommitResult r;
-  r.commit_timestamp = MakeTimestamp(response->commit_timestamp());
-  if (response->has_commit_stats()) {
-    r.commit_stats.emplace(
-        spanner::CommitStats{response->commit_stats().mutation_count()});
-  }
-  return r;
+  return FromProto(*response);
 }
 
 Status ConnectionImpl::RollbackImpl(
@@ -1442,6 +1829,135 @@ spanner::BatchedCommitResultStream ConnectionImpl::BatchWriteImpl(
       });
 }
 
+future<StatusOr<google::spanner::v1::ResultSet>>
+ConnectionImpl::AsyncExecuteSqlImpl(
+    SessionHolder& session,
+    StatusOr<google::spanner::v1::TransactionSelector>& selector,
+    TransactionContext& ctx, SqlParams params) {
+  using Response = StatusOr<google::spanner::v1::ResultSet>;
+  if (!selector.ok()) return make_ready_future(Response(selector.status()));
+
+  auto prepare_status = PrepareSession(session);
+  if (!prepare_status.ok()) {
+    return make_ready_future(Response(std::move(prepare_status)));
+  }
+
+  auto request = std::make_shared<google::spanner::v1::ExecuteSqlRequest>(
+      MakeExecuteSqlRequest(session->session_name(), *selector, ctx,
+                            std::move(params),
+                            google::spanner::v1::ExecuteSqlRequest::NORMAL));
+  return AsyncExecuteSqlRpc(background_threads_->cq(),
+                            GetStubBasedOnSessionMode(*session, ctx),
+                            internal::SaveCurrentOptions(), session, selector,
+                            ctx, std::move(request), __func__);
+}
+
+future<StatusOr<spanner::CommitResult>> ConnectionImpl::AsyncCommitImpl(
+    SessionHolder& session,
+    StatusOr<google::spanner::v1::TransactionSelector>& selector,
+    TransactionContext& ctx, CommitParams params) {
+  using Response = StatusOr<spanner::CommitResult>;
+  // Fail the commit if the transaction has been invalidated.
+  if (!selector.ok()) return make_ready_future(Response(selector.status()));
+
+  auto prepare_status = PrepareSession(session);
+  if (!prepare_status.ok()) {
+    return make_ready_future(Response(std::move(prepare_status)));
+  }
+
+  auto request = std::make_shared<google::spanner::v1::CommitRequest>(
+      MakeCommitRequest(session->session_name(), ctx, std::move(params)));
+  auto cq = background_threads_->cq();
+  auto stub = GetStubBasedOnSessionMode(*session, ctx);
+  auto options = internal::SaveCurrentOptions();
+  auto const* func = __func__;
+  auto commit = [cq, stub, options, &session, &ctx, request, func]() mutable {
+    return AsyncCommitRpc(std::move(cq), std::move(stub), std::move(options),
+                          session, ctx, std::move(request), func)
+        .then([](future<StatusOr<google::spanner::v1::CommitResponse>> f)
+                  -> Response {
+          auto response = f.get();
+          if (!response) return std::move(response).status();
+          return FromProto(*response);
+        });
+  };
+
+  switch (selector->selector_case()) {
+    case google::spanner::v1::TransactionSelector::kSingleUse: {
+      *request->mutable_single_use_transaction() = selector->single_use();
+      return commit();
+    }
+    case google::spanner::v1::TransactionSelector::kBegin: {
+      std::optional<google::spanner::v1::Mutation> mutation = std::nullopt;
+      if (session->is_multiplexed()) {
+        // See `CommitImpl()`.
+        mutation = GetRandomElement(request->mutations());
+      }
+      return AsyncBeginTransactionRpc(cq, stub, options, session,
+                                      selector->begin(), std::string(), ctx,
+                                      std::move(mutation), func)
+          .then([&selector, request, commit](
+                    future<StatusOr<google::spanner::v1::Transaction>>
+                        f) mutable {
+            auto begin = f.get();
+            if (!begin.ok()) {
+              selector = begin.status();  // invalidate the transaction
+              return make_ready_future(Response(begin.status()));
+            }
+            selector->set_id(begin->id());
+            request->set_transaction_id(selector->id());
+            return commit();
+          });
+    }
+    case google::spanner::v1::TransactionSelector::kId: {
+      request->set_transaction_id(selector->id());
+      return commit();
+    }
+    default:
+      return make_ready_future(Response(internal::InternalError(
+          "TransactionSelector state error", GCP_ERROR_INFO())));
+  }
+}
+
+future<Status> ConnectionImpl::AsyncRollbackImpl(
+    SessionHolder& session,
+    StatusOr<google::spanner::v1::TransactionSelector>& selector,
+    TransactionContext& ctx) {
+  if (!selector.ok()) return make_ready_future(selector.status());
+  if (selector->has_single_use()) {
+    return make_ready_future(internal::InvalidArgumentError(
+        "Cannot rollback a single-use transaction", GCP_ERROR_INFO()));
+  }
+
+  auto prepare_status = PrepareSession(session);
+  if (!prepare_status.ok()) {
+    return make_ready_future(std::move(prepare_status));
+  }
+
+  auto cq = background_threads_->cq();
+  auto stub = GetStubBasedOnSessionMode(*session, ctx);
+  auto options = internal::SaveCurrentOptions();
+  auto const* func = __func__;
+  if (!selector->has_begin()) {
+    return AsyncRollbackRpc(std::move(cq), stub, options, session,
+                            selector->id(), func);
+  }
+  return AsyncBeginTransactionRpc(cq, stub, options, session,
+                                  selector->begin(), std::string(), ctx,
+                                  std::nullopt, func)
+      .then([cq, stub, options, &session, &selector,
+             func](future<StatusOr<google::spanner::v1::Transaction>> f) {
+        auto begin = f.get();
+        if (!begin.ok()) {
+          selector = begin.status();  // invalidate the transaction
+          return make_ready_future(begin.status());
+        }
+        selector->set_id(begin->id());
+        return AsyncRollbackRpc(cq, stub, options, session, selector->id(),
+                                func);
+      });
+}
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner_internal
 }  // namespace cloud
@@ -24,6 +24,7 @@
 #include "google/cloud/spanner/mutations.h"
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/background_threads.h"
+#include "google/cloud/future.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include "google/spanner/v1/spanner.pb.h"
@@ -42,7 +43,8 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
  * A concrete `Connection` subclass that uses gRPC to actually talk to a real
  * Spanner instance.
  */
-class ConnectionImpl : public spanner::Connection {
+class ConnectionImpl : public spanner::Connection,
+                       public std::enable_shared_from_this<ConnectionImpl> {
  public:
   ConnectionImpl(spanner::Database db,
                  std::unique_ptr<BackgroundThreads> background_threads,
@@ -67,6 +69,11 @@ class ConnectionImpl : public spanner::Connection {
   StatusOr<spanner::CommitResult> Commit(CommitParams) override;
   Status Rollback(RollbackParams) override;
   spanner::BatchedCommitResultStream BatchWrite(BatchWriteParams) override;
+  future<StatusOr<spanner::DmlResult>> AsyncExecuteDml(SqlParams) override;
+  future<StatusOr<spanner::CommitResult>> AsyncCommit(CommitParams) override;
+  future<Status> AsyncRollback(RollbackParams) override;
+  future<StatusOr<spanner::CommitResult>> AsyncRunTransaction(
+      AsyncRunTransactionParams) override;
 
  private:
   Status PrepareSession(SessionHolder& session,
@@ -147,6 +154,21 @@ class ConnectionImpl : public spanner::Connection {
 
   spanner::BatchedCommitResultStream BatchWriteImpl(BatchWriteParams);
 
+  future<StatusOr<google::spanner::v1::ResultSet>> AsyncExecuteSqlImpl(
+      SessionHolder& session,
+      StatusOr<google::spanner::v1::TransactionSelector>& selector,
+      TransactionContext& ctx, SqlParams params);
+
+  future<StatusOr<spanner::CommitResult>> AsyncCommitImpl(
+      SessionHolder& session,
+      StatusOr<google::spanner::v1::TransactionSelector>& selector,
+      TransactionContext& ctx, CommitParams params);
+
+  future<Status> AsyncRollbackImpl(
+      SessionHolder& session,
+      StatusOr<google::spanner::v1::TransactionSelector>& selector,
+      TransactionContext& ctx);
+
   template <typename ResultType>
   StatusOr<ResultType> ExecuteSqlImpl(
       SessionHolder& session,
@@ -0,0 +1,550 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/internal/connection_impl.h"
+#include "google/cloud/spanner/internal/defaults.h"
+#include "google/cloud/spanner/internal/spanner_stub.h"
+#include "google/cloud/spanner/mutations.h"
+#include "google/cloud/spanner/timestamp.h"
+#include "google/cloud/credentials.h"
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/make_status.h"
+#include "google/cloud/internal/streaming_read_rpc.h"
+#include "google/cloud/rpc_metadata.h"
+#include "google/cloud/testing_util/allocation_counter.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/**
+ * @file
+ *
+ * CPU and allocation microbenchmarks for the `ExecuteQuery()`, `Read()` and
+ * `Commit()` data paths of `spanner::Client`.
+ *
+ * Unlike the benchmarks in `spanner/benchmarks`, these do not need a Cloud
+ * Spanner instance or the emulator. The client runs over the usual
+ * `ConnectionImpl`, with an in-process fake `SpannerStub`. The fake streams
+ * synthetic `PartialResultSet`s, chunked at a configurable size, so that the
+ * strings and the lists of strings are split across responses and merged by
+ * `MergeChunk()`. Besides the usual timings, where each iteration is one call,
+ * each benchmark reports:
+ *
+ * - `allocs_per_row`, or `allocs_per_call` for `Commit()`: heap allocations
+ *   made by the benchmark thread, excluding the background threads of the
+ *   connection. This includes the fake's copy of each response, which stands
+ *   in for the deserialization of the gRPC messages.
+ * - `cpu_per_row`: CPU time per row.
+ */
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::testing_util::AllocationCounter;
+using PartialResultSets = std::vector<google::spanner::v1::PartialResultSet>;
+using RowType = std::tuple<std::int64_t, std::string, std::vector<std::string>>;
+
+// Each call reads about this much data.
+auto constexpr kBytesPerCall = 1024 * 1024;
+auto constexpr kMaxRowsPerCall = 1000;
+auto constexpr kTagsPerRow = 4;
+
+struct RowShape {
+  // The size of the `Name` column, and of all the `Tags` together.
+  std::size_t value_size;
+  // The (approximate) maximum payload of each `PartialResultSet`.
+  std::size_t chunk_size;
+};
+
+// The benchmark arguments are the size of the values, and the size of the
+// chunks in which they are streamed.
+void RowShapes(::benchmark::internal::Benchmark* b) {
+  b->ArgNames({"value_size", "chunk_size"});
+  b->Args({16, 1024 * 1024});       // Small values, not chunked.
+  b->Args({1024, 1024 * 1024});     // Medium values, not chunked.
+  b->Args({1024, 1000});            // Most rows split across responses.
+  b->Args({64 * 1024, 16 * 1024});  // Each value split many times.
+}
+
+RowShape MakeRowShape(::benchmark::State const& state) {
+  return RowShape{static_cast<std::size_t>(state.range(0)),
+                  static_cast<std::size_t>(state.range(1))};
+}
+
+std::int64_t RowsPerCall(RowShape const& shape) {
+  auto const row_size = static_cast<std::int64_t>(2 * shape.value_size + 8);
+  return (std::max<std::int64_t>)(
+      1, (std::min<std::int64_t>)(kMaxRowsPerCall, kBytesPerCall / row_size));
+}
+
+void ReportCounters(::benchmark::State& state, std::int64_t rows,
+                    std::int64_t allocations) {
+  state.SetItemsProcessed(rows);
+  state.counters["allocs_per_row"] =
+      rows == 0 ? 0 : static_cast<double>(allocations) / rows;
+  state.counters["cpu_per_row"] = ::benchmark::Counter(
+      static_cast<double>(rows),
+      ::benchmark::Counter::kIsRate | ::benchmark::Counter::kInvert);
+}
+
+// The payload of a STRING, or ARRAY<STRING>, value.
+std::size_t PayloadSize(google::protobuf::Value const& v) {
+  if (v.kind_case() == google::protobuf::Value::kStringValue) {
+    return v.string_value().size();
+  }
+  std::size_t size = 0;
+  for (auto const& e : v.list_value().values()) size += e.string_value().size();
+  return size;
+}
+
+bool IsSplittable(google::protobuf::Value const& v) {
+  return v.kind_case() == google::protobuf::Value::kStringValue ||
+         v.kind_case() == google::protobuf::Value::kListValue;
+}
+
+// Splits `v` after `n` bytes of payload, leaving the head in `v`, and
+// returning the tail. Lists are split in the middle of an element, as the
+// first element of the tail is merged into the last element of the head.
+google::protobuf::Value Split(google::protobuf::Value& v, std::size_t n) {
+  google::protobuf::Value tail;
+  if (v.kind_case() == google::protobuf::Value::kStringValue) {
+    tail.set_string_value(v.string_value().substr(n));
+    v.mutable_string_value()->resize(n);
+    return tail;
+  }
+  auto& values = *v.mutable_list_value()->mutable_values();
+  int k = 0;
+  for (; k + 1 < values.size(); ++k) {
+    auto const size = values.Get(k).string_value().size();
+    if (size > n) break;
+    n -= size;
+  }
+  auto& split = *values.Mutable(k)->mutable_string_value();
+  auto& tail_values = *tail.mutable_list_value()->mutable_values();
+  tail_values.Add()->set_string_value(split.substr(n));
+  split.resize(n);
+  for (int i = k + 1; i < values.size(); ++i) {
+    *tail_values.Add() = std::move(*values.Mutable(i));
+  }
+  values.DeleteSubrange(k + 1, values.size() - k - 1);
+  return tail;
+}
+
+/// Packs values into `PartialResultSet`s, splitting them as Spanner does.
+class ResponseBuilder {
+ public:
+  explicit ResponseBuilder(std::size_t chunk_size)
+      : chunk_size_((std::max<std::size_t>)(chunk_size, 1)) {
+    responses_.emplace_back();
+  }
+
+  void Append(google::protobuf::Value v) {
+    auto size = PayloadSize(v);
+    while (used_ + size > chunk_size_ && IsSplittable(v)) {
+      auto tail = Split(v, chunk_size_ - used_);
+      Add(std::move(v), chunk_size_ - used_);
+      responses_.back().set_chunked_value(true);
+      NextResponse();
+      v = std::move(tail);
+      size = PayloadSize(v);
+    }
+    if (used_ != 0 && used_ + size > chunk_size_) NextResponse();
+    Add(std::move(v), size);
+  }
+
+  PartialResultSets Build(google::spanner::v1::ResultSetMetadata metadata) && {
+    *responses_.front().mutable_metadata() = std::move(metadata);
+    return std::move(responses_);
+  }
+
+ private:
+  void Add(google::protobuf::Value v, std::size_t size) {
+    *responses_.back().add_values() = std::move(v);
+    used_ += size;
+  }
+
+  void NextResponse() {
+    responses_.emplace_back();
+    used_ = 0;
+  }
+
+  std::size_t chunk_size_;
+  std::size_t used_ = 0;
+  PartialResultSets responses_;
+};
+
+google::spanner::v1::ResultSetMetadata MakeMetadata() {
+  google::spanner::v1::ResultSetMetadata metadata;
+  auto& row_type = *metadata.mutable_row_type();
+  auto add = [&row_type](std::string name, google::spanner::v1::TypeCode code)
+      -> google::spanner::v1::Type& {
+    auto& field = *row_type.add_fields();
+    field.set_name(std::move(name));
+    field.mutable_type()->set_code(code);
+    return *field.mutable_type();
+  };
+  add("Id", google::spanner::v1::TypeCode::INT64);
+  add("Name", google::spanner::v1::TypeCode::STRING);
+  add("Tags", google::spanner::v1::TypeCode::ARRAY)
+      .mutable_array_element_type()
+      ->set_code(google::spanner::v1::TypeCode::STRING);
+  return metadata;
+}
+
+PartialResultSets MakeResponses(RowShape const& shape) {
+  auto const tag_size =
+      (std::max<std::size_t>)(1, shape.value_size / kTagsPerRow);
+  ResponseBuilder builder(shape.chunk_size);
+  auto const rows = RowsPerCall(shape);
+  for (std::int64_t i = 0; i != rows; ++i) {
+    auto const c = static_cast<char>('a' + i % 26);
+    google::protobuf::Value id;
+    id.set_string_value(std::to_string(i));
+    builder.Append(std::move(id));
+    google::protobuf::Value name;
+    name.set_string_value(std::string(shape.value_size, c));
+    builder.Append(std::move(name));
+    google::protobuf::Value tags;
+    for (int j = 0; j != kTagsPerRow; ++j) {
+      tags.mutable_list_value()->add_values()->set_string_value(
+          std::string(tag_size, c));
+    }
+    builder.Append(std::move(tags));
+  }
+  return std::move(builder).Build(MakeMetadata());
+}
+
+template <typename Response>
+class FakeStream : public google::cloud::internal::StreamingReadRpc<Response> {
+ public:
+  explicit FakeStream(std::shared_ptr<std::vector<Response> const> responses,
+                      Status status = {})
+      : responses_(std::move(responses)), status_(std::move(status)) {}
+
+  void Cancel() override {}
+
+  std::optional<Status> Read(Response* response) override {
+    if (next_ == responses_->size()) return status_;
+    *response = (*responses_)[next_++];
+    return std::nullopt;
+  }
+
+  RpcMetadata GetRequestMetadata() const override { return {}; }
+
+ private:
+  std::shared_ptr<std::vector<Response> const> responses_;
+  Status status_;
+  std::size_t next_ = 0;
+};
+
+Status Unused() {
+  return google::cloud::internal::UnimplementedError(
+      "not used by the benchmarks", GCP_ERROR_INFO());
+}
+
+/**
+ * A `SpannerStub` that serves the same responses to every query and read, and
+ * accepts every transaction.
+ */
+class FakeSpannerStub : public SpannerStub {
+ public:
+  explicit FakeSpannerStub(std::shared_ptr<PartialResultSets const> responses)
+      : responses_(std::move(responses)) {}
+
+  StatusOr<google::spanner::v1::Session> CreateSession(
+      grpc::ClientContext&, Options const&,
+      google::spanner::v1::CreateSessionRequest const& request) override {
+    google::spanner::v1::Session session;
+    session.set_name(request.database() + "/sessions/multiplexed");
+    session.set_multiplexed(request.session().multiplexed());
+    return session;
+  }
+
+  StatusOr<google::spanner::v1::BatchCreateSessionsResponse>
+  BatchCreateSessions(
+      grpc::ClientContext&, Options const&,
+      google::spanner::v1::BatchCreateSessionsRequest const& request) override {
+    google::spanner::v1::BatchCreateSessionsResponse response;
+    for (int i = 0; i != request.session_count(); ++i) {
+      response.add_session()->set_name(request.database() + "/sessions/" +
+                                       std::to_string(next_session_++));
+    }
+    return response;
+  }
+
+  Status DeleteSession(
+      grpc::ClientContext&, Options const&,
+      google::spanner::v1::DeleteSessionRequest const&) override {
+    return Status{};
+  }
+
+  StatusOr<google::spanner::v1::ResultSet> ExecuteSql(
+      grpc::ClientContext&, Options const&,
+      google::spanner::v1::ExecuteSqlRequest const&) override {
+    return Unused();
+  }
+
+  std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+      google::spanner::v1::PartialResultSet>>
+  ExecuteStreamingSql(std::shared_ptr<grpc::ClientContext>, Options const&,
+                      google::spanner::v1::ExecuteSqlRequest const&) override {
+    return std::make_unique<FakeStream<google::spanner::v1::PartialResultSet>>(
+        responses_);
+  }
+
+  StatusOr<google::spanner::v1::ExecuteBatchDmlResponse> ExecuteBatchDml(
+      grpc::ClientContext&, Options const&,
+      google::spanner::v1::ExecuteBatchDmlRequest const&) override {
+    return Unused();
+  }
+
+  std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+      google::spanner::v1::PartialResultSet>>
+  StreamingRead(std::shared_ptr<grpc::ClientContext>, Options const&,
+                google::spanner::v1::ReadRequest const&) override {
+    return std::make_unique<FakeStream<google::spanner::v1::PartialResultSet>>(
+        responses_);
+  }
+
+  StatusOr<google::spanner::v1::Transaction> BeginTransaction(
+      grpc::ClientContext&, Options const&,
+      google::spanner::v1::BeginTransactionRequest const&) override {
+    google::spanner::v1::Transaction txn;
+    txn.set_id("fake-transaction");
+    return txn;
+  }
+
+  StatusOr<google::spanner::v1::CommitResponse> Commit(
+      grpc::ClientContext&, Options const&,
+      google::spanner::v1::CommitRequest const&) override {
+    google::spanner::v1::CommitResponse response;
+    *response.mutable_commit_timestamp() =
+        spanner::MakeTimestamp(std::chrono::system_clock::now())
+            .value()
+            .get<protobuf::Timestamp>()
+            .value();
+    return response;
+  }
+
+  Status Rollback(grpc::ClientContext&, Options const&,
+                  google::spanner::v1::RollbackRequest const&) override {
+    return Status{};
+  }
+
+  StatusOr<google::spanner::v1::PartitionResponse> PartitionQuery(
+      grpc::ClientContext&, Options const&,
+      google::spanner::v1::PartitionQueryRequest const&) override {
+    return Unused();
+  }
+
+  StatusOr<google::spanner::v1::PartitionResponse> PartitionRead(
+      grpc::ClientContext&, Options const&,
+      google::spanner::v1::PartitionReadRequest const&) override {
+    return Unused();
+  }
+
+  std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+      google::spanner::v1::BatchWriteResponse>>
+  BatchWrite(std::shared_ptr<grpc::ClientContext>, Options const&,
+             google::spanner::v1::BatchWriteRequest const&) override {
+    return std::make_unique<
+        FakeStream<google::spanner::v1::BatchWriteResponse>>(
+        std::make_shared<
+            std::vector<google::spanner::v1::BatchWriteResponse> const>(),
+        Unused());
+  }
+
+  std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+      google::spanner::v1::CacheUpdate>>
+  FetchCacheUpdate(
+      std::shared_ptr<grpc::ClientContext>, Options const&,
+      google::spanner::v1::FetchCacheUpdateRequest const&) override {
+    return std::make_unique<FakeStream<google::spanner::v1::CacheUpdate>>(
+        std::make_shared<std::vector<google::spanner::v1::CacheUpdate> const>(),
+        Unused());
+  }
+
+  future<StatusOr<google::spanner::v1::Session>> AsyncCreateSession(
+      CompletionQueue&, std::shared_ptr<grpc::ClientContext>,
+      google::cloud::internal::ImmutableOptions,
+      google::spanner::v1::CreateSessionRequest const&) override {
+    return make_ready_future(StatusOr<google::spanner::v1::Session>(Unused()));
+  }
+
+  future<StatusOr<google::spanner::v1::BatchCreateSessionsResponse>>
+  AsyncBatchCreateSessions(
+      CompletionQueue&, std::shared_ptr<grpc::ClientContext>,
+      google::cloud::internal::ImmutableOptions,
+      google::spanner::v1::BatchCreateSessionsRequest const&) override {
+    return make_ready_future(
+        StatusOr<google::spanner::v1::BatchCreateSessionsResponse>(Unused()));
+  }
+
+  future<Status> AsyncDeleteSession(
+      CompletionQueue&, std::shared_ptr<grpc::ClientContext>,
+      google::cloud::internal::ImmutableOptions,
+      google::spanner::v1::DeleteSessionRequest const&) override {
+    return make_ready_future(Status{});
+  }
+
+  future<StatusOr<google::spanner::v1::ResultSet>> AsyncExecuteSql(
+      CompletionQueue&, std::shared_ptr<grpc::ClientContext>,
+      google::cloud::internal::ImmutableOptions,
+      google::spanner::v1::ExecuteSqlRequest const&) override {
+    return make_ready_future(
+        StatusOr<google::spanner::v1::ResultSet>(Unused()));
+  }
+
+  future<StatusOr<google::spanner::v1::Transaction>> AsyncBeginTransaction(
+      CompletionQueue&, std::shared_ptr<grpc::ClientContext>,
+      google::cloud::internal::ImmutableOptions,
+      google::spanner::v1::BeginTransactionRequest const&) override {
+    return make_ready_future(
+        StatusOr<google::spanner::v1::Transaction>(Unused()));
+  }
+
+  future<StatusOr<google::spanner::v1::CommitResponse>> AsyncCommit(
+      CompletionQueue&, std::shared_ptr<grpc::ClientContext>,
+      google::cloud::internal::ImmutableOptions,
+      google::spanner::v1::CommitRequest const&) override {
+    return make_ready_future(
+        StatusOr<google::spanner::v1::CommitResponse>(Unused()));
+  }
+
+  future<Status> AsyncRollback(
+      CompletionQueue&, std::shared_ptr<grpc::ClientContext>,
+      google::cloud::internal::ImmutableOptions,
+      google::spanner::v1::RollbackRequest const&) override {
+    return make_ready_future(Status{});
+  }
+
+ private:
+  std::shared_ptr<PartialResultSets const> responses_;
+  std::atomic<int> next_session_{0};
+};
+
+/// A `Client` using `ConnectionImpl` over a `FakeSpannerStub`.
+spanner::Client MakeFakeClient(RowShape const& shape) {
+  auto opts = DefaultOptions(
+      Options{}.set<UnifiedCredentialsOption>(MakeInsecureCredentials()));
+  auto background =
+      google::cloud::internal::MakeBackgroundThreadsFactory(opts)();
+  std::vector<std::shared_ptr<SpannerStub>> stubs = {
+      std::make_shared<FakeSpannerStub>(
+          std::make_shared<PartialResultSets const>(MakeResponses(shape)))};
+  return spanner::Client(std::make_shared<ConnectionImpl>(
+      spanner::Database("fake-project", "fake-instance", "fake-database"),
+      std::move(background), std::move(stubs), std::move(opts)));
+}
+
+// Drains `rows`, returning the number of rows, or an error.
+StatusOr<std::int64_t> Consume(spanner::RowStream rows) {
+  std::int64_t count = 0;
+  for (auto& row : spanner::StreamOf<RowType>(rows)) {
+    if (!row) return std::move(row).status();
+    ::benchmark::DoNotOptimize(*row);
+    ++count;
+  }
+  return count;
+}
+
+// Stream rows with `Client::ExecuteQuery()`.
+void BM_ExecuteQuery(::benchmark::State& state) {
+  auto client = MakeFakeClient(MakeRowShape(state));
+
+  std::int64_t total_rows = 0;
+  std::int64_t allocations = 0;
+  for (auto _ : state) {
+    auto const counter = AllocationCounter::PerThread();
+    auto rows = Consume(client.ExecuteQuery(
+        spanner::SqlStatement("SELECT Id, Name, Tags FROM Users")));
+    allocations += counter.Sample();
+    if (!rows) {
+      state.SkipWithError(rows.status().message().c_str());
+      break;
+    }
+    total_rows += *rows;
+  }
+  ReportCounters(state, total_rows, allocations);
+}
+BENCHMARK(BM_ExecuteQuery)->Apply(RowShapes);
+
+// Stream rows with `Client::Read()`.
+void BM_Read(::benchmark::State& state) {
+  auto client = MakeFakeClient(MakeRowShape(state));
+
+  std::int64_t total_rows = 0;
+  std::int64_t allocations = 0;
+  for (auto _ : state) {
+    auto const counter = AllocationCounter::PerThread();
+    auto rows = Consume(client.Read("Users", spanner::KeySet::All(),
+                                    {"Id", "Name", "Tags"}));
+    allocations += counter.Sample();
+    if (!rows) {
+      state.SkipWithError(rows.status().message().c_str());
+      break;
+    }
+    total_rows += *rows;
+  }
+  ReportCounters(state, total_rows, allocations);
+}
+BENCHMARK(BM_Read)->Apply(RowShapes);
+
+// Commit a single row with `Client::Commit()`. The argument is the size of
+// the values.
+void BM_Commit(::benchmark::State& state) {
+  auto const value_size = static_cast<std::size_t>(state.range(0));
+  auto client = MakeFakeClient(RowShape{value_size, kBytesPerCall});
+  auto const name = std::string(value_size, 'x');
+  auto const tags = std::vector<std::string>(
+      kTagsPerRow,
+      std::string((std::max<std::size_t>)(1, value_size / kTagsPerRow), 'x'));
+
+  std::int64_t calls = 0;
+  std::int64_t allocations = 0;
+  for (auto _ : state) {
+    auto const counter = AllocationCounter::PerThread();
+    auto commit = client.Commit(spanner::Mutations{
+        spanner::InsertOrUpdateMutationBuilder("Users", {"Id", "Name", "Tags"})
+            .EmplaceRow(calls, name, tags)
+            .Build()});
+    allocations += counter.Sample();
+    if (!commit) {
+      state.SkipWithError(commit.status().message().c_str());
+      break;
+    }
+    ++calls;
+  }
+  state.SetItemsProcessed(calls);
+  state.counters["allocs_per_call"] =
+      calls == 0 ? 0 : static_cast<double>(allocations) / calls;
+}
+BENCHMARK(BM_Commit)->ArgName("value_size")->Arg(16)->Arg(1024)->Arg(64 * 1024);
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
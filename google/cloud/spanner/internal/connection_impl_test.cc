@@ -3328,6 +3328,148 @@ TEST(ConnectionImplTest, RollbackSuccess) {
   EXPECT_STATUS_OK(rollback);
 }
 
+TEST(ConnectionImplTest, AsyncExecuteDmlBeginsTransaction) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("placeholder_project", "placeholder_instance",
+                              "placeholder_database_id");
+  EXPECT_CALL(*mock, CreateSession(_, _, IsMultiplexed()))
+      .WillOnce(Return(ByMove(MakeMultiplexedSession({"multiplexed"}))));
+  auto constexpr kText = R"pb(
+    metadata: { transaction: { id: "1234567890" } }
+    stats: { row_count_exact: 42 }
+  )pb";
+  google::spanner::v1::ResultSet response;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText, &response));
+  EXPECT_CALL(*mock, AsyncExecuteSql)
+      .WillOnce([&response](CompletionQueue&, auto, auto,
+                            google::spanner::v1::ExecuteSqlRequest const& r) {
+        EXPECT_TRUE(r.transaction().has_begin());
+        return make_ready_future(make_status_or(response));
+      })
+      .WillOnce([&response](CompletionQueue&, auto, auto,
+                            google::spanner::v1::ExecuteSqlRequest const& r) {
+        EXPECT_EQ("1234567890", r.transaction().id());
+        return make_ready_future(make_status_or(response));
+      });
+
+  auto conn = MakeConnectionImpl(db, mock);
+  internal::OptionsSpan span(MakeLimitedTimeOptions());
+  auto txn = MakeReadWriteTransaction(spanner::Transaction::ReadWriteOptions());
+  auto r0 = conn->AsyncExecuteDml({txn, spanner::SqlStatement("DELETE 1")});
+  auto r1 = conn->AsyncExecuteDml({txn, spanner::SqlStatement("DELETE 2")});
+  auto result = r0.get();
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(42, result->RowsModified());
+  result = r1.get();
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(42, result->RowsModified());
+}
+
+TEST(ConnectionImplTest, AsyncCommitBeginsTransaction) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("placeholder_project", "placeholder_instance",
+                              "placeholder_database_id");
+  EXPECT_CALL(*mock, CreateSession(_, _, IsMultiplexed()))
+      .WillOnce(Return(ByMove(MakeMultiplexedSession({"multiplexed"}))));
+  EXPECT_CALL(*mock, AsyncBeginTransaction)
+      .WillOnce([](CompletionQueue&, auto, auto,
+                   google::spanner::v1::BeginTransactionRequest const& r) {
+        EXPECT_EQ("multiplexed", r.session());
+        EXPECT_TRUE(r.options().has_read_write());
+        return make_ready_future(make_status_or(MakeTestTransaction()));
+      });
+  auto const ts =
+      spanner::MakeTimestamp(std::chrono::system_clock::from_time_t(123))
+          .value();
+  EXPECT_CALL(*mock, AsyncCommit)
+      .WillOnce([&ts](CompletionQueue&, auto, auto,
+                      google::spanner::v1::CommitRequest const& r) {
+        EXPECT_EQ("1234567890", r.transaction_id());
+        return make_ready_future(make_status_or(MakeCommitResponse(ts)));
+      });
+
+  auto conn = MakeConnectionImpl(db, mock);
+  internal::OptionsSpan span(MakeLimitedTimeOptions());
+  auto commit = conn->AsyncCommit({spanner::MakeReadWriteTransaction()}).get();
+  ASSERT_STATUS_OK(commit);
+  EXPECT_EQ(ts, commit->commit_timestamp);
+}
+
+TEST(ConnectionImplTest, AsyncRollback) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("project", "instance", "database");
+  EXPECT_CALL(*mock, CreateSession(_, _, IsMultiplexed()))
+      .WillOnce(Return(ByMove(MakeMultiplexedSession({"multiplexed"}))));
+  EXPECT_CALL(*mock, AsyncRollback)
+      .WillOnce([](CompletionQueue&, auto, auto,
+                   google::spanner::v1::RollbackRequest const& r) {
+        EXPECT_EQ("multiplexed", r.session());
+        EXPECT_EQ("test-txn-id", r.transaction_id());
+        return make_ready_future(Status());
+      });
+
+  auto conn = MakeConnectionImpl(db, mock);
+  internal::OptionsSpan span(MakeLimitedTimeOptions());
+  auto txn = spanner::MakeReadWriteTransaction();
+  SetTransactionId(txn, "test-txn-id");
+  EXPECT_STATUS_OK(conn->AsyncRollback({txn}).get());
+
+  auto single_use =
+      MakeSingleUseTransaction(spanner::Transaction::ReadOnlyOptions());
+  EXPECT_THAT(conn->AsyncRollback({single_use}).get(),
+              StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST(ConnectionImplTest, AsyncRunTransactionRerunsAbortedTransaction) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("placeholder_project", "placeholder_instance",
+                              "placeholder_database_id");
+  EXPECT_CALL(*mock, CreateSession(_, _, IsMultiplexed()))
+      .WillOnce(Return(ByMove(MakeMultiplexedSession({"multiplexed"}))));
+  EXPECT_CALL(*mock, AsyncBeginTransaction)
+      .Times(2)
+      .WillRepeatedly([](CompletionQueue&, auto, auto,
+                         google::spanner::v1::BeginTransactionRequest const&) {
+        return make_ready_future(make_status_or(MakeTestTransaction()));
+      });
+  auto const ts =
+      spanner::MakeTimestamp(std::chrono::system_clock::from_time_t(123))
+          .value();
+  EXPECT_CALL(*mock, AsyncCommit)
+      .WillOnce([](CompletionQueue&, auto, auto,
+                   google::spanner::v1::CommitRequest const&) {
+        return make_ready_future(
+            StatusOr<google::spanner::v1::CommitResponse>(
+                internal::AbortedError("aborted")));
+      })
+      .WillOnce([&ts](CompletionQueue&, auto, auto,
+                      google::spanner::v1::CommitRequest const& r) {
+        EXPECT_EQ(1, r.mutations_size());
+        return make_ready_future(make_status_or(MakeCommitResponse(ts)));
+      });
+
+  auto conn = MakeConnectionImpl(db, mock);
+  internal::OptionsSpan span(MakeLimitedTimeOptions());
+  int calls = 0;
+  auto result =
+      conn->AsyncRunTransaction(
+              {[&calls](spanner::Transaction const&) {
+                 ++calls;
+                 return make_ready_future(make_status_or(spanner::Mutations{
+                     spanner::MakeDeleteMutation("table",
+                                                 spanner::KeySet::All())}));
+               },
+               spanner::LimitedErrorCountTransactionRerunPolicy(2).clone(),
+               spanner::ExponentialBackoffPolicy(std::chrono::microseconds(1),
+                                                 std::chrono::microseconds(1),
+                                                 2.0)
+                   .clone()})
+          .get();
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(ts, result->commit_timestamp);
+  EXPECT_EQ(2, calls);
+}
+
 TEST(ConnectionImplTest, RollbackInvalidatedTransaction) {
   auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
   auto db = spanner::Database("placeholder_project", "placeholder_instance",
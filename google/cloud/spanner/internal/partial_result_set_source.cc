@@ -92,9 +92,14 @@ PartialResultSetSource::PartialResultSetSource(
     values_space_limit_ =
         options_.get<spanner::StreamingResumabilityBufferSizeOption>();
   }
+  if (options_.has<spanner::StreamingResumabilityTotalBufferSizeOption>()) {
+    total_space_limit_ =
+        options_.get<spanner::StreamingResumabilityTotalBufferSizeOption>();
+  }
 }
 
 PartialResultSetSource::~PartialResultSetSource() {
+  ClearValuesSpace();
   internal::OptionsSpan span(options_);
   if (state_ == kReading) {
     // Finish() can deadlock if there is still data in the streaming RPC,
@@ -116,6 +121,33 @@ PartialResultSetSource::~PartialResultSetSource() {
 }
 
 StatusOr<spanner::Row> PartialResultSetSource::NextRow() {
+  auto has_row = AdvanceRow();
+  if (!has_row) return std::move(has_row).status();
+  if (!*has_row) return spanner::Row();
+  auto value_it = RowBegin();
+  std::vector<spanner::Value> values;
+  values.reserve(metadata_->row_type().fields_size());
+  for (auto const& field : metadata_->row_type().fields()) {
+    values.push_back(FromProto(field.type(), std::move(*value_it)));
+    ++value_it;
+  }
+  return RowFriend::MakeRow(std::move(values), columns_);
+}
+
+StatusOr<bool> PartialResultSetSource::NextRowValues(
+    RowValuesFunction const& f) {
+  auto has_row = AdvanceRow();
+  if (!has_row || !*has_row) return has_row;
+  // The values are passed in place, avoiding the copies out of the arena.
+  auto value_it = RowBegin();
+  row_values_.resize(columns_->size());
+  for (auto& v : row_values_) v = &*value_it++;
+  auto status = f(row_values_);
+  if (!status.ok()) return status;
+  return true;
+}
+
+StatusOr<bool> PartialResultSetSource::AdvanceRow() {
   if (usable_rows_ == 0 && rows_returned_ > 0) {
     // There may be complete or partial rows in values_ that haven't been
     // returned to the clients yet. Let's copy it over before we reset
@@ -129,7 +161,7 @@ StatusOr<spanner::Row> PartialResultSetSource::NextRow() {
                               tmp.data());
     }
     values_.reset();
-    values_space_.Clear();
+    ClearValuesSpace();
     arena_.Reset();
     values_.emplace(
         google::protobuf::Arena::Create<
@@ -143,21 +175,24 @@ StatusOr<spanner::Row> PartialResultSetSource::NextRow() {
     rows_returned_ = 0;
   }
   while (usable_rows_ == 0) {
-    if (state_ == kFinished) return spanner::Row();
+    if (state_ == kFinished) return false;
     internal::OptionsSpan span(options_);
     auto status = ReadFromStream();
     if (!status.ok()) return status;
   }
-  auto value_it = (*values_)->begin() + rows_returned_ * columns_->size();
   ++rows_returned_;
   --usable_rows_;
-  std::vector<spanner::Value> values;
-  values.reserve(metadata_->row_type().fields_size());
-  for (auto const& field : metadata_->row_type().fields()) {
-    values.push_back(FromProto(field.type(), std::move(*value_it)));
-    ++value_it;
-  }
-  return RowFriend::MakeRow(std::move(values), columns_);
+  return true;
+}
+
+google::protobuf::RepeatedPtrField<google::protobuf::Value>::iterator
+PartialResultSetSource::RowBegin() {
+  return (*values_)->begin() + (rows_returned_ - 1) * columns_->size();
+}
+
+void PartialResultSetSource::ClearValuesSpace() {
+  budget_.Release(values_space_.space_used);
+  values_space_.Clear();
 }
 
 Status PartialResultSetSource::ReadFromStream() {
@@ -227,7 +262,7 @@ Status PartialResultSetSource::ReadFromStream() {
     }
     values_back_incomplete_ = false;
     values->Clear();
-    values_space_.Clear();
+    ClearValuesSpace();
   }
 
   // If the final value in the previous `PartialResultSet` was incomplete,
@@ -257,13 +292,18 @@ Status PartialResultSetSource::ReadFromStream() {
 
   // If we didn't receive a resume token, and have not exceeded our buffer
   // limit, then we choose to `Read()` again so as to maintain resumability.
+  // Delivering the rows instead, when the limit is exceeded, also stops us
+  // reading from the stream until the caller has consumed them.
   if (result_set.result.resume_token().empty() && values_space_limit_ > 0) {
+    std::size_t space_used = 0;
     for (auto it = values->begin() + values_space_.index; it != values->end();
          ++it) {
-      values_space_.space_used += it->SpaceUsedLong();
+      space_used += it->SpaceUsedLong();
     }
+    values_space_.space_used += space_used;
     values_space_.index = values->size();
-    if (values_space_.space_used < values_space_limit_) {
+    auto const in_budget = budget_.Reserve(space_used, total_space_limit_);
+    if (in_budget && values_space_.space_used < values_space_limit_) {
       return {};  // OK
     }
   }
@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PARTIAL_RESULT_SET_SOURCE_H
 
 #include "google/cloud/spanner/internal/partial_result_set_reader.h"
+#include "google/cloud/spanner/internal/resume_buffer_budget.h"
 #include "google/cloud/spanner/results.h"
 #include "google/cloud/spanner/value.h"
 #include "google/cloud/spanner/version.h"
@@ -67,6 +68,8 @@ class PartialResultSetSource : public PartialResultSourceInterface {
 
   StatusOr<spanner::Row> NextRow() override;
 
+  StatusOr<bool> NextRowValues(RowValuesFunction const& f) override;
+
   std::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
     return metadata_;
   }
@@ -86,6 +89,16 @@ class PartialResultSetSource : public PartialResultSourceInterface {
 
   Status ReadFromStream();
 
+  // Makes the next row available, returning false at end-of-stream.
+  StatusOr<bool> AdvanceRow();
+
+  // The first value of the row made available by `AdvanceRow()`.
+  google::protobuf::RepeatedPtrField<google::protobuf::Value>::iterator
+  RowBegin();
+
+  // Forgets the space used by `values_`, returning it to the budget.
+  void ClearValuesSpace();
+
   // Arena for the values_ field.
   google::protobuf::Arena arena_;
 
@@ -119,6 +132,9 @@ class PartialResultSetSource : public PartialResultSourceInterface {
   std::optional<google::protobuf::RepeatedPtrField<google::protobuf::Value>*>
       values_;
 
+  // The values passed to `NextRowValues()` callbacks, reused across rows.
+  std::vector<google::protobuf::Value*> row_values_;
+
   // `space_used` is the sum of the SpaceUsedLong() by the values at indexes [0,
   // index) in `values_`.
   struct PrecomputedSpaceUsed {
@@ -145,6 +161,12 @@ class PartialResultSetSource : public PartialResultSourceInterface {
   // set the default limit to twice that.
   std::size_t values_space_limit_ = 2 * 100 * (std::size_t{1} << 20);
 
+  // The space used by `values_` is also counted against a process-wide
+  // budget, and we stop buffering should the total across all streams get
+  // larger than this limit (when non-zero).
+  ResumeBufferBudget& budget_ = ResumeBufferBudget::Global();
+  std::size_t total_space_limit_ = 0;
+
   // `*values_.rbegin()` exists, but it is incomplete. The rest of the value
   // will be sent in subsequent `PartialResultSet` messages.
   bool values_back_incomplete_ = false;
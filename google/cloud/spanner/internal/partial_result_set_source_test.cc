@@ -15,6 +15,7 @@
 #include "google/cloud/spanner/internal/partial_result_set_source.h"
 #include "google/cloud/spanner/mocks/row.h"
 #include "google/cloud/spanner/options.h"
+#include "google/cloud/spanner/results.h"
 #include "google/cloud/spanner/row.h"
 #include "google/cloud/spanner/testing/mock_partial_result_set_reader.h"
 #include "google/cloud/spanner/value.h"
@@ -26,7 +27,10 @@
 #include <grpcpp/grpcpp.h>
 #include <array>
 #include <cstdint>
+#include <optional>
 #include <string>
+#include <tuple>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -39,6 +43,7 @@ using ::google::cloud::testing_util::IsProtoEqual;
 using ::google::cloud::testing_util::StatusIs;
 using ::google::protobuf::TextFormat;
 using ::testing::_;
+using ::testing::ElementsAre;
 using ::testing::Return;
 using ::testing::UnitTest;
 
@@ -459,6 +464,143 @@ TEST(PartialResultSetSourceTest, MultipleResponses) {
   }
 }
 
+/**
+ * @test Verify that buffered values are counted against the process-wide
+ * budget while resumability is maintained, and returned afterwards.
+ */
+TEST(PartialResultSetSourceTest, TotalBufferSizeAccounting) {
+  std::array<char const*, 2> text{{
+      R"pb(
+        metadata: {
+          row_type: {
+            fields: {
+              name: "UserId",
+              type: { code: INT64 }
+            }
+          }
+        }
+        values: { string_value: "10" }
+      )pb",
+      R"pb(
+        values: { string_value: "22" }
+      )pb",
+  }};
+  std::array<google::spanner::v1::PartialResultSet, text.size()> response;
+  for (std::size_t i = 0; i != text.size(); ++i) {
+    SCOPED_TRACE("Converting text to proto [" + std::to_string(i) + "]");
+    ASSERT_TRUE(TextFormat::ParseFromString(text[i], &response[i]));
+  }
+
+  auto& budget = ResumeBufferBudget::Global();
+  auto const initial_bytes = budget.buffered_bytes();
+  auto const initial_overflows = budget.overflow_count();
+
+  auto grpc_reader = std::make_unique<MockPartialResultSetReader>();
+  EXPECT_CALL(*grpc_reader, Read(_, _))
+      .WillOnce([&response](std::optional<std::string> const&,
+                            spanner_internal::UnownedPartialResultSet& result) {
+        result.result = response[0];
+        return true;
+      })
+      .WillOnce([&response](std::optional<std::string> const& resume_token,
+                            spanner_internal::UnownedPartialResultSet& result) {
+        // The first row was buffered, so the stream is still resumable.
+        EXPECT_EQ(resume_token, "");
+        result.result = response[1];
+        return true;
+      })
+      .WillOnce(Return(false));
+  EXPECT_CALL(*grpc_reader, Finish()).WillOnce(ResultMock(Status()));
+  EXPECT_CALL(*grpc_reader, TryCancel()).Times(0);
+
+  internal::OptionsSpan overlay(Options{}.set<StringOption>("uh-oh"));
+  auto reader = CreatePartialResultSetSource(std::move(grpc_reader));
+  ASSERT_STATUS_OK(reader);
+  EXPECT_GT(budget.buffered_bytes(), initial_bytes);
+
+  EXPECT_THAT((*reader)->NextRow(),
+              IsValidAndEquals(spanner_mocks::MakeRow({
+                  {"UserId", spanner::Value(10)},
+              })));
+  EXPECT_THAT((*reader)->NextRow(),
+              IsValidAndEquals(spanner_mocks::MakeRow({
+                  {"UserId", spanner::Value(22)},
+              })));
+  EXPECT_THAT((*reader)->NextRow(), IsValidAndEquals(spanner::Row{}));
+  reader->reset();
+  EXPECT_EQ(budget.buffered_bytes(), initial_bytes);
+  EXPECT_EQ(budget.overflow_count(), initial_overflows);
+}
+
+/**
+ * @test Verify that a stream delivers its buffered rows, giving up
+ * resumability, when the process-wide budget is exhausted.
+ */
+TEST(PartialResultSetSourceTest, TotalBufferSizeExceeded) {
+  std::array<char const*, 2> text{{
+      R"pb(
+        metadata: {
+          row_type: {
+            fields: {
+              name: "UserId",
+              type: { code: INT64 }
+            }
+          }
+        }
+        values: { string_value: "10" }
+      )pb",
+      R"pb(
+        values: { string_value: "22" }
+      )pb",
+  }};
+  std::array<google::spanner::v1::PartialResultSet, text.size()> response;
+  for (std::size_t i = 0; i != text.size(); ++i) {
+    SCOPED_TRACE("Converting text to proto [" + std::to_string(i) + "]");
+    ASSERT_TRUE(TextFormat::ParseFromString(text[i], &response[i]));
+  }
+
+  auto& budget = ResumeBufferBudget::Global();
+  auto const initial_bytes = budget.buffered_bytes();
+  auto const initial_overflows = budget.overflow_count();
+
+  auto grpc_reader = std::make_unique<MockPartialResultSetReader>();
+  EXPECT_CALL(*grpc_reader, Read(_, _))
+      .WillOnce([&response](std::optional<std::string> const&,
+                            spanner_internal::UnownedPartialResultSet& result) {
+        result.result = response[0];
+        return true;
+      })
+      .WillOnce([&response](std::optional<std::string> const& resume_token,
+                            spanner_internal::UnownedPartialResultSet& result) {
+        // The first row was delivered, so the stream is not resumable.
+        EXPECT_EQ(resume_token, std::nullopt);
+        result.result = response[1];
+        return true;
+      })
+      .WillOnce(Return(false));
+  EXPECT_CALL(*grpc_reader, Finish()).WillOnce(ResultMock(Status()));
+  EXPECT_CALL(*grpc_reader, TryCancel()).Times(0);
+
+  internal::OptionsSpan overlay(Options{}.set<StringOption>("uh-oh"));
+  auto reader = CreatePartialResultSetSource(
+      std::move(grpc_reader),
+      Options{}.set<spanner::StreamingResumabilityTotalBufferSizeOption>(1));
+  ASSERT_STATUS_OK(reader);
+  EXPECT_GT(budget.overflow_count(), initial_overflows);
+
+  EXPECT_THAT((*reader)->NextRow(),
+              IsValidAndEquals(spanner_mocks::MakeRow({
+                  {"UserId", spanner::Value(10)},
+              })));
+  EXPECT_THAT((*reader)->NextRow(),
+              IsValidAndEquals(spanner_mocks::MakeRow({
+                  {"UserId", spanner::Value(22)},
+              })));
+  EXPECT_THAT((*reader)->NextRow(), IsValidAndEquals(spanner::Row{}));
+  reader->reset();
+  EXPECT_EQ(budget.buffered_bytes(), initial_bytes);
+}
+
 /**
  * @test Verify the behavior when a response with no values is received.
  */
@@ -933,6 +1075,104 @@ TEST(PartialResultSetSourceTest, ErrorOnIncompleteRow) {
                        " that is not on a row boundary"));
 }
 
+/**
+ * @test Verify `DecodeStreamOf()` decodes the rows in place, including those
+ * split across responses.
+ */
+TEST(PartialResultSetSourceTest, DecodeStreamOf) {
+  std::array<char const*, 3> text{{
+      R"pb(
+        metadata: {
+          row_type: {
+            fields: {
+              name: "UserId",
+              type: { code: INT64 }
+            }
+            fields: {
+              name: "UserName",
+              type: { code: STRING }
+            }
+          }
+        }
+        values: { string_value: "10" }
+        values: { string_value: "user10" }
+        values: { string_value: "22" }
+      )pb",
+      R"pb(
+        values: { string_value: "user22" }
+        values: { string_value: "99" }
+      )pb",
+      R"pb(
+        values: { null_value: NULL_VALUE }
+      )pb",
+  }};
+  auto grpc_reader = std::make_unique<MockPartialResultSetReader>();
+  auto& read = EXPECT_CALL(*grpc_reader, Read(_, _));
+  for (auto const* t : text) {
+    google::spanner::v1::PartialResultSet response;
+    ASSERT_TRUE(TextFormat::ParseFromString(t, &response));
+    read.WillOnce([response](std::optional<std::string> const&,
+                             UnownedPartialResultSet& result) {
+      result.result = response;
+      return true;
+    });
+  }
+  read.WillOnce(Return(false));
+  EXPECT_CALL(*grpc_reader, Finish()).WillOnce(ResultMock(Status()));
+  EXPECT_CALL(*grpc_reader, TryCancel()).Times(0);
+
+  auto reader = CreatePartialResultSetSource(std::move(grpc_reader));
+  ASSERT_STATUS_OK(reader);
+  spanner::RowStream rows(*std::move(reader));
+
+  using RowType = std::tuple<std::int64_t, std::optional<std::string>>;
+  std::vector<RowType> actual;
+  for (auto& row : spanner::DecodeStreamOf<RowType>(rows)) {
+    ASSERT_STATUS_OK(row);
+    actual.push_back(*std::move(row));
+  }
+  EXPECT_THAT(actual, ElementsAre(RowType{10, "user10"}, RowType{22, "user22"},
+                                  RowType{99, std::nullopt}));
+}
+
+/// @test Verify `DecodeStreamOf()` checks the row type before reading rows.
+TEST(PartialResultSetSourceTest, DecodeStreamOfWrongType) {
+  auto constexpr kText = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "UserId",
+          type: { code: INT64 }
+        }
+      }
+    }
+    values: { string_value: "10" }
+  )pb";
+  google::spanner::v1::PartialResultSet response;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText, &response));
+  auto grpc_reader = std::make_unique<MockPartialResultSetReader>();
+  EXPECT_CALL(*grpc_reader, Read(_, _))
+      .WillOnce([&response](std::optional<std::string> const&,
+                            UnownedPartialResultSet& result) {
+        result.result = response;
+        return true;
+      });
+  // The stream is cancelled without reading the remaining rows.
+  EXPECT_CALL(*grpc_reader, TryCancel()).WillOnce(VoidMock());
+  EXPECT_CALL(*grpc_reader, Finish()).WillOnce(ResultMock(Status()));
+
+  auto reader = CreatePartialResultSetSource(std::move(grpc_reader));
+  ASSERT_STATUS_OK(reader);
+  spanner::RowStream rows(*std::move(reader));
+
+  std::vector<StatusOr<std::tuple<std::string>>> actual;
+  for (auto& row : spanner::DecodeStreamOf<std::tuple<std::string>>(rows)) {
+    actual.push_back(std::move(row));
+  }
+  EXPECT_THAT(actual,
+              ElementsAre(StatusIs(StatusCode::kUnknown, "wrong type")));
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner_internal
@@ -0,0 +1,386 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/query_cache_connection.h"
+#include "google/cloud/spanner/internal/session.h"
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/sql_statement.h"
+#include "google/cloud/spanner/timestamp.h"
+#include "google/cloud/spanner/transaction.h"
+#include "google/cloud/spanner/value.h"
+#include "absl/types/variant.h"
+#include "google/protobuf/timestamp.pb.h"
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/// The rows of a query, and the time of the data they were read from.
+struct CachedQueryResult {
+  std::vector<spanner::Row> rows;
+  std::optional<google::spanner::v1::ResultSetMetadata> metadata;
+  QueryCacheConnection::Clock::time_point read_time;
+  std::size_t bytes = 0;
+};
+
+namespace {
+
+using Clock = QueryCacheConnection::Clock;
+
+// The `max_staleness` of a single-use, bounded-staleness transaction.
+std::optional<std::chrono::nanoseconds> MaxStaleness(
+    spanner::Transaction const& txn) {
+  std::optional<std::chrono::nanoseconds> max_staleness;
+  Visit(txn, [&max_staleness](
+                 SessionHolder&,
+                 StatusOr<google::spanner::v1::TransactionSelector> const& s,
+                 TransactionContext const&) {
+    if (!s || !s->has_single_use()) return false;
+    auto const& opts = s->single_use();
+    if (!opts.has_read_only() || !opts.read_only().has_max_staleness()) {
+      return false;
+    }
+    auto const& d = opts.read_only().max_staleness();
+    max_staleness = std::chrono::seconds(d.seconds()) +
+                    std::chrono::nanoseconds(d.nanos());
+    return true;
+  });
+  return max_staleness;
+}
+
+std::string MakeKey(std::string const& database,
+                    spanner::Connection::SqlParams const& params) {
+  auto const& query_options = params.query_options;
+  std::string key = database;
+  key.push_back('\0');
+  key += query_options.optimizer_version().value_or("");
+  key.push_back('\0');
+  key += query_options.optimizer_statistics_package().value_or("");
+  key.push_back('\0');
+  // The parameters are a map, so serialize them deterministically.
+  auto statement = ToProto(params.statement);
+  google::protobuf::io::StringOutputStream output(&key);
+  google::protobuf::io::CodedOutputStream coded(&output);
+  coded.SetSerializationDeterministic(true);
+  statement.SerializeToCodedStream(&coded);
+  coded.Trim();
+  return key;
+}
+
+// Approximates the memory used by the row.
+std::size_t RowBytes(spanner::Row const& row) {
+  auto bytes = sizeof(row);
+  for (auto const& v : row.values()) {
+    auto proto = ToProto(v);
+    bytes += sizeof(v) + proto.first.ByteSizeLong();
+    bytes += proto.second.ByteSizeLong();
+  }
+  return bytes;
+}
+
+// The time of the data read by a query, if the metadata includes it.
+std::optional<Clock::time_point> ReadTime(
+    google::spanner::v1::ResultSetMetadata const& metadata) {
+  auto const& txn = metadata.transaction();
+  if (!txn.has_read_timestamp()) return std::nullopt;
+  auto ts = spanner::MakeTimestamp(txn.read_timestamp());
+  if (!ts) return std::nullopt;
+  auto read_time = ts->get<spanner::sys_time<Clock::duration>>();
+  if (!read_time) return std::nullopt;
+  return *read_time;
+}
+
+/// Yields copies of the rows of a cached result.
+class CachedResultSource : public spanner::ResultSourceInterface {
+ public:
+  explicit CachedResultSource(std::shared_ptr<CachedQueryResult const> result)
+      : result_(std::move(result)) {}
+
+  StatusOr<spanner::Row> NextRow() override {
+    if (next_ != result_->rows.size()) return result_->rows[next_++];
+    return spanner::Row();
+  }
+
+  std::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
+    return result_->metadata;
+  }
+
+  std::optional<google::spanner::v1::ResultSetStats> Stats() const override {
+    return std::nullopt;
+  }
+
+ private:
+  std::shared_ptr<CachedQueryResult const> result_;
+  std::size_t next_ = 0;
+};
+
+spanner::RowStream MakeRowStream(
+    std::shared_ptr<CachedQueryResult const> result) {
+  return spanner::RowStream(
+      std::make_unique<CachedResultSource>(std::move(result)));
+}
+
+}  // namespace
+
+/**
+ * Yields the rows of a query as they arrive from the child connection, and
+ * copies them into the cache while they fit.
+ *
+ * The placeholder for the query is replaced when the stream ends, and removed
+ * on errors, once the rows exceed `max_bytes`, or if the stream is destroyed
+ * before it ends.
+ */
+class QueryCacheConnection::FillSource : public spanner::ResultSourceInterface {
+ public:
+  FillSource(std::weak_ptr<QueryCacheConnection> cache, std::string key,
+             spanner::RowStream rows, Clock::time_point read_time,
+             std::size_t max_bytes)
+      : cache_(std::move(cache)),
+        key_(std::move(key)),
+        source_(RowStreamFriend::ReleaseSource(rows)),
+        max_bytes_(max_bytes),
+        result_(std::make_shared<CachedQueryResult>()) {
+    result_->read_time = read_time;
+    result_->bytes = sizeof(CachedQueryResult);
+  }
+  ~FillSource() override { Abandon(); }
+
+  StatusOr<spanner::Row> NextRow() override {
+    auto row = source_->NextRow();
+    if (!result_) return row;
+    if (!row) {
+      // Errors are not cached.
+      Abandon();
+    } else if (row->size() == 0) {
+      Finish();
+    } else if ((result_->bytes += RowBytes(*row)) > max_bytes_) {
+      Abandon();
+    } else {
+      result_->rows.push_back(*row);
+    }
+    return row;
+  }
+
+  std::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
+    return source_->Metadata();
+  }
+
+  std::optional<google::spanner::v1::ResultSetStats> Stats() const override {
+    return source_->Stats();
+  }
+
+ private:
+  void Finish() {
+    auto result = std::move(result_);
+    result->metadata = source_->Metadata();
+    if (result->metadata) {
+      result->bytes += result->metadata->ByteSizeLong();
+      auto read_time = ReadTime(*result->metadata);
+      if (read_time) result->read_time = *read_time;
+    }
+    if (auto cache = cache_.lock()) cache->EndFill(key_, std::move(result));
+  }
+
+  void Abandon() {
+    if (!result_) return;
+    result_.reset();
+    if (auto cache = cache_.lock()) cache->EndFill(key_, nullptr);
+  }
+
+  std::weak_ptr<QueryCacheConnection> cache_;
+  std::string key_;
+  std::unique_ptr<spanner::ResultSourceInterface> source_;
+  std::size_t max_bytes_;
+  // Null once the rows are no longer copied.
+  std::shared_ptr<CachedQueryResult> result_;
+};
+
+QueryCacheConnection::QueryCacheConnection(
+    std::string database, std::shared_ptr<spanner::Connection> child,
+    std::size_t max_bytes, std::shared_ptr<Clock> clock)
+    : database_(std::move(database)),
+      child_(std::move(child)),
+      max_bytes_(max_bytes),
+      clock_(std::move(clock)) {}
+
+spanner::RowStream QueryCacheConnection::ExecuteQuery(SqlParams params) {
+  auto const max_staleness = MaxStaleness(params.transaction);
+  if (!max_staleness || params.partition_token ||
+      !absl::holds_alternative<absl::monostate>(params.directed_read_option)) {
+    return child_->ExecuteQuery(std::move(params));
+  }
+  auto self = weak_from_this();
+  if (self.expired()) return child_->ExecuteQuery(std::move(params));
+  auto key = MakeKey(database_, params);
+
+  std::unique_lock<std::mutex> lk(mu_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    auto& entry = it->second;
+    if (!entry.result) {
+      // Another stream is filling the entry. The application controls how
+      // fast (and if) that stream is read, so do not wait for it.
+      lk.unlock();
+      return child_->ExecuteQuery(std::move(params));
+    }
+    if (entry.result->read_time + *max_staleness >= clock_->Now()) {
+      lru_.splice(lru_.begin(), lru_, entry.lru);
+      return MakeRowStream(entry.result);
+    }
+    // Too stale for this caller, replace it.
+    Erase(it, lk);
+  }
+  entries_.emplace(key, Entry{});
+  lk.unlock();
+
+  // If the read timestamp is not returned, the data is at most
+  // `max_staleness` older than the start of the query.
+  auto const read_time = clock_->Now() - *max_staleness;
+  auto rows = child_->ExecuteQuery(std::move(params));
+  return spanner::RowStream(std::make_unique<FillSource>(
+      std::move(self), std::move(key), std::move(rows), read_time,
+      max_bytes_));
+}
+
+void QueryCacheConnection::EndFill(
+    std::string const& key, std::shared_ptr<CachedQueryResult const> result) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto it = entries_.find(key);
+  if (it != entries_.end() && !it->second.result) {
+    if (result && result->bytes <= max_bytes_) {
+      Insert(key, std::move(result), lk);
+    } else {
+      Erase(it, lk);
+    }
+  }
+}
+
+void QueryCacheConnection::Insert(
+    std::string const& key, std::shared_ptr<CachedQueryResult const> result,
+    std::unique_lock<std::mutex> const& lk) {
+  // Evict the least-recently-used results to make room.
+  while (!lru_.empty() && cached_bytes_ + result->bytes > max_bytes_) {
+    Erase(entries_.find(lru_.back()), lk);
+  }
+  auto& entry = entries_[key];
+  cached_bytes_ += result->bytes;
+  entry.result = std::move(result);
+  entry.lru = lru_.insert(lru_.begin(), key);
+}
+
+void QueryCacheConnection::Erase(EntryMap::iterator it,
+                                 std::unique_lock<std::mutex> const&) {
+  if (it == entries_.end()) return;
+  if (it->second.result) {
+    cached_bytes_ -= it->second.result->bytes;
+    lru_.erase(it->second.lru);
+  }
+  entries_.erase(it);
+}
+
+std::size_t QueryCacheConnection::cached_bytes() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return cached_bytes_;
+}
+
+Options QueryCacheConnection::options() { return child_->options(); }
+
+spanner::RowStream QueryCacheConnection::Read(ReadParams params) {
+  return child_->Read(std::move(params));
+}
+
+StatusOr<std::vector<spanner::ReadPartition>>
+QueryCacheConnection::PartitionRead(PartitionReadParams params) {
+  return child_->PartitionRead(std::move(params));
+}
+
+StatusOr<spanner::DmlResult> QueryCacheConnection::ExecuteDml(
+    SqlParams params) {
+  return child_->ExecuteDml(std::move(params));
+}
+
+spanner::ProfileQueryResult QueryCacheConnection::ProfileQuery(
+    SqlParams params) {
+  return child_->ProfileQuery(std::move(params));
+}
+
+StatusOr<spanner::ProfileDmlResult> QueryCacheConnection::ProfileDml(
+    SqlParams params) {
+  return child_->ProfileDml(std::move(params));
+}
+
+StatusOr<spanner::ExecutionPlan> QueryCacheConnection::AnalyzeSql(
+    SqlParams params) {
+  return child_->AnalyzeSql(std::move(params));
+}
+
+StatusOr<spanner::PartitionedDmlResult>
+QueryCacheConnection::ExecutePartitionedDml(
+    ExecutePartitionedDmlParams params) {
+  return child_->ExecutePartitionedDml(std::move(params));
+}
+
+StatusOr<std::vector<spanner::QueryPartition>>
+QueryCacheConnection::PartitionQuery(PartitionQueryParams params) {
+  return child_->PartitionQuery(std::move(params));
+}
+
+StatusOr<spanner::BatchDmlResult> QueryCacheConnection::ExecuteBatchDml(
+    ExecuteBatchDmlParams params) {
+  return child_->ExecuteBatchDml(std::move(params));
+}
+
+StatusOr<spanner::CommitResult> QueryCacheConnection::Commit(
+    CommitParams params) {
+  return child_->Commit(std::move(params));
+}
+
+Status QueryCacheConnection::Rollback(RollbackParams params) {
+  return child_->Rollback(std::move(params));
+}
+
+spanner::BatchedCommitResultStream QueryCacheConnection::BatchWrite(
+    BatchWriteParams params) {
+  return child_->BatchWrite(std::move(params));
+}
+
+future<StatusOr<spanner::DmlResult>> QueryCacheConnection::AsyncExecuteDml(
+    SqlParams params) {
+  return child_->AsyncExecuteDml(std::move(params));
+}
+
+future<StatusOr<spanner::CommitResult>> QueryCacheConnection::AsyncCommit(
+    CommitParams params) {
+  return child_->AsyncCommit(std::move(params));
+}
+
+future<Status> QueryCacheConnection::AsyncRollback(RollbackParams params) {
+  return child_->AsyncRollback(std::move(params));
+}
+
+future<StatusOr<spanner::CommitResult>>
+QueryCacheConnection::AsyncRunTransaction(AsyncRunTransactionParams params) {
+  return child_->AsyncRunTransaction(std::move(params));
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
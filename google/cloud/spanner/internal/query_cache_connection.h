@@ -0,0 +1,130 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_QUERY_CACHE_CONNECTION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_QUERY_CACHE_CONNECTION_H
+
+#include "google/cloud/spanner/connection.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/internal/clock.h"
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+struct CachedQueryResult;
+
+/**
+ * A `Connection` decorator caching the results of bounded-staleness queries.
+ *
+ * `ExecuteQuery()` in a single-use, read-only transaction with a
+ * `max_staleness` bound is served from the cache while the read timestamp of
+ * the cached result is within that bound. The results are keyed by the
+ * database, the SQL statement and its parameters, and the optimizer options.
+ * The results are evicted in least-recently-used order to keep their total
+ * size under `max_bytes`.
+ *
+ * On a miss the rows are returned as they arrive from the child connection,
+ * and copied into the cache until their size exceeds `max_bytes`. Until that
+ * stream is consumed or destroyed, other callers with the same key bypass the
+ * cache, rather than waiting for a stream the application may never finish.
+ *
+ * Queries with partition tokens or directed reads, and all other operations,
+ * are forwarded to the child connection. Instances must be owned by a
+ * `std::shared_ptr`.
+ */
+class QueryCacheConnection
+    : public spanner::Connection,
+      public std::enable_shared_from_this<QueryCacheConnection> {
+ public:
+  using Clock = ::google::cloud::internal::SystemClock;
+
+  QueryCacheConnection(
+      std::string database, std::shared_ptr<spanner::Connection> child,
+      std::size_t max_bytes,
+      std::shared_ptr<Clock> clock = std::make_shared<Clock>());
+
+  Options options() override;
+  spanner::RowStream Read(ReadParams) override;
+  StatusOr<std::vector<spanner::ReadPartition>> PartitionRead(
+      PartitionReadParams) override;
+  spanner::RowStream ExecuteQuery(SqlParams) override;
+  StatusOr<spanner::DmlResult> ExecuteDml(SqlParams) override;
+  spanner::ProfileQueryResult ProfileQuery(SqlParams) override;
+  StatusOr<spanner::ProfileDmlResult> ProfileDml(SqlParams) override;
+  StatusOr<spanner::ExecutionPlan> AnalyzeSql(SqlParams) override;
+  StatusOr<spanner::PartitionedDmlResult> ExecutePartitionedDml(
+      ExecutePartitionedDmlParams) override;
+  StatusOr<std::vector<spanner::QueryPartition>> PartitionQuery(
+      PartitionQueryParams) override;
+  StatusOr<spanner::BatchDmlResult> ExecuteBatchDml(
+      ExecuteBatchDmlParams) override;
+  StatusOr<spanner::CommitResult> Commit(CommitParams) override;
+  Status Rollback(RollbackParams) override;
+  spanner::BatchedCommitResultStream BatchWrite(BatchWriteParams) override;
+  future<StatusOr<spanner::DmlResult>> AsyncExecuteDml(SqlParams) override;
+  future<StatusOr<spanner::CommitResult>> AsyncCommit(CommitParams) override;
+  future<Status> AsyncRollback(RollbackParams) override;
+  future<StatusOr<spanner::CommitResult>> AsyncRunTransaction(
+      AsyncRunTransactionParams) override;
+
+  /// The total size of the cached results, for testing.
+  std::size_t cached_bytes() const;
+
+ private:
+  class FillSource;
+
+  /// A cached result, or a placeholder while the result is being fetched.
+  struct Entry {
+    // Null while the result is being fetched.
+    std::shared_ptr<CachedQueryResult const> result;
+    // The position in `lru_`, valid once `result` is set.
+    std::list<std::string>::iterator lru;
+  };
+  using EntryMap = std::unordered_map<std::string, Entry>;
+
+  /// Replaces the placeholder for @p key with @p result, or removes it if
+  /// @p result is null.
+  void EndFill(std::string const& key,
+               std::shared_ptr<CachedQueryResult const> result);
+  void Insert(std::string const& key,
+              std::shared_ptr<CachedQueryResult const> result,
+              std::unique_lock<std::mutex> const& lk);
+  void Erase(EntryMap::iterator it, std::unique_lock<std::mutex> const& lk);
+
+  std::string database_;
+  std::shared_ptr<spanner::Connection> child_;
+  std::size_t const max_bytes_;
+  std::shared_ptr<Clock> clock_;
+
+  mutable std::mutex mu_;
+  EntryMap entries_;              // GUARDED_BY(mu_)
+  std::list<std::string> lru_;    // GUARDED_BY(mu_), most recent first
+  std::size_t cached_bytes_ = 0;  // GUARDED_BY(mu_)
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_QUERY_CACHE_CONNECTION_H
@@ -0,0 +1,394 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/query_cache_connection.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/spanner/mocks/row.h"
+#include "google/cloud/spanner/timestamp.h"
+#include "google/cloud/spanner/transaction.h"
+#include "google/cloud/testing_util/fake_clock.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::google::cloud::testing_util::FakeSystemClock;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::Gt;
+using ::testing::IsEmpty;
+using ::testing::Return;
+
+auto constexpr kDatabase = "projects/p/instances/i/databases/d";
+
+spanner::Transaction BoundedStaleness(std::chrono::nanoseconds staleness) {
+  return MakeSingleUseTransaction(
+      spanner::Transaction::SingleUseOptions(staleness));
+}
+
+spanner::Connection::SqlParams MakeParams(spanner::Transaction txn,
+                                          std::int64_t id) {
+  return {std::move(txn),
+          spanner::SqlStatement("SELECT Name FROM Users WHERE Id = @id",
+                                {{"id", spanner::Value(id)}})};
+}
+
+// A stream with `rows`, ending with `status`, read at `read_time`.
+spanner::RowStream MakeStream(std::vector<spanner::Row> rows,
+                              std::optional<FakeSystemClock::time_point>
+                                  read_time = std::nullopt,
+                              Status status = {}) {
+  auto source = std::make_unique<MockResultSetSource>();
+  google::spanner::v1::ResultSetMetadata metadata;
+  auto& field = *metadata.mutable_row_type()->add_fields();
+  field.set_name("Name");
+  field.mutable_type()->set_code(google::spanner::v1::TypeCode::STRING);
+  if (read_time) {
+    auto ts = spanner::MakeTimestamp(*read_time).value();
+    *metadata.mutable_transaction()->mutable_read_timestamp() =
+        ts.get<protobuf::Timestamp>().value();
+  }
+  EXPECT_CALL(*source, Metadata()).WillRepeatedly(Return(metadata));
+  EXPECT_CALL(*source, NextRow())
+      .WillRepeatedly([rows = std::move(rows), status = std::move(status),
+                       next = std::size_t{0}]() mutable
+                      -> StatusOr<spanner::Row> {
+        if (next != rows.size()) return rows[next++];
+        if (!status.ok()) return status;
+        return spanner::Row();
+      });
+  return spanner::RowStream(std::move(source));
+}
+
+std::vector<std::string> Names(spanner::RowStream rows) {
+  std::vector<std::string> names;
+  for (auto& row : spanner::StreamOf<std::tuple<std::string>>(rows)) {
+    if (!row) break;
+    names.push_back(std::get<0>(*row));
+  }
+  return names;
+}
+
+class QueryCacheConnectionTest : public ::testing::Test {
+ protected:
+  QueryCacheConnectionTest()
+      : mock_(std::make_shared<MockConnection>()),
+        clock_(std::make_shared<FakeSystemClock>()) {
+    clock_->SetTime(std::chrono::system_clock::from_time_t(1700000000));
+  }
+
+  std::shared_ptr<QueryCacheConnection> MakeConnection(
+      std::size_t max_bytes = 1024 * 1024) {
+    return std::make_shared<QueryCacheConnection>(kDatabase, mock_, max_bytes,
+                                                  clock_);
+  }
+
+  std::shared_ptr<MockConnection> mock_;
+  std::shared_ptr<FakeSystemClock> clock_;
+};
+
+TEST_F(QueryCacheConnectionTest, ForwardsOtherTransactions) {
+  EXPECT_CALL(*mock_, ExecuteQuery).Times(2).WillRepeatedly([] {
+    return MakeStream({spanner_mocks::MakeRow("Ann")});
+  });
+
+  auto conn = MakeConnection();
+  auto txn = MakeSingleUseTransaction(spanner::Transaction::SingleUseOptions(
+      spanner::Transaction::ReadOnlyOptions()));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre("Ann"));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre("Ann"));
+  EXPECT_EQ(conn->cached_bytes(), 0U);
+}
+
+TEST_F(QueryCacheConnectionTest, HitWithinStaleness) {
+  EXPECT_CALL(*mock_, ExecuteQuery).WillOnce([this] {
+    return MakeStream(
+        {spanner_mocks::MakeRow("Ann"), spanner_mocks::MakeRow("Bob")},
+        clock_->Now() - std::chrono::seconds(2));
+  });
+
+  auto conn = MakeConnection();
+  auto txn = BoundedStaleness(std::chrono::seconds(10));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre("Ann", "Bob"));
+  EXPECT_THAT(conn->cached_bytes(), Gt(0U));
+
+  clock_->AdvanceTime(std::chrono::seconds(7));
+  auto rows = conn->ExecuteQuery(MakeParams(txn, 1));
+  auto read_timestamp = rows.ReadTimestamp();
+  ASSERT_TRUE(read_timestamp.has_value());
+  EXPECT_EQ(*read_timestamp,
+            spanner::MakeTimestamp(clock_->Now() - std::chrono::seconds(9))
+                .value());
+  EXPECT_THAT(Names(std::move(rows)), ElementsAre("Ann", "Bob"));
+}
+
+TEST_F(QueryCacheConnectionTest, RefreshesStaleResults) {
+  EXPECT_CALL(*mock_, ExecuteQuery)
+      .WillOnce([this] {
+        return MakeStream({spanner_mocks::MakeRow("Ann")}, clock_->Now());
+      })
+      .WillOnce([this] {
+        return MakeStream({spanner_mocks::MakeRow("Bob")}, clock_->Now());
+      });
+
+  auto conn = MakeConnection();
+  EXPECT_THAT(Names(conn->ExecuteQuery(
+                  MakeParams(BoundedStaleness(std::chrono::seconds(10)), 1))),
+              ElementsAre("Ann"));
+
+  // Too stale for a tighter bound, which replaces the cached result.
+  clock_->AdvanceTime(std::chrono::seconds(5));
+  EXPECT_THAT(Names(conn->ExecuteQuery(
+                  MakeParams(BoundedStaleness(std::chrono::seconds(1)), 1))),
+              ElementsAre("Bob"));
+  EXPECT_THAT(Names(conn->ExecuteQuery(
+                  MakeParams(BoundedStaleness(std::chrono::seconds(1)), 1))),
+              ElementsAre("Bob"));
+}
+
+TEST_F(QueryCacheConnectionTest, ParametersAreInTheKey) {
+  EXPECT_CALL(*mock_, ExecuteQuery)
+      .WillOnce([] { return MakeStream({spanner_mocks::MakeRow("Ann")}); })
+      .WillOnce([] { return MakeStream({spanner_mocks::MakeRow("Bob")}); });
+
+  auto conn = MakeConnection();
+  auto txn = BoundedStaleness(std::chrono::seconds(10));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre("Ann"));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 2))),
+              ElementsAre("Bob"));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre("Ann"));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 2))),
+              ElementsAre("Bob"));
+}
+
+TEST_F(QueryCacheConnectionTest, ErrorsAreNotCached) {
+  EXPECT_CALL(*mock_, ExecuteQuery)
+      .WillOnce([] {
+        return MakeStream({spanner_mocks::MakeRow("Ann")}, std::nullopt,
+                          Status(StatusCode::kUnavailable, "try-again"));
+      })
+      .WillOnce([] { return MakeStream({spanner_mocks::MakeRow("Ann")}); });
+
+  auto conn = MakeConnection();
+  auto txn = BoundedStaleness(std::chrono::seconds(10));
+  auto rows = conn->ExecuteQuery(MakeParams(txn, 1));
+  auto it = rows.begin();
+  ASSERT_NE(it, rows.end());
+  EXPECT_TRUE(it->ok());
+  ++it;
+  ASSERT_NE(it, rows.end());
+  EXPECT_THAT(*it, StatusIs(StatusCode::kUnavailable));
+  EXPECT_EQ(conn->cached_bytes(), 0U);
+
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre("Ann"));
+  EXPECT_THAT(conn->cached_bytes(), Gt(0U));
+}
+
+TEST_F(QueryCacheConnectionTest, EvictsLeastRecentlyUsed) {
+  EXPECT_CALL(*mock_, ExecuteQuery)
+      .Times(4)
+      .WillRepeatedly([](spanner::Connection::SqlParams const& p) {
+        auto id = p.statement.GetParameter("id")->get<std::int64_t>().value();
+        return MakeStream({spanner_mocks::MakeRow(std::to_string(id))});
+      });
+
+  // Measure the size of a single result.
+  auto const result_bytes = [this] {
+    auto conn = MakeConnection();
+    Names(conn->ExecuteQuery(
+        MakeParams(BoundedStaleness(std::chrono::seconds(10)), 0)));
+    return conn->cached_bytes();
+  }();
+
+  auto conn = MakeConnection(2 * result_bytes);
+  auto txn = BoundedStaleness(std::chrono::seconds(10));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))), ElementsAre("1"));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 2))), ElementsAre("2"));
+  // Use the first result, so the second one is evicted.
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))), ElementsAre("1"));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 3))), ElementsAre("3"));
+  EXPECT_EQ(conn->cached_bytes(), 2 * result_bytes);
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))), ElementsAre("1"));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 3))), ElementsAre("3"));
+}
+
+TEST_F(QueryCacheConnectionTest, ResultsLargerThanTheCache) {
+  EXPECT_CALL(*mock_, ExecuteQuery).Times(2).WillRepeatedly([] {
+    return MakeStream({spanner_mocks::MakeRow(std::string(1024, 'x'))});
+  });
+
+  auto conn = MakeConnection(512);
+  auto txn = BoundedStaleness(std::chrono::seconds(10));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre(std::string(1024, 'x')));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre(std::string(1024, 'x')));
+  EXPECT_EQ(conn->cached_bytes(), 0U);
+}
+
+TEST_F(QueryCacheConnectionTest, StalledFillsDoNotBlockOtherCallers) {
+  EXPECT_CALL(*mock_, ExecuteQuery).Times(3).WillRepeatedly([] {
+    return MakeStream(
+        {spanner_mocks::MakeRow("Ann"), spanner_mocks::MakeRow("Bob")});
+  });
+
+  auto conn = MakeConnection();
+  auto txn = BoundedStaleness(std::chrono::seconds(10));
+  {
+    // The application reads one row of the filling stream, and stops.
+    auto rows = conn->ExecuteQuery(MakeParams(txn, 1));
+    auto it = rows.begin();
+    ASSERT_NE(it, rows.end());
+    // Callers on other threads go to the child connection meanwhile.
+    auto other = std::async(std::launch::async, [&conn, txn] {
+      return Names(conn->ExecuteQuery(MakeParams(txn, 1)));
+    });
+    EXPECT_THAT(other.get(), ElementsAre("Ann", "Bob"));
+    EXPECT_EQ(conn->cached_bytes(), 0U);
+  }
+  // The stalled stream was discarded, so the next caller fills the cache.
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre("Ann", "Bob"));
+  EXPECT_THAT(conn->cached_bytes(), Gt(0U));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre("Ann", "Bob"));
+}
+
+TEST_F(QueryCacheConnectionTest, EmptyResults) {
+  EXPECT_CALL(*mock_, ExecuteQuery).WillOnce([] { return MakeStream({}); });
+
+  auto conn = MakeConnection();
+  auto txn = BoundedStaleness(std::chrono::seconds(10));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))), IsEmpty());
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))), IsEmpty());
+}
+
+TEST_F(QueryCacheConnectionTest, StreamsRowsAsTheyArrive) {
+  int calls = 0;
+  EXPECT_CALL(*mock_, ExecuteQuery).WillOnce([&calls] {
+    auto source = std::make_unique<MockResultSetSource>();
+    EXPECT_CALL(*source, Metadata())
+        .WillRepeatedly(Return(google::spanner::v1::ResultSetMetadata{}));
+    EXPECT_CALL(*source, NextRow())
+        .WillRepeatedly([&calls]() -> StatusOr<spanner::Row> {
+          if (++calls == 1) return spanner_mocks::MakeRow("Ann");
+          return spanner::Row();
+        });
+    return spanner::RowStream(std::move(source));
+  });
+
+  auto conn = MakeConnection();
+  auto txn = BoundedStaleness(std::chrono::seconds(10));
+  auto rows = conn->ExecuteQuery(MakeParams(txn, 1));
+  auto it = rows.begin();
+  ASSERT_NE(it, rows.end());
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(conn->cached_bytes(), 0U);
+  ++it;
+  EXPECT_EQ(it, rows.end());
+  EXPECT_THAT(conn->cached_bytes(), Gt(0U));
+}
+
+TEST_F(QueryCacheConnectionTest, KeepsTheMetadata) {
+  EXPECT_CALL(*mock_, ExecuteQuery).WillOnce([this] {
+    return MakeStream({spanner_mocks::MakeRow("Ann")}, clock_->Now());
+  });
+
+  auto conn = MakeConnection();
+  auto txn = BoundedStaleness(std::chrono::seconds(10));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre("Ann"));
+  auto rows = conn->ExecuteQuery(MakeParams(txn, 1));
+  auto metadata = RowStreamFriend::ReleaseSource(rows)->Metadata();
+  ASSERT_TRUE(metadata.has_value());
+  ASSERT_EQ(metadata->row_type().fields_size(), 1);
+  EXPECT_EQ(metadata->row_type().fields(0).name(), "Name");
+  EXPECT_TRUE(metadata->transaction().has_read_timestamp());
+}
+
+TEST_F(QueryCacheConnectionTest, DiscardedStreamsAreNotCached) {
+  EXPECT_CALL(*mock_, ExecuteQuery).Times(2).WillRepeatedly([] {
+    return MakeStream(
+        {spanner_mocks::MakeRow("Ann"), spanner_mocks::MakeRow("Bob")});
+  });
+
+  auto conn = MakeConnection();
+  auto txn = BoundedStaleness(std::chrono::seconds(10));
+  {
+    auto rows = conn->ExecuteQuery(MakeParams(txn, 1));
+    auto it = rows.begin();
+    ASSERT_NE(it, rows.end());
+  }
+  EXPECT_EQ(conn->cached_bytes(), 0U);
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre("Ann", "Bob"));
+}
+
+TEST_F(QueryCacheConnectionTest, LargeResultsReleaseWaiters) {
+  EXPECT_CALL(*mock_, ExecuteQuery).Times(2).WillRepeatedly([] {
+    return MakeStream({spanner_mocks::MakeRow(std::string(1024, 'x')),
+                       spanner_mocks::MakeRow("Bob")});
+  });
+
+  auto conn = MakeConnection(512);
+  auto txn = BoundedStaleness(std::chrono::seconds(10));
+  auto rows = conn->ExecuteQuery(MakeParams(txn, 1));
+  auto it = rows.begin();
+  ASSERT_NE(it, rows.end());
+  // The result no longer fits, so other callers do not wait for it.
+  auto other = std::async(std::launch::async, [&conn, txn] {
+    return Names(conn->ExecuteQuery(MakeParams(txn, 1)));
+  });
+  EXPECT_THAT(other.get(), ElementsAre(std::string(1024, 'x'), "Bob"));
+  ++it;
+  ASSERT_NE(it, rows.end());
+  EXPECT_EQ(conn->cached_bytes(), 0U);
+}
+
+TEST_F(QueryCacheConnectionTest, NestedQueriesDoNotWait) {
+  EXPECT_CALL(*mock_, ExecuteQuery).Times(2).WillRepeatedly([] {
+    return MakeStream({spanner_mocks::MakeRow("Ann")});
+  });
+
+  auto conn = MakeConnection();
+  auto txn = BoundedStaleness(std::chrono::seconds(10));
+  auto outer = conn->ExecuteQuery(MakeParams(txn, 1));
+  EXPECT_THAT(Names(conn->ExecuteQuery(MakeParams(txn, 1))),
+              ElementsAre("Ann"));
+  EXPECT_THAT(Names(std::move(outer)), ElementsAre("Ann"));
+  EXPECT_THAT(conn->cached_bytes(), Gt(0U));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
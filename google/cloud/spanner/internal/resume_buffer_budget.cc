@@ -0,0 +1,46 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/resume_buffer_budget.h"
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+ResumeBufferBudget& ResumeBufferBudget::Global() {
+  // Never destroyed, so streams outliving static destruction are safe.
+  static auto* const kBudget = new ResumeBufferBudget;
+  return *kBudget;
+}
+
+bool ResumeBufferBudget::Reserve(std::size_t bytes, std::size_t limit) {
+  auto const total = buffered_bytes_.fetch_add(bytes) + bytes;
+  auto peak = peak_buffered_bytes_.load();
+  while (total > peak &&
+         !peak_buffered_bytes_.compare_exchange_weak(peak, total)) {
+  }
+  if (limit == 0 || total <= limit) return true;
+  ++overflow_count_;
+  return false;
+}
+
+void ResumeBufferBudget::Release(std::size_t bytes) {
+  buffered_bytes_.fetch_sub(bytes);
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
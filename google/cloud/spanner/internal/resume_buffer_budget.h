@@ -0,0 +1,71 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_RESUME_BUFFER_BUDGET_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_RESUME_BUFFER_BUDGET_H
+
+#include "google/cloud/spanner/version.h"
+#include <atomic>
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Accounts for the memory buffered to keep streaming reads resumable.
+ *
+ * Each `PartialResultSetSource` adds the space used by the values it holds
+ * back while waiting for a resume token, and removes it once those values
+ * are delivered or discarded. The total, across all the streams sharing the
+ * budget, lets a stream give up resumability (and so release its buffer)
+ * before the process as a whole runs out of memory.
+ */
+class ResumeBufferBudget {
+ public:
+  /// The budget shared by all the streams in the process.
+  static ResumeBufferBudget& Global();
+
+  /**
+   * Adds @p bytes to the total, returning true if the new total does not
+   * exceed @p limit. A @p limit of 0 means there is no limit. The bytes are
+   * added either way, and must be removed by a matching `Release()`.
+   */
+  bool Reserve(std::size_t bytes, std::size_t limit);
+  void Release(std::size_t bytes);
+
+  /// The number of bytes currently buffered.
+  std::size_t buffered_bytes() const { return buffered_bytes_.load(); }
+
+  /// The largest value of `buffered_bytes()` seen so far.
+  std::size_t peak_buffered_bytes() const {
+    return peak_buffered_bytes_.load();
+  }
+
+  /// The number of times a stream gave up resumability to stay in budget.
+  std::size_t overflow_count() const { return overflow_count_.load(); }
+
+ private:
+  std::atomic<std::size_t> buffered_bytes_{0};
+  std::atomic<std::size_t> peak_buffered_bytes_{0};
+  std::atomic<std::size_t> overflow_count_{0};
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_RESUME_BUFFER_BUDGET_H
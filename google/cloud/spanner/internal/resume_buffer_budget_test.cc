@@ -0,0 +1,74 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/resume_buffer_budget.h"
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+TEST(ResumeBufferBudget, ReserveAndRelease) {
+  ResumeBufferBudget budget;
+  EXPECT_TRUE(budget.Reserve(100, 250));
+  EXPECT_TRUE(budget.Reserve(150, 250));
+  EXPECT_EQ(budget.buffered_bytes(), 250);
+  EXPECT_EQ(budget.overflow_count(), 0);
+
+  // Over the limit, but the bytes are still accounted for.
+  EXPECT_FALSE(budget.Reserve(1, 250));
+  EXPECT_EQ(budget.buffered_bytes(), 251);
+  EXPECT_EQ(budget.overflow_count(), 1);
+
+  budget.Release(101);
+  EXPECT_EQ(budget.buffered_bytes(), 150);
+  EXPECT_EQ(budget.peak_buffered_bytes(), 251);
+  EXPECT_TRUE(budget.Reserve(100, 250));
+}
+
+TEST(ResumeBufferBudget, NoLimit) {
+  ResumeBufferBudget budget;
+  EXPECT_TRUE(budget.Reserve(1 << 30, 0));
+  EXPECT_TRUE(budget.Reserve(1 << 30, 0));
+  EXPECT_EQ(budget.overflow_count(), 0);
+}
+
+TEST(ResumeBufferBudget, Concurrent) {
+  ResumeBufferBudget budget;
+  auto constexpr kThreads = 8;
+  auto constexpr kIterations = 10000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kThreads; ++i) {
+    threads.emplace_back([&budget] {
+      for (int j = 0; j != kIterations; ++j) {
+        budget.Reserve(16, 0);
+        budget.Release(16);
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(budget.buffered_bytes(), 0);
+  EXPECT_LE(budget.peak_buffered_bytes(), kThreads * 16);
+  EXPECT_GE(budget.peak_buffered_bytes(), 16);
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
@@ -239,6 +239,62 @@ future<StatusOr<google::spanner::v1::ResultSet>> SpannerAuth::AsyncExecuteSql(
       });
 }
 
+future<StatusOr<google::spanner::v1::Transaction>>
+SpannerAuth::AsyncBeginTransaction(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::spanner::v1::BeginTransactionRequest const& request) {
+  return auth_->AsyncConfigureContext(std::move(context))
+      .then([cq, child = child_, options = std::move(options),
+             request](future<StatusOr<std::shared_ptr<grpc::ClientContext>>>
+                          f) mutable {
+        auto context = f.get();
+        if (!context) {
+          return make_ready_future(StatusOr<google::spanner::v1::Transaction>(
+              std::move(context).status()));
+        }
+        return child->AsyncBeginTransaction(cq, *std::move(context),
+                                            std::move(options), request);
+      });
+}
+
+future<StatusOr<google::spanner::v1::CommitResponse>> SpannerAuth::AsyncCommit(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::spanner::v1::CommitRequest const& request) {
+  return auth_->AsyncConfigureContext(std::move(context))
+      .then([cq, child = child_, options = std::move(options),
+             request](future<StatusOr<std::shared_ptr<grpc::ClientContext>>>
+                          f) mutable {
+        auto context = f.get();
+        if (!context) {
+          return make_ready_future(
+              StatusOr<google::spanner::v1::CommitResponse>(
+                  std::move(context).status()));
+        }
+        return child->AsyncCommit(cq, *std::move(context), std::move(options),
+                                  request);
+      });
+}
+
+future<Status> SpannerAuth::AsyncRollback(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::spanner::v1::RollbackRequest const& request) {
+  return auth_->AsyncConfigureContext(std::move(context))
+      .then([cq, child = child_, options = std::move(options),
+             request](future<StatusOr<std::shared_ptr<grpc::ClientContext>>>
+                          f) mutable {
+        auto context = f.get();
+        if (!context) return make_ready_future(std::move(context).status());
+        return child->AsyncRollback(cq, *std::move(context),
+                                    std::move(options), request);
+      });
+}
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner_internal
 }  // namespace cloud
@@ -130,6 +130,24 @@ class SpannerLogging : public SpannerStub {
       google::cloud::internal::ImmutableOptions options,
       google::spanner::v1::ExecuteSqlRequest const& request) override;
 
+  future<StatusOr<google::spanner::v1::Transaction>> AsyncBeginTransaction(
+      google::cloud::CompletionQueue& cq,
+      std::shared_ptr<grpc::ClientContext> context,
+      google::cloud::internal::ImmutableOptions options,
+      google::spanner::v1::BeginTransactionRequest const& request) override;
+
+  future<StatusOr<google::spanner::v1::CommitResponse>> AsyncCommit(
+      google::cloud::CompletionQueue& cq,
+      std::shared_ptr<grpc::ClientContext> context,
+      google::cloud::internal::ImmutableOptions options,
+      google::spanner::v1::CommitRequest const& request) override;
+
+  future<Status> AsyncRollback(
+      google::cloud::CompletionQueue& cq,
+      std::shared_ptr<grpc::ClientContext> context,
+      google::cloud::internal::ImmutableOptions options,
+      google::spanner::v1::RollbackRequest const& request) override;
+
  private:
   std::shared_ptr<SpannerStub> child_;
   TracingOptions tracing_options_;
@@ -223,6 +223,41 @@ SpannerMetadata::AsyncExecuteSql(
                                  request);
 }
 
+future<StatusOr<google::spanner::v1::Transaction>>
+SpannerMetadata::AsyncBeginTransaction(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::spanner::v1::BeginTransactionRequest const& request) {
+  SetMetadata(*context, *options,
+              absl::StrCat("session=", internal::UrlEncode(request.session())));
+  return child_->AsyncBeginTransaction(cq, std::move(context),
+                                       std::move(options), request);
+}
+
+future<StatusOr<google::spanner::v1::CommitResponse>>
+SpannerMetadata::AsyncCommit(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::spanner::v1::CommitRequest const& request) {
+  SetMetadata(*context, *options,
+              absl::StrCat("session=", internal::UrlEncode(request.session())));
+  return child_->AsyncCommit(cq, std::move(context), std::move(options),
+                             request);
+}
+
+future<Status> SpannerMetadata::AsyncRollback(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::spanner::v1::RollbackRequest const& request) {
+  SetMetadata(*context, *options,
+              absl::StrCat("session=", internal::UrlEncode(request.session())));
+  return child_->AsyncRollback(cq, std::move(context), std::move(options),
+                               request);
+}
+
 void SpannerMetadata::SetMetadata(grpc::ClientContext& context,
                                   Options const& options,
                                   std::string const& request_params) {
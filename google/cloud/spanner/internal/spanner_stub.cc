@@ -265,6 +265,63 @@ DefaultSpannerStub::AsyncExecuteSql(
       request, std::move(context));
 }
 
+future<StatusOr<google::spanner::v1::Transaction>>
+DefaultSpannerStub::AsyncBeginTransaction(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    // NOLINTNEXTLINE(performance-unnecessary-value-param)
+    google::cloud::internal::ImmutableOptions,
+    google::spanner::v1::BeginTransactionRequest const& request) {
+  return internal::MakeUnaryRpcImpl<
+      google::spanner::v1::BeginTransactionRequest,
+      google::spanner::v1::Transaction>(
+      cq,
+      [this](grpc::ClientContext* context,
+             google::spanner::v1::BeginTransactionRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return grpc_stub_->AsyncBeginTransaction(context, request, cq);
+      },
+      request, std::move(context));
+}
+
+future<StatusOr<google::spanner::v1::CommitResponse>>
+DefaultSpannerStub::AsyncCommit(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    // NOLINTNEXTLINE(performance-unnecessary-value-param)
+    google::cloud::internal::ImmutableOptions,
+    google::spanner::v1::CommitRequest const& request) {
+  return internal::MakeUnaryRpcImpl<google::spanner::v1::CommitRequest,
+                                    google::spanner::v1::CommitResponse>(
+      cq,
+      [this](grpc::ClientContext* context,
+             google::spanner::v1::CommitRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return grpc_stub_->AsyncCommit(context, request, cq);
+      },
+      request, std::move(context));
+}
+
+future<Status> DefaultSpannerStub::AsyncRollback(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    // NOLINTNEXTLINE(performance-unnecessary-value-param)
+    google::cloud::internal::ImmutableOptions,
+    google::spanner::v1::RollbackRequest const& request) {
+  return internal::MakeUnaryRpcImpl<google::spanner::v1::RollbackRequest,
+                                    google::protobuf::Empty>(
+             cq,
+             [this](grpc::ClientContext* context,
+                    google::spanner::v1::RollbackRequest const& request,
+                    grpc::CompletionQueue* cq) {
+               return grpc_stub_->AsyncRollback(context, request, cq);
+             },
+             request, std::move(context))
+      .then([](future<StatusOr<google::protobuf::Empty>> f) {
+        return f.get().status();
+      });
+}
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner_internal
 }  // namespace cloud
@@ -131,6 +131,25 @@ class SpannerStub {
       std::shared_ptr<grpc::ClientContext> context,
       google::cloud::internal::ImmutableOptions options,
       google::spanner::v1::ExecuteSqlRequest const& request) = 0;
+
+  virtual future<StatusOr<google::spanner::v1::Transaction>>
+  AsyncBeginTransaction(
+      google::cloud::CompletionQueue& cq,
+      std::shared_ptr<grpc::ClientContext> context,
+      google::cloud::internal::ImmutableOptions options,
+      google::spanner::v1::BeginTransactionRequest const& request) = 0;
+
+  virtual future<StatusOr<google::spanner::v1::CommitResponse>> AsyncCommit(
+      google::cloud::CompletionQueue& cq,
+      std::shared_ptr<grpc::ClientContext> context,
+      google::cloud::internal::ImmutableOptions options,
+      google::spanner::v1::CommitRequest const& request) = 0;
+
+  virtual future<Status> AsyncRollback(
+      google::cloud::CompletionQueue& cq,
+      std::shared_ptr<grpc::ClientContext> context,
+      google::cloud::internal::ImmutableOptions options,
+      google::spanner::v1::RollbackRequest const& request) = 0;
 };
 
 class DefaultSpannerStub : public SpannerStub {
@@ -258,6 +258,46 @@ SpannerTracingStub::AsyncExecuteSql(
   return internal::EndSpan(std::move(context), std::move(span), std::move(f));
 }
 
+future<StatusOr<google::spanner::v1::Transaction>>
+SpannerTracingStub::AsyncBeginTransaction(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::spanner::v1::BeginTransactionRequest const& request) {
+  auto span =
+      internal::MakeSpanGrpc("google.spanner.v1.Spanner", "BeginTransaction");
+  internal::OTelScope scope(span);
+  internal::InjectTraceContext(*context, *propagator_);
+  auto f =
+      child_->AsyncBeginTransaction(cq, context, std::move(options), request);
+  return internal::EndSpan(std::move(context), std::move(span), std::move(f));
+}
+
+future<StatusOr<google::spanner::v1::CommitResponse>>
+SpannerTracingStub::AsyncCommit(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::spanner::v1::CommitRequest const& request) {
+  auto span = internal::MakeSpanGrpc("google.spanner.v1.Spanner", "Commit");
+  internal::OTelScope scope(span);
+  internal::InjectTraceContext(*context, *propagator_);
+  auto f = child_->AsyncCommit(cq, context, std::move(options), request);
+  return internal::EndSpan(std::move(context), std::move(span), std::move(f));
+}
+
+future<Status> SpannerTracingStub::AsyncRollback(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::spanner::v1::RollbackRequest const& request) {
+  auto span = internal::MakeSpanGrpc("google.spanner.v1.Spanner", "Rollback");
+  internal::OTelScope scope(span);
+  internal::InjectTraceContext(*context, *propagator_);
+  auto f = child_->AsyncRollback(cq, context, std::move(options), request);
+  return internal::EndSpan(std::move(context), std::move(span), std::move(f));
+}
+
 std::shared_ptr<SpannerStub> MakeSpannerTracingStub(
     std::shared_ptr<SpannerStub> stub) {
   return std::make_shared<SpannerTracingStub>(std::move(stub));
@@ -17,6 +17,7 @@
 
 #include "google/cloud/spanner/internal/session.h"
 #include "google/cloud/spanner/version.h"
+#include "google/cloud/future.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/port_platform.h"
 #include "google/cloud/status_or.h"
@@ -26,6 +27,8 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -49,7 +52,7 @@ using VisitInvokeResult = ::google::cloud::internal::invoke_result_t<
 /**
  * The internal representation of a google::cloud::spanner::Transaction.
  */
-class TransactionImpl {
+class TransactionImpl : public std::enable_shared_from_this<TransactionImpl> {
  public:
   TransactionImpl(google::spanner::v1::TransactionSelector selector,
                   bool route_to_leader, std::string tag);
@@ -113,34 +116,94 @@ class TransactionImpl {
     try {
 #endif
       auto r = f(session_, selector_, ctx);
-      bool done = false;
-      {
-        std::unique_lock<std::mutex> lock(mu_);
-        stub_ = ctx.stub;
-        UpdatePrecommitToken(lock, ctx.precommit_token);
-        state_ =
-            selector_ && selector_->has_begin() ? State::kBegin : State::kDone;
-        done = (state_ == State::kDone);
-      }
-      if (done) {
-        cond_.notify_all();
-      } else {
-        cond_.notify_one();
-      }
+      EndPending(ctx);
       return r;
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
     } catch (...) {
+      std::vector<promise<void>> waiters;
       {
         std::lock_guard<std::mutex> lock(mu_);
         state_ = State::kBegin;
+        waiters.swap(waiters_);
       }
       cond_.notify_one();
+      for (auto& w : waiters) w.set_value();
       throw;
     }
 #endif
   }
 
+  // Asynchronous version of `Visit()`. The functor has the same contract,
+  // but returns a `future<>`, and the transaction state is updated when that
+  // future is satisfied. The `SessionHolder`, selector, and context passed to
+  // the functor remain valid until then.
+  //
+  // Rather than blocking while another visitor is assigning the transaction
+  // ID, the functor is called once that visitor is done.
+  //
+  // The `TransactionImpl` must be owned by a `std::shared_ptr`. The pending
+  // callbacks keep it alive, so the caller may release the transaction
+  // before the returned future is satisfied.
+  template <typename Functor>
+  VisitInvokeResult<Functor> AsyncVisit(Functor f) {
+    using ResultType = VisitInvokeResult<Functor>;
+    std::unique_lock<std::mutex> lock(mu_);
+    if (state_ == State::kPending) {
+      waiters_.emplace_back();
+      auto ready = waiters_.back().get_future();
+      lock.unlock();
+      return ready.then(
+          [self = shared_from_this(), f = std::move(f)](future<void>) mutable {
+            return self->AsyncVisit(std::move(f));
+          });
+    }
+    auto ctx = std::make_shared<TransactionContext>(
+        TransactionContext{route_to_leader_, tag_, ++seqno_, stub_,
+                           precommit_token_});
+    if (state_ == State::kDone) {
+      lock.unlock();
+      return f(session_, selector_, *ctx)
+          .then([self = shared_from_this(), ctx](ResultType r) {
+            std::unique_lock<std::mutex> lk(self->mu_);
+            self->UpdatePrecommitToken(lk, ctx->precommit_token);
+            return r.get();
+          });
+    }
+    state_ = State::kPending;
+    lock.unlock();
+    // selector_->has_begin(), but only one visitor active at a time.
+    return f(session_, selector_, *ctx)
+        .then([self = shared_from_this(), ctx](ResultType r) {
+          self->EndPending(*ctx);
+          return r.get();
+        });
+  }
+
  private:
+  // Updates the state after the visitor that was assigning the transaction ID
+  // is done, and wakes up the waiting visitors.
+  void EndPending(TransactionContext const& ctx) {
+    bool done = false;
+    std::vector<promise<void>> waiters;
+    {
+      std::unique_lock<std::mutex> lock(mu_);
+      stub_ = ctx.stub;
+      UpdatePrecommitToken(lock, ctx.precommit_token);
+      state_ =
+          selector_ && selector_->has_begin() ? State::kBegin : State::kDone;
+      done = (state_ == State::kDone);
+      waiters.swap(waiters_);
+    }
+    if (done) {
+      cond_.notify_all();
+    } else {
+      cond_.notify_one();
+    }
+    // Each asynchronous visitor tries again, and waits again if another
+    // visitor is now assigning the transaction ID.
+    for (auto& w : waiters) w.set_value();
+  }
+
   void UpdatePrecommitToken(
       std::unique_lock<std::mutex> const&,
       std::optional<google::spanner::v1::MultiplexedSessionPrecommitToken>
@@ -155,6 +218,7 @@ class TransactionImpl {
 
   std::mutex mu_;
   std::condition_variable cond_;
+  std::vector<promise<void>> waiters_;  // asynchronous visitors
   SessionHolder session_;
   StatusOr<google::spanner::v1::TransactionSelector> selector_;
   bool route_to_leader_;
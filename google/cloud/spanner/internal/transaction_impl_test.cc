@@ -314,6 +314,64 @@ TEST(InternalTransaction, ReadFailsAndTxnInvalidated) {
                                    std::nullopt));
 }
 
+TEST(InternalTransaction, AsyncVisitWaitsForBegin) {
+  auto txn = spanner::MakeReadWriteTransaction();
+  promise<void> begin_done;
+  std::vector<std::string> ids;
+  auto visitor = [&ids, &begin_done](SessionHolder&,
+                                     StatusOr<TransactionSelector>& selector,
+                                     TransactionContext&) {
+    if (selector->has_begin()) {
+      return begin_done.get_future().then([&selector](future<void>) {
+        selector->set_id("txn0");
+        return std::string("begin");
+      });
+    }
+    ids.push_back(selector->id());
+    return make_ready_future(selector->id());
+  };
+  auto f0 = AsyncVisit(txn, visitor);
+  auto f1 = AsyncVisit(txn, visitor);
+  auto f2 = AsyncVisit(txn, visitor);
+  // The other visitors wait until the first one assigns the transaction ID.
+  EXPECT_FALSE(f1.is_ready());
+  EXPECT_FALSE(f2.is_ready());
+  EXPECT_THAT(ids, IsEmpty());
+
+  begin_done.set_value();
+  EXPECT_EQ("begin", f0.get());
+  EXPECT_EQ("txn0", f1.get());
+  EXPECT_EQ("txn0", f2.get());
+  EXPECT_EQ(2, ids.size());
+}
+
+TEST(InternalTransaction, AsyncVisitOutlivesTransaction) {
+  promise<void> begin_done;
+  auto visitor = [&begin_done](SessionHolder&,
+                               StatusOr<TransactionSelector>& selector,
+                               TransactionContext&) {
+    if (selector->has_begin()) {
+      return begin_done.get_future().then([&selector](future<void>) {
+        selector->set_id("txn0");
+        return std::string("begin");
+      });
+    }
+    return make_ready_future(selector->id());
+  };
+  future<std::string> f0;
+  future<std::string> f1;
+  {
+    auto txn = spanner::MakeReadWriteTransaction();
+    f0 = AsyncVisit(txn, visitor);
+    f1 = AsyncVisit(txn, visitor);
+    EXPECT_FALSE(f1.is_ready());
+  }
+  // The pending visitors still use the transaction after it is released.
+  begin_done.set_value();
+  EXPECT_EQ("begin", f0.get());
+  EXPECT_EQ("txn0", f1.get());
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner_internal
@@ -0,0 +1,163 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/transaction_scheduler.h"
+#include "google/cloud/internal/make_status.h"
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+TransactionScheduler::TransactionScheduler(int max_concurrency)
+    : max_concurrency_(std::max(max_concurrency, 1)),
+      limit_(max_concurrency_) {}
+
+TransactionScheduler::Ticket::Ticket(TransactionScheduler* scheduler,
+                                     std::vector<TableKey> keys,
+                                     std::vector<std::string> tables,
+                                     std::thread::id thread)
+    : scheduler_(scheduler),
+      keys_(std::move(keys)),
+      tables_(std::move(tables)),
+      thread_(thread) {}
+
+TransactionScheduler::Ticket::Ticket(Ticket&& rhs) noexcept
+    : scheduler_(std::exchange(rhs.scheduler_, nullptr)),
+      keys_(std::move(rhs.keys_)),
+      tables_(std::move(rhs.tables_)),
+      thread_(rhs.thread_) {}
+
+TransactionScheduler::Ticket::~Ticket() {
+  if (scheduler_ != nullptr) scheduler_->Release(*this);
+}
+
+void TransactionScheduler::Ticket::OnCommit(Status const& status) {
+  if (scheduler_ != nullptr) scheduler_->OnCommit(status);
+}
+
+StatusOr<TransactionScheduler::Ticket> TransactionScheduler::Admit(
+    std::map<std::string, spanner::KeySet> const& key_sets) {
+  std::vector<TableKey> keys;
+  std::vector<std::string> tables;
+  for (auto const& kv : key_sets) {
+    auto proto = ToProto(kv.second);
+    // The ranges cannot be compared with other keys and ranges, so they
+    // overlap the whole table.
+    if (proto.all() || proto.ranges_size() != 0) {
+      tables.push_back(kv.first);
+      continue;
+    }
+    for (auto const& key : proto.keys()) {
+      keys.emplace_back(kv.first, key.SerializeAsString());
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  auto const thread = std::this_thread::get_id();
+
+  std::unique_lock<std::mutex> lk(mu_);
+  if (threads_.count(thread) != 0) {
+    return internal::FailedPreconditionError(
+        "this thread already holds declared keys, for example, in the "
+        "mutator of another Commit(), waiting for more keys could deadlock",
+        GCP_ERROR_INFO());
+  }
+  cv_.wait(lk, [&] { return CanRun(keys, tables); });
+  ++running_;
+  for (auto const& k : keys) {
+    held_keys_.insert(k);
+    ++held_key_counts_[k.first];
+  }
+  held_tables_.insert(tables.begin(), tables.end());
+  threads_.insert(thread);
+  return Ticket(this, std::move(keys), std::move(tables), thread);
+}
+
+int TransactionScheduler::concurrency_limit() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return limit_;
+}
+
+int TransactionScheduler::running() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return running_;
+}
+
+bool TransactionScheduler::CanRun(
+    std::vector<TableKey> const& keys,
+    std::vector<std::string> const& tables) const {
+  if (running_ >= limit_) return false;
+  auto const table_free = [this](std::string const& table) {
+    return held_tables_.count(table) == 0 &&
+           held_key_counts_.count(table) == 0;
+  };
+  if (!std::all_of(tables.begin(), tables.end(), table_free)) return false;
+  return std::none_of(keys.begin(), keys.end(), [this](TableKey const& k) {
+    return held_tables_.count(k.first) != 0 || held_keys_.count(k) != 0;
+  });
+}
+
+void TransactionScheduler::Release(Ticket const& ticket) {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    --running_;
+    for (auto const& k : ticket.keys_) {
+      held_keys_.erase(k);
+      auto i = held_key_counts_.find(k.first);
+      if (--i->second == 0) held_key_counts_.erase(i);
+    }
+    for (auto const& t : ticket.tables_) held_tables_.erase(t);
+    threads_.erase(threads_.find(ticket.thread_));
+  }
+  cv_.notify_all();
+}
+
+void TransactionScheduler::OnCommit(Status const& status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (status.code() == StatusCode::kAborted) {
+    limit_ = std::max(limit_ / 2, 1);
+    return;
+  }
+  if (!status.ok() || limit_ == max_concurrency_) return;
+  ++limit_;
+  lk.unlock();
+  cv_.notify_all();
+}
+
+std::shared_ptr<TransactionScheduler> GetTransactionScheduler(
+    std::shared_ptr<spanner::Connection> const& conn) {
+  using Map = std::map<std::weak_ptr<spanner::Connection>,
+                       std::shared_ptr<TransactionScheduler>,
+                       std::owner_less<std::weak_ptr<spanner::Connection>>>;
+  static auto* const kMu = new std::mutex;
+  static auto* const kSchedulers = new Map;
+  std::lock_guard<std::mutex> lk(*kMu);
+  // Forget the schedulers of the connections that were deleted.
+  for (auto i = kSchedulers->begin(); i != kSchedulers->end();) {
+    i = i->first.expired() ? kSchedulers->erase(i) : std::next(i);
+  }
+  auto& scheduler = (*kSchedulers)[conn];
+  if (!scheduler) scheduler = std::make_shared<TransactionScheduler>();
+  return scheduler;
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
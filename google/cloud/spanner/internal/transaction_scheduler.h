@@ -0,0 +1,140 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_TRANSACTION_SCHEDULER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_TRANSACTION_SCHEDULER_H
+
+#include "google/cloud/spanner/connection.h"
+#include "google/cloud/spanner/keys.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Schedules the read-write transactions run by `Client::Commit()` to reduce
+ * the number of them that abort.
+ *
+ * Transactions that declare overlapping key sets are run one at a time, so
+ * they do not abort each other. The scheduler does not know the order of the
+ * key columns, so key ranges are not compared. Two key sets of the same table
+ * overlap when they contain an equal key, or when either of them contains a
+ * range or is `KeySet::All()`.
+ *
+ * The number of transactions running at once is also limited. The limit is
+ * halved whenever a commit aborts (the keys are contended by transactions
+ * outside the scheduler's control), and increased by one whenever a commit
+ * succeeds, up to `max_concurrency`.
+ *
+ * A thread that holds a ticket, for example while it runs the mutator of
+ * `Client::Commit()`, cannot be admitted again. Waiting for more keys while
+ * holding some deadlocks when two threads nest their transactions in the
+ * opposite order, so `Admit()` fails instead.
+ */
+class TransactionScheduler {
+ public:
+  static constexpr int kDefaultMaxConcurrency = 64;
+
+  explicit TransactionScheduler(int max_concurrency = kDefaultMaxConcurrency);
+
+  /// A table name and a serialized key of that table.
+  using TableKey = std::pair<std::string, std::string>;
+
+  /**
+   * The right to run a transaction, which lasts until the `Ticket` is
+   * destroyed. The `TransactionScheduler` must outlive its tickets.
+   */
+  class Ticket {
+   public:
+    Ticket(Ticket&& rhs) noexcept;
+    Ticket& operator=(Ticket&&) = delete;
+    Ticket(Ticket const&) = delete;
+    Ticket& operator=(Ticket const&) = delete;
+    ~Ticket();
+
+    /// Records the outcome of an attempt to commit the transaction.
+    void OnCommit(Status const& status);
+
+   private:
+    friend class TransactionScheduler;
+    Ticket(TransactionScheduler* scheduler, std::vector<TableKey> keys,
+           std::vector<std::string> tables, std::thread::id thread);
+
+    TransactionScheduler* scheduler_;  // null once moved from
+    std::vector<TableKey> keys_;
+    std::vector<std::string> tables_;
+    std::thread::id thread_;
+  };
+
+  /**
+   * Blocks until a transaction on @p key_sets, indexed by table name, can run.
+   *
+   * Returns an error if the calling thread already holds a ticket.
+   */
+  StatusOr<Ticket> Admit(
+      std::map<std::string, spanner::KeySet> const& key_sets);
+
+  /// The current limit on the number of running transactions.
+  int concurrency_limit() const;
+
+  /// The number of running transactions.
+  int running() const;
+
+ private:
+  bool CanRun(std::vector<TableKey> const& keys,
+              std::vector<std::string> const& tables) const;
+  void Release(Ticket const& ticket);
+  void OnCommit(Status const& status);
+
+  int const max_concurrency_;
+  mutable std::mutex mu_;
+  std::condition_variable cv_;  // notified when a transaction can run
+  int limit_;                   // GUARDED_BY(mu_)
+  int running_ = 0;             // GUARDED_BY(mu_)
+  std::set<TableKey> held_keys_;  // GUARDED_BY(mu_)
+  // The number of held keys of each table.
+  std::map<std::string, int> held_key_counts_;  // GUARDED_BY(mu_)
+  // The tables held in full, because a ticket declared a range or all keys.
+  std::set<std::string> held_tables_;  // GUARDED_BY(mu_)
+  // The thread of each ticket.
+  std::unordered_multiset<std::thread::id> threads_;  // GUARDED_BY(mu_)
+};
+
+/**
+ * Returns the scheduler shared by the `Client`s using @p conn, creating it on
+ * first use.
+ */
+std::shared_ptr<TransactionScheduler> GetTransactionScheduler(
+    std::shared_ptr<spanner::Connection> const& conn);
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_TRANSACTION_SCHEDULER_H
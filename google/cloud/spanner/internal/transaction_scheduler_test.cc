@@ -0,0 +1,246 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/transaction_scheduler.h"
+#include "google/cloud/spanner/keys.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::spanner::KeySet;
+using ::google::cloud::spanner::MakeKey;
+using ::google::cloud::spanner::MakeKeyBoundClosed;
+using ::google::cloud::spanner::MakeKeyBoundOpen;
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::testing_util::StatusIs;
+
+// The key sets of a transaction updating @p key_set of @p table.
+std::map<std::string, KeySet> InTable(KeySet key_set,
+                                      std::string table = "Table") {
+  return {{std::move(table), std::move(key_set)}};
+}
+
+// Runs `Admit(key_set)` in a thread, recording when it returns.
+class AdmitThread {
+ public:
+  AdmitThread(TransactionScheduler& scheduler, KeySet key_set)
+      : thread_([this, &scheduler, key_set = std::move(key_set)] {
+          auto ticket = scheduler.Admit(InTable(key_set));
+          admitted_ = true;
+        }) {}
+  ~AdmitThread() { thread_.join(); }
+
+  // Returns true if the `Admit()` has not returned after a short while.
+  bool Blocked() const {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return !admitted_;
+  }
+
+ private:
+  std::atomic<bool> admitted_{false};
+  std::thread thread_;
+};
+
+TEST(TransactionScheduler, DisjointKeysRunConcurrently) {
+  TransactionScheduler scheduler;
+  auto t1 =
+      scheduler.Admit(InTable(KeySet().AddKey(MakeKey(1)).AddKey(MakeKey(2))));
+  auto t2 = scheduler.Admit(InTable(KeySet().AddKey(MakeKey(3))));
+  EXPECT_EQ(scheduler.running(), 2);
+}
+
+TEST(TransactionScheduler, DifferentTablesDoNotOverlap) {
+  TransactionScheduler scheduler;
+  auto t1 = scheduler.Admit(InTable(KeySet().AddKey(MakeKey(1)), "T1"));
+  auto t2 = scheduler.Admit(InTable(KeySet().AddKey(MakeKey(1)), "T2"));
+  auto t3 = scheduler.Admit(InTable(KeySet::All(), "T3"));
+  ASSERT_STATUS_OK(t1);
+  ASSERT_STATUS_OK(t2);
+  ASSERT_STATUS_OK(t3);
+  EXPECT_EQ(scheduler.running(), 3);
+}
+
+TEST(TransactionScheduler, OverlappingKeysRunInTurn) {
+  TransactionScheduler scheduler;
+  std::unique_ptr<AdmitThread> waiter;
+  {
+    auto t1 = scheduler.Admit(
+        InTable(KeySet().AddKey(MakeKey(1)).AddKey(MakeKey(2))));
+    waiter = std::make_unique<AdmitThread>(
+        scheduler, KeySet().AddKey(MakeKey(2)).AddKey(MakeKey(3)));
+    EXPECT_TRUE(waiter->Blocked());
+    EXPECT_EQ(scheduler.running(), 1);
+  }
+  waiter.reset();
+  EXPECT_EQ(scheduler.running(), 0);
+
+  // The keys are released, so they can be admitted again.
+  auto t2 = scheduler.Admit(InTable(KeySet().AddKey(MakeKey(2))));
+  EXPECT_EQ(scheduler.running(), 1);
+}
+
+TEST(TransactionScheduler, RangesOverlapTheTable) {
+  TransactionScheduler scheduler;
+  std::unique_ptr<AdmitThread> waiter;
+  {
+    // The range does not contain the key, but without the schema the
+    // scheduler cannot tell.
+    auto t1 = scheduler.Admit(InTable(
+        KeySet().AddRange(MakeKeyBoundClosed(1), MakeKeyBoundOpen(2))));
+    waiter = std::make_unique<AdmitThread>(scheduler,
+                                           KeySet().AddKey(MakeKey(3)));
+    EXPECT_TRUE(waiter->Blocked());
+  }
+  waiter.reset();
+  {
+    auto t2 = scheduler.Admit(InTable(KeySet().AddKey(MakeKey(3))));
+    waiter = std::make_unique<AdmitThread>(
+        scheduler,
+        KeySet().AddRange(MakeKeyBoundClosed(1), MakeKeyBoundOpen(2)));
+    EXPECT_TRUE(waiter->Blocked());
+  }
+  waiter.reset();
+  EXPECT_EQ(scheduler.running(), 0);
+}
+
+TEST(TransactionScheduler, AllOverlapsTheTable) {
+  TransactionScheduler scheduler;
+  std::unique_ptr<AdmitThread> waiter;
+  {
+    auto t1 = scheduler.Admit(InTable(KeySet::All()));
+    waiter = std::make_unique<AdmitThread>(scheduler,
+                                           KeySet().AddKey(MakeKey(1)));
+    EXPECT_TRUE(waiter->Blocked());
+  }
+  waiter.reset();
+  {
+    auto t2 = scheduler.Admit(InTable(KeySet().AddKey(MakeKey(1))));
+    waiter = std::make_unique<AdmitThread>(scheduler, KeySet::All());
+    EXPECT_TRUE(waiter->Blocked());
+  }
+  waiter.reset();
+  EXPECT_EQ(scheduler.running(), 0);
+}
+
+TEST(TransactionScheduler, AbortsReduceConcurrency) {
+  TransactionScheduler scheduler(4);
+  EXPECT_EQ(scheduler.concurrency_limit(), 4);
+  {
+    auto t = scheduler.Admit(InTable(KeySet().AddKey(MakeKey(1))));
+    ASSERT_STATUS_OK(t);
+    t->OnCommit(Status(StatusCode::kAborted, "aborted"));
+    EXPECT_EQ(scheduler.concurrency_limit(), 2);
+    t->OnCommit(Status(StatusCode::kAborted, "aborted"));
+    EXPECT_EQ(scheduler.concurrency_limit(), 1);
+    t->OnCommit(Status(StatusCode::kAborted, "aborted"));
+    EXPECT_EQ(scheduler.concurrency_limit(), 1);
+    // Other errors say nothing about contention.
+    t->OnCommit(Status(StatusCode::kPermissionDenied, "uh-oh"));
+    EXPECT_EQ(scheduler.concurrency_limit(), 1);
+  }
+
+  std::unique_ptr<AdmitThread> waiter;
+  {
+    auto t = scheduler.Admit(InTable(KeySet().AddKey(MakeKey(1))));
+    ASSERT_STATUS_OK(t);
+    waiter = std::make_unique<AdmitThread>(scheduler,
+                                           KeySet().AddKey(MakeKey(2)));
+    EXPECT_TRUE(waiter->Blocked());
+    // A successful commit raises the limit, admitting the waiter.
+    t->OnCommit(Status());
+    EXPECT_EQ(scheduler.concurrency_limit(), 2);
+    waiter.reset();
+  }
+
+  auto t = scheduler.Admit(InTable(KeySet().AddKey(MakeKey(1))));
+  ASSERT_STATUS_OK(t);
+  for (int i = 0; i != 10; ++i) t->OnCommit(Status());
+  EXPECT_EQ(scheduler.concurrency_limit(), 4);
+}
+
+TEST(TransactionScheduler, NestedAdmissionsFail) {
+  TransactionScheduler scheduler;
+  std::unique_ptr<AdmitThread> waiter;
+  {
+    auto t1 = scheduler.Admit(InTable(KeySet().AddKey(MakeKey(1))));
+    ASSERT_STATUS_OK(t1);
+    EXPECT_THAT(scheduler.Admit(InTable(
+                    KeySet().AddKey(MakeKey(2)).AddKey(MakeKey(1)))),
+                StatusIs(StatusCode::kFailedPrecondition));
+    EXPECT_THAT(scheduler.Admit(InTable(KeySet::All())),
+                StatusIs(StatusCode::kFailedPrecondition));
+    // Even disjoint keys fail, see `NestedAdmissionsInOppositeOrder`.
+    EXPECT_THAT(scheduler.Admit(InTable(KeySet().AddKey(MakeKey(2)))),
+                StatusIs(StatusCode::kFailedPrecondition));
+    EXPECT_THAT(scheduler.Admit(InTable(KeySet().AddKey(MakeKey(1)), "T2")),
+                StatusIs(StatusCode::kFailedPrecondition));
+    EXPECT_EQ(scheduler.running(), 1);
+
+    // Other threads wait for the keys instead.
+    waiter =
+        std::make_unique<AdmitThread>(scheduler, KeySet().AddKey(MakeKey(1)));
+    EXPECT_TRUE(waiter->Blocked());
+  }
+  waiter.reset();
+  EXPECT_EQ(scheduler.running(), 0);
+}
+
+TEST(TransactionScheduler, NestedAdmissionsInOppositeOrder) {
+  TransactionScheduler scheduler;
+  std::promise<void> ready1;
+  std::promise<void> ready2;
+  auto nest = [&scheduler](int held, int nested, std::promise<void>& ready,
+                           std::future<void> other_ready) {
+    auto t = scheduler.Admit(InTable(KeySet().AddKey(MakeKey(held))));
+    ASSERT_STATUS_OK(t);
+    ready.set_value();
+    other_ready.wait();
+    // Waiting here, while the other thread waits for `held`, would deadlock.
+    EXPECT_THAT(scheduler.Admit(InTable(KeySet().AddKey(MakeKey(nested)))),
+                StatusIs(StatusCode::kFailedPrecondition));
+  };
+  std::thread th1(nest, 1, 2, std::ref(ready1), ready2.get_future());
+  std::thread th2(nest, 2, 1, std::ref(ready2), ready1.get_future());
+  th1.join();
+  th2.join();
+  EXPECT_EQ(scheduler.running(), 0);
+}
+
+TEST(TransactionScheduler, SharedByConnection) {
+  auto c1 = std::make_shared<MockConnection>();
+  auto c2 = std::make_shared<MockConnection>();
+  auto s1 = GetTransactionScheduler(c1);
+  EXPECT_EQ(s1, GetTransactionScheduler(c1));
+  EXPECT_NE(s1, GetTransactionScheduler(c2));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
@@ -66,6 +66,13 @@ class MockConnection : public spanner::Connection {
   MOCK_METHOD(Status, Rollback, (RollbackParams), (override));
   MOCK_METHOD(spanner::BatchedCommitResultStream, BatchWrite,
               (BatchWriteParams), (override));
+  MOCK_METHOD(future<StatusOr<spanner::DmlResult>>, AsyncExecuteDml,
+              (SqlParams), (override));
+  MOCK_METHOD(future<StatusOr<spanner::CommitResult>>, AsyncCommit,
+              (CommitParams), (override));
+  MOCK_METHOD(future<Status>, AsyncRollback, (RollbackParams), (override));
+  MOCK_METHOD(future<StatusOr<spanner::CommitResult>>, AsyncRunTransaction,
+              (AsyncRunTransactionParams), (override));
 };
 
 /**
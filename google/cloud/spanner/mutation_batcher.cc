@@ -0,0 +1,335 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/mutation_batcher.h"
+#include "google/cloud/spanner/options.h"
+#include "google/cloud/internal/make_status.h"
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// Cloud Spanner doesn't accept more than this in a single commit.
+auto constexpr kSpannerMutationLimit = 80000;
+auto constexpr kDefaultMutationLimit = 10000;
+auto constexpr kDefaultMaxBytesPerBatch = 8 * 1024 * 1024;
+auto constexpr kDefaultMaxBatches = 4;
+auto constexpr kDefaultMaxOutstandingBytes =
+    kDefaultMaxBytesPerBatch * kDefaultMaxBatches;
+auto constexpr kDefaultFlushInterval = std::chrono::milliseconds(100);
+
+template <typename Option>
+typename Option::Type Get(Options const& opts, typename Option::Type value) {
+  return opts.has<Option>() ? opts.get<Option>() : value;
+}
+
+// Cloud Spanner counts each column of each row written, and each deleted
+// key set, as a mutation.
+std::size_t MutationCount(google::spanner::v1::Mutation const& m) {
+  auto count = [](auto const& write) -> std::size_t {
+    return static_cast<std::size_t>(write.columns_size()) *
+           static_cast<std::size_t>(write.values_size());
+  };
+  switch (m.operation_case()) {
+    case google::spanner::v1::Mutation::kInsert:
+      return count(m.insert());
+    case google::spanner::v1::Mutation::kUpdate:
+      return count(m.update());
+    case google::spanner::v1::Mutation::kInsertOrUpdate:
+      return count(m.insert_or_update());
+    case google::spanner::v1::Mutation::kReplace:
+      return count(m.replace());
+    default:
+      return 1;
+  }
+}
+
+}  // namespace
+
+MutationBatcher::MutationBatcher(Client client, CompletionQueue cq,
+                                 Options opts)
+    : client_(std::move(client)),
+      cq_(std::move(cq)),
+      opts_(std::move(opts)),
+      max_mutations_per_batch_((std::min<std::size_t>)(
+          Get<MutationBatcherMaxMutationsPerBatchOption>(
+              opts_, kDefaultMutationLimit),
+          kSpannerMutationLimit)),
+      max_bytes_per_batch_(Get<MutationBatcherMaxBytesPerBatchOption>(
+          opts_, kDefaultMaxBytesPerBatch)),
+      max_batches_((std::max<std::size_t>)(
+          Get<MutationBatcherMaxBatchesOption>(opts_, kDefaultMaxBatches),
+          1)),
+      max_outstanding_bytes_(Get<MutationBatcherMaxOutstandingBytesOption>(
+          opts_, kDefaultMaxOutstandingBytes)),
+      flush_interval_(Get<MutationBatcherFlushIntervalOption>(
+          opts_, kDefaultFlushInterval)) {}
+
+MutationBatcher::~MutationBatcher() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  sent_cv_.notify_all();
+  for (auto& t : workers_) t.join();
+}
+
+std::pair<future<void>, future<StatusOr<Timestamp>>>
+MutationBatcher::AsyncApply(Mutation mutation) {
+  Mutations group;
+  group.push_back(std::move(mutation));
+  return AsyncApply(std::move(group));
+}
+
+std::pair<future<void>, future<StatusOr<Timestamp>>>
+MutationBatcher::AsyncApply(Mutations group) {
+  PendingGroup pending{std::move(group), 0, 0, {}, {}};
+  for (auto const& m : pending.group) {
+    // This operation might not be cheap, so let's cache it.
+    auto proto = m.as_proto();
+    pending.num_mutations += MutationCount(proto);
+    pending.request_size += proto.ByteSizeLong();
+  }
+  auto res = std::make_pair(pending.admission_promise.get_future(),
+                            pending.completion_promise.get_future());
+
+  auto status = IsValid(pending);
+  if (!status.ok()) {
+    // Destroy the mutations before satisfying the admission promise so that
+    // we can limit the memory usage.
+    pending.group.clear();
+    pending.completion_promise.set_value(std::move(status));
+    // No need to consider no_more_pending_promises because this operation
+    // didn't lower the number of pending operations.
+    pending.admission_promise.set_value();
+    return res;
+  }
+
+  std::unique_lock<std::mutex> lk(mu_);
+  ++num_requests_pending_;
+  pending_groups_.push(std::move(pending));
+  SatisfyPromises(TryAdmit(), lk);
+  return res;
+}
+
+future<void> MutationBatcher::AsyncWaitForNoPendingRequests() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (num_requests_pending_ == 0 && num_outstanding_batches_ == 0 &&
+      num_outstanding_timers_ == 0) {
+    return make_ready_future();
+  }
+  no_more_pending_promises_.emplace_back();
+  auto f = no_more_pending_promises_.back().get_future();
+  // Do not wait for the flush interval of the current batch.
+  cur_batch_.due = true;
+  SatisfyPromises(TryAdmit(), lk);
+  return f;
+}
+
+Status MutationBatcher::IsValid(PendingGroup const& group) const {
+  // Objects of this class need to be aware of the maximum allowed number of
+  // mutations in a batch because it should not pack more. If we have this
+  // knowledge, we might as well simplify everything and not admit larger
+  // groups.
+  if (group.group.empty()) {
+    return internal::InvalidArgumentError("Supplied mutation group is empty",
+                                          GCP_ERROR_INFO());
+  }
+  if (group.num_mutations > max_mutations_per_batch_) {
+    std::ostringstream os;
+    os << "Too many (" << group.num_mutations
+       << ") mutations in a mutation group. " << max_mutations_per_batch_
+       << " is the limit.";
+    return internal::InvalidArgumentError(std::move(os).str(),
+                                          GCP_ERROR_INFO());
+  }
+  if (group.request_size > max_bytes_per_batch_) {
+    std::ostringstream os;
+    os << "Too large (" << group.request_size
+       << " bytes) mutation group. " << max_bytes_per_batch_
+       << " bytes is the limit.";
+    return internal::InvalidArgumentError(std::move(os).str(),
+                                          GCP_ERROR_INFO());
+  }
+  // The flow control would never admit such a group, and it would block all
+  // the groups queued behind it.
+  if (group.request_size > max_outstanding_bytes_) {
+    std::ostringstream os;
+    os << "Too large (" << group.request_size
+       << " bytes) mutation group. " << max_outstanding_bytes_
+       << " outstanding bytes is the limit.";
+    return internal::InvalidArgumentError(std::move(os).str(),
+                                          GCP_ERROR_INFO());
+  }
+  return Status{};
+}
+
+bool MutationBatcher::HasSpaceFor(PendingGroup const& group) const {
+  return outstanding_size_ + group.request_size <= max_outstanding_bytes_ &&
+         cur_batch_.requests_size + group.request_size <=
+             max_bytes_per_batch_ &&
+         cur_batch_.num_mutations + group.num_mutations <=
+             max_mutations_per_batch_;
+}
+
+bool MutationBatcher::ShouldFlush() const {
+  // Send the current batch if its flush interval expired, if it is full, or
+  // if it blocks the admission of more groups.
+  return cur_batch_.due || !pending_groups_.empty() ||
+         cur_batch_.num_mutations >= max_mutations_per_batch_ ||
+         cur_batch_.requests_size >= max_bytes_per_batch_;
+}
+
+bool MutationBatcher::FlushIfPossible() {
+  if (cur_batch_.groups.empty() || num_outstanding_batches_ >= max_batches_) {
+    return false;
+  }
+  ++num_outstanding_batches_;
+  Batch batch;
+  std::swap(batch, cur_batch_);
+  cur_batch_.id = ++next_batch_id_;
+  timer_.cancel();
+  // Running the batch here might lead to a deadlock, because the mutex is
+  // held, and the batch blocks until the `BatchWrite` stream completes. Each
+  // outstanding batch gets its own worker, so they never queue behind each
+  // other.
+  sent_batches_.push(std::move(batch));
+  if (workers_.size() < num_outstanding_batches_) {
+    workers_.emplace_back([this] { Worker(); });
+  } else {
+    sent_cv_.notify_one();
+  }
+  return true;
+}
+
+void MutationBatcher::StartTimer() {
+  ++num_outstanding_timers_;
+  timer_ = cq_.MakeRelativeTimer(flush_interval_)
+               .then([this, id = cur_batch_.id](auto) { OnTimer(id); });
+}
+
+void MutationBatcher::OnTimer(std::uint64_t batch_id) {
+  std::unique_lock<std::mutex> lk(mu_);
+  --num_outstanding_timers_;
+  // Unless the batch was already sent.
+  if (cur_batch_.id == batch_id) cur_batch_.due = true;
+  SatisfyPromises(TryAdmit(), lk);
+}
+
+void MutationBatcher::Worker() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (true) {
+    sent_cv_.wait(lk, [this] { return shutdown_ || !sent_batches_.empty(); });
+    // Drain the sent batches even when shutting down, to satisfy their
+    // promises.
+    if (sent_batches_.empty()) return;
+    auto batch = std::move(sent_batches_.front());
+    sent_batches_.pop();
+    lk.unlock();
+    RunBatch(std::move(batch));
+    lk.lock();
+  }
+}
+
+void MutationBatcher::RunBatch(Batch batch) {
+  auto const num_groups = batch.groups.size();
+  std::vector<bool> done(num_groups, false);
+  auto results = client_.CommitAtLeastOnce(std::move(batch.groups), opts_);
+  for (auto& result : results) {
+    if (!result) {
+      // The stream failed, this is the status of all the unreported groups.
+      for (std::size_t i = 0; i != num_groups; ++i) {
+        if (done[i]) continue;
+        batch.completion_promises[i].set_value(result.status());
+        done[i] = true;
+      }
+      break;
+    }
+    for (auto const idx : result->indexes) {
+      if (idx >= num_groups || done[idx]) continue;
+      batch.completion_promises[idx].set_value(result->commit_timestamp);
+      done[idx] = true;
+    }
+  }
+  for (std::size_t i = 0; i != num_groups; ++i) {
+    if (done[i]) continue;
+    batch.completion_promises[i].set_value(internal::UnknownError(
+        "BatchWrite did not report the status of the mutation group",
+        GCP_ERROR_INFO()));
+  }
+  batch.completion_promises.clear();
+
+  std::unique_lock<std::mutex> lk(mu_);
+  outstanding_size_ -= batch.requests_size;
+  num_requests_pending_ -= num_groups;
+  num_outstanding_batches_--;
+  SatisfyPromises(TryAdmit(), lk);  // unlocks the lock
+}
+
+std::vector<MutationBatcher::AdmissionPromise> MutationBatcher::TryAdmit() {
+  // Defer satisfying promises until we release the lock.
+  std::vector<AdmissionPromise> admission_promises;
+
+  do {
+    while (!pending_groups_.empty() && HasSpaceFor(pending_groups_.front())) {
+      auto& group = pending_groups_.front();
+      admission_promises.emplace_back(std::move(group.admission_promise));
+      Admit(std::move(group));
+      pending_groups_.pop();
+    }
+  } while (ShouldFlush() && FlushIfPossible());
+  return admission_promises;
+}
+
+void MutationBatcher::Admit(PendingGroup group) {
+  if (cur_batch_.groups.empty()) StartTimer();
+  outstanding_size_ += group.request_size;
+  cur_batch_.requests_size += group.request_size;
+  cur_batch_.num_mutations += group.num_mutations;
+  cur_batch_.groups.push_back(std::move(group.group));
+  cur_batch_.completion_promises.push_back(
+      std::move(group.completion_promise));
+}
+
+void MutationBatcher::SatisfyPromises(
+    std::vector<AdmissionPromise> admission_promises,
+    std::unique_lock<std::mutex>& lk) {
+  std::vector<NoMorePendingPromise> no_more_pending_promises;
+  if (num_requests_pending_ == 0 && num_outstanding_batches_ == 0 &&
+      num_outstanding_timers_ == 0) {
+    // Wait for the outstanding batches and timers too, so the application can
+    // shut down the completion queue once this promise is satisfied.
+    no_more_pending_promises_.swap(no_more_pending_promises);
+  }
+  lk.unlock();
+
+  // Inform the user that we've admitted these groups and there might be some
+  // space in the buffer finally.
+  for (auto& promise : admission_promises) {
+    promise.set_value();
+  }
+  for (auto& promise : no_more_pending_promises) {
+    promise.set_value();
+  }
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
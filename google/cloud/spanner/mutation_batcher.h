@@ -0,0 +1,245 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_MUTATION_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_MUTATION_BATCHER_H
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/commit_result.h"
+#include "google/cloud/spanner/mutations.h"
+#include "google/cloud/spanner/timestamp.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status_or.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Packs mutation groups into batches for `Client::CommitAtLeastOnce()`.
+ *
+ * Applications ingesting many independent mutations can use this class to
+ * pack them into `BatchWrite` requests. Use `MutationBatcher::AsyncApply()`
+ * to apply a single `Mutation`, or a group of `Mutations` that must be
+ * committed atomically. The batcher sends a batch when it reaches the
+ * `MutationBatcherMaxMutationsPerBatchOption` or
+ * `MutationBatcherMaxBytesPerBatchOption` limits, or when its oldest
+ * mutation group has waited for `MutationBatcherFlushIntervalOption`. At
+ * most `MutationBatcherMaxBatchesOption` batches are outstanding.
+ *
+ * The flow control bounds the bytes of the admitted but uncompleted mutation
+ * groups to `MutationBatcherMaxOutstandingBytesOption`.
+ *
+ * Like the batched `Client::CommitAtLeastOnce()`, mutation groups are not
+ * replay protected, and there is no atomicity or ordering between groups.
+ *
+ * The `BatchWrite` streams block the thread reading them, so the batcher
+ * reads each outstanding batch on a thread that it owns, starting at most
+ * `MutationBatcherMaxBatchesOption` threads. It only uses the
+ * `CompletionQueue` for its flush timers. The batcher must outlive all its
+ * pending requests, see `AsyncWaitForNoPendingRequests()`.
+ *
+ * @par Thread-safety
+ * Instances of this class are guaranteed to work when accessed concurrently
+ * from multiple threads.
+ *
+ * @par Example
+ * @code
+ * namespace spanner = ::google::cloud::spanner;
+ * google::cloud::CompletionQueue cq;
+ * std::thread runner([&cq] { cq.Run(); });
+ *
+ * spanner::MutationBatcher batcher(client, cq);
+ * while (HasMoreMutations()) {
+ *   auto admission_completion = batcher.AsyncApply(GenerateMutation());
+ *   admission_completion.second.then([](auto f) {
+ *     auto commit_timestamp = f.get();
+ *     // handle the completion asynchronously
+ *   });
+ *   // Slow down if the batcher is buffering too much data.
+ *   admission_completion.first.get();
+ * }
+ * batcher.AsyncWaitForNoPendingRequests().get();
+ * cq.Shutdown();
+ * runner.join();
+ * @endcode
+ */
+class MutationBatcher {
+ public:
+  /**
+   * Creates a batcher applying mutations with @p client.
+   *
+   * @param client the client used to apply the batches.
+   * @param cq runs the flush timers.
+   * @param opts (optional) the `MutationBatcher*Option`s, and any options for
+   *     the batched `Client::CommitAtLeastOnce()`.
+   */
+  MutationBatcher(Client client, CompletionQueue cq, Options opts = {});
+
+  /// Waits for the threads reading the outstanding batches.
+  ~MutationBatcher();
+
+  /**
+   * Asynchronously applies a mutation.
+   *
+   * @return *admission* and *completion* futures. The *completion* future
+   *     reports the commit timestamp, or the error, of the mutation. The
+   *     application should not submit more mutations until the *admission*
+   *     future is satisfied, to bound the memory used by the batcher.
+   */
+  std::pair<future<void>, future<StatusOr<Timestamp>>> AsyncApply(
+      Mutation mutation);
+
+  /**
+   * Asynchronously applies a group of mutations, committed atomically.
+   *
+   * @see `AsyncApply(Mutation)` for the returned futures.
+   */
+  std::pair<future<void>, future<StatusOr<Timestamp>>> AsyncApply(
+      Mutations group);
+
+  /**
+   * Sends the mutations buffered so far, and waits until all the submitted
+   * mutations complete.
+   *
+   * @return a future satisfied once all the mutations submitted before
+   *     calling this function complete; if there are no such mutations, the
+   *     returned future is already satisfied.
+   */
+  future<void> AsyncWaitForNoPendingRequests();
+
+ private:
+  using CompletionPromise = promise<StatusOr<Timestamp>>;
+  using AdmissionPromise = promise<void>;
+  using NoMorePendingPromise = promise<void>;
+
+  /// A mutation group before it is admitted.
+  struct PendingGroup {
+    Mutations group;
+    std::size_t num_mutations;
+    std::size_t request_size;
+    CompletionPromise completion_promise;
+    AdmissionPromise admission_promise;
+  };
+
+  /// The mutation groups sent in one `BatchWrite` request.
+  struct Batch {
+    std::uint64_t id = 0;
+    std::size_t num_mutations = 0;
+    std::size_t requests_size = 0;
+    // The flush interval of the batch expired.
+    bool due = false;
+    std::vector<Mutations> groups;
+    std::vector<CompletionPromise> completion_promises;
+  };
+
+  /// Check if a mutation group doesn't exceed the allowed limits.
+  Status IsValid(PendingGroup const& group) const;
+
+  /// Check if the group fits in the current batch and the flow control.
+  bool HasSpaceFor(PendingGroup const& group) const;
+
+  /// Whether the current batch should be sent now.
+  bool ShouldFlush() const;
+
+  /**
+   * Send the current batch if there are not too many outstanding already.
+   * If there are no mutations in the batch, it's a noop.
+   */
+  bool FlushIfPossible();
+
+  /// Start the flush timer of the current batch.
+  void StartTimer();
+  void OnTimer(std::uint64_t batch_id);
+
+  /// Runs the batches sent by `FlushIfPossible()`, in a thread of `workers_`.
+  void Worker();
+
+  /// Runs a batch, blocking until its `BatchWrite` stream completes.
+  void RunBatch(Batch batch);
+
+  /**
+   * Try to move groups waiting in `pending_groups_` to the current batch, and
+   * send the batches that should be sent.
+   *
+   * @return the admission promises of the newly admitted groups.
+   */
+  std::vector<AdmissionPromise> TryAdmit();
+
+  /// Append @p group to the current batch.
+  void Admit(PendingGroup group);
+
+  /**
+   * Satisfies passed admission promises and potentially the promises of no more
+   * pending requests. Unlocks `lk`.
+   */
+  void SatisfyPromises(std::vector<AdmissionPromise>,
+                       std::unique_lock<std::mutex>& lk);
+
+  Client client_;
+  CompletionQueue cq_;
+  Options opts_;
+  std::size_t const max_mutations_per_batch_;
+  std::size_t const max_bytes_per_batch_;
+  std::size_t const max_batches_;
+  std::size_t const max_outstanding_bytes_;
+  std::chrono::milliseconds const flush_interval_;
+
+  std::mutex mu_;
+  /// Num batches sent but not completed.
+  std::size_t num_outstanding_batches_ = 0;
+  /// Size of admitted but uncompleted groups.
+  std::size_t outstanding_size_ = 0;
+  /// Number of uncompleted groups (including not admitted).
+  std::size_t num_requests_pending_ = 0;
+  std::uint64_t next_batch_id_ = 0;
+  /// The flush timer of the current batch, cancelled when the batch is sent.
+  future<void> timer_;
+  /// Number of timers that did not run their callback.
+  std::size_t num_outstanding_timers_ = 0;
+  /// Currently constructed batch of mutation groups.
+  Batch cur_batch_;
+  /// The groups which have not been admitted yet.
+  std::queue<PendingGroup> pending_groups_;
+  /// Satisfied by `AsyncWaitForNoPendingRequests()`.
+  std::vector<NoMorePendingPromise> no_more_pending_promises_;
+  /// The batches sent, but not yet picked up by a worker.
+  std::queue<Batch> sent_batches_;
+  /// Signaled when a batch is sent, or when the batcher is destroyed.
+  std::condition_variable sent_cv_;
+  bool shutdown_ = false;
+  /// Started on demand, never more than `max_batches_`.
+  std::vector<std::thread> workers_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_MUTATION_BATCHER_H
@@ -0,0 +1,279 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/mutation_batcher.h"
+#include "google/cloud/mocks/mock_stream_range.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/spanner/options.h"
+#include "google/cloud/spanner/timestamp.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/time/time.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::testing_util::IsOkAndHolds;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::Return;
+using ::testing::SizeIs;
+
+// Each of these mutations counts as 2 mutations.
+Mutation MakeMutation(std::int64_t key) {
+  return MakeInsertOrUpdateMutation("table", {"key", "value"}, key,
+                                    std::string("value"));
+}
+
+Timestamp MakeTestTimestamp(std::int64_t seconds) {
+  return MakeTimestamp(absl::FromUnixSeconds(seconds)).value();
+}
+
+class MutationBatcherTest : public ::testing::Test {
+ protected:
+  MutationBatcherTest() : conn_(std::make_shared<MockConnection>()) {
+    EXPECT_CALL(*conn_, options()).WillRepeatedly(Return(Options{}));
+  }
+
+  ~MutationBatcherTest() override {
+    cq_.Shutdown();
+    runner_.join();
+  }
+
+  static Options TestOptions() {
+    return Options{}.set<MutationBatcherFlushIntervalOption>(
+        std::chrono::hours(1));
+  }
+
+  std::shared_ptr<MockConnection> conn_;
+  CompletionQueue cq_;
+  // A single thread: the batches must not block the completion queue.
+  std::thread runner_{[this] { cq_.Run(); }};
+};
+
+TEST_F(MutationBatcherTest, FansOutGroupResults) {
+  auto const ts = MakeTestTimestamp(1);
+  EXPECT_CALL(*conn_, BatchWrite)
+      .WillOnce([&](Connection::BatchWriteParams const& p) {
+        EXPECT_THAT(p.mutation_groups, SizeIs(3));
+        return mocks::MakeStreamRange<BatchedCommitResult>(
+            {{{0, 2}, ts},
+             {{1}, Status(StatusCode::kFailedPrecondition, "uh-oh")}});
+      });
+
+  MutationBatcher batcher(Client(conn_), cq_, TestOptions());
+  auto r0 = batcher.AsyncApply(MakeMutation(0));
+  auto r1 = batcher.AsyncApply(Mutations{MakeMutation(1), MakeMutation(2)});
+  auto r2 = batcher.AsyncApply(MakeMutation(3));
+  r0.first.get();
+  r1.first.get();
+  r2.first.get();
+
+  batcher.AsyncWaitForNoPendingRequests().get();
+  EXPECT_THAT(r0.second.get(), IsOkAndHolds(ts));
+  EXPECT_THAT(r1.second.get(), StatusIs(StatusCode::kFailedPrecondition));
+  EXPECT_THAT(r2.second.get(), IsOkAndHolds(ts));
+}
+
+TEST_F(MutationBatcherTest, RejectsInvalidGroups) {
+  EXPECT_CALL(*conn_, BatchWrite).Times(0);
+
+  MutationBatcher batcher(
+      Client(conn_), cq_,
+      TestOptions()
+          .set<MutationBatcherMaxMutationsPerBatchOption>(3)
+          .set<MutationBatcherMaxBytesPerBatchOption>(1024));
+  auto empty = batcher.AsyncApply(Mutations{});
+  auto too_many =
+      batcher.AsyncApply(Mutations{MakeMutation(0), MakeMutation(1)});
+  auto too_large = batcher.AsyncApply(MakeInsertOrUpdateMutation(
+      "table", {"key", "value"}, 0, std::string(2048, 'x')));
+
+  for (auto* r : {&empty, &too_many, &too_large}) {
+    EXPECT_TRUE(r->first.is_ready());
+    EXPECT_THAT(r->second.get(), StatusIs(StatusCode::kInvalidArgument));
+  }
+  EXPECT_TRUE(batcher.AsyncWaitForNoPendingRequests().is_ready());
+}
+
+TEST_F(MutationBatcherTest, RejectsGroupsOverOutstandingBytes) {
+  auto const ts = MakeTestTimestamp(3);
+  EXPECT_CALL(*conn_, BatchWrite)
+      .WillOnce([&](Connection::BatchWriteParams const& p) {
+        EXPECT_THAT(p.mutation_groups, SizeIs(1));
+        return mocks::MakeStreamRange<BatchedCommitResult>({{{0}, ts}});
+      });
+
+  MutationBatcher batcher(
+      Client(conn_), cq_,
+      TestOptions()
+          .set<MutationBatcherMaxBytesPerBatchOption>(4096)
+          .set<MutationBatcherMaxOutstandingBytesOption>(1024));
+  auto too_large = batcher.AsyncApply(MakeInsertOrUpdateMutation(
+      "table", {"key", "value"}, 0, std::string(2048, 'x')));
+  EXPECT_TRUE(too_large.first.is_ready());
+  EXPECT_THAT(too_large.second.get(), StatusIs(StatusCode::kInvalidArgument));
+
+  // The rejected group does not block the groups after it.
+  auto r = batcher.AsyncApply(MakeMutation(0));
+  r.first.get();
+  batcher.AsyncWaitForNoPendingRequests().get();
+  EXPECT_THAT(r.second.get(), IsOkAndHolds(ts));
+}
+
+TEST_F(MutationBatcherTest, FlushesFullBatches) {
+  auto const ts = MakeTestTimestamp(2);
+  EXPECT_CALL(*conn_, BatchWrite)
+      .Times(2)
+      .WillRepeatedly([&](Connection::BatchWriteParams const& p) {
+        EXPECT_THAT(p.mutation_groups, SizeIs(1));
+        return mocks::MakeStreamRange<BatchedCommitResult>({{{0}, ts}});
+      });
+
+  MutationBatcher batcher(
+      Client(conn_), cq_,
+      TestOptions().set<MutationBatcherMaxMutationsPerBatchOption>(2));
+  auto r0 = batcher.AsyncApply(MakeMutation(0));
+  auto r1 = batcher.AsyncApply(MakeMutation(1));
+  // The batches are full, they do not wait for the flush interval.
+  EXPECT_THAT(r0.second.get(), IsOkAndHolds(ts));
+  EXPECT_THAT(r1.second.get(), IsOkAndHolds(ts));
+  batcher.AsyncWaitForNoPendingRequests().get();
+}
+
+TEST_F(MutationBatcherTest, FlushesOnTimer) {
+  auto const ts = MakeTestTimestamp(3);
+  EXPECT_CALL(*conn_, BatchWrite)
+      .WillOnce([&](Connection::BatchWriteParams const& p) {
+        EXPECT_THAT(p.mutation_groups, SizeIs(2));
+        return mocks::MakeStreamRange<BatchedCommitResult>({{{0, 1}, ts}});
+      });
+
+  MutationBatcher batcher(
+      Client(conn_), cq_,
+      Options{}.set<MutationBatcherFlushIntervalOption>(
+          std::chrono::milliseconds(10)));
+  auto r0 = batcher.AsyncApply(MakeMutation(0));
+  auto r1 = batcher.AsyncApply(MakeMutation(1));
+  EXPECT_THAT(r0.second.get(), IsOkAndHolds(ts));
+  EXPECT_THAT(r1.second.get(), IsOkAndHolds(ts));
+  batcher.AsyncWaitForNoPendingRequests().get();
+}
+
+TEST_F(MutationBatcherTest, StreamErrorFailsRemainingGroups) {
+  auto const ts = MakeTestTimestamp(4);
+  EXPECT_CALL(*conn_, BatchWrite)
+      .WillOnce([&](Connection::BatchWriteParams const&) {
+        return mocks::MakeStreamRange<BatchedCommitResult>(
+            {{{1}, ts}}, Status(StatusCode::kUnavailable, "try-again"));
+      })
+      .WillOnce([&](Connection::BatchWriteParams const&) {
+        // The stream ends without reporting the group.
+        return mocks::MakeStreamRange<BatchedCommitResult>({});
+      });
+
+  MutationBatcher batcher(Client(conn_), cq_, TestOptions());
+  auto r0 = batcher.AsyncApply(MakeMutation(0));
+  auto r1 = batcher.AsyncApply(MakeMutation(1));
+  auto r2 = batcher.AsyncApply(MakeMutation(2));
+  batcher.AsyncWaitForNoPendingRequests().get();
+  EXPECT_THAT(r0.second.get(), StatusIs(StatusCode::kUnavailable));
+  EXPECT_THAT(r1.second.get(), IsOkAndHolds(ts));
+  EXPECT_THAT(r2.second.get(), StatusIs(StatusCode::kUnavailable));
+
+  auto r3 = batcher.AsyncApply(MakeMutation(3));
+  batcher.AsyncWaitForNoPendingRequests().get();
+  EXPECT_THAT(r3.second.get(), StatusIs(StatusCode::kUnknown));
+}
+
+TEST_F(MutationBatcherTest, AdmissionWaitsForOutstandingBatches) {
+  auto const ts = MakeTestTimestamp(5);
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  EXPECT_CALL(*conn_, BatchWrite)
+      .Times(3)
+      .WillRepeatedly([&](Connection::BatchWriteParams const&) {
+        released.wait();
+        return mocks::MakeStreamRange<BatchedCommitResult>({{{0}, ts}});
+      });
+
+  MutationBatcher batcher(
+      Client(conn_), cq_,
+      TestOptions()
+          .set<MutationBatcherMaxMutationsPerBatchOption>(2)
+          .set<MutationBatcherMaxBatchesOption>(1));
+  // Sent immediately, as the batch is full.
+  auto r0 = batcher.AsyncApply(MakeMutation(0));
+  // Admitted into a full batch, waiting for the first one.
+  auto r1 = batcher.AsyncApply(MakeMutation(1));
+  // Does not fit in the current batch.
+  auto r2 = batcher.AsyncApply(MakeMutation(2));
+  EXPECT_TRUE(r0.first.is_ready());
+  EXPECT_TRUE(r1.first.is_ready());
+  EXPECT_FALSE(r2.first.is_ready());
+
+  release.set_value();
+  r2.first.get();
+  batcher.AsyncWaitForNoPendingRequests().get();
+  EXPECT_THAT(r0.second.get(), IsOkAndHolds(ts));
+  EXPECT_THAT(r1.second.get(), IsOkAndHolds(ts));
+  EXPECT_THAT(r2.second.get(), IsOkAndHolds(ts));
+}
+
+TEST_F(MutationBatcherTest, BlockedBatchesDoNotStallTimers) {
+  auto const ts = MakeTestTimestamp(6);
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  EXPECT_CALL(*conn_, BatchWrite)
+      .Times(2)
+      .WillRepeatedly([&](Connection::BatchWriteParams const& p) {
+        auto proto = p.mutation_groups.at(0).at(0).as_proto();
+        if (proto.insert_or_update().values(0).values(0).string_value() ==
+            "0") {
+          released.wait();
+        }
+        return mocks::MakeStreamRange<BatchedCommitResult>({{{0}, ts}});
+      });
+
+  MutationBatcher batcher(
+      Client(conn_), cq_,
+      Options{}
+          .set<MutationBatcherMaxMutationsPerBatchOption>(3)
+          .set<MutationBatcherFlushIntervalOption>(
+              std::chrono::milliseconds(10)));
+  auto r0 = batcher.AsyncApply(MakeMutation(0));
+  // Does not fit with `r0`, so `r0` is sent and blocks in `BatchWrite`.
+  auto r1 = batcher.AsyncApply(MakeMutation(1));
+  // `r1` is sent by the flush timer, which runs on the only completion queue
+  // thread.
+  EXPECT_THAT(r1.second.get(), IsOkAndHolds(ts));
+  EXPECT_FALSE(r0.second.is_ready());
+
+  release.set_value();
+  EXPECT_THAT(r0.second.get(), IsOkAndHolds(ts));
+  batcher.AsyncWaitForNoPendingRequests().get();
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
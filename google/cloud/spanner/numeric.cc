@@ -19,8 +19,10 @@
 #include <cerrno>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <iomanip>
 #include <locale>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -114,6 +116,130 @@ Status OutOfRange(std::string message, internal::ErrorInfoBuilder info) {
   return internal::OutOfRangeError(std::move(message), std::move(info));
 }
 
+// 10^kDecimalUnitsScale, and the largest magnitude of any units.
+auto constexpr kUnitsPerOne = 1000000000;
+absl::uint128 const kMaxUnits =
+    absl::MakeUint128(0x4b3b4ca85a86c47aULL, 0x098a223fffffffffULL);
+
+absl::uint128 Magnitude(absl::int128 units) {
+  return units < 0 ? -absl::uint128(units) : absl::uint128(units);
+}
+
+// Negates `mag`, which is at most `kMaxUnits`, when `negative`.
+absl::int128 WithSign(bool negative, absl::uint128 mag) {
+  auto const units = absl::int128(mag);
+  return negative ? -units : units;
+}
+
+// Appends the decimal digits of `v`, at least `width` of them. `v` must be
+// less than 10^38.
+void AppendDigits(std::string& s, absl::uint128 v, std::size_t width) {
+  char buf[40];
+  char* p = buf + sizeof(buf);
+  auto prepend = [&p](std::uint64_t v, std::size_t width) {
+    while (v != 0 || width != 0) {
+      *--p = static_cast<char>('0' + v % 10);
+      v /= 10;
+      if (width != 0) --width;
+    }
+  };
+  // Avoid 128-bit divisions for each digit.
+  auto constexpr kChunk = std::uint64_t{10000000000000000000U};  // 10^19
+  if (absl::Uint128High64(v) != 0) {
+    prepend(static_cast<std::uint64_t>(v % kChunk), 19);
+    v /= kChunk;
+    width = width > 19 ? width - 19 : 0;
+  }
+  prepend(absl::Uint128Low64(v), width);
+  s.append(p, buf + sizeof(buf));
+}
+
+// Powers of 10 up to the largest in a `std::uint64_t`.
+std::size_t constexpr kMaxDigits64 = 19;
+std::uint64_t constexpr kPow10[kMaxDigits64 + 1] = {
+    1U,
+    10U,
+    100U,
+    1000U,
+    10000U,
+    100000U,
+    1000000U,
+    10000000U,
+    100000000U,
+    1000000000U,
+    10000000000U,
+    100000000000U,
+    1000000000000U,
+    10000000000000U,
+    100000000000000U,
+    1000000000000000U,
+    10000000000000000U,
+    100000000000000000U,
+    1000000000000000000U,
+    10000000000000000000U,
+};
+
+// The value of the `n` (at most 19) decimal digits at `p`.
+std::uint64_t ParseDigits(char const* p, std::size_t n) {
+  std::uint64_t v = 0;
+  for (; n >= 8; p += 8, n -= 8) {
+    // Convert 8 digits at once, combining adjacent pairs of digits, then
+    // pairs of those, and so on. The loop compiles to a single load.
+    std::uint64_t w = 0;
+    for (int i = 0; i != 8; ++i) {
+      w |= std::uint64_t{static_cast<unsigned char>(p[i])} << (8 * i);
+    }
+    w = ((w & 0x0F0F0F0F0F0F0F0FU) * 2561) >> 8;
+    w = ((w & 0x00FF00FF00FF00FFU) * 6553601) >> 16;
+    w = ((w & 0x0000FFFF0000FFFFU) * 42949672960001U) >> 32;
+    v = v * 100000000U + w;
+  }
+  for (; n != 0; ++p, --n) v = v * 10 + static_cast<std::uint64_t>(*p - '0');
+  return v;
+}
+
+// Splits a canonical representation into its sign, integer, and fractional
+// parts (the latter without the decimal point).
+void SplitRep(absl::string_view rep, bool& negative,
+              absl::string_view& int_part, absl::string_view& frac_part) {
+  negative = !rep.empty() && rep.front() == '-';
+  if (negative) rep.remove_prefix(1);
+  auto const dp = rep.find('.');
+  int_part = rep.substr(0, dp);
+  frac_part = dp == absl::string_view::npos ? absl::string_view()
+                                            : rep.substr(dp + 1);
+}
+
+StatusOr<absl::int128> MultiplyUnits(absl::int128 a, absl::int128 b,
+                                     bool exact) {
+  // With a = qa * S + ra and b = qb * S + rb, where S is `kUnitsPerOne`,
+  // (a * b) / S = qa * qb * S + qa * rb + ra * qb + (ra * rb) / S.
+  auto const ma = Magnitude(a);
+  auto const mb = Magnitude(b);
+  auto const qa = ma / kUnitsPerOne;
+  auto const ra = ma % kUnitsPerOne;
+  auto const qb = mb / kUnitsPerOne;
+  auto const rb = mb % kUnitsPerOne;
+  if (qb != 0 && qa > (kMaxUnits / kUnitsPerOne) / qb) {
+    return DecimalRangeError("*");
+  }
+  auto const low = ra * rb;
+  absl::uint128 mag = qa * qb * kUnitsPerOne;
+  for (auto const term : {qa * rb, ra * qb, low / kUnitsPerOne}) {
+    // Each term, and `mag`, is at most `kMaxUnits`, so this cannot overflow.
+    mag += term;
+    if (mag > kMaxUnits) return DecimalRangeError("*");
+  }
+  if (exact && low % kUnitsPerOne != 0) {
+    return OutOfRange(
+        "Decimal operator* result has more than 9 fractional digits",
+        GCP_ERROR_INFO());
+  }
+  if (low % kUnitsPerOne >= kUnitsPerOne / 2) ++mag;
+  if (mag > kMaxUnits) return DecimalRangeError("*");
+  return WithSign((a < 0) != (b < 0), mag);
+}
+
 }  // namespace
 
 Status DataLoss(std::string message) {
@@ -241,6 +367,128 @@ StatusOr<std::string> MakeDecimalRep(double d) {
   return rep;
 }
 
+bool ParseDecimalUnits(std::string const& rep, absl::int128& units) {
+  if (rep.empty() || rep.front() == 'N') return false;  // "NaN"
+  bool negative;
+  absl::string_view int_part;
+  absl::string_view frac_part;
+  SplitRep(rep, negative, int_part, frac_part);
+  if (int_part.size() > kDecimalUnitsDigits - kDecimalUnitsScale ||
+      frac_part.size() > kDecimalUnitsScale) {
+    return false;
+  }
+  // The digits of the units, which are at most 38, so the high 19 digits
+  // and the low 19 digits are each parsed with 64-bit arithmetic.
+  char digits[kDecimalUnitsDigits];
+  auto* p = std::copy(int_part.begin(), int_part.end(), digits);
+  p = std::copy(frac_part.begin(), frac_part.end(), p);
+  p = std::fill_n(p, kDecimalUnitsScale - frac_part.size(), '0');
+  auto const n = static_cast<std::size_t>(p - digits);
+  auto const lo_n = (std::min)(n, kMaxDigits64);
+  auto const hi = ParseDigits(digits, n - lo_n);
+  auto const lo = ParseDigits(digits + n - lo_n, lo_n);
+  units = WithSign(negative, absl::uint128(hi) * kPow10[lo_n] + lo);
+  return true;
+}
+
+std::string DecimalRepFromUnits(absl::int128 units) {
+  auto const mag = Magnitude(units);
+  std::string rep;
+  if (units < 0) rep.push_back('-');
+  AppendDigits(rep, mag / kUnitsPerOne, 1);
+  auto frac = static_cast<std::uint32_t>(mag % kUnitsPerOne);
+  if (frac != 0) {
+    auto width = kDecimalUnitsScale;
+    for (; frac % 10 == 0; frac /= 10) --width;
+    rep.push_back('.');
+    AppendDigits(rep, frac, width);
+  }
+  return rep;
+}
+
+StatusOr<absl::int128> AddDecimalUnits(absl::int128 a, absl::int128 b) {
+  auto const max = absl::int128(kMaxUnits);
+  if ((b > 0 && a > max - b) || (b < 0 && a < -max - b)) {
+    return DecimalRangeError("+");
+  }
+  return a + b;
+}
+
+StatusOr<absl::int128> SubtractDecimalUnits(absl::int128 a, absl::int128 b) {
+  auto const max = absl::int128(kMaxUnits);
+  if ((b < 0 && a > max + b) || (b > 0 && a < -max + b)) {
+    return DecimalRangeError("-");
+  }
+  return a - b;
+}
+
+void FormatDecimalUnits(absl::int128 units, std::string& rep,
+                        std::atomic<bool>& has_rep) {
+  // Only the first `ToString()` of each value formatted from units gets here,
+  // so a single mutex suffices.
+  static auto* const kMu = new std::mutex;
+  std::lock_guard<std::mutex> lk(*kMu);
+  if (has_rep.load(std::memory_order_relaxed)) return;
+  rep = DecimalRepFromUnits(units);
+  has_rep.store(true, std::memory_order_release);
+}
+
+StatusOr<absl::int128> MultiplyDecimalUnits(absl::int128 a, absl::int128 b) {
+  return MultiplyUnits(a, b, false);
+}
+
+StatusOr<absl::int128> MultiplyDecimalUnitsExact(absl::int128 a,
+                                                 absl::int128 b) {
+  return MultiplyUnits(a, b, true);
+}
+
+int CompareDecimalRep(std::string const& a, std::string const& b) {
+  auto const a_nan = a == "NaN";
+  auto const b_nan = b == "NaN";
+  if (a_nan || b_nan) return static_cast<int>(a_nan) - static_cast<int>(b_nan);
+  bool a_neg;
+  bool b_neg;
+  absl::string_view a_int;
+  absl::string_view b_int;
+  absl::string_view a_frac;
+  absl::string_view b_frac;
+  SplitRep(a, a_neg, a_int, a_frac);
+  SplitRep(b, b_neg, b_int, b_frac);
+  if (a_neg != b_neg) return a_neg ? -1 : 1;
+  // Compare the magnitudes, which have no leading or trailing zeros.
+  int cmp = 0;
+  if (a_int.size() != b_int.size()) {
+    cmp = a_int.size() < b_int.size() ? -1 : 1;
+  } else if (a_int != b_int) {
+    cmp = a_int < b_int ? -1 : 1;
+  } else if (a_frac != b_frac) {
+    cmp = a_frac < b_frac ? -1 : 1;
+  }
+  return a_neg ? -cmp : cmp;
+}
+
+Status DecimalRangeError(char const* op) {
+  return OutOfRange(std::string("Decimal operator") + op +
+                        " operand or result outside the range of +/-" +
+                        "(10^29 - 10^-9)",
+                    GCP_ERROR_INFO());
+}
+
+bool DecimalUnitsToDouble(absl::int128 units, double& d) {
+  // Integers up to 2^53 are exactly representable as a double, so a single
+  // (correctly rounded) division yields the closest double.
+  auto constexpr kExact = std::int64_t{1} << 53;
+  if (units >= -kExact && units <= kExact) {
+    d = static_cast<double>(units) / kUnitsPerOne;
+    return true;
+  }
+  if (units % kUnitsPerOne != 0) return false;
+  auto const q = units / kUnitsPerOne;
+  if (q < -kExact || q > kExact) return false;
+  d = static_cast<double>(q);
+  return true;
+}
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner_internal
 
@@ -21,6 +21,7 @@
 #include "absl/numeric/int128.h"
 #include "absl/strings/string_view.h"
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <deque>
@@ -59,6 +60,35 @@ namespace spanner_internal {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 template <spanner::DecimalMode Mode>
 StatusOr<spanner::Decimal<Mode>> MakeDecimal(std::string);
+struct DecimalFriend;
+
+// The binary representation of a `Decimal`: its value scaled by
+// 10^kDecimalUnitsScale, when that is an integer with at most
+// kDecimalUnitsDigits digits.
+std::size_t constexpr kDecimalUnitsScale = 9;
+std::size_t constexpr kDecimalUnitsDigits = 38;
+
+// Parses the units of a canonical decimal representation, returning false
+// if the value (or NaN) has no binary representation.
+bool ParseDecimalUnits(std::string const& rep, absl::int128& units);
+// The canonical decimal representation of the given units.
+std::string DecimalRepFromUnits(absl::int128 units);
+// Sets @p rep to `DecimalRepFromUnits(units)`, then @p has_rep, unless
+// another thread has already done so.
+void FormatDecimalUnits(absl::int128 units, std::string& rep,
+                        std::atomic<bool>& has_rep);
+// Arithmetic on units, failing when the result has no binary representation.
+// `MultiplyDecimalUnits()` rounds halfway cases away from zero, while
+// `MultiplyDecimalUnitsExact()` fails if the product needs rounding.
+StatusOr<absl::int128> AddDecimalUnits(absl::int128 a, absl::int128 b);
+StatusOr<absl::int128> SubtractDecimalUnits(absl::int128 a, absl::int128 b);
+StatusOr<absl::int128> MultiplyDecimalUnits(absl::int128 a, absl::int128 b);
+StatusOr<absl::int128> MultiplyDecimalUnitsExact(absl::int128 a,
+                                                 absl::int128 b);
+// Compares the canonical representations of two decimal values, ordering NaN
+// after all other values.
+int CompareDecimalRep(std::string const& a, std::string const& b);
+Status DecimalRangeError(char const* op);
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner_internal
 
@@ -75,8 +105,16 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
  * the `ToString()` member function, and the `ToDouble()`/`ToInteger()`
  * free functions.
  *
- * `Decimal` values can be copied/assigned/moved, compared for equality, and
- * streamed.
+ * `Decimal` values can be copied/assigned/moved, compared, added,
+ * subtracted, multiplied, and streamed.
+ *
+ * Comparisons, arithmetic, and the `ToInteger()` conversions use a binary
+ * fixed-point representation of any value with at most 29 integer and 9
+ * fractional digits (that is, every `Numeric` value). Values built from
+ * strings parse it on each such use, while the results of arithmetic, and
+ * values built from integers, keep it, and are only formatted as a string
+ * by the first `ToString()`. Arithmetic fails with `kOutOfRange` when either
+ * operand, or the result, is outside that range, even for `PgNumeric`.
  *
  * @par Example
  *
@@ -107,14 +145,41 @@ class Decimal {
   ///@}
 
   /// A zero value.
-  Decimal() : rep_("0") {}
+  Decimal() : rep_("0"), units_(0), has_units_(true), has_rep_(true) {}
 
   /// @name Regular value type, supporting copy, assign, move.
   ///@{
-  Decimal(Decimal&&) noexcept = default;
-  Decimal& operator=(Decimal&&) noexcept = default;
-  Decimal(Decimal const&) = default;
-  Decimal& operator=(Decimal const&) = default;
+  Decimal(Decimal&& rhs) noexcept
+      : units_(rhs.units_), has_units_(rhs.has_units_) {
+    if (rhs.has_rep_.load(std::memory_order_acquire)) {
+      rep_ = std::move(rhs.rep_);
+      has_rep_.store(true, std::memory_order_relaxed);
+    }
+  }
+  Decimal& operator=(Decimal&& rhs) noexcept {
+    units_ = rhs.units_;
+    has_units_ = rhs.has_units_;
+    auto const has_rep = rhs.has_rep_.load(std::memory_order_acquire);
+    if (has_rep) rep_ = std::move(rhs.rep_);
+    has_rep_.store(has_rep, std::memory_order_relaxed);
+    return *this;
+  }
+  Decimal(Decimal const& rhs)
+      : units_(rhs.units_), has_units_(rhs.has_units_) {
+    if (rhs.has_rep_.load(std::memory_order_acquire)) {
+      rep_ = rhs.rep_;
+      has_rep_.store(true, std::memory_order_relaxed);
+    }
+  }
+  Decimal& operator=(Decimal const& rhs) {
+    if (this == &rhs) return *this;
+    units_ = rhs.units_;
+    has_units_ = rhs.has_units_;
+    auto const has_rep = rhs.has_rep_.load(std::memory_order_acquire);
+    if (has_rep) rep_ = rhs.rep_;
+    has_rep_.store(has_rep, std::memory_order_relaxed);
+    return *this;
+  }
   ///@}
 
   /**
@@ -129,8 +194,11 @@ class Decimal {
    * Note: The string never includes an exponent field.
    */
   ///@{
-  std::string const& ToString() const& { return rep_; }
-  std::string&& ToString() && { return std::move(rep_); }
+  std::string const& ToString() const& { return Rep(); }
+  std::string&& ToString() && {
+    Rep();
+    return std::move(rep_);
+  }
   ///@}
 
   /// @name Relational operators
@@ -141,11 +209,50 @@ class Decimal {
     // in kPostgreSQL mode, but unlike typical NaN implementations,
     // PostgreSQL considers NaN values as equal, so that they may be
     // sorted. We do the same.
-    return a.rep_ == b.rep_;
+    if (a.has_units_ && b.has_units_) return a.units_ == b.units_;
+    return a.Rep() == b.Rep();
   }
   friend bool operator!=(Decimal const& a, Decimal const& b) {
     return !(a == b);
   }
+  /// Like PostgreSQL, NaN values are ordered after all other values.
+  friend bool operator<(Decimal const& a, Decimal const& b) {
+    return Compare(a, b) < 0;
+  }
+  friend bool operator<=(Decimal const& a, Decimal const& b) {
+    return Compare(a, b) <= 0;
+  }
+  friend bool operator>(Decimal const& a, Decimal const& b) {
+    return Compare(a, b) > 0;
+  }
+  friend bool operator>=(Decimal const& a, Decimal const& b) {
+    return Compare(a, b) >= 0;
+  }
+  ///@}
+
+  /**
+   * @name Arithmetic operators
+   *
+   * The result of a `Numeric` multiplication is rounded to `kFracPrecision`
+   * (that is, 9) digits after the decimal point, with halfway cases rounding
+   * away from zero. A `PgNumeric` multiplication is exact, and fails with
+   * `kOutOfRange` when the product has more than 9 fractional digits.
+   * Any operation with a NaN operand yields NaN.
+   */
+  ///@{
+  friend StatusOr<Decimal> operator+(Decimal const& a, Decimal const& b) {
+    return Apply(a, b, &spanner_internal::AddDecimalUnits, "+");
+  }
+  friend StatusOr<Decimal> operator-(Decimal const& a, Decimal const& b) {
+    return Apply(a, b, &spanner_internal::SubtractDecimalUnits, "-");
+  }
+  friend StatusOr<Decimal> operator*(Decimal const& a, Decimal const& b) {
+    return Apply(a, b,
+                 kFracPrecision == spanner_internal::kDecimalUnitsScale
+                     ? &spanner_internal::MultiplyDecimalUnits
+                     : &spanner_internal::MultiplyDecimalUnitsExact,
+                 "*");
+  }
   ///@}
 
   /// Outputs string representation of the `Decimal` to the provided stream.
@@ -160,10 +267,64 @@ class Decimal {
       GOOGLE_CLOUD_CPP_NS::
 #endif
           MakeDecimal(std::string);
+  friend struct spanner_internal::DecimalFriend;
+
+  // The units of values built from strings are only parsed when needed, so
+  // the construction is no more expensive than validating the string.
+  explicit Decimal(std::string rep) : rep_(std::move(rep)), has_rep_(true) {}
+
+  // Likewise, values built from units are only formatted when needed.
+  struct UnitsTag {};
+  Decimal(UnitsTag, absl::int128 units) : units_(units), has_units_(true) {}
+
+  // The canonical representation, formatted from `units_` unless it is
+  // already known.
+  std::string const& Rep() const {
+    if (!has_rep_.load(std::memory_order_acquire)) {
+      spanner_internal::FormatDecimalUnits(units_, rep_, has_rep_);
+    }
+    return rep_;
+  }
 
-  explicit Decimal(std::string rep) : rep_(std::move(rep)) {}
+  // Only values without units can be NaN, and those always have `rep_`.
+  bool IsNaN() const { return kHasNaN && !has_units_ && rep_ == "NaN"; }
 
-  std::string rep_;  // a valid and canonical decimal representation
+  // The value * 10^kDecimalUnitsScale, parsed from `rep_` unless it is
+  // already known. Returns false when the value has no binary representation.
+  bool Units(absl::int128& units) const {
+    if (has_units_) {
+      units = units_;
+      return true;
+    }
+    return spanner_internal::ParseDecimalUnits(rep_, units);
+  }
+
+  static int Compare(Decimal const& a, Decimal const& b) {
+    absl::int128 ua;
+    absl::int128 ub;
+    if (a.Units(ua) && b.Units(ub)) return ua < ub ? -1 : (ub < ua ? 1 : 0);
+    return spanner_internal::CompareDecimalRep(a.Rep(), b.Rep());
+  }
+
+  using UnitsOp = StatusOr<absl::int128> (*)(absl::int128, absl::int128);
+  static StatusOr<Decimal> Apply(Decimal const& a, Decimal const& b,
+                                 UnitsOp op, char const* name) {
+    if (a.IsNaN()) return a;
+    if (b.IsNaN()) return b;
+    absl::int128 ua;
+    absl::int128 ub;
+    if (!a.Units(ua) || !b.Units(ub)) {
+      return spanner_internal::DecimalRangeError(name);
+    }
+    auto units = op(ua, ub);
+    if (!units) return std::move(units).status();
+    return Decimal(UnitsTag{}, *units);
+  }
+
+  mutable std::string rep_;  // a valid and canonical decimal representation
+  absl::int128 units_ = 0;   // the value * 10^kDecimalUnitsScale
+  bool has_units_ = false;   // whether `units_` is known
+  mutable std::atomic<bool> has_rep_{false};  // whether `rep_` is known
 };
 
 template <DecimalMode Mode>
@@ -193,6 +354,62 @@ StatusOr<std::string> MakeDecimalRep(std::string s, bool has_nan,
                                      std::size_t frac_prec);
 StatusOr<std::string> MakeDecimalRep(double d);
 
+struct DecimalFriend {
+  template <spanner::DecimalMode Mode>
+  static spanner::Decimal<Mode> FromUnits(absl::int128 units) {
+    return spanner::Decimal<Mode>(typename spanner::Decimal<Mode>::UnitsTag{},
+                                  units);
+  }
+
+  // Returns false when the value has no binary representation.
+  template <spanner::DecimalMode Mode>
+  static bool Units(spanner::Decimal<Mode> const& d, absl::int128& units) {
+    return d.Units(units);
+  }
+
+  // Returns nullptr unless the units are known without parsing the value.
+  template <spanner::DecimalMode Mode>
+  static absl::int128 const* KnownUnits(spanner::Decimal<Mode> const& d) {
+    return d.has_units_ ? &d.units_ : nullptr;
+  }
+};
+
+// `ToDouble()` of a value with the given units, if it can be computed
+// exactly from the units.
+bool DecimalUnitsToDouble(absl::int128 units, double& d);
+
+// The units of the integer @p i, if it is not too large for them.
+template <typename T>
+bool IntegerToDecimalUnits(T i, absl::int128& units) {
+  // Any 64-bit integer (at most 20 digits) has units.
+  if (std::numeric_limits<T>::digits > 64) return false;
+  units = absl::int128(i) * 1000000000;
+  return true;
+}
+
+// `ToInteger(d)` from the units of @p d, rounding halfway cases away from
+// zero. Returns false when the slow path must be used, either because the
+// value has no units, or to produce the error.
+template <typename T, spanner::DecimalMode Mode>
+bool DecimalToInteger(spanner::Decimal<Mode> const& d, T& v) {
+  if (std::numeric_limits<T>::digits > 64) return false;
+  absl::int128 units;
+  if (!DecimalFriend::Units(d, units)) return false;
+  // Like the slow path, reject all negative values for unsigned types.
+  if (!std::numeric_limits<T>::is_signed && units < 0) return false;
+  auto constexpr kScale = 1000000000;
+  auto q = units / kScale;
+  auto const r = units % kScale;
+  if (r >= kScale / 2) ++q;
+  if (r <= -kScale / 2) --q;
+  if (q < absl::int128((std::numeric_limits<T>::min)()) ||
+      q > absl::int128((std::numeric_limits<T>::max)())) {
+    return false;
+  }
+  v = static_cast<T>(q);
+  return true;
+}
+
 template <spanner::DecimalMode Mode>
 StatusOr<spanner::Decimal<Mode>> MakeDecimal(std::string s) {
   auto rep = MakeDecimalRep(std::move(s), spanner::Decimal<Mode>::kHasNaN,
@@ -261,6 +478,10 @@ template <typename T, DecimalMode Mode,
           /// @endcond
           >
 StatusOr<Decimal<Mode>> MakeDecimal(T i, int exponent = 0) {
+  absl::int128 units;
+  if (exponent == 0 && spanner_internal::IntegerToDecimalUnits(i, units)) {
+    return spanner_internal::DecimalFriend::FromUnits<Mode>(units);
+  }
   return spanner_internal::MakeDecimal<Mode>(spanner_internal::ToString(i),
                                              exponent);
 }
@@ -273,6 +494,11 @@ StatusOr<Decimal<Mode>> MakeDecimal(T i, int exponent = 0) {
  */
 template <DecimalMode Mode>
 double ToDouble(Decimal<Mode> const& d) {
+  // Parsing the units is not cheaper than `std::atof()`, so only use them if
+  // they are known.
+  double v;
+  auto const* units = spanner_internal::DecimalFriend::KnownUnits(d);
+  if (units && spanner_internal::DecimalUnitsToDouble(*units, v)) return v;
   return std::atof(d.ToString().c_str());
 }
 
@@ -303,6 +529,10 @@ template <typename T, DecimalMode Mode,
           >
 StatusOr<T> ToInteger(  // NOLINT(misc-no-recursion)
     Decimal<Mode> const& d, int exponent = 0) {
+  T fast;
+  if (exponent == 0 && spanner_internal::DecimalToInteger(d, fast)) {
+    return fast;
+  }
   std::string const& rep = d.ToString();
   if (exponent != 0) {
     auto const en = spanner_internal::MakeDecimal<Mode>(rep, exponent);
@@ -343,6 +573,10 @@ template <typename T, DecimalMode Mode,
           >
 StatusOr<T> ToInteger(  // NOLINT(misc-no-recursion)
     Decimal<Mode> const& d, int exponent = 0) {
+  T fast;
+  if (exponent == 0 && spanner_internal::DecimalToInteger(d, fast)) {
+    return fast;
+  }
   std::string const& rep = d.ToString();
   if (exponent != 0) {
     auto const en = spanner_internal::MakeDecimal<Mode>(rep, exponent);
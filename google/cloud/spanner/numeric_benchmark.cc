@@ -24,25 +24,28 @@ namespace spanner {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
 
-// Run on (96 X 2000.17 MHz CPU s)
+// Run on (1 X 2000 MHz CPU )
 // CPU Caches:
-//   L1 Data 32K (x48)
-//   L1 Instruction 32K (x48)
-//   L2 Unified 1024K (x48)
-//   L3 Unified 39424K (x2)
-// Load Average: 0.22, 1.93, 3.67
+//   L1 Data 48 KiB (x1)
+//   L1 Instruction 32 KiB (x1)
+//   L2 Unified 2048 KiB (x1)
+//   L3 Unified 107520 KiB (x1)
+// Load Average: 0.79, 0.81, 0.57
 // ------------------------------------------------------------------------
 // Benchmark                              Time             CPU   Iterations
 // ------------------------------------------------------------------------
-// BM_NumericFromStringCanonical       76.0 ns         76.0 ns      8999376
-// BM_NumericFromString                 369 ns          369 ns      1925749
-// BM_NumericFromDouble                2072 ns         2072 ns       340812
-// BM_NumericFromUnsigned               168 ns          168 ns      4151959
-// BM_NumericFromInteger                165 ns          165 ns      4238271
-// BM_NumericToString                 0.360 ns        0.360 ns   1000000000
-// BM_NumericToDouble                   115 ns          115 ns      6120955
-// BM_NumericToUnsigned                83.8 ns         83.8 ns      8466831
-// BM_NumericToInteger                 86.3 ns         86.3 ns      8092890
+// BM_NumericFromStringCanonical        139 ns          137 ns      6383830
+// BM_NumericFromString                 684 ns          675 ns      1020254
+// BM_NumericFromDouble                3044 ns         2984 ns       232525
+// BM_NumericFromUnsigned              93.7 ns         91.5 ns      8905030
+// BM_NumericFromInteger               95.8 ns         95.3 ns      7295935
+// BM_NumericToString                  32.5 ns         32.2 ns     21734837
+// BM_NumericToDouble                   153 ns          149 ns      4635386
+// BM_NumericToUnsigned                17.3 ns         17.0 ns     47297557
+// BM_NumericToInteger                 19.5 ns         19.3 ns     37344476
+// BM_NumericAdd                        394 ns          391 ns      1815450
+// BM_NumericMultiply                   459 ns          453 ns      1586502
+// BM_NumericCompare                    169 ns          155 ns      4475454
 
 void BM_NumericFromStringCanonical(benchmark::State& state) {
   std::string s = "99999999999999999999999999999.999999999";
@@ -121,6 +124,33 @@ void BM_NumericToInteger(benchmark::State& state) {
 }
 BENCHMARK(BM_NumericToInteger);
 
+void BM_NumericAdd(benchmark::State& state) {
+  Numeric a = MakeNumeric("12345678901234567890.123456789").value();
+  Numeric b = MakeNumeric("-98765432109876543210.987654321").value();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a + b);
+  }
+}
+BENCHMARK(BM_NumericAdd);
+
+void BM_NumericMultiply(benchmark::State& state) {
+  Numeric a = MakeNumeric("12345678901234.123456789").value();
+  Numeric b = MakeNumeric("-98765432109876.987654321").value();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a * b);
+  }
+}
+BENCHMARK(BM_NumericMultiply);
+
+void BM_NumericCompare(benchmark::State& state) {
+  Numeric a = MakeNumeric("99999999999999999999999999999.999999998").value();
+  Numeric b = MakeNumeric("99999999999999999999999999999.999999999").value();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a < b);
+  }
+}
+BENCHMARK(BM_NumericCompare);
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner
@@ -64,6 +64,96 @@ TEST(Numeric, RegularSemantics) {
 TEST(Numeric, RelationalOperators) {
   EXPECT_EQ(MakeNumeric(1).value(), MakeNumeric(1U).value());
   EXPECT_NE(MakeNumeric(-2).value(), MakeNumeric(2U).value());
+
+  auto const values = {"-99999.5", "-2", "-1.25", "-1.2", "0", "0.000000001",
+                       "1.2",      "1.25", "2",  "10",  "99999.5"};
+  for (auto const* a : values) {
+    for (auto const* b : values) {
+      auto const na = MakeNumeric(a).value();
+      auto const nb = MakeNumeric(b).value();
+      auto const da = std::stod(a);
+      auto const db = std::stod(b);
+      EXPECT_EQ(da < db, na < nb) << a << " < " << b;
+      EXPECT_EQ(da <= db, na <= nb) << a << " <= " << b;
+      EXPECT_EQ(da > db, na > nb) << a << " > " << b;
+      EXPECT_EQ(da >= db, na >= nb) << a << " >= " << b;
+      EXPECT_EQ(da == db, na == nb) << a << " == " << b;
+    }
+  }
+}
+
+TEST(Numeric, Arithmetic) {
+  auto n = [](char const* s) { return MakeNumeric(s).value(); };
+  EXPECT_EQ(n("3.75"), (n("1.5") + n("2.25")).value());
+  EXPECT_EQ(n("-0.75"), (n("1.5") - n("2.25")).value());
+  EXPECT_EQ(n("3.375"), (n("1.5") * n("2.25")).value());
+  EXPECT_EQ(n("-3.375"), (n("-1.5") * n("2.25")).value());
+  EXPECT_EQ(n("3.375"), (n("-1.5") * n("-2.25")).value());
+  EXPECT_EQ(n("0"), (n("0") * n("-2.25")).value());
+  EXPECT_EQ("0", (n("1.5") - n("1.5")).value().ToString());
+  EXPECT_EQ("-0.000000001", (n("0") - n("0.000000001")).value().ToString());
+
+  // Products are rounded to 9 fractional digits, away from zero.
+  EXPECT_EQ(n("0.000000001"), (n("0.00001") * n("0.00005")).value());
+  EXPECT_EQ(n("-0.000000001"), (n("-0.00001") * n("0.00005")).value());
+  EXPECT_EQ(n("0"), (n("0.00001") * n("0.000049999")).value());
+  EXPECT_EQ(n("0.333333333"), (n("0.666666666") * n("0.5")).value());
+
+  // Results at the limits of the range.
+  auto const max = MakeNumeric(std::string(29, '9') + ".999999999").value();
+  auto const min = MakeNumeric("-" + max.ToString()).value();
+  EXPECT_EQ(max, (max - n("0")).value());
+  EXPECT_EQ(min, (n("0") - max).value());
+  EXPECT_EQ(max, (max * n("1")).value());
+  EXPECT_EQ(min, (max * n("-1")).value());
+  EXPECT_EQ(n("0"), (max + min).value());
+  auto const big = MakeNumeric(kNumericIntMax, 0).value();
+  EXPECT_EQ("-" + std::string(29, '9'), (big * n("-1")).value().ToString());
+  EXPECT_EQ(n("99999999999999999999990000000"),
+            (n("9999999999999.999999999") * n("10000000000000000")).value());
+}
+
+TEST(Numeric, ArithmeticFail) {
+  auto n = [](char const* s) { return MakeNumeric(s).value(); };
+  auto const max = MakeNumeric(std::string(29, '9') + ".999999999").value();
+  auto const min = MakeNumeric("-" + max.ToString()).value();
+  EXPECT_THAT(max + n("0.000000001"), StatusIs(StatusCode::kOutOfRange));
+  EXPECT_THAT(min - n("0.000000001"), StatusIs(StatusCode::kOutOfRange));
+  EXPECT_THAT(min + min, StatusIs(StatusCode::kOutOfRange));
+  EXPECT_THAT(max - min, StatusIs(StatusCode::kOutOfRange));
+  EXPECT_THAT(max * n("1.000000001"), StatusIs(StatusCode::kOutOfRange));
+  EXPECT_THAT(max * max, StatusIs(StatusCode::kOutOfRange));
+  EXPECT_THAT(min * n("100000000000000"), StatusIs(StatusCode::kOutOfRange));
+  // The product is rounded out of range.
+  EXPECT_THAT(n("99999997800000048399998935200.023425599") *
+                  n("1.000000022"),
+              StatusIs(StatusCode::kOutOfRange));
+}
+
+TEST(Numeric, ConversionFastPaths) {
+  // These values have a binary representation, check that the conversions
+  // agree with the decimal representation.
+  for (auto const* s :
+       {"0", "1", "-1", "0.5", "-0.5", "1.499999999", "-1.5", "2.5",
+        "9007199.254740993", "123456789012345678901234567.5",
+        "-9223372036854775808.4", "9223372036854775807.499999999"}) {
+    auto const v = MakeNumeric(s).value();
+    EXPECT_EQ(std::stod(s), ToDouble(v)) << s;
+  }
+  EXPECT_EQ(2, ToInteger<int>(MakeNumeric("1.5").value()).value());
+  EXPECT_EQ(-2, ToInteger<int>(MakeNumeric("-1.5").value()).value());
+  EXPECT_EQ(1, ToInteger<int>(MakeNumeric("1.499999999").value()).value());
+  EXPECT_EQ(std::numeric_limits<std::int64_t>::min(),
+            ToInteger<std::int64_t>(
+                MakeNumeric("-9223372036854775808.4").value())
+                .value());
+  EXPECT_THAT(ToInteger<std::int64_t>(
+                  MakeNumeric("9223372036854775807.5").value()),
+              StatusIs(StatusCode::kDataLoss));
+  EXPECT_THAT(ToInteger<std::uint8_t>(MakeNumeric("255.5").value()),
+              StatusIs(StatusCode::kDataLoss));
+  EXPECT_THAT(ToInteger<unsigned>(MakeNumeric("-0.4").value()),
+              StatusIs(StatusCode::kDataLoss));
 }
 
 TEST(Numeric, OutputStreaming) {
@@ -560,8 +650,18 @@ TEST(Numeric, PostgreSQL) {
     EXPECT_EQ("NaN", nan.value().ToString());
   }
 
-  // Unlike regular NaN values, PostgreSQL NaNs compare equal.
-  EXPECT_EQ(MakePgNumeric("NaN"), MakePgNumeric("NaN"));
+  // Unlike regular NaN values, PostgreSQL NaNs compare equal, and are
+  // ordered after all other values.
+  auto const nan = MakePgNumeric("NaN").value();
+  EXPECT_EQ(nan, MakePgNumeric("NaN").value());
+  EXPECT_LE(nan, nan);
+  EXPECT_FALSE(nan < nan);
+  EXPECT_LT(MakePgNumeric(-1).value(), nan);
+  EXPECT_GT(nan, MakePgNumeric(1).value());
+
+  // Operations with NaN yield NaN.
+  EXPECT_EQ(nan, (nan + MakePgNumeric(1).value()).value());
+  EXPECT_EQ(nan, (MakePgNumeric(1).value() * nan).value());
 
   // Check some limits of representation and rounding.
   auto limit = "-" + std::string(131072, '9') + "." + std::string(16383, '9');
@@ -571,6 +671,30 @@ TEST(Numeric, PostgreSQL) {
   auto round_up = "0." + std::string(16383, '9') + "5";
   EXPECT_EQ("1", MakePgNumeric(round_up).value().ToString());
 
+  // Values outside the binary representation are ordered by their decimal
+  // representation, but are not supported by the arithmetic operators.
+  auto const huge = MakePgNumeric("1" + std::string(40, '0')).value();
+  auto const tiny = MakePgNumeric("0." + std::string(20, '0') + "1").value();
+  EXPECT_LT(MakePgNumeric(limit).value(), huge);
+  EXPECT_LT(MakePgNumeric(0).value(), tiny);
+  EXPECT_LT(tiny, MakePgNumeric("0.000000001").value());
+  EXPECT_LT(huge, nan);
+  EXPECT_EQ(1e40, ToDouble(huge));
+  EXPECT_THAT(huge + MakePgNumeric(1).value(),
+              StatusIs(StatusCode::kOutOfRange));
+  EXPECT_THAT(tiny * MakePgNumeric(1).value(),
+              StatusIs(StatusCode::kOutOfRange));
+  EXPECT_EQ(MakePgNumeric("2.5").value(),
+            (MakePgNumeric("1.25").value() * MakePgNumeric(2).value()).value());
+
+  // PostgreSQL products are exact, rather than rounded to 9 digits.
+  auto pg = [](char const* s) { return MakePgNumeric(s).value(); };
+  EXPECT_THAT(pg("0.00001") * pg("0.00001"),
+              StatusIs(StatusCode::kOutOfRange,
+                       HasSubstr("more than 9 fractional digits")));
+  EXPECT_THAT(pg("0.5") * pg("0.000000001"), StatusIs(StatusCode::kOutOfRange));
+  EXPECT_EQ(pg("0.000000001"), (pg("0.00002") * pg("0.00005")).value());
+
   // Finally, check some random integer/scaled/double conversions.
   EXPECT_EQ(1, ToInteger<int>(MakePgNumeric(1).value()).value());
   EXPECT_EQ(123400, ToInteger<int>(MakePgNumeric(1234, 1).value(), 1).value());
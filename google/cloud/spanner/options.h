@@ -41,6 +41,7 @@
 #include "google/cloud/spanner/backoff_policy.h"
 #include "google/cloud/spanner/directed_read_replicas.h"
 #include "google/cloud/spanner/internal/session.h"
+#include "google/cloud/spanner/keys.h"
 #include "google/cloud/spanner/lock_hint.h"
 #include "google/cloud/spanner/order_by.h"
 #include "google/cloud/spanner/polling_policy.h"
@@ -55,6 +56,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -264,6 +266,29 @@ using SessionPoolOptionList =
     OptionList<RouteToLeaderOption, SessionCreatorRoleOption,
                SessionPoolLabelsOption>;
 
+/**
+ * Option for `google::cloud::Options` to enable a client-side cache of query
+ * results, holding up to this many bytes. Pass to `spanner::MakeConnection()`.
+ *
+ * When set to a positive value, the connection caches the results of
+ * `Client::ExecuteQuery()` in single-use, bounded-staleness transactions,
+ * that is, with `Transaction::SingleUseOptions(max_staleness)`. A cached
+ * result is returned while its read timestamp is within the `max_staleness`
+ * of the query. The results are keyed by the SQL statement, its parameters,
+ * and the optimizer options. A result is cached once the first caller has
+ * read all its rows. Until then, other queries for it are sent to the
+ * service, rather than waiting for that caller. Results larger than the
+ * cache are streamed without being cached. Queries with directed reads are
+ * not cached.
+ *
+ * The cache is disabled by default.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct QueryCacheMaxBytesOption {
+  using Type = std::size_t;
+};
+
 /**
  * Option for `google::cloud::Options` to set the optimizer version used in an
  * SQL query.
@@ -336,6 +361,24 @@ struct StreamingResumabilityBufferSizeOption {
   using Type = std::size_t;
 };
 
+/**
+ * Option for `google::cloud::Options` to set a limit on how much data will
+ * be buffered to guarantee resumability across all the streaming reads and
+ * SQL queries in the process.
+ *
+ * A stream that would take the total over this limit delivers the rows it
+ * has buffered, as if it had exceeded its own
+ * `StreamingResumabilityBufferSizeOption`, and so may fail if it is
+ * interrupted before a new resumption point can be established. Streams with
+ * different limits share the same total. There is no limit when the option
+ * is unset, or when it is set to 0.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct StreamingResumabilityTotalBufferSizeOption {
+  using Type = std::size_t;
+};
+
 /**
  * Option for `google::cloud::Options` to set the desired partition size to
  * be generated by `Client::PartitionRead()` or `PartitionQuery()`.
@@ -378,6 +421,94 @@ struct PartitionDataBoostOption {
   using Type = bool;
 };
 
+/**
+ * Option for `google::cloud::Options` to set the maximum number of partitions
+ * that a `PartitionedExecutor` runs at the same time.
+ *
+ * The default is the number of hardware threads.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct PartitionExecutorMaxConcurrencyOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Option for `google::cloud::Options` to set the maximum number of rows
+ * buffered by the `RowStream` returned from a `PartitionedExecutor`.
+ *
+ * The partitions stop reading rows while the buffer is full. The default is
+ * 1,024 rows.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct PartitionExecutorBufferedRowsOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Option for `google::cloud::Options` to set the maximum number of mutations
+ * in a batch sent by a `MutationBatcher`.
+ *
+ * Mutations are counted like in a commit: each column of each inserted,
+ * updated, or replaced row, and each deleted key set. Values above the
+ * service limit of 80,000 are ignored. The default is 10,000 mutations.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct MutationBatcherMaxMutationsPerBatchOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Option for `google::cloud::Options` to set the maximum size, in bytes, of a
+ * batch sent by a `MutationBatcher`.
+ *
+ * Larger mutation groups are rejected. The default is 8 MiB.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct MutationBatcherMaxBytesPerBatchOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Option for `google::cloud::Options` to set the maximum number of batches a
+ * `MutationBatcher` sends concurrently.
+ *
+ * The default is 4 batches.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct MutationBatcherMaxBatchesOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Option for `google::cloud::Options` to set the maximum size, in bytes, of
+ * the mutation groups admitted by a `MutationBatcher` but not yet completed.
+ *
+ * The default is 4 times the `MutationBatcherMaxBytesPerBatchOption` default.
+ * Mutation groups larger than this limit are rejected.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct MutationBatcherMaxOutstandingBytesOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Option for `google::cloud::Options` to set how long a `MutationBatcher`
+ * waits for more mutations before sending a batch that is not full.
+ *
+ * The default is 100 milliseconds.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct MutationBatcherFlushIntervalOption {
+  using Type = std::chrono::milliseconds;
+};
+
 /**
  * Option for `google::cloud::Options` to indicate which replicas or regions
  * should be used for reads/queries in read-only or single-use transactions.
@@ -404,6 +535,26 @@ struct TransactionTagOption {
   using Type = std::string;
 };
 
+/**
+ * Option for `google::cloud::Options` to declare the keys that a read-write
+ * transaction run by `Client::Commit(mutator, ...)` will update, by table
+ * name.
+ *
+ * Transactions run by `Client`s sharing a `Connection` that declare
+ * overlapping key sets are run one at a time, instead of aborting each other.
+ * Key sets of the same table overlap when they contain an equal key, or when
+ * either of them contains a key range or is `KeySet::All()`. Key sets of
+ * different tables never overlap. While commits abort, the number of
+ * declared transactions running at once is also reduced.
+ *
+ * Transactions that do not declare a key set are run immediately.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct TransactionKeySetOption {
+  using Type = std::map<std::string, KeySet>;
+};
+
 /**
  * Option for `google::cloud::Options` to control when transaction mutations
  * will not be recorded in change streams that track columns modified by the
@@ -0,0 +1,359 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/partitioned_executor.h"
+#include "google/cloud/spanner/backoff_policy.h"
+#include "google/cloud/spanner/options.h"
+#include "google/cloud/spanner/retry_policy.h"
+#include "google/cloud/spanner/transaction.h"
+#include "google/cloud/internal/make_status.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+auto constexpr kDefaultBufferedRows = 1024;
+auto constexpr kDefaultPartitionRetries = 3;
+
+// Returns the rows of the partition with the given index.
+using PartitionRunner = std::function<RowStream(std::size_t)>;
+
+std::size_t MaxConcurrency(Options const& opts) {
+  if (opts.has<PartitionExecutorMaxConcurrencyOption>()) {
+    return (std::max)(std::size_t{1},
+                      opts.get<PartitionExecutorMaxConcurrencyOption>());
+  }
+  return (std::max)(1U, std::thread::hardware_concurrency());
+}
+
+std::size_t BufferedRows(Options const& opts) {
+  if (opts.has<PartitionExecutorBufferedRowsOption>()) {
+    return (std::max)(std::size_t{1},
+                      opts.get<PartitionExecutorBufferedRowsOption>());
+  }
+  return kDefaultBufferedRows;
+}
+
+std::unique_ptr<RetryPolicy> PartitionRetryPolicy(Options const& opts) {
+  if (opts.has<SpannerRetryPolicyOption>()) {
+    return opts.get<SpannerRetryPolicyOption>()->clone();
+  }
+  return LimitedErrorCountRetryPolicy(kDefaultPartitionRetries).clone();
+}
+
+std::unique_ptr<BackoffPolicy> PartitionBackoffPolicy(Options const& opts) {
+  if (opts.has<SpannerBackoffPolicyOption>()) {
+    return opts.get<SpannerBackoffPolicyOption>()->clone();
+  }
+  auto constexpr kBackoffScaling = 2.0;
+  return ExponentialBackoffPolicy(std::chrono::milliseconds(100),
+                                  std::chrono::seconds(10), kBackoffScaling)
+      .clone();
+}
+
+/**
+ * Runs a number of partitions in a bounded pool of threads.
+ *
+ * Each thread runs one partition at a time, passing its rows to the sink.
+ * The first error, from a partition or from the sink, stops all the
+ * partitions.
+ */
+class PartitionWorkers {
+ public:
+  using Done = std::function<void(Status)>;
+
+  PartitionWorkers(std::size_t partitions, PartitionRunner run,
+                   PartitionedExecutor::RowCallback sink, Options opts,
+                   Done done = {})
+      : partitions_(partitions),
+        run_(std::move(run)),
+        sink_(std::move(sink)),
+        opts_(std::move(opts)),
+        done_(std::move(done)) {
+    auto const n = (std::min)(MaxConcurrency(opts_), partitions_);
+    running_ = n;
+    if (n == 0 && done_) done_(Status{});
+    threads_.reserve(n);
+    for (std::size_t i = 0; i != n; ++i) {
+      threads_.emplace_back([this] { Worker(); });
+    }
+  }
+
+  ~PartitionWorkers() { Join(); }
+
+  // Stops the partitions, without waiting for them.
+  void Stop() { stopped_ = true; }
+
+  // Waits for the partitions, and returns the first error, if any.
+  Status Join() {
+    for (auto& t : threads_) {
+      if (t.joinable()) t.join();
+    }
+    std::lock_guard<std::mutex> lk(mu_);
+    return status_;
+  }
+
+ private:
+  void Worker() {
+    Status status;
+    while (status.ok() && !stopped_) {
+      auto const index = next_.fetch_add(1);
+      if (index >= partitions_) break;
+      status = RunPartition(index);
+    }
+    std::unique_lock<std::mutex> lk(mu_);
+    if (!status.ok() && status_.ok() && !stopped_) {
+      status_ = std::move(status);
+      stopped_ = true;
+    }
+    if (--running_ != 0 || !done_) return;
+    auto final_status = status_;
+    lk.unlock();
+    done_(std::move(final_status));
+  }
+
+  // Runs one partition, rerunning it while it fails before returning any
+  // rows.
+  Status RunPartition(std::size_t index) {
+    auto retry_policy = PartitionRetryPolicy(opts_);
+    auto backoff_policy = PartitionBackoffPolicy(opts_);
+    for (;;) {
+      auto rows = run_(index);
+      bool has_rows = false;
+      Status status;
+      for (auto& row : rows) {
+        if (stopped_) {
+          return internal::CancelledError("partitioned execution stopped",
+                                          GCP_ERROR_INFO());
+        }
+        if (!row) {
+          status = std::move(row).status();
+          break;
+        }
+        has_rows = true;
+        status = sink_(index, *std::move(row));
+        if (!status.ok()) return status;
+      }
+      if (status.ok() || has_rows) return status;
+      if (!retry_policy->OnFailure(status)) return status;
+      std::this_thread::sleep_for(backoff_policy->OnCompletion());
+    }
+  }
+
+  std::size_t const partitions_;
+  PartitionRunner const run_;
+  PartitionedExecutor::RowCallback const sink_;
+  Options const opts_;
+  Done const done_;
+  std::atomic<std::size_t> next_{0};
+  std::atomic<bool> stopped_{false};
+  std::mutex mu_;
+  std::size_t running_;  // GUARDED_BY(mu_)
+  Status status_;        // GUARDED_BY(mu_)
+  std::vector<std::thread> threads_;
+};
+
+/**
+ * Merges the rows of all the partitions into a single stream.
+ *
+ * The workers block while the buffer is full. Destroying the source stops
+ * the partitions and waits for the workers.
+ */
+class MergedRowSource : public ResultSourceInterface {
+ public:
+  explicit MergedRowSource(std::size_t capacity) : capacity_(capacity) {}
+
+  ~MergedRowSource() override {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      cancelled_ = true;
+    }
+    space_cv_.notify_all();
+    if (workers_) workers_->Stop();
+    workers_.reset();
+  }
+
+  void Start(std::size_t partitions, PartitionRunner run,
+             Options const& opts) {
+    workers_ = std::make_unique<PartitionWorkers>(
+        partitions, std::move(run),
+        [this](std::size_t, Row row) { return Push(std::move(row)); }, opts,
+        [this](Status status) { Finish(std::move(status)); });
+  }
+
+  void Finish(Status status) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      done_ = true;
+      status_ = std::move(status);
+    }
+    rows_cv_.notify_all();
+  }
+
+  StatusOr<Row> NextRow() override {
+    std::unique_lock<std::mutex> lk(mu_);
+    rows_cv_.wait(lk, [this] { return !rows_.empty() || done_; });
+    if (rows_.empty()) {
+      if (!status_.ok()) return status_;
+      return Row();
+    }
+    auto row = std::move(rows_.front());
+    rows_.pop_front();
+    lk.unlock();
+    space_cv_.notify_one();
+    return row;
+  }
+
+  std::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
+    return std::nullopt;
+  }
+
+  std::optional<google::spanner::v1::ResultSetStats> Stats() const override {
+    return std::nullopt;
+  }
+
+ private:
+  Status Push(Row row) {
+    std::unique_lock<std::mutex> lk(mu_);
+    space_cv_.wait(lk,
+                   [this] { return rows_.size() < capacity_ || cancelled_; });
+    if (cancelled_) {
+      return internal::CancelledError("the row stream was destroyed",
+                                      GCP_ERROR_INFO());
+    }
+    rows_.push_back(std::move(row));
+    lk.unlock();
+    rows_cv_.notify_one();
+    return Status{};
+  }
+
+  std::size_t const capacity_;
+  std::mutex mu_;
+  std::condition_variable rows_cv_;
+  std::condition_variable space_cv_;
+  std::deque<Row> rows_;    // GUARDED_BY(mu_)
+  bool done_ = false;       // GUARDED_BY(mu_)
+  bool cancelled_ = false;  // GUARDED_BY(mu_)
+  Status status_;           // GUARDED_BY(mu_)
+  std::unique_ptr<PartitionWorkers> workers_;
+};
+
+template <typename Partitions>
+RowStream MergePartitions(StatusOr<Partitions> partitions,
+                          std::function<RowStream(Partitions const&,
+                                                  std::size_t)> const& run,
+                          Options const& opts) {
+  auto source = std::make_unique<MergedRowSource>(BufferedRows(opts));
+  if (!partitions) {
+    source->Finish(std::move(partitions).status());
+    return RowStream(std::move(source));
+  }
+  auto const n = partitions->size();
+  source->Start(
+      n,
+      [run, p = *std::move(partitions)](std::size_t i) { return run(p, i); },
+      opts);
+  return RowStream(std::move(source));
+}
+
+template <typename Partitions>
+Status RunPartitions(StatusOr<Partitions> partitions,
+                     std::function<RowStream(Partitions const&, std::size_t)>
+                         const& run,
+                     PartitionedExecutor::RowCallback callback,
+                     Options const& opts) {
+  if (!partitions) return std::move(partitions).status();
+  auto const n = partitions->size();
+  PartitionWorkers workers(
+      n, [run, &p = *partitions](std::size_t i) { return run(p, i); },
+      std::move(callback), opts);
+  return workers.Join();
+}
+
+}  // namespace
+
+PartitionedExecutor::PartitionedExecutor(Client client, Options opts)
+    : client_(std::move(client)), opts_(std::move(opts)) {}
+
+RowStream PartitionedExecutor::ExecuteQuery(SqlStatement statement,
+                                            Options opts) {
+  opts = internal::MergeOptions(std::move(opts), opts_);
+  auto client = client_;
+  return MergePartitions<std::vector<QueryPartition>>(
+      client_.PartitionQuery(MakeReadOnlyTransaction(), std::move(statement),
+                             opts),
+      [client, opts](std::vector<QueryPartition> const& p,
+                     std::size_t i) mutable {
+        return client.ExecuteQuery(p[i], opts);
+      },
+      opts);
+}
+
+Status PartitionedExecutor::ExecuteQuery(SqlStatement statement,
+                                         RowCallback callback, Options opts) {
+  opts = internal::MergeOptions(std::move(opts), opts_);
+  auto client = client_;
+  return RunPartitions<std::vector<QueryPartition>>(
+      client_.PartitionQuery(MakeReadOnlyTransaction(), std::move(statement),
+                             opts),
+      [client, opts](std::vector<QueryPartition> const& p,
+                     std::size_t i) mutable {
+        return client.ExecuteQuery(p[i], opts);
+      },
+      std::move(callback), opts);
+}
+
+RowStream PartitionedExecutor::Read(std::string table, KeySet keys,
+                                    std::vector<std::string> columns,
+                                    Options opts) {
+  opts = internal::MergeOptions(std::move(opts), opts_);
+  auto client = client_;
+  return MergePartitions<std::vector<ReadPartition>>(
+      client_.PartitionRead(MakeReadOnlyTransaction(), std::move(table),
+                            std::move(keys), std::move(columns), opts),
+      [client, opts](std::vector<ReadPartition> const& p,
+                     std::size_t i) mutable { return client.Read(p[i], opts); },
+      opts);
+}
+
+Status PartitionedExecutor::Read(std::string table, KeySet keys,
+                                 std::vector<std::string> columns,
+                                 RowCallback callback, Options opts) {
+  opts = internal::MergeOptions(std::move(opts), opts_);
+  auto client = client_;
+  return RunPartitions<std::vector<ReadPartition>>(
+      client_.PartitionRead(MakeReadOnlyTransaction(), std::move(table),
+                            std::move(keys), std::move(columns), opts),
+      [client, opts](std::vector<ReadPartition> const& p,
+                     std::size_t i) mutable { return client.Read(p[i], opts); },
+      std::move(callback), opts);
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
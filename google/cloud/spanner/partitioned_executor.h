@@ -0,0 +1,132 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_PARTITIONED_EXECUTOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_PARTITIONED_EXECUTOR_H
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/keys.h"
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/row.h"
+#include "google/cloud/spanner/sql_statement.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Runs partitioned reads and queries using a bounded pool of threads.
+ *
+ * `PartitionedExecutor` partitions a query or a read in a new read-only
+ * transaction, using `Client::PartitionQuery()` or `Client::PartitionRead()`,
+ * and then runs the partitions concurrently. At most
+ * `PartitionExecutorMaxConcurrencyOption` partitions run at the same time.
+ * Set `PartitionDataBoostOption` to run the partitions using Data Boost.
+ *
+ * The results are returned either as a single `RowStream`, where the rows
+ * of different partitions are interleaved in no particular order, or by
+ * calling a function for each row.
+ *
+ * Each partition is retried independently, using the policies in
+ * `SpannerRetryPolicyOption` and `SpannerBackoffPolicyOption` (by default up
+ * to 3 transient failures), as long as it failed before returning any rows.
+ * Failures after the first row are returned to the caller, because the rows
+ * already returned cannot be recalled. The first such failure stops all the
+ * partitions.
+ *
+ * @par Example
+ * @code
+ * namespace spanner = ::google::cloud::spanner;
+ * auto executor = spanner::PartitionedExecutor(
+ *     client, Options{}.set<spanner::PartitionDataBoostOption>(true));
+ * auto rows = executor.ExecuteQuery(spanner::SqlStatement("SELECT * FROM T"));
+ * for (auto const& row : rows) {
+ *   if (!row) return row.status();
+ *   // ... process the row ...
+ * }
+ * @endcode
+ */
+class PartitionedExecutor {
+ public:
+  /**
+   * Called for each row of each partition.
+   *
+   * The function is called concurrently, from different threads, for rows of
+   * different partitions, and sequentially for the rows of the same
+   * partition. The first argument is the index of the partition. Returning a
+   * non-OK status stops all the partitions.
+   */
+  using RowCallback = std::function<Status(std::size_t, Row)>;
+
+  /**
+   * Creates an executor for @p client.
+   *
+   * @param client the client used to partition and to run the partitions.
+   * @param opts (optional) the options for all the calls. They include the
+   *     options for `Client::PartitionQuery()`, `Client::PartitionRead()`,
+   *     `Client::ExecuteQuery()` and `Client::Read()`, and the
+   *     `PartitionExecutor*Option`s.
+   */
+  explicit PartitionedExecutor(Client client, Options opts = {});
+
+  /**
+   * Runs the partitions of @p statement and returns all their rows.
+   *
+   * The `RowStream` owns the worker threads. Destroying it before the end of
+   * the stream cancels the remaining partitions. When the stream buffers
+   * `PartitionExecutorBufferedRowsOption` rows, the workers wait until the
+   * application consumes some rows.
+   *
+   * @note The returned `RowStream` does not report `RowsModified()` or
+   *     `ReadTimestamp()`.
+   */
+  RowStream ExecuteQuery(SqlStatement statement, Options opts = {});
+
+  /// Runs the partitions of @p statement, calling @p callback for each row.
+  Status ExecuteQuery(SqlStatement statement, RowCallback callback,
+                      Options opts = {});
+
+  /**
+   * Reads the partitions of @p keys in @p table and returns all their rows.
+   *
+   * @see `ExecuteQuery(SqlStatement,Options)` for the behavior of the
+   *     returned stream.
+   */
+  RowStream Read(std::string table, KeySet keys,
+                 std::vector<std::string> columns, Options opts = {});
+
+  /// Reads the partitions of @p keys in @p table, calling @p callback for
+  /// each row.
+  Status Read(std::string table, KeySet keys, std::vector<std::string> columns,
+              RowCallback callback, Options opts = {});
+
+ private:
+  Client client_;
+  Options opts_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_PARTITIONED_EXECUTOR_H
@@ -0,0 +1,245 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/partitioned_executor.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/spanner/mocks/row.h"
+#include "google/cloud/spanner/options.h"
+#include "google/cloud/spanner/query_partition.h"
+#include "google/cloud/spanner/read_partition.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::Return;
+using ::testing::UnorderedElementsAre;
+
+std::vector<QueryPartition> MakeQueryPartitions(int n, bool data_boost) {
+  std::vector<QueryPartition> partitions;
+  for (int i = 0; i != n; ++i) {
+    partitions.push_back(spanner_internal::MakeQueryPartition(
+        "txn-id", false, "", "session", std::to_string(i), data_boost,
+        SqlStatement("SELECT * FROM T")));
+  }
+  return partitions;
+}
+
+// Returns the rows {10 * p, 10 * p + 1} for partition p.
+RowStream MakeRows(std::string const& token) {
+  auto const base = std::int64_t{10} * std::stoi(token);
+  auto source = std::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*source, NextRow)
+      .WillOnce(Return(spanner_mocks::MakeRow(base)))
+      .WillOnce(Return(spanner_mocks::MakeRow(base + 1)))
+      .WillOnce(Return(Row()));
+  return RowStream(std::move(source));
+}
+
+RowStream MakeErrorRows(Status status) {
+  auto source = std::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*source, NextRow).WillOnce(Return(std::move(status)));
+  return RowStream(std::move(source));
+}
+
+Options TestOptions() {
+  return Options{}
+      .set<PartitionExecutorMaxConcurrencyOption>(2)
+      .set<SpannerRetryPolicyOption>(
+          std::make_shared<LimitedErrorCountRetryPolicy>(2))
+      .set<SpannerBackoffPolicyOption>(
+          std::make_shared<ExponentialBackoffPolicy>(
+              std::chrono::microseconds(1), std::chrono::microseconds(1),
+              2.0));
+}
+
+std::vector<std::int64_t> Values(RowStream& rows) {
+  std::vector<std::int64_t> values;
+  for (auto& row : StreamOf<std::tuple<std::int64_t>>(rows)) {
+    EXPECT_STATUS_OK(row);
+    if (!row) break;
+    values.push_back(std::get<0>(*row));
+  }
+  return values;
+}
+
+TEST(PartitionedExecutorTest, ExecuteQueryMergesPartitions) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, PartitionQuery)
+      .WillOnce([](Connection::PartitionQueryParams const& p) {
+        EXPECT_TRUE(p.partition_options.data_boost);
+        return MakeQueryPartitions(3, true);
+      });
+  EXPECT_CALL(*conn, ExecuteQuery)
+      .Times(3)
+      .WillRepeatedly([](Connection::SqlParams const& p) {
+        EXPECT_TRUE(p.partition_data_boost);
+        return MakeRows(p.partition_token.value_or("0"));
+      });
+
+  PartitionedExecutor executor(Client(conn), TestOptions());
+  auto rows =
+      executor.ExecuteQuery(SqlStatement("SELECT * FROM T"),
+                            Options{}.set<PartitionDataBoostOption>(true));
+  EXPECT_THAT(Values(rows), UnorderedElementsAre(0, 1, 10, 11, 20, 21));
+}
+
+TEST(PartitionedExecutorTest, ExecuteQueryPartitionFailure) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, PartitionQuery)
+      .WillOnce(Return(Status(StatusCode::kPermissionDenied, "uh-oh")));
+  EXPECT_CALL(*conn, ExecuteQuery).Times(0);
+
+  PartitionedExecutor executor(Client(conn), TestOptions());
+  auto rows = executor.ExecuteQuery(SqlStatement("SELECT * FROM T"));
+  auto it = rows.begin();
+  ASSERT_NE(it, rows.end());
+  EXPECT_THAT(*it, StatusIs(StatusCode::kPermissionDenied));
+}
+
+TEST(PartitionedExecutorTest, RetriesPartitionsIndependently) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, PartitionQuery).WillOnce([] {
+    return MakeQueryPartitions(2, false);
+  });
+  std::atomic<int> failures{0};
+  EXPECT_CALL(*conn, ExecuteQuery)
+      .Times(4)
+      .WillRepeatedly([&failures](Connection::SqlParams const& p) {
+        // Partition "1" fails twice before returning any rows.
+        if (p.partition_token == "1" && failures.fetch_add(1) < 2) {
+          return MakeErrorRows(Status(StatusCode::kUnavailable, "try-again"));
+        }
+        return MakeRows(p.partition_token.value_or("0"));
+      });
+
+  PartitionedExecutor executor(Client(conn), TestOptions());
+  auto rows = executor.ExecuteQuery(SqlStatement("SELECT * FROM T"));
+  EXPECT_THAT(Values(rows), UnorderedElementsAre(0, 1, 10, 11));
+}
+
+TEST(PartitionedExecutorTest, PermanentFailureStopsStream) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, PartitionQuery).WillOnce([] {
+    return MakeQueryPartitions(1, false);
+  });
+  EXPECT_CALL(*conn, ExecuteQuery).WillOnce([](Connection::SqlParams const&) {
+    return MakeErrorRows(Status(StatusCode::kPermissionDenied, "uh-oh"));
+  });
+
+  PartitionedExecutor executor(Client(conn), TestOptions());
+  auto rows = executor.ExecuteQuery(SqlStatement("SELECT * FROM T"));
+  auto it = rows.begin();
+  ASSERT_NE(it, rows.end());
+  EXPECT_THAT(*it, StatusIs(StatusCode::kPermissionDenied));
+}
+
+TEST(PartitionedExecutorTest, DestroyStreamStopsWorkers) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, PartitionQuery).WillOnce([] {
+    return MakeQueryPartitions(4, false);
+  });
+  EXPECT_CALL(*conn, ExecuteQuery)
+      .WillRepeatedly([](Connection::SqlParams const&) {
+        auto source = std::make_unique<MockResultSetSource>();
+        EXPECT_CALL(*source, NextRow)
+            .WillRepeatedly(Return(spanner_mocks::MakeRow(std::int64_t{1})));
+        return RowStream(std::move(source));
+      });
+
+  PartitionedExecutor executor(
+      Client(conn),
+      TestOptions().set<PartitionExecutorBufferedRowsOption>(1));
+  auto rows = executor.ExecuteQuery(SqlStatement("SELECT * FROM T"));
+  auto it = rows.begin();
+  ASSERT_NE(it, rows.end());
+  EXPECT_STATUS_OK(*it);
+  // The partitions never end, destroying `rows` must stop them.
+}
+
+TEST(PartitionedExecutorTest, ReadWithCallback) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, PartitionRead)
+      .WillOnce([](Connection::PartitionReadParams const& p) {
+        EXPECT_EQ("T", p.read_params.table);
+        std::vector<ReadPartition> partitions;
+        for (int i = 0; i != 3; ++i) {
+          partitions.push_back(spanner_internal::MakeReadPartition(
+              "txn-id", false, "", "session", std::to_string(i), "T",
+              KeySet::All(), {"C"}, false, ReadOptions{}));
+        }
+        return partitions;
+      });
+  EXPECT_CALL(*conn, Read)
+      .Times(3)
+      .WillRepeatedly([](Connection::ReadParams const& p) {
+        return MakeRows(p.partition_token.value_or("0"));
+      });
+
+  std::mutex mu;
+  std::vector<std::int64_t> values;
+  std::vector<std::size_t> indexes;
+  PartitionedExecutor executor(Client(conn), TestOptions());
+  auto status = executor.Read(
+      "T", KeySet::All(), {"C"}, [&](std::size_t index, Row row) {
+        auto value = row.get<std::int64_t>(0);
+        if (!value) return std::move(value).status();
+        std::lock_guard<std::mutex> lk(mu);
+        values.push_back(*value);
+        indexes.push_back(index);
+        return Status{};
+      });
+  ASSERT_STATUS_OK(status);
+  EXPECT_THAT(values, UnorderedElementsAre(0, 1, 10, 11, 20, 21));
+  EXPECT_THAT(indexes, UnorderedElementsAre(0, 0, 1, 1, 2, 2));
+}
+
+TEST(PartitionedExecutorTest, CallbackErrorStopsPartitions) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, PartitionQuery).WillOnce([] {
+    return MakeQueryPartitions(1, false);
+  });
+  EXPECT_CALL(*conn, ExecuteQuery).WillOnce([](Connection::SqlParams const&) {
+    auto source = std::make_unique<MockResultSetSource>();
+    EXPECT_CALL(*source, NextRow)
+        .WillOnce(Return(spanner_mocks::MakeRow(std::int64_t{1})));
+    return RowStream(std::move(source));
+  });
+
+  PartitionedExecutor executor(Client(conn), TestOptions());
+  auto status = executor.ExecuteQuery(
+      SqlStatement("SELECT * FROM T"), [](std::size_t, Row const&) {
+        return Status(StatusCode::kAborted, "stop");
+      });
+  EXPECT_THAT(status, StatusIs(StatusCode::kAborted));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
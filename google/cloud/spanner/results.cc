@@ -18,6 +18,8 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -67,6 +69,24 @@ std::optional<spanner::ExecutionPlan> GetExecutionPlan(
 }
 }  // namespace
 
+StatusOr<bool> ResultSourceInterface::NextRowValues(
+    RowValuesFunction const& f) {
+  auto row = NextRow();
+  if (!row) return std::move(row).status();
+  if (row->size() == 0) return false;
+  std::vector<google::protobuf::Value> values;
+  values.reserve(row->size());
+  for (auto& v : std::move(*row).values()) {
+    values.push_back(spanner_internal::ToProto(std::move(v)).second);
+  }
+  std::vector<google::protobuf::Value*> pointers;
+  pointers.reserve(values.size());
+  for (auto& v : values) pointers.push_back(&v);
+  auto status = f(pointers);
+  if (!status.ok()) return status;
+  return true;
+}
+
 std::int64_t RowStream::RowsModified() const {
   return GetRowsModified(source_);
 }
@@ -108,5 +128,16 @@ std::optional<spanner::ExecutionPlan> ProfileDmlResult::ExecutionPlan() const {
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner
+
+namespace spanner_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+std::unique_ptr<spanner::ResultSourceInterface> RowStreamFriend::ReleaseSource(
+    spanner::RowStream& rows) {
+  return std::move(rows.source_);
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner_internal
 }  // namespace cloud
 }  // namespace google
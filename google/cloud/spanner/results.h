@@ -18,15 +18,41 @@
 #include "google/cloud/spanner/row.h"
 #include "google/cloud/spanner/timestamp.h"
 #include "google/cloud/spanner/version.h"
+#include "google/cloud/internal/make_status.h"
 #include "google/cloud/optional.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include "google/protobuf/struct.pb.h"
 #include "google/spanner/v1/spanner.pb.h"
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
+namespace spanner {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+class ResultSourceInterface;
+class RowStream;
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner
+
+namespace spanner_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+struct RowStreamFriend {
+  static std::unique_ptr<spanner::ResultSourceInterface> ReleaseSource(
+      spanner::RowStream& rows);
+};
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner_internal
+
 namespace spanner {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 
@@ -53,6 +79,26 @@ class ResultSourceInterface {
    */
   virtual StatusOr<spanner::Row> NextRow() = 0;
 
+  /**
+   * Called with the values of a row, in column order. The function may move
+   * the values out, and returns a non-OK status to stop the stream.
+   */
+  using RowValuesFunction =
+      std::function<Status(std::vector<google::protobuf::Value*> const&)>;
+
+  /**
+   * Calls @p f with the values of the next row in the stream, without
+   * creating a `spanner::Row`.
+   *
+   * The types of the values are given by the `row_type` in `Metadata()`.
+   * This is used by `DecodeStreamOf()`. The default implementation uses
+   * `NextRow()`.
+   *
+   * @return `true` if @p f was called, `false` at end-of-stream, or the
+   *   error from the stream or from @p f.
+   */
+  virtual StatusOr<bool> NextRowValues(RowValuesFunction const& f);
+
   /**
    * Returns metadata about the result set, such as the field types and the
    * transaction id created by the request.
@@ -72,6 +118,9 @@ class ResultSourceInterface {
   virtual std::optional<google::spanner::v1::ResultSetStats> Stats() const = 0;
 };
 
+template <typename Tuple>
+class DecodedRowStream;
+
 /**
  * Contains a hierarchical representation of the operations the database server
  * performs in order to execute a particular SQL statement.
@@ -128,9 +177,242 @@ class RowStream {
   std::optional<Timestamp> ReadTimestamp() const;
 
  private:
+  template <typename Tuple>
+  friend DecodedRowStream<Tuple> DecodeStreamOf(RowStream& rows);
+  friend struct spanner_internal::RowStreamFriend;
+
   std::unique_ptr<ResultSourceInterface> source_;
 };
 
+/**
+ * A `DecodedRowStream<Tuple>` defines a range that decodes `Tuple` objects
+ * directly from the values received in a `RowStream`.
+ *
+ * `StreamOf<Tuple>()` converts each value of each row into a `Value`, and
+ * then each `Value` into its C++ type, checking its type every time. This
+ * range instead decodes the values straight into the `Tuple`, checking the
+ * column types against the `Tuple` only once, from the `ResultSetMetadata`
+ * of the stream. Streams without a row type in their metadata, such as those
+ * created in tests, are decoded row by row, like `StreamOf<Tuple>()` does.
+ *
+ * Users create instances using the `DecodeStreamOf<T>(rows)` non-member
+ * factory function (defined below).
+ *
+ * @code
+ * auto rows = client.ExecuteQuery(...);
+ * using RowType = std::tuple<std::int64_t, std::string, bool>;
+ * for (auto& row : DecodeStreamOf<RowType>(rows)) {
+ *   if (!row) {
+ *     // Handle error;
+ *   }
+ *   std::int64_t x = std::get<0>(*row);
+ *   ...
+ * }
+ * @endcode
+ *
+ * @tparam Tuple the std::tuple<...> to parse each row into.
+ */
+template <typename Tuple>
+class DecodedRowStream {
+ public:
+  static_assert(spanner_internal::IsTuple<Tuple>::value,
+                "DecodedRowStream<T> requires a std::tuple parameter");
+
+  /**
+   * An _Input Iterator_ returning a sequence of `StatusOr<Tuple>` objects.
+   * Default constructing an `iterator` creates an instance that represents
+   * "end".
+   */
+  class iterator {
+   public:
+    /// @name Iterator type aliases
+    ///@{
+    using iterator_category = std::input_iterator_tag;
+    using value_type = StatusOr<Tuple>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+    using const_pointer = value_type const*;
+    using const_reference = value_type const&;
+    ///@}
+
+    iterator() = default;
+
+    reference operator*() { return row_; }
+    pointer operator->() { return &row_; }
+
+    const_reference operator*() const { return row_; }
+    const_pointer operator->() const { return &row_; }
+
+    iterator& operator++() {
+      Advance();
+      return *this;
+    }
+
+    iterator operator++(int) {
+      auto const old = *this;
+      ++*this;
+      return old;
+    }
+
+    friend bool operator==(iterator const& a, iterator const& b) {
+      return a.stream_ == b.stream_;
+    }
+
+    friend bool operator!=(iterator const& a, iterator const& b) {
+      return !(a == b);
+    }
+
+   private:
+    friend class DecodedRowStream;
+
+    explicit iterator(DecodedRowStream* stream) : stream_(stream) {
+      Advance();
+    }
+
+    void Advance() {
+      if (stream_ == nullptr) return;
+      // An error ends the stream.
+      if (!row_ok_ || !stream_->Next(row_)) {
+        stream_ = nullptr;
+        return;
+      }
+      row_ok_ = row_.ok();
+    }
+
+    bool row_ok_{true};
+    value_type row_;
+    DecodedRowStream* stream_ = nullptr;  // nullptr means "end"
+  };
+
+  // This class is movable but not copyable.
+  DecodedRowStream(DecodedRowStream&&) = default;
+  DecodedRowStream& operator=(DecodedRowStream&&) = default;
+
+  iterator begin() { return iterator(this); }
+  // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+  iterator end() { return {}; }
+
+ private:
+  template <typename T>
+  friend DecodedRowStream<T> DecodeStreamOf(RowStream& rows);
+
+  explicit DecodedRowStream(ResultSourceInterface* source)
+      : source_(source) {}
+
+  enum class Mode { kUnknown, kRows, kValues };
+
+  // Sets @p row to the next row, or returns false at end-of-stream.
+  bool Next(StatusOr<Tuple>& row) {
+    if (mode_ == Mode::kUnknown) {
+      auto status = CheckRowType();
+      if (!status.ok()) {
+        row = std::move(status);
+        return true;
+      }
+    }
+    if (mode_ == Mode::kRows) {
+      auto r = source_->NextRow();
+      if (!r) {
+        row = std::move(r).status();
+        return true;
+      }
+      if (r->size() == 0) return false;
+      row = std::move(*r).template get<Tuple>();
+      return true;
+    }
+    auto has_row = source_->NextRowValues(
+        [this](std::vector<google::protobuf::Value*> const& values) {
+          return Decode(values);
+        });
+    if (!has_row) {
+      row = std::move(has_row).status();
+      return true;
+    }
+    if (!*has_row) return false;
+    row = std::move(tup_);
+    return true;
+  }
+
+  // Checks the column types, once, using the metadata of the stream.
+  Status CheckRowType() {
+    mode_ = Mode::kRows;
+    auto metadata = source_->Metadata();
+    if (!metadata || metadata->row_type().fields().empty()) return {};
+    auto const& fields = metadata->row_type().fields();
+    if (fields.size() != std::tuple_size<Tuple>::value) {
+      auto constexpr kMsg = "Tuple has the wrong number of elements";
+      return internal::InvalidArgumentError(kMsg, GCP_ERROR_INFO());
+    }
+    types_.reserve(fields.size());
+    for (auto const& field : fields) types_.push_back(field.type());
+    Status status;
+    auto type = types_.cbegin();
+    spanner_internal::ForEach(tup_, CheckType{status}, type);
+    if (!status.ok()) return status;
+    mode_ = Mode::kValues;
+    return {};
+  }
+
+  Status Decode(std::vector<google::protobuf::Value*> const& values) {
+    if (values.size() != types_.size()) {
+      return internal::InternalError("row size does not match its metadata",
+                                     GCP_ERROR_INFO());
+    }
+    Status status;
+    auto value = values.begin();
+    auto type = types_.cbegin();
+    spanner_internal::ForEach(tup_, DecodeValue{status}, value, type);
+    return status;
+  }
+
+  struct CheckType {
+    Status& status;
+    template <typename T, typename It>
+    void operator()(T const&, It& it) const {
+      if (!status.ok()) return;
+      if (spanner_internal::ValueInternals::TypeProtoIs<T>(*it++)) return;
+      status = internal::UnknownError("wrong type", GCP_ERROR_INFO());
+    }
+  };
+
+  struct DecodeValue {
+    Status& status;
+    template <typename T, typename ValueIt, typename TypeIt>
+    void operator()(T& t, ValueIt& value, TypeIt& type) const {
+      auto& v = **value++;
+      auto const& vt = *type++;
+      if (!status.ok()) return;
+      auto x =
+          spanner_internal::ValueInternals::GetValue<T>(std::move(v), vt);
+      if (!x) {
+        status = std::move(x).status();
+      } else {
+        t = *std::move(x);
+      }
+    }
+  };
+
+  ResultSourceInterface* source_;
+  Mode mode_ = Mode::kUnknown;
+  std::vector<google::spanner::v1::Type> types_;
+  Tuple tup_;
+};
+
+/**
+ * A factory that creates a `DecodedRowStream<Tuple>` to decode the rows in
+ * @p rows.
+ *
+ * @note Ownership of @p rows is not transferred, so it must outlive the
+ *     returned `DecodedRowStream`.
+ *
+ * @tparam Tuple the std::tuple<...> to parse each row into.
+ */
+template <typename Tuple>
+DecodedRowStream<Tuple> DecodeStreamOf(RowStream& rows) {
+  return DecodedRowStream<Tuple>(rows.source_.get());
+}
+
 /**
  * Represents the result of a data modifying operation using
  * `spanner::Client::ExecuteDml()`.
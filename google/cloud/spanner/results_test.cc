@@ -23,6 +23,8 @@
 #include <chrono>
 #include <iostream>
 #include <string>
+#include <tuple>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -31,9 +33,11 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
 
 using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::google::cloud::testing_util::IsOkAndHolds;
 using ::google::cloud::testing_util::IsProtoEqual;
 using ::google::cloud::testing_util::StatusIs;
 using ::google::protobuf::TextFormat;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::Return;
 using ::testing::UnorderedPointwise;
@@ -115,6 +119,74 @@ TEST(RowStream, IterateError) {
   EXPECT_EQ(num_rows, 2);
 }
 
+TEST(RowStream, DecodeWithoutRowType) {
+  auto mock_source = std::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*mock_source, Metadata()).WillOnce(Return(std::nullopt));
+  EXPECT_CALL(*mock_source, NextRow())
+      .WillOnce(Return(spanner_mocks::MakeRow(5, true, "foo")))
+      .WillOnce(Return(spanner_mocks::MakeRow(10, false, "bar")))
+      .WillOnce(Return(Row()));
+
+  RowStream rows(std::move(mock_source));
+  using RowType = std::tuple<std::int64_t, bool, std::string>;
+  std::vector<RowType> actual;
+  for (auto& row : DecodeStreamOf<RowType>(rows)) {
+    ASSERT_STATUS_OK(row);
+    actual.push_back(*std::move(row));
+  }
+  EXPECT_THAT(actual, ElementsAre(RowType{5, true, "foo"},
+                                  RowType{10, false, "bar"}));
+}
+
+TEST(RowStream, DecodeWithRowType) {
+  auto constexpr kText = R"pb(
+    row_type: {
+      fields: {
+        name: "c0",
+        type: { code: INT64 }
+      }
+      fields: {
+        name: "c1",
+        type: { code: BOOL }
+      }
+    }
+  )pb";
+  google::spanner::v1::ResultSetMetadata metadata;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText, &metadata));
+  auto mock_source = std::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*mock_source, Metadata()).WillOnce(Return(metadata));
+  // The default `NextRowValues()` uses `NextRow()`.
+  EXPECT_CALL(*mock_source, NextRow())
+      .WillOnce(Return(spanner_mocks::MakeRow(5, true)))
+      .WillOnce(Return(Status(StatusCode::kUnavailable, "try-again")));
+
+  RowStream rows(std::move(mock_source));
+  using RowType = std::tuple<std::int64_t, bool>;
+  std::vector<StatusOr<RowType>> actual;
+  for (auto& row : DecodeStreamOf<RowType>(rows)) {
+    actual.push_back(std::move(row));
+  }
+  EXPECT_THAT(actual,
+              ElementsAre(IsOkAndHolds(RowType{5, true}),
+                          StatusIs(StatusCode::kUnavailable, "try-again")));
+}
+
+TEST(RowStream, DecodeWrongNumberOfColumns) {
+  google::spanner::v1::ResultSetMetadata metadata;
+  metadata.mutable_row_type()->add_fields()->mutable_type()->set_code(
+      google::spanner::v1::TypeCode::INT64);
+  auto mock_source = std::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*mock_source, Metadata()).WillOnce(Return(metadata));
+  EXPECT_CALL(*mock_source, NextRow()).Times(0);
+
+  RowStream rows(std::move(mock_source));
+  std::vector<StatusOr<std::tuple<std::int64_t, bool>>> actual;
+  for (auto& row : DecodeStreamOf<std::tuple<std::int64_t, bool>>(rows)) {
+    actual.push_back(std::move(row));
+  }
+  EXPECT_THAT(actual, ElementsAre(StatusIs(StatusCode::kInvalidArgument)));
+}
+
 TEST(RowStream, TimestampNoTransaction) {
   auto mock_source = std::make_unique<MockResultSetSource>();
   google::spanner::v1::ResultSetMetadata no_transaction;
@@ -35,18 +35,23 @@ spanner_client_unit_tests = [
     "internal/merge_chunk_test.cc",
     "internal/partial_result_set_resume_test.cc",
     "internal/partial_result_set_source_test.cc",
+    "internal/query_cache_connection_test.cc",
+    "internal/resume_buffer_budget_test.cc",
     "internal/route_to_leader_test.cc",
     "internal/session_pool_test.cc",
     "internal/spanner_stub_factory_test.cc",
     "internal/status_utils_test.cc",
     "internal/transaction_impl_test.cc",
+    "internal/transaction_scheduler_test.cc",
     "internal/tuple_utils_test.cc",
     "interval_test.cc",
     "json_test.cc",
     "keys_test.cc",
+    "mutation_batcher_test.cc",
     "mutations_test.cc",
     "numeric_test.cc",
     "partition_options_test.cc",
+    "partitioned_executor_test.cc",
     "proto_enum_test.cc",
     "proto_message_test.cc",
     "query_options_test.cc",
@@ -103,16 +103,36 @@ class MockSpannerStub : public google::cloud::spanner_internal::SpannerStub {
                google::spanner::v1::BeginTransactionRequest const&),
               (override));
 
+  MOCK_METHOD(future<StatusOr<google::spanner::v1::Transaction>>,
+              AsyncBeginTransaction,
+              (CompletionQueue&, std::shared_ptr<grpc::ClientContext>,
+               google::cloud::internal::ImmutableOptions,
+               google::spanner::v1::BeginTransactionRequest const&),
+              (override));
+
   MOCK_METHOD(StatusOr<google::spanner::v1::CommitResponse>, Commit,
               (grpc::ClientContext&, Options const&,
                google::spanner::v1::CommitRequest const&),
               (override));
 
+  MOCK_METHOD(future<StatusOr<google::spanner::v1::CommitResponse>>,
+              AsyncCommit,
+              (CompletionQueue&, std::shared_ptr<grpc::ClientContext>,
+               google::cloud::internal::ImmutableOptions,
+               google::spanner::v1::CommitRequest const&),
+              (override));
+
   MOCK_METHOD(Status, Rollback,
               (grpc::ClientContext&, Options const&,
                google::spanner::v1::RollbackRequest const&),
               (override));
 
+  MOCK_METHOD(future<Status>, AsyncRollback,
+              (CompletionQueue&, std::shared_ptr<grpc::ClientContext>,
+               google::cloud::internal::ImmutableOptions,
+               google::spanner::v1::RollbackRequest const&),
+              (override));
+
   MOCK_METHOD(StatusOr<google::spanner::v1::PartitionResponse>, PartitionQuery,
               (grpc::ClientContext&, Options const&,
                google::spanner::v1::PartitionQueryRequest const&),
@@ -288,6 +288,12 @@ struct TransactionInternals {
     return txn.impl_->Visit(std::forward<Functor>(f));
   }
 
+  template <typename Functor>
+  static VisitInvokeResult<Functor> AsyncVisit(spanner::Transaction const& txn,
+                                               Functor f) {
+    return txn.impl_->AsyncVisit(std::move(f));
+  }
+
   static spanner::Transaction MakeTransactionFromIds(
       std::string session_id, std::string transaction_id, bool route_to_leader,
       std::string transaction_tag);
@@ -312,6 +318,14 @@ VisitInvokeResult<Functor> Visit(spanner::Transaction txn, Functor&& f) {
   return TransactionInternals::Visit(std::move(txn), std::forward<Functor>(f));
 }
 
+// Asynchronous version of `Visit()`, where @p f returns a `future<>`. The
+// transaction is kept alive until that future is satisfied.
+template <typename Functor>
+VisitInvokeResult<Functor> AsyncVisit(spanner::Transaction const& txn,
+                                      Functor f) {
+  return TransactionInternals::AsyncVisit(txn, std::move(f));
+}
+
 inline spanner::Transaction MakeTransactionFromIds(
     std::string session_id, std::string transaction_id, bool route_to_leader,
     std::string transaction_tag) {
@@ -662,9 +662,17 @@ StatusOr<Bytes> Value::GetValue(Bytes const&, google::protobuf::Value const& pv,
   if (pv.kind_case() != google::protobuf::Value::kStringValue) {
     return internal::UnknownError("missing BYTES", GCP_ERROR_INFO());
   }
-  auto decoded = spanner_internal::BytesFromBase64(pv.string_value());
-  if (!decoded) return decoded.status();
-  return *decoded;
+  return spanner_internal::BytesFromBase64(pv.string_value());
+}
+
+StatusOr<Bytes> Value::GetValue(Bytes const&, google::protobuf::Value&& pv,
+                                google::spanner::v1::Type const&) {
+  if (pv.kind_case() != google::protobuf::Value::kStringValue) {
+    return internal::UnknownError("missing BYTES", GCP_ERROR_INFO());
+  }
+  // Keep the base64 representation, without copying it.
+  return spanner_internal::BytesFromBase64(
+      std::move(*pv.mutable_string_value()));
 }
 
 StatusOr<Json> Value::GetValue(Json const&, google::protobuf::Value const& pv,
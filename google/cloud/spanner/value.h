@@ -561,9 +561,9 @@ class Value {
   }
   template <typename M>
   static google::protobuf::Value MakeValueProto(ProtoMessage<M> m) {
-    internal::Base64Encoder encoder;
-    for (auto c : std::string{m}) encoder.PushBack(c);
-    return MakeValueProto(std::move(encoder).FlushAndPad());
+    auto const serialized = std::string{m};
+    return MakeValueProto(
+        internal::Base64Encode(serialized.data(), serialized.size()));
   }
   static google::protobuf::Value MakeValueProto(int i);
   static google::protobuf::Value MakeValueProto(char const* s);
@@ -625,6 +625,8 @@ class Value {
                                         google::spanner::v1::Type const&);
   static StatusOr<Bytes> GetValue(Bytes const&, google::protobuf::Value const&,
                                   google::spanner::v1::Type const&);
+  static StatusOr<Bytes> GetValue(Bytes const&, google::protobuf::Value&&,
+                                  google::spanner::v1::Type const&);
   static StatusOr<Json> GetValue(Json const&, google::protobuf::Value const&,
                                  google::spanner::v1::Type const&);
   static StatusOr<JsonB> GetValue(JsonB const&, google::protobuf::Value const&,
@@ -671,9 +673,13 @@ class Value {
     if (pv.kind_case() != google::protobuf::Value::kStringValue) {
       return internal::UnknownError("missing PROTO", GCP_ERROR_INFO());
     }
-    auto bytes = internal::Base64DecodeToBytes(pv.string_value());
-    if (!bytes) return std::move(bytes).status();
-    return ProtoMessage<M>(std::string(bytes->begin(), bytes->end()));
+    std::string serialized(internal::Base64DecodedSize(pv.string_value()),
+                           '\0');
+    auto n = internal::Base64DecodeInto(
+        pv.string_value(), reinterpret_cast<unsigned char*>(&serialized[0]));
+    if (!n) return std::move(n).status();
+    serialized.resize(*n);
+    return ProtoMessage<M>(std::move(serialized));
   }
   template <typename T, typename V>
   static StatusOr<std::optional<T>> GetValue(
@@ -811,6 +817,25 @@ struct ValueInternals {
       spanner::Value v) {
     return std::make_pair(std::move(v.type_), std::move(v.value_));
   }
+
+  // Checks if the C++ type `T` can represent values of type @p t.
+  template <typename T>
+  static bool TypeProtoIs(google::spanner::v1::Type const& t) {
+    return spanner::Value::TypeProtoIs(T{}, t);
+  }
+
+  // Like `spanner::Value::get<T>() &&`, for a value and type already checked
+  // with `TypeProtoIs<T>()`.
+  template <typename T>
+  static StatusOr<T> GetValue(google::protobuf::Value&& v,
+                              google::spanner::v1::Type const& t) {
+    if (v.kind_case() == google::protobuf::Value::kNullValue) {
+      if (spanner::Value::IsOptional<T>::value) return T{};
+      return internal::UnknownError("null value", GCP_ERROR_INFO());
+    }
+    auto tag = T{};  // Works around an odd msvc issue
+    return spanner::Value::GetValue(std::move(tag), std::move(v), t);
+  }
 };
 
 inline spanner::Value FromProto(google::spanner::v1::Type t,
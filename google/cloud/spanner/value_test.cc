@@ -367,6 +367,27 @@ TEST(Value, RvalueGetString) {
   EXPECT_EQ("", *s);
 }
 
+// NOTE: This test relies on the same unspecified behavior as the previous one,
+// as `Bytes` holds its base64 representation in a `std::string`.
+TEST(Value, RvalueGetBytes) {
+  using Type = Bytes;
+  Type const data = Bytes(std::string(128, 'x'));
+  Value v(data);
+
+  auto s = v.get<Type>();
+  ASSERT_STATUS_OK(s);
+  EXPECT_EQ(data, *s);
+
+  s = std::move(v).get<Type>();
+  ASSERT_STATUS_OK(s);
+  EXPECT_EQ(data, *s);
+
+  // NOLINTNEXTLINE(bugprone-use-after-move)
+  s = v.get<Type>();
+  ASSERT_STATUS_OK(s);
+  EXPECT_EQ(Bytes(), *s);
+}
+
 // NOTE: This test relies on unspecified behavior about the moved-from state
 // of std::string. Specifically, this test relies on the fact that "large"
 // strings, when moved-from, end up empty. And we use this fact to verify that
@@ -0,0 +1,53 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/testing_util/allocation_counter.h"
+#include "google/cloud/internal/port_platform.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+thread_local std::int64_t thread_allocations = 0;
+std::atomic<std::int64_t> process_allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++thread_allocations;
+  process_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto* p = std::malloc(size == 0 ? 1 : size)) return p;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  throw std::bad_alloc();
+#else
+  std::abort();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace testing_util {
+
+std::int64_t AllocationCounter::Count(Accounting accounting) {
+  if (accounting == Accounting::kPerThread) return thread_allocations;
+  return process_allocations.load(std::memory_order_relaxed);
+}
+
+}  // namespace testing_util
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,70 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_ALLOCATION_COUNTER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_ALLOCATION_COUNTER_H
+
+#include "google/cloud/version.h"
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace testing_util {
+
+/**
+ * Counts the heap allocations made through `operator new`.
+ *
+ * The library containing this class replaces the global `operator new` and
+ * `operator delete` of the program, so only benchmarks should link it.
+ *
+ * Use `PerThread()` to exclude the allocations of other threads in the
+ * process, such as an embedded server, and `PerProcess()` when the code under
+ * test does its work in background threads. Like the timings, the counts
+ * depend on the compiler and the standard library, so compare the results of a
+ * change against a baseline built and run on the same machine.
+ */
+class AllocationCounter {
+ public:
+  static AllocationCounter PerThread() {
+    return AllocationCounter(Accounting::kPerThread);
+  }
+  static AllocationCounter PerProcess() {
+    return AllocationCounter(Accounting::kPerProcess);
+  }
+
+  /// The number of allocations since this object was created.
+  std::int64_t Sample() const { return Count(accounting_) - start_; }
+
+ private:
+  enum class Accounting {
+    kPerThread,
+    kPerProcess,
+  };
+
+  explicit AllocationCounter(Accounting accounting)
+      : accounting_(accounting), start_(Count(accounting)) {}
+
+  static std::int64_t Count(Accounting accounting);
+
+  Accounting accounting_;
+  std::int64_t start_;
+};
+
+}  // namespace testing_util
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_ALLOCATION_COUNTER_H